@@ -4,9 +4,14 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
 #include <glm/glm.hpp>
 
 const int MAX_FRAME_DRAWS = 3;
@@ -169,6 +174,37 @@ static void copyBuffer(VkDevice device, VkQueue transferQueue, VkCommandPool tra
 	vkFreeCommandBuffers(device, transferCommandPool, 1, &transferCommandBuffer);
 }
 
+// Portable aligned allocation for the dynamic uniform transfer space.  align must be a power of two (as Vulkan's
+// minUniformBufferOffsetAlignment is); memory from alignedAlloc must be released with alignedFree.
+static void* alignedAlloc(size_t size, size_t align)
+{
+  void* p = nullptr;
+
+#ifdef _WIN32
+  p = _aligned_malloc(size, align);
+#else
+  if (align < sizeof(void*)) align = sizeof(void*);   // posix_memalign wants a multiple of sizeof(void*)
+  if (posix_memalign(&p, align, size) != 0) p = nullptr;
+#endif
+
+  if (p == nullptr)
+  {
+    std::cerr << "[-] failed to allocate " << size << " bytes aligned to " << align << std::endl;
+    throw std::runtime_error("Failed to allocate aligned memory!");
+  }
+
+  return p;
+}
+
+static void alignedFree(void* p)
+{
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+
 
 
 
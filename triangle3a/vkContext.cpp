@@ -169,10 +169,31 @@ int vkContext::initContext()
 
 
 
+/************************************************************************************************************************
+ * function  : updateModel
+ *
+ * abstract  : Sets the model matrix of an object.  The new matrix is written into the CPU side transfer space and the
+ *             object's version is bumped so that updateUniformBuffers copies it into each image's buffer the next time
+ *             that image is used.  Setting a matrix equal to the current one does not dirty the object.
+ *
+ * parameters: modelId -- [in] index of the object in the mesh list
+ *             newModel -- [in] the new model matrix
+ *
+ * returns   : void
+ *
+ * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) added dirty tracking
+************************************************************************************************************************/
 void vkContext::updateModel(int modelId, glm::mat4 newModel)
 {
-  if (modelId >= m_meshList.size()) return;
+  if (modelId < 0 || modelId >= (int)m_meshList.size()) return;
+
+  UboModel* thisModel = (UboModel*)((uint8_t*)m_modelTransferSpace + (modelId * m_modelUniformAlignment));
+  if (thisModel->model == newModel) return;
+
+  thisModel->model = newModel;
   m_meshList[modelId].setModel(newModel);
+  m_modelVersion[modelId]++;
 }
 
 
@@ -263,12 +284,15 @@ void vkContext::cleanupContext()
 {
   vkDeviceWaitIdle(m_device.logical);
   
-  _aligned_free(m_modelTransferSpace);
+  alignedFree(m_modelTransferSpace);
 
   vkDestroyDescriptorPool(m_device.logical, m_descriptorPool, nullptr);
   vkDestroyDescriptorSetLayout(m_device.logical, m_descriptorSetLayout, nullptr);
   for (size_t i = 0; i < m_swapChainImages.size(); i++)
   {
+    vkUnmapMemory(m_device.logical, m_vpUniformBufferMemory[i]);
+    vkUnmapMemory(m_device.logical, m_modelDUniformBufferMemory[i]);
+
     vkDestroyBuffer(m_device.logical, m_vpUniformBuffer[i], nullptr);
     vkFreeMemory(m_device.logical, m_vpUniformBufferMemory[i], nullptr);
     vkDestroyBuffer(m_device.logical, m_modelDUniformBuffer[i], nullptr);
@@ -1100,13 +1124,16 @@ void vkContext::createSynchronisations()
 /************************************************************************************************************************
  * function  : createUniformBuffers 
  *
- * abstract  :
+ * abstract  : Creates one view-projection buffer and one dynamic model buffer per swapchain image and maps them for the
+ *             life of the context.  The model buffers only require HOST_VISIBLE memory, if the type we get is not also
+ *             HOST_COHERENT the writes made by updateUniformBuffers are flushed explicitly.
  *
  * parameters: void 
  *
  * returns   : void 
  *
  * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) persistent mapping, model buffers no longer require coherent memory
 ************************************************************************************************************************/
 void vkContext::createUniformBuffers()
 {
@@ -1128,8 +1155,37 @@ void vkContext::createUniformBuffers()
       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &m_vpUniformBuffer[i], &m_vpUniformBufferMemory[i]);
 
     createBuffer(m_device.physical, m_device.logical, modelBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &m_modelDUniformBuffer[i], &m_modelDUniformBufferMemory[i]);
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &m_modelDUniformBuffer[i], &m_modelDUniformBufferMemory[i]);
   }
+
+  // every model buffer has the same requirements, so they all land in the same memory type
+  VkMemoryRequirements memRequirements;
+  vkGetBufferMemoryRequirements(m_device.logical, m_modelDUniformBuffer[0], &memRequirements);
+
+  VkPhysicalDeviceMemoryProperties memoryProperties;
+  vkGetPhysicalDeviceMemoryProperties(m_device.physical, &memoryProperties);
+
+  uint32_t typeIndex = findMemoryTypeIndex(m_device.physical, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+  m_modelMemoryCoherent = (memoryProperties.memoryTypes[typeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+  m_modelMemorySize = memRequirements.size;
+
+  std::cout << "[?] model uniform memory is " << (m_modelMemoryCoherent ? "host coherent" : "non-coherent, flushing dirty ranges") << std::endl;
+
+  m_vpUniformMapped.resize(m_swapChainImages.size());
+  m_modelUniformMapped.resize(m_swapChainImages.size());
+  for (size_t i = 0; i < m_swapChainImages.size(); i++)
+  {
+    if (vkMapMemory(m_device.logical, m_vpUniformBufferMemory[i], 0, VK_WHOLE_SIZE, 0, &m_vpUniformMapped[i]) != VK_SUCCESS ||
+        vkMapMemory(m_device.logical, m_modelDUniformBufferMemory[i], 0, VK_WHOLE_SIZE, 0, &m_modelUniformMapped[i]) != VK_SUCCESS)
+    {
+      std::cerr << "[-] failed to map uniform buffer memory" << std::endl;
+      throw std::runtime_error("Failed to map uniform buffer memory!");
+    }
+  }
+
+  // nothing has been written to any image yet, version 0 forces the first write of every object
+  m_modelWrittenVersion.assign(m_swapChainImages.size(), std::vector<uint32_t>(MAX_OBJECTS, 0));
+  m_flushRanges.reserve(MAX_OBJECTS);
 }
 
 
@@ -1257,7 +1313,11 @@ void vkContext::createDescriptorSets()
 /************************************************************************************************************************
  * function  : updateUniformBuffer
  *
- * abstract  :
+ * abstract  : Brings the uniform buffers of an image up to date.  The view-projection matrix is always copied.  Model
+ *             matrices are only copied for objects whose version has changed since this image's buffer was last
+ *             written, the dirty slots are collected into merged ranges (rounded out to nonCoherentAtomSize) and flushed
+ *             with vkFlushMappedMemoryRanges when the memory is not host coherent.  With mostly static objects the cost
+ *             of this function is proportional to the number of objects that moved, not the number of objects.
  *
  * parameters: imageIndex -- [in] the current image we are working with.  Recall, framebuffer, image, command buffer and 
  *                           uniform buffers are all in a one-to-one correspondnce
@@ -1265,25 +1325,51 @@ void vkContext::createDescriptorSets()
  * returns   : void
  *
  * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) persistent mapping, only dirty objects are written and flushed
 ************************************************************************************************************************/
 void vkContext::updateUniformBuffers(uint32_t imageIndex)
 {
-  void* data;
-  vkMapMemory(m_device.logical, m_vpUniformBufferMemory[imageIndex], 0, sizeof(UboVP), 0, &data);
-  memcpy(data, &m_uboVP, sizeof(UboVP));
-  vkUnmapMemory(m_device.logical, m_vpUniformBufferMemory[imageIndex]);
+  memcpy(m_vpUniformMapped[imageIndex], &m_uboVP, sizeof(UboVP));
+
+  std::vector<uint32_t>& written = m_modelWrittenVersion[imageIndex];
+  uint8_t* dst = (uint8_t*)m_modelUniformMapped[imageIndex];
+  const uint8_t* src = (const uint8_t*)m_modelTransferSpace;
 
-  // Copy Model data
+  m_flushRanges.clear();
   for (size_t i = 0; i < m_meshList.size(); i++)
   {
-    UboModel* thisModel = (UboModel*)((uint64_t)m_modelTransferSpace + (i * m_modelUniformAlignment));
-    *thisModel = m_meshList[i].getModel();
+    if (written[i] == m_modelVersion[i]) continue;
+
+    VkDeviceSize offset = i * m_modelUniformAlignment;
+    memcpy(dst + offset, src + offset, sizeof(UboModel));
+    written[i] = m_modelVersion[i];
+
+    if (m_modelMemoryCoherent) continue;
+
+    // flush ranges must start and end on a multiple of nonCoherentAtomSize (or end at the end of the allocation)
+    VkDeviceSize start = (offset / m_nonCoherentAtomSize) * m_nonCoherentAtomSize;
+    VkDeviceSize end = ((offset + sizeof(UboModel) + m_nonCoherentAtomSize - 1) / m_nonCoherentAtomSize) * m_nonCoherentAtomSize;
+    if (end > m_modelMemorySize) end = m_modelMemorySize;
+
+    if (!m_flushRanges.empty() && m_flushRanges.back().offset + m_flushRanges.back().size >= start)
+    {
+      m_flushRanges.back().size = end - m_flushRanges.back().offset;    // adjacent or overlapping, extend the last range
+    }
+    else
+    {
+      VkMappedMemoryRange range = {};
+      range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+      range.memory = m_modelDUniformBufferMemory[imageIndex];
+      range.offset = start;
+      range.size = end - start;
+      m_flushRanges.push_back(range);
+    }
   }
 
-  // Map the list of model data
-  vkMapMemory(m_device.logical, m_modelDUniformBufferMemory[imageIndex], 0, m_modelUniformAlignment * m_meshList.size(), 0, &data);
-  memcpy(data, m_modelTransferSpace, m_modelUniformAlignment * m_meshList.size());
-  vkUnmapMemory(m_device.logical, m_modelDUniformBufferMemory[imageIndex]);
+  if (!m_flushRanges.empty())
+  {
+    vkFlushMappedMemoryRanges(m_device.logical, static_cast<uint32_t>(m_flushRanges.size()), m_flushRanges.data());
+  }
 }
 
 /************************************************************************************************************************
@@ -1416,6 +1502,7 @@ void vkContext::getPhysicalDevice()
   vkGetPhysicalDeviceProperties(m_device.physical, &deviceProperties);
 
   m_minUniformBufferOffset = deviceProperties.limits.minUniformBufferOffsetAlignment;
+  m_nonCoherentAtomSize = deviceProperties.limits.nonCoherentAtomSize;
 }
 
 
@@ -1423,19 +1510,29 @@ void vkContext::getPhysicalDevice()
 /************************************************************************************************************************
  * function  : allocateDynamicBufferTransferSpace 
  *
- * abstract  : This function allocates aligned memory space for use in transfering data from teh CPU to the GPU for use
- *             in dynamic uniform descriptor sets
- *
- * parameters:
- *
- * returns   :
- *
- * written   : Apr 2024 (GKHuber)
+ * abstract  : This function allocates aligned memory space for use in transfering data from teh CPU to the GPU for use
+ *             in dynamic uniform descriptor sets.  The transfer space holds the current model matrix of every object,
+ *             laid out exactly as in the uniform buffers, and is seeded from the meshes.
+ *
+ * parameters:
+ *
+ * returns   : void, throws runtime exception if the allocation fails
+ *
+ * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) portable aligned allocation, per object versions for dirty tracking
 ************************************************************************************************************************/
 void vkContext::allocateDynamicBufferTransferSpace()
 {
   m_modelUniformAlignment = (sizeof(UboModel) + m_minUniformBufferOffset - 1) & ~(m_minUniformBufferOffset - 1);
-  m_modelTransferSpace = (UboModel*)_aligned_malloc(m_modelUniformAlignment * MAX_OBJECTS, m_modelUniformAlignment);
+  m_modelTransferSpace = (UboModel*)alignedAlloc(m_modelUniformAlignment * MAX_OBJECTS, m_modelUniformAlignment);
+
+  for (size_t i = 0; i < m_meshList.size(); i++)
+  {
+    UboModel* thisModel = (UboModel*)((uint8_t*)m_modelTransferSpace + (i * m_modelUniformAlignment));
+    *thisModel = m_meshList[i].getModel();
+  }
+
+  m_modelVersion.assign(MAX_OBJECTS, 1);
 }
 
 
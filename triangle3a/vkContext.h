@@ -66,10 +66,22 @@ private:
   std::vector<VkBuffer>        m_modelDUniformBuffer;
   std::vector<VkDeviceMemory>  m_modelDUniformBufferMemory;
 
+  std::vector<void*>           m_vpUniformMapped;              // uniform buffers stay mapped for the life of the context
+  std::vector<void*>           m_modelUniformMapped;
+
   VkDeviceSize                 m_minUniformBufferOffset;
+  VkDeviceSize                 m_nonCoherentAtomSize;          // granularity of vkFlushMappedMemoryRanges
+  VkDeviceSize                 m_modelMemorySize;              // size of each model buffer's allocation
+  bool                         m_modelMemoryCoherent;          // false => dirty ranges must be flushed
   size_t                       m_modelUniformAlignment;
   UboModel*                    m_modelTransferSpace;
 
+  // dirty tracking: an object is copied into an image's buffer only when its version differs from the version that
+  // buffer last received, so static objects cost nothing per frame
+  std::vector<uint32_t>                m_modelVersion;
+  std::vector<std::vector<uint32_t>>   m_modelWrittenVersion;  // [image][object]
+  std::vector<VkMappedMemoryRange>     m_flushRanges;          // scratch, reused every frame
+
   struct {
     VkPhysicalDevice  physical;
     VkDevice          logical;
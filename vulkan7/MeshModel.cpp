@@ -1,14 +1,13 @@
 #include "MeshModel.h"
 
-MeshModel::MeshModel()
+MeshModel::MeshModel() : m_meshList(std::make_shared<std::vector<mesh>>()), m_model(1.0f)
 {
 
 }
 
 
-MeshModel::MeshModel(std::vector<mesh> newMeshList)
+MeshModel::MeshModel(std::vector<mesh>&& meshes) : m_meshList(std::make_shared<std::vector<mesh>>(std::move(meshes)))
 {
-  m_meshList = newMeshList;
   m_model = glm::mat4(1.0f);
 }
 
@@ -16,19 +15,41 @@ MeshModel::~MeshModel()
 {
 }
 
+// the instance starts with this model's transform, it is usually replaced straight away
+MeshModel MeshModel::createInstance()
+{
+  MeshModel instance;
+  instance.m_meshList = m_meshList;
+  instance.m_model = m_model;
+  instance.m_ownsMeshes = false;
+
+  return instance;
+}
+
 size_t MeshModel::getMeshCount()
 {
-  return m_meshList.size();
+  return m_meshList->size();
+}
+
+size_t MeshModel::getIndexCount()
+{
+  size_t indexCount = 0;
+  for (auto& m : *m_meshList)
+  {
+    indexCount += m.getIndexCount();
+  }
+
+  return indexCount;
 }
 
 mesh* MeshModel::getMesh(size_t ndx)
 {
-  if (ndx >= m_meshList.size())
+  if (ndx >= m_meshList->size())
   {
     throw std::runtime_error("Attempted to access index out of bounds");
   }
 
-  return &m_meshList[ndx];
+  return &(*m_meshList)[ndx];
 }
 
 glm::mat4 MeshModel::getModel()
@@ -41,14 +62,6 @@ void MeshModel::setModel(glm::mat4 newModel)
   m_model = newModel;
 }
 
-void MeshModel::destroyMeshModel()
-{
-  for (auto& m : m_meshList)
-  {
-    m.destroyBuffers();
-  }
-}
-
 std::vector <std::string> MeshModel::LoadMaterials(const aiScene* scene)
 {	
 	// Create 1:1 sized list of textures
@@ -82,31 +95,119 @@ std::vector <std::string> MeshModel::LoadMaterials(const aiScene* scene)
 	return textureList;
 }
 
-std::vector<mesh> MeshModel::loadNode(VkPhysicalDevice newPhysicalDevice, VkDevice newDevice, VkQueue transferQueue, VkCommandPool transferCommandPool, aiNode* _node, const aiScene* scene, std::vector<int> matToTex)
+size_t MeshModel::countMeshes(aiNode* _node)
 {
-	std::vector<mesh> meshList;
+	size_t count = _node->mNumMeshes;
+	for (size_t i = 0; i < _node->mNumChildren; i++)
+	{
+		count += countMeshes(_node->mChildren[i]);
+	}
+
+	return count;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : loadNode
+ *
+ * abstract  : Creates a mesh for each aiMesh of the node and its children, depth first, appending them to the caller's
+ *             list.  Each mesh is constructed in place, so with the list reserved for countMeshes(node) the meshes are
+ *             never copied or moved; the conversion buffers are reused from one mesh of the node to the next.
+ *
+ * parameters: _node -- [in] node to load, with its children
+ *             scene -- [in] the imported scene
+ *             matToTex -- [in] material index to texture, null handles get the default texture
+ *             meshes -- [in/out] list the meshes are appended to
+ *             buildMeshlets -- [in] also split the meshes into meshlets (see vkContext::setMeshlets)
+ *
+ * returns   : void
+ *
+ * written   : Mar 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) appends to one list rather than returning a list per node for the caller to copy
+************************************************************************************************************************/
+void MeshModel::loadNode(VkPhysicalDevice newPhysicalDevice, VkDevice newDevice, VkQueue transferQueue, VkCommandPool transferCommandPool, aiNode* _node, const aiScene* scene,
+                         const std::vector<textureHandle>& matToTex, std::vector<mesh>* meshes, bool buildMeshlets)
+{
+	std::vector<vertex> vertices;
+	std::vector<uint32_t> indices;
 
-	// Go through each mesh at this node and create it, then add it to our meshList
+	// Go through each mesh at this node and create it at the end of the list
 	for (size_t i = 0; i < _node->mNumMeshes; i++)
 	{
-		meshList.push_back(
-			loadMesh(newPhysicalDevice, newDevice, transferQueue, transferCommandPool, scene->mMeshes[_node->mMeshes[i]], scene, matToTex)
-		);
+		aiMesh* _mesh = scene->mMeshes[_node->mMeshes[i]];
+		convertMesh(_mesh, &vertices, &indices);
+		meshes->emplace_back(newPhysicalDevice, newDevice, transferQueue, transferCommandPool, &vertices, &indices, matToTex[_mesh->mMaterialIndex], buildMeshlets);
 	}
 
-	// Go through each node attached to this node and load it, then append their meshes to this node's mesh list
+	// Go through each node attached to this node and append its meshes
 	for (size_t i = 0; i < _node->mNumChildren; i++)
 	{
-		std::vector<mesh> newList = loadNode(newPhysicalDevice, newDevice, transferQueue, transferCommandPool, _node->mChildren[i], scene, matToTex);
-		meshList.insert(meshList.end(), newList.begin(), newList.end());
+		loadNode(newPhysicalDevice, newDevice, transferQueue, transferCommandPool, _node->mChildren[i], scene, matToTex, meshes, buildMeshlets);
 	}
+}
+mesh MeshModel::loadMesh(VkPhysicalDevice newPhysicalDevice, VkDevice newDevice, VkQueue transferQueue, VkCommandPool transferCommandPool, aiMesh* _mesh, const aiScene* scene, const std::vector<textureHandle>& matToTex, bool buildMeshlets)
+{
+	std::vector<vertex> vertices;
+	std::vector<uint32_t> indices;
+	convertMesh(_mesh, &vertices, &indices);
 
-	return meshList;
+	// Create new mesh with details and return it
+	return mesh(newPhysicalDevice, newDevice, transferQueue, transferCommandPool, &vertices, &indices, matToTex[_mesh->mMaterialIndex], buildMeshlets);
 }
-mesh MeshModel::loadMesh(VkPhysicalDevice newPhysicalDevice, VkDevice newDevice, VkQueue transferQueue, VkCommandPool transferCommandPool, aiMesh* _mesh, const aiScene* scene, std::vector<int> matToTex)
+
+
+
+/************************************************************************************************************************
+ * function  : mergeNode
+ *
+ * abstract  : The merging counterpart of loadNode.  Rather than creating a mesh for each aiMesh, each is converted and
+ *             handed to the merger with the node's transform composed with its parents', so the merged meshes end up in
+ *             model space (loadNode leaves every mesh in its own node's space).
+ *
+ * parameters: _node -- [in] node to add, with its children
+ *             scene -- [in] the imported scene
+ *             matToTex -- [in] material index to the texture index given to the merger (see meshMerger::build)
+ *             parent -- [in] transform of the node's parent into model space, identity for the root
+ *             merger -- [in/out] collects the meshes
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void MeshModel::mergeNode(aiNode* _node, const aiScene* scene, const std::vector<int>& matToTex, const glm::mat4& parent, meshMerger* merger)
 {
+	// aiMatrix4x4 is row major, glm is column major
+	glm::mat4 local;
+	for (int row = 0; row < 4; row++)
+	{
+		for (int col = 0; col < 4; col++) local[col][row] = _node->mTransformation[row][col];
+	}
+	glm::mat4 transform = parent * local;
+
 	std::vector<vertex> vertices;
 	std::vector<uint32_t> indices;
+	for (size_t i = 0; i < _node->mNumMeshes; i++)
+	{
+		aiMesh* _mesh = scene->mMeshes[_node->mMeshes[i]];
+		convertMesh(_mesh, &vertices, &indices);
+		merger->add(vertices.data(), (uint32_t)vertices.size(), indices.data(), (uint32_t)indices.size(), matToTex[_mesh->mMaterialIndex], &transform);
+	}
+
+	for (size_t i = 0; i < _node->mNumChildren; i++)
+	{
+		mergeNode(_node->mChildren[i], scene, matToTex, transform, merger);
+	}
+}
+
+
+
+// converts an aiMesh into our vertex layout (white, UVs as imported) and a triangle list
+void MeshModel::convertMesh(aiMesh* _mesh, std::vector<vertex>* pVertices, std::vector<uint32_t>* pIndices)
+{
+	std::vector<vertex>& vertices = *pVertices;
+	std::vector<uint32_t>& indices = *pIndices;
+	indices.clear();
 
 	// Resize vertex list to hold all vertices for mesh
 	vertices.resize(_mesh->mNumVertices);
@@ -143,11 +244,6 @@ mesh MeshModel::loadMesh(VkPhysicalDevice newPhysicalDevice, VkDevice newDevice,
 			indices.push_back(face.mIndices[j]);
 		}
 	}
-
-	// Create new mesh with details and return it
-	mesh newMesh = mesh(newPhysicalDevice, newDevice, transferQueue, transferCommandPool, &vertices, &indices, matToTex[_mesh->mMaterialIndex]);
-
-	return newMesh;
 }
 
 
@@ -1,36 +1,53 @@
 #ifndef _MeshModel_h_
 #define _MeshModel_h_
 
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 
 #include <assimp/scene.h>
 
 #include "mesh.h"
+#include "meshMerger.h"
 
+// A model's meshes.  The mesh list is built once by the loader and moved in, never copied; instances of a model share
+// the same list, which (with its buffers) goes when the last model using it does.
 class MeshModel
 {
 public:
   MeshModel();
-  MeshModel(std::vector<mesh>);
+  explicit MeshModel(std::vector<mesh>&& meshes);
   ~MeshModel();
 
+  MeshModel(const MeshModel&) = delete;
+  MeshModel& operator=(const MeshModel&) = delete;
+  MeshModel(MeshModel&&) noexcept = default;
+  MeshModel& operator=(MeshModel&&) noexcept = default;
+
+  MeshModel createInstance();                      // another model drawing this one's meshes
+
   size_t    getMeshCount();
+  size_t    getIndexCount();
 
   mesh*     getMesh(size_t ndx);
 
   glm::mat4 getModel();
   void      setModel(glm::mat4);
 
-  void      destroyMeshModel();
+  bool      ownsMeshes() { return m_ownsMeshes; }    // false for instances, their meshes are counted with the original
 
   static std::vector<std::string>  LoadMaterials(const aiScene* scene);
-  static std::vector<mesh> loadNode(VkPhysicalDevice, VkDevice, VkQueue, VkCommandPool, aiNode*, const aiScene*, std::vector<int>);
-  static mesh loadMesh(VkPhysicalDevice, VkDevice, VkQueue, VkCommandPool,aiMesh*, const aiScene*, std::vector<int>);
+  static size_t countMeshes(aiNode*);              // meshes loadNode creates for the node and its children
+  static void loadNode(VkPhysicalDevice, VkDevice, VkQueue, VkCommandPool, aiNode*, const aiScene*, const std::vector<textureHandle>& matToTex,
+                       std::vector<mesh>* meshes, bool buildMeshlets = false);
+  static mesh loadMesh(VkPhysicalDevice, VkDevice, VkQueue, VkCommandPool,aiMesh*, const aiScene*, const std::vector<textureHandle>& matToTex, bool buildMeshlets = false);
+  static void mergeNode(aiNode*, const aiScene*, const std::vector<int>& matToTex, const glm::mat4& parent, meshMerger* merger);
+  static void convertMesh(aiMesh*, std::vector<vertex>* vertices, std::vector<uint32_t>* indices);
 
 private:
-  std::vector<mesh>  m_meshList;
+  std::shared_ptr<std::vector<mesh>> m_meshList;  // shared with instances
   glm::mat4          m_model;
+  bool               m_ownsMeshes = true;
 
 };
 
@@ -0,0 +1,7 @@
+#version 450
+
+layout(location = 0) out vec4 outColour;
+
+void main() {
+	outColour = vec4(0.9, 0.6, 0.2, 1.0);
+}
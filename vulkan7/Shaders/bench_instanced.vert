@@ -0,0 +1,11 @@
+#version 450 		// Use GLSL 4.5
+
+// object data benchmark -- matrix is a per-instance attribute (locations 1 to 4), one draw for every object
+
+layout(location=0) in vec2 pos;
+layout(location=1) in mat4 mvp;
+
+void main()
+{
+	gl_Position = mvp * vec4(pos, 0.0, 1.0);
+}
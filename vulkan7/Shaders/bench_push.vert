@@ -0,0 +1,15 @@
+#version 450 		// Use GLSL 4.5
+
+// object data benchmark -- matrix pushed before each draw
+
+layout(location=0) in vec2 pos;
+
+layout(push_constant) uniform PushObject
+{
+	mat4 mvp;
+} pushObject;
+
+void main()
+{
+	gl_Position = pushObject.mvp * vec4(pos, 0.0, 1.0);
+}
@@ -0,0 +1,15 @@
+#version 450 		// Use GLSL 4.5
+
+// object data benchmark -- every matrix in one storage buffer, the draw's firstInstance selects the object
+
+layout(location=0) in vec2 pos;
+
+layout(std430, set=0, binding=0) readonly buffer Objects
+{
+	mat4 mvp[];
+} objects;
+
+void main()
+{
+	gl_Position = objects.mvp[gl_InstanceIndex] * vec4(pos, 0.0, 1.0);
+}
@@ -0,0 +1,15 @@
+#version 450 		// Use GLSL 4.5
+
+// object data benchmark -- dynamic uniform buffer, rebound at the object's offset before each draw
+
+layout(location=0) in vec2 pos;
+
+layout(set=0, binding=0) uniform UboObject
+{
+	mat4 mvp;
+} uboObject;
+
+void main()
+{
+	gl_Position = uboObject.mvp * vec4(pos, 0.0, 1.0);
+}
@@ -0,0 +1,13 @@
+#version 450
+
+layout(location = 0) in vec2 fragTex;
+layout(location = 1) in vec4 fragCol;
+
+layout(set = 0, binding = 0) uniform sampler2D fontAtlas;     // white, the glyphs are in the alpha
+
+layout(location = 0) out vec4 outColour;
+
+void main()
+{
+	outColour = vec4(fragCol.rgb, fragCol.a * texture(fontAtlas, fragTex).a);
+}
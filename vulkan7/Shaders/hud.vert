@@ -0,0 +1,27 @@
+#version 450
+
+// performance HUD -- one instanced triangle strip, a quad per instance (see perfHud.h)
+
+layout(location = 0) in vec4 rect;             // x, y, width, height in pixels from the top left
+layout(location = 1) in uint glyph;            // font atlas cell, 16 across and 6 down; cell 95 is solid
+layout(location = 2) in vec4 colour;
+
+layout(push_constant) uniform Screen
+{
+	vec2 size;
+} screen;
+
+layout(location = 0) out vec2 fragTex;
+layout(location = 1) out vec4 fragCol;
+
+void main()
+{
+	vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+	vec2 pixel = rect.xy + corner * rect.zw;
+	gl_Position = vec4(pixel / screen.size * 2.0 - 1.0, 0.0, 1.0);
+
+	// the solid cell is sampled in its middle so filtering never reaches the edge of the atlas
+	vec2 cellCorner = (glyph == 95u) ? vec2(0.5) : corner;
+	fragTex = (vec2(glyph % 16u, glyph / 16u) + cellCorner) / vec2(16.0, 6.0);
+	fragCol = colour;
+}
@@ -0,0 +1,15 @@
+#version 450
+
+layout(binding = 0) uniform sampler2DArray inputColour;  // Colour output from the scene, one layer per view
+
+layout(location = 0) out vec4 colour;
+
+void main()
+{
+	// the views side by side, left to right
+	ivec3 size = textureSize(inputColour, 0);
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	int   view = min(pixel.x / size.x, size.z - 1);
+
+	colour = texelFetch(inputColour, ivec3(min(pixel.x - view * size.x, size.x - 1), pixel.y, view), 0);
+}
\ No newline at end of file
@@ -11,7 +11,7 @@ layout(set=0, binding=0) uniform UboVP {
 
 layout(push_constant) uniform PushModel
 {
-	mat4 model;
+	mat4 mvp;				// proj * view * model, composed on the CPU once per object
 } pushModel;
 
 layout(location = 0) out vec3 fragCol;	// Output colour for vertex (location is required)
@@ -21,7 +21,7 @@ layout(location = 1) out vec2 fragTex;
 
 void main() 
 {
-	gl_Position = uboVP.proj*uboVP.view*pushModel.model *vec4(pos, 1.0);
+	gl_Position = pushModel.mvp * vec4(pos, 1.0);
 	fragCol = col;
 	fragTex = tex;
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "allocTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> s_allocations(0);
+static std::atomic<uint64_t> s_frees(0);
+static std::atomic<uint64_t> s_bytes(0);
+
+
+/************************************************************************************************************************
+ * function  : getAllocationCounts
+ *
+ * abstract  : Returns the number of calls to operator new / delete, and the bytes requested, since the program started.
+ *             The counts cover every thread.  If tracking is not compiled in all counts are zero.
+ *
+ * parameters: void
+ *
+ * returns   : allocCounts, snapshot of the counters
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+allocCounts getAllocationCounts()
+{
+  allocCounts counts;
+
+  counts.allocations = s_allocations.load(std::memory_order_relaxed);
+  counts.frees = s_frees.load(std::memory_order_relaxed);
+  counts.bytes = s_bytes.load(std::memory_order_relaxed);
+
+  return counts;
+}
+
+
+
+allocCounts allocationsSince(const allocCounts& start)
+{
+  allocCounts now = getAllocationCounts();
+
+  now.allocations -= start.allocations;
+  now.frees -= start.frees;
+  now.bytes -= start.bytes;
+
+  return now;
+}
+
+
+
+bool allocationTrackingEnabled()
+{
+#ifdef TRACK_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+
+#ifdef TRACK_ALLOCATIONS
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// replacement global allocation functions.  Only the basic forms need replacing, the standard library implements the
+// array and nothrow forms in terms of them; the aligned forms have to be done separately.
+static void* countedAlloc(size_t size)
+{
+  s_allocations.fetch_add(1, std::memory_order_relaxed);
+  s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  void* p = std::malloc(size ? size : 1);
+  if (nullptr == p) throw std::bad_alloc();
+
+  return p;
+}
+
+static void* countedAlignedAlloc(size_t size, std::align_val_t alignment)
+{
+  s_allocations.fetch_add(1, std::memory_order_relaxed);
+  s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  size_t align = static_cast<size_t>(alignment);
+  size_t rounded = ((size ? size : 1) + align - 1) & ~(align - 1);
+
+#ifdef _WIN32
+  void* p = _aligned_malloc(rounded, align);
+#else
+  void* p = std::aligned_alloc(align, rounded);
+#endif
+  if (nullptr == p) throw std::bad_alloc();
+
+  return p;
+}
+
+static void countedFree(void* p)
+{
+  if (nullptr == p) return;
+
+  s_frees.fetch_add(1, std::memory_order_relaxed);
+  std::free(p);
+}
+
+static void countedAlignedFree(void* p)
+{
+  if (nullptr == p) return;
+
+  s_frees.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void* operator new[](size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+#endif
@@ -0,0 +1,24 @@
+#ifndef _allocTracker_h_
+#define _allocTracker_h_
+
+#include <cstdint>
+
+// Debug allocation counter.  When TRACK_ALLOCATIONS is defined (it is by default in debug builds, i.e. when NDEBUG is
+// not defined) the global operator new/delete are replaced with versions that count every call.  Take a snapshot before
+// and after a block of code to find out how many heap allocations it made.
+#if !defined(NDEBUG) && !defined(TRACK_ALLOCATIONS) && !defined(NO_TRACK_ALLOCATIONS)
+#define TRACK_ALLOCATIONS
+#endif
+
+struct allocCounts
+{
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+  uint64_t bytes = 0;                 // total bytes requested, not bytes live
+};
+
+bool        allocationTrackingEnabled();
+allocCounts getAllocationCounts();
+allocCounts allocationsSince(const allocCounts& start);
+
+#endif
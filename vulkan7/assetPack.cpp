@@ -0,0 +1,592 @@
+#include "assetPack.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "utilities.h"
+
+static const char PACK_MAGIC[8] = { 'V', 'K', 'P', 'A', 'C', 'K', '\0', '\0' };
+
+static_assert(sizeof(packHeader) == 56, "packHeader is written as it is, it must not change size");
+static_assert(sizeof(packEntry) == 32, "packEntry is written as it is, it must not change size");
+
+static assetPack* g_currentPack = nullptr;
+static jobSystem* g_packJobs = nullptr;
+
+// rounds up to a whole number of pages
+static uint64_t pageAlign(uint64_t size)
+{
+  return (size + PACK_PAGE_SIZE - 1) & ~static_cast<uint64_t>(PACK_PAGE_SIZE - 1);
+}
+
+
+
+packBuffer::~packBuffer()
+{
+#ifdef _WIN32
+  _aligned_free(m_data);
+#else
+  free(m_data);
+#endif
+}
+
+
+
+// makes room for size bytes, rounded up to whole pages so an unbuffered read of the padded entry fits
+void packBuffer::resize(size_t size)
+{
+  size_t capacity = static_cast<size_t>(pageAlign(std::max<size_t>(size, 1)));
+  if (capacity > m_capacity)
+  {
+#ifdef _WIN32
+    _aligned_free(m_data);
+    m_data = static_cast<uint8_t*>(_aligned_malloc(capacity, PACK_PAGE_SIZE));
+#else
+    free(m_data);
+    void* p = nullptr;
+    m_data = (0 == posix_memalign(&p, PACK_PAGE_SIZE, capacity)) ? static_cast<uint8_t*>(p) : nullptr;
+#endif
+    m_capacity = (nullptr != m_data) ? capacity : 0;
+    if (nullptr == m_data) throw std::runtime_error("failed to allocate a pack buffer");
+  }
+  m_size = size;
+}
+
+
+
+assetPack::assetPack() : m_header(), m_file(-1), m_direct(-1)
+{
+}
+
+
+
+assetPack::~assetPack()
+{
+  close();
+}
+
+
+
+/************************************************************************************************************************
+ * function  : open
+ *
+ * abstract  : Opens a pack and reads everything in front of the data (hash index and names) with a single read, then
+ *             checks that every entry's name is in the names block, hashes to its stored hash and that its data is page
+ *             aligned and inside the file.  The file stays open for read; it is also opened unbuffered if the OS and
+ *             file system allow (tmpfs, for one, does not), otherwise all reads are buffered.
+ *
+ * parameters: fileName -- [in] .vkp file written by build
+ *
+ * returns   : void, throws std::runtime_error if the file can not be read or is not a valid pack
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void assetPack::open(const std::string& fileName)
+{
+  close();
+
+  uint64_t fileSize = 0;
+#ifdef _WIN32
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  LARGE_INTEGER size;
+  if (INVALID_HANDLE_VALUE == file || !GetFileSizeEx(file, &size))
+  {
+    if (INVALID_HANDLE_VALUE != file) CloseHandle(file);
+    std::cerr << "[-] failed to open " << fileName << std::endl;
+    throw std::runtime_error("failed to open " + fileName);
+  }
+  m_file = reinterpret_cast<intptr_t>(file);
+  fileSize = static_cast<uint64_t>(size.QuadPart);
+#else
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0)
+  {
+    if (fd >= 0) ::close(fd);
+    std::cerr << "[-] failed to open " << fileName << std::endl;
+    throw std::runtime_error("failed to open " + fileName);
+  }
+  m_file = fd;
+  fileSize = static_cast<uint64_t>(st.st_size);
+#endif
+
+  try
+  {
+    packHeader header;
+    if (fileSize < sizeof(header) || !readAt(m_file, 0, &header, sizeof(header)) || 0 != memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)))
+    {
+      throw std::runtime_error(fileName + " is not an asset pack");
+    }
+    if (PACK_VERSION != header.version || PACK_PAGE_SIZE != header.pageSize)
+    {
+      throw std::runtime_error(fileName + " is an asset pack of a version we can not read");
+    }
+
+    // the index is a power of two with at least one empty slot (so a lookup ends), and the layout is as build writes it
+    uint64_t indexBytes = (uint64_t)header.indexSlots * sizeof(packEntry);
+    if (0 == header.indexSlots || 0 != (header.indexSlots & (header.indexSlots - 1)) || header.entryCount >= header.indexSlots ||
+        sizeof(header) != header.indexOffset || header.indexOffset + indexBytes != header.namesOffset ||
+        header.namesBytes > fileSize || header.namesOffset + header.namesBytes > header.dataOffset ||
+        0 != header.dataOffset % PACK_PAGE_SIZE || header.dataOffset > fileSize)
+    {
+      throw std::runtime_error(fileName + " has a bad header");
+    }
+
+    std::vector<uint8_t> front(static_cast<size_t>(indexBytes + header.namesBytes));
+    if (!readAt(m_file, header.indexOffset, front.data(), front.size())) throw std::runtime_error("failed to read " + fileName);
+
+    m_index.resize(header.indexSlots);
+    memcpy(m_index.data(), front.data(), static_cast<size_t>(indexBytes));
+    m_names.assign(reinterpret_cast<const char*>(front.data() + indexBytes), static_cast<size_t>(header.namesBytes));
+
+    uint32_t used = 0;
+    for (const packEntry& entry : m_index)
+    {
+      if (0 == entry.nameLength) continue;
+      used++;
+
+      if ((uint64_t)entry.nameOffset + entry.nameLength > m_names.size() ||
+          entry.offset < header.dataOffset || 0 != entry.offset % PACK_PAGE_SIZE ||
+          entry.size > fileSize || entry.offset + pageAlign(entry.size) > fileSize ||
+          entry.hash != hashName(getName(entry)))
+      {
+        throw std::runtime_error(fileName + " has a bad index entry");
+      }
+    }
+    if (used != header.entryCount) throw std::runtime_error(fileName + " has a bad index");
+
+    m_header = header;
+  }
+  catch (const std::exception&)
+  {
+    close();
+    throw;
+  }
+
+#ifdef _WIN32
+  HANDLE direct = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+  m_direct = (INVALID_HANDLE_VALUE == direct) ? -1 : reinterpret_cast<intptr_t>(direct);
+#elif defined(O_DIRECT)
+  m_direct = ::open(fileName.c_str(), O_RDONLY | O_DIRECT);
+#endif
+
+  m_fileName = fileName;
+}
+
+
+
+void assetPack::close()
+{
+#ifdef _WIN32
+  if (-1 != m_file) CloseHandle(reinterpret_cast<HANDLE>(m_file));
+  if (-1 != m_direct) CloseHandle(reinterpret_cast<HANDLE>(m_direct));
+#else
+  if (-1 != m_file) ::close(static_cast<int>(m_file));
+  if (-1 != m_direct) ::close(static_cast<int>(m_direct));
+#endif
+
+  m_file = -1;
+  m_direct = -1;
+  m_header = packHeader();
+  m_index.clear();
+  m_names.clear();
+  m_fileName.clear();
+}
+
+
+
+bool assetPack::isOpen() const
+{
+  return -1 != m_file;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : find
+ *
+ * abstract  : Looks a name up in the hash index, probing linearly from its hash's slot until the name or an empty slot
+ *             is found.
+ *
+ * parameters: name -- [in] asset path, as it would be opened (it is normalised first)
+ *
+ * returns   : const packEntry*, the entry or nullptr if the pack does not hold the asset (or is not open)
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+const packEntry* assetPack::find(const std::string& name) const
+{
+  if (m_index.empty()) return nullptr;
+
+  std::string key = normaliseName(name);
+  uint64_t    hash = hashName(key);
+  size_t      mask = m_index.size() - 1;
+
+  for (size_t slot = static_cast<size_t>(hash) & mask; ; slot = (slot + 1) & mask)
+  {
+    const packEntry& entry = m_index[slot];
+    if (0 == entry.nameLength) return nullptr;
+    if (hash == entry.hash && key.size() == entry.nameLength && 0 == m_names.compare(entry.nameOffset, entry.nameLength, key)) return &entry;
+  }
+}
+
+
+
+std::string assetPack::getName(const packEntry& entry) const
+{
+  return m_names.substr(entry.nameOffset, entry.nameLength);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : read
+ *
+ * abstract  : Reads an entry into caller memory with positional reads, buffered, split into PACK_READ_PIECE pieces read
+ *             in parallel when a job system is given and the entry is large.
+ *
+ * parameters: entry -- [in] an entry returned by find
+ *             dst -- [out] at least entry.size bytes
+ *             jobs -- [in] job system to read the pieces on, nullptr => read on this thread
+ *
+ * returns   : void, throws std::runtime_error if the read fails
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void assetPack::read(const packEntry& entry, void* dst, jobSystem* jobs)
+{
+  if (!readPieces(m_file, entry.offset, static_cast<uint8_t*>(dst), static_cast<size_t>(entry.size), jobs))
+  {
+    std::cerr << "[-] failed to read " << getName(entry) << " from " << m_fileName << std::endl;
+    throw std::runtime_error("failed to read " + getName(entry));
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : read
+ *
+ * abstract  : Reads an entry into a page aligned buffer.  The entry is page aligned in the file and padded to a whole
+ *             page, so the padded size can be read unbuffered straight into the buffer; if the pack could not be
+ *             opened unbuffered, or the read fails (some file systems refuse it at read time), it is read buffered.
+ *
+ * parameters: entry -- [in] an entry returned by find
+ *             dst -- [out] resized to entry.size
+ *             jobs -- [in] job system to read the pieces on, nullptr => read on this thread
+ *
+ * returns   : void, throws std::runtime_error if the read fails
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void assetPack::read(const packEntry& entry, packBuffer* dst, jobSystem* jobs)
+{
+  dst->resize(static_cast<size_t>(entry.size));
+
+  if (-1 != m_direct && readPieces(m_direct, entry.offset, dst->data(), static_cast<size_t>(pageAlign(entry.size)), jobs)) return;
+
+  read(entry, static_cast<void*>(dst->data()), jobs);
+}
+
+
+
+// one positional read of a whole range, retried until it is all there
+bool assetPack::readAt(intptr_t file, uint64_t offset, void* dst, size_t size) const
+{
+  uint8_t* p = static_cast<uint8_t*>(dst);
+  while (size > 0)
+  {
+#ifdef _WIN32
+    OVERLAPPED at = {};
+    at.Offset = static_cast<DWORD>(offset);
+    at.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD done = 0;
+    DWORD want = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+    if (!ReadFile(reinterpret_cast<HANDLE>(file), p, want, &done, &at) || 0 == done) return false;
+#else
+    ssize_t done = pread(static_cast<int>(file), p, size, static_cast<off_t>(offset));
+    if (done < 0 && EINTR == errno) continue;
+    if (done <= 0) return false;
+#endif
+    p += done;
+    offset += done;
+    size -= done;
+  }
+  return true;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : readPieces
+ *
+ * abstract  : Reads a range of the pack.  A range of up to PACK_READ_PIECE is one read on this thread, a larger one is
+ *             cut into PACK_READ_PIECE pieces (a whole number of pages, so unbuffered reads stay aligned) each read by
+ *             a job; the jobs only record failure, they never throw.
+ *
+ * parameters: file -- [in] descriptor to read from, buffered or unbuffered
+ *             offset -- [in] start of the range in the pack
+ *             dst -- [out] size bytes
+ *             size -- [in] bytes to read
+ *             jobs -- [in] job system for the pieces, nullptr => read on this thread
+ *
+ * returns   : bool, true if every piece was read, false otherwise
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+bool assetPack::readPieces(intptr_t file, uint64_t offset, uint8_t* dst, size_t size, jobSystem* jobs)
+{
+  if (nullptr == jobs || size <= PACK_READ_PIECE) return readAt(file, offset, dst, size);
+
+  jobCounter        counter;
+  std::atomic<bool> ok{ true };
+  for (size_t first = 0; first < size; first += PACK_READ_PIECE)
+  {
+    size_t length = std::min(PACK_READ_PIECE, size - first);
+    jobs->run([this, file, offset, dst, first, length, &ok]()
+      {
+        if (!readAt(file, offset + first, dst + first, length)) ok.store(false, std::memory_order_relaxed);
+      }, &counter);
+  }
+  jobs->wait(&counter);
+
+  return ok.load(std::memory_order_relaxed);
+}
+
+
+
+// FNV-1a, 64 bit
+uint64_t assetPack::hashName(const std::string& name)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned char c : name)
+  {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+
+
+// the key an asset is stored and looked up under: '/' separators, no "." components or repeated separators
+std::string assetPack::normaliseName(const std::string& name)
+{
+  std::string key;
+  key.reserve(name.size());
+
+  size_t start = 0;
+  while (start <= name.size())
+  {
+    size_t end = name.find_first_of("/\\", start);
+    if (std::string::npos == end) end = name.size();
+
+    size_t length = end - start;
+    if (length > 0 && !(1 == length && '.' == name[start]))
+    {
+      if (!key.empty()) key += '/';
+      key.append(name, start, length);
+    }
+    start = end + 1;
+  }
+
+  return key;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : build
+ *
+ * abstract  : Packs every regular file under the directories (recursively) into one file.  Names are the files' paths
+ *             as given, normalised, so packing "./Textures" stores "Textures/plain.png", which is what the code opens.
+ *             The layout is worked out from the file sizes first, the header, index and names are written, then each
+ *             file copied in starting on a page and padded to a whole page.
+ *
+ * parameters: packFile -- [in] name of the pack to write (a pack inside the directories is not packed into itself)
+ *             directories -- [in] directories to pack
+ *
+ * returns   : void, throws std::runtime_error if a directory or file can not be read or the pack written
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void assetPack::build(const std::string& packFile, const std::vector<std::string>& directories)
+{
+  namespace fs = std::filesystem;
+
+  std::string packKey = normaliseName(packFile);
+  std::vector<std::pair<std::string, std::string>> files;      // { key, path }
+
+  for (const std::string& directory : directories)
+  {
+    std::error_code error;
+    fs::recursive_directory_iterator it(directory, error), last;
+    if (error) throw std::runtime_error("failed to read directory " + directory);
+
+    for (; it != last; it.increment(error))
+    {
+      if (error) throw std::runtime_error("failed to read directory " + directory);
+      if (!it->is_regular_file()) continue;
+
+      std::string path = it->path().generic_string();
+      std::string key = normaliseName(path);
+      if (key != packKey) files.push_back({ key, path });
+    }
+  }
+
+  std::sort(files.begin(), files.end());
+  files.erase(std::unique(files.begin(), files.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), files.end());
+
+  if (files.size() >= UINT32_MAX / 2) throw std::runtime_error("too many files to pack");
+
+  // layout
+  packHeader header = {};
+  memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+  header.version = PACK_VERSION;
+  header.pageSize = PACK_PAGE_SIZE;
+  header.entryCount = static_cast<uint32_t>(files.size());
+  header.indexSlots = 1;
+  while (header.indexSlots < 2 * header.entryCount + 1) header.indexSlots *= 2;
+  header.indexOffset = sizeof(header);
+  header.namesOffset = header.indexOffset + (uint64_t)header.indexSlots * sizeof(packEntry);
+
+  std::string names;
+  std::vector<packEntry> entries(files.size());
+  for (size_t f = 0; f < files.size(); f++)
+  {
+    if (names.size() + files[f].first.size() > UINT32_MAX) throw std::runtime_error("file names too long to pack");
+
+    entries[f].hash = hashName(files[f].first);
+    entries[f].nameOffset = static_cast<uint32_t>(names.size());
+    entries[f].nameLength = static_cast<uint32_t>(files[f].first.size());
+    entries[f].size = static_cast<uint64_t>(fs::file_size(files[f].second));
+    names += files[f].first;
+  }
+  header.namesBytes = names.size();
+  header.dataOffset = pageAlign(header.namesOffset + header.namesBytes);
+
+  uint64_t offset = header.dataOffset;
+  std::vector<packEntry> index(header.indexSlots, packEntry());
+  for (packEntry& entry : entries)
+  {
+    entry.offset = offset;
+    offset += pageAlign(entry.size);
+
+    size_t slot = static_cast<size_t>(entry.hash) & (index.size() - 1);
+    while (0 != index[slot].nameLength) slot = (slot + 1) & (index.size() - 1);
+    index[slot] = entry;
+  }
+
+  std::ofstream out(packFile, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+  {
+    std::cerr << "[-] failed to create " << packFile << std::endl;
+    throw std::runtime_error("failed to create " + packFile);
+  }
+
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(packEntry));
+  out.write(names.data(), names.size());
+
+  std::vector<char> piece(PACK_READ_PIECE);
+  for (size_t f = 0; f < files.size(); f++)
+  {
+    out.seekp(static_cast<std::streamoff>(entries[f].offset));
+
+    std::ifstream in(files[f].second, std::ios::binary);
+    uint64_t      left = entries[f].size;
+    while (left > 0 && in)
+    {
+      size_t length = static_cast<size_t>(std::min<uint64_t>(left, piece.size()));
+      in.read(piece.data(), length);
+      out.write(piece.data(), in.gcount());
+      left -= static_cast<uint64_t>(in.gcount());
+    }
+    if (0 != left) throw std::runtime_error("failed to read " + files[f].second);
+  }
+
+  // pad the last entry to a whole page, every entry can then be read unbuffered
+  uint64_t end = offset;
+  if (!files.empty() && static_cast<uint64_t>(out.tellp()) < end)
+  {
+    out.seekp(static_cast<std::streamoff>(end - 1));
+    out.put('\0');
+  }
+
+  out.close();
+  if (!out) throw std::runtime_error("failed to write " + packFile);
+
+  std::cerr << "[+] wrote " << packFile << " (" << files.size() << " files, " << (end - header.dataOffset) / (1024 * 1024)
+            << " MB)" << std::endl;
+}
+
+
+
+// the pack readAsset and mapAsset look in, and the job system large reads are split over
+void assetPack::setCurrent(assetPack* pack, jobSystem* jobs)
+{
+  g_currentPack = pack;
+  g_packJobs = jobs;
+}
+
+
+
+assetPack* assetPack::current()
+{
+  return g_currentPack;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : readAsset
+ *
+ * abstract  : Reads an asset whole, from the current pack if there is one holding it and otherwise from the loose file,
+ *             so it can be used wherever readFile was.
+ *
+ * parameters: fileName -- [in] path of the asset
+ *
+ * returns   : std::vector<char>, the asset's bytes.  Throws std::runtime_error if it can not be read
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+std::vector<char> readAsset(const std::string& fileName)
+{
+  assetPack*       pack = assetPack::current();
+  const packEntry* entry = (nullptr != pack) ? pack->find(fileName) : nullptr;
+  if (nullptr == entry) return readFile(fileName);
+
+  std::vector<char> buf(static_cast<size_t>(entry->size));
+  pack->read(*entry, buf.data(), g_packJobs);
+  return buf;
+}
+
+
+
+// maps an asset, its range of the current pack if there is one holding it and otherwise the loose file
+void mapAsset(const std::string& fileName, mappedFile* file)
+{
+  assetPack*       pack = assetPack::current();
+  const packEntry* entry = (nullptr != pack) ? pack->find(fileName) : nullptr;
+
+  if (nullptr == entry) file->open(fileName);
+  else file->open(pack->getFileName(), entry->offset, static_cast<size_t>(entry->size));
+}
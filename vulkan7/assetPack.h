@@ -0,0 +1,115 @@
+#ifndef _assetPack_h_
+#define _assetPack_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "jobSystem.h"
+#include "mappedFile.h"
+
+const uint32_t PACK_VERSION = 1;
+const uint32_t PACK_PAGE_SIZE = 4096;            // entries start on a page and are padded to one, so they can be read unbuffered
+const size_t   PACK_READ_PIECE = 1024 * 1024;    // an entry larger than this is read by several jobs, a piece each
+
+// header of an asset pack (.vkp), at offset 0.  The pack is laid out as header, hash index, entry names, then each
+// entry's bytes starting on a page boundary; everything before dataOffset is read in one go when the pack is opened.
+struct packHeader
+{
+  char     magic[8];                  // "VKPACK\0\0"
+  uint32_t version;
+  uint32_t pageSize;
+  uint32_t entryCount;
+  uint32_t indexSlots;                // a power of two, at least twice entryCount
+  uint64_t indexOffset;               // indexSlots packEntrys
+  uint64_t namesOffset;               // entry names, back to back and not terminated
+  uint64_t namesBytes;
+  uint64_t dataOffset;                // first entry, page aligned
+};
+
+// one slot of the hash index, a slot with a zero nameLength is empty
+struct packEntry
+{
+  uint64_t hash;                      // FNV-1a of the normalised name, see assetPack::hashName
+  uint64_t offset;                    // page aligned
+  uint64_t size;
+  uint32_t nameOffset;                // into the names block
+  uint32_t nameLength;
+};
+
+// a block of memory that unbuffered reads can go straight into, aligned and sized to whole pages
+class packBuffer
+{
+public:
+  packBuffer() : m_data(nullptr), m_size(0), m_capacity(0) { }
+  ~packBuffer();
+
+  packBuffer(const packBuffer&) = delete;
+  packBuffer& operator=(const packBuffer&) = delete;
+
+  void     resize(size_t size);                      // keeps nothing, contents are undefined afterwards
+  uint8_t* data() { return m_data; }
+  size_t   size() const { return m_size; }
+  size_t   capacity() const { return m_capacity; }
+
+private:
+  uint8_t* m_data;
+  size_t   m_size;
+  size_t   m_capacity;
+};
+
+// A single file holding the loose assets (shaders, textures, models) so that startup does not open, stat and read
+// each one.  build() packs directories into a file; open() reads the header, hash index and names with one read and
+// keeps the file open, after which find() is a hash lookup and read() is one positional read (pread/ReadFile at an
+// offset) straight into the caller's memory.  When that memory is a packBuffer the read is unbuffered (O_DIRECT or
+// FILE_FLAG_NO_BUFFERING) since entries are page aligned, so a texture does not pass through the page cache on its way
+// to the staging buffer.  Large entries are split into pieces read in parallel on the job system.  Names are looked up
+// normalised, "./Textures/a.png" and "Textures\a.png" are the same entry.
+//
+// The current pack (setCurrent) is used by readAsset and mapAsset, which fall back to the loose file when there is no
+// pack or the asset is not in it, so the rest of the code does not care whether a pack is in use.
+class assetPack
+{
+public:
+  assetPack();
+  ~assetPack();
+
+  assetPack(const assetPack&) = delete;
+  assetPack& operator=(const assetPack&) = delete;
+
+  void open(const std::string& fileName);            // throws std::runtime_error if it is not a valid pack
+  void close();
+  bool isOpen() const;
+
+  const packEntry*   find(const std::string& name) const;         // nullptr if the pack does not hold it
+  std::string        getName(const packEntry& entry) const;
+  uint32_t           getEntryCount() const { return m_header.entryCount; }
+  const std::string& getFileName() const { return m_fileName; }
+
+  void read(const packEntry& entry, void* dst, jobSystem* jobs = nullptr);    // entry.size bytes, throws on failure
+  void read(const packEntry& entry, packBuffer* dst, jobSystem* jobs = nullptr);
+
+  static uint64_t    hashName(const std::string& name);
+  static std::string normaliseName(const std::string& name);
+  static void        build(const std::string& packFile, const std::vector<std::string>& directories);
+
+  static void       setCurrent(assetPack* pack, jobSystem* jobs);  // nullptr => loose files only
+  static assetPack* current();
+
+private:
+  std::string            m_fileName;
+  packHeader             m_header;
+  std::vector<packEntry> m_index;
+  std::string            m_names;
+  intptr_t               m_file;                      // descriptor (HANDLE on Windows), -1 when closed
+  intptr_t               m_direct;                    // the same file opened unbuffered, -1 if the OS would not
+
+  bool readAt(intptr_t file, uint64_t offset, void* dst, size_t size) const;
+  bool readPieces(intptr_t file, uint64_t offset, uint8_t* dst, size_t size, jobSystem* jobs);
+};
+
+std::vector<char> readAsset(const std::string& fileName);                  // from the current pack, else readFile
+void              mapAsset(const std::string& fileName, mappedFile* file); // maps the pack entry, else the file
+
+#endif
@@ -0,0 +1,510 @@
+#include "chunkFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include "MeshModel.h"
+#include "meshMerger.h"
+#include "objLoader.h"
+#include "jobSystem.h"
+#include "assetPack.h"
+
+static const char CHUNK_MAGIC[8] = { 'V', 'K', 'C', 'H', 'U', 'N', 'K', '\0' };
+
+static_assert(sizeof(chunkFileHeader) == 56, "chunkFileHeader is written as it is, it must not change size");
+static_assert(sizeof(chunkRecord) == 56, "chunkRecord is written as it is, it must not change size");
+
+// a chunk before it is written, a range of one texture group's (reordered) triangle list
+struct chunkRange
+{
+  size_t group;
+  size_t first;
+  size_t count;
+};
+
+static void loadForChunking(const std::string& modelFile, meshMerger* merger, std::vector<std::string>* textureNames);
+static void splitGroup(const std::vector<vertex>& vertices, const std::vector<uint32_t>& indices, size_t group,
+                       std::vector<uint32_t>* order, std::vector<chunkRange>* chunks);
+static void buildProxy(const std::vector<vertex>& vertices, const std::vector<uint32_t>& indices, const glm::vec3& lo,
+                       const glm::vec3& hi, std::vector<vertex>* proxyVertices, std::vector<uint32_t>* proxyIndices);
+
+// rounds a file offset up to the next page
+static uint64_t pageAlign(uint64_t offset)
+{
+  return (offset + CHUNK_PAGE_SIZE - 1) & ~(uint64_t)(CHUNK_PAGE_SIZE - 1);
+}
+
+
+
+chunkFile::chunkFile()
+{
+}
+
+
+
+chunkFile::~chunkFile()
+{
+  close();
+}
+
+
+
+void chunkFile::close()
+{
+  m_chunks.clear();
+  m_textureNames.clear();
+  m_file.close();
+}
+
+
+
+/************************************************************************************************************************
+ * function  : open
+ *
+ * abstract  : Maps a chunk file and reads its texture names and chunk table.  Every offset and count in the table is
+ *             checked against the size of the file, so a chunk's data can be read later without further checks; the
+ *             indices themselves are not checked here (that would touch every page) but by the stream as it pages a
+ *             chunk in.  Proxy indices are checked, they are small and read now anyway.
+ *
+ * parameters: fileName -- [in] .vkc file written by build
+ *
+ * returns   : void, throws std::runtime_error if the file can not be mapped or is not a valid chunk file
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void chunkFile::open(const std::string& fileName)
+{
+  close();
+  mapAsset(fileName, &m_file);
+
+  const uint8_t* file = m_file.data();
+  uint64_t       fileSize = m_file.size();
+
+  chunkFileHeader header;
+  if (fileSize < sizeof(header)) throw std::runtime_error(fileName + " is not a chunk file");
+  memcpy(&header, file, sizeof(header));
+
+  if (0 != memcmp(header.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)))
+  {
+    throw std::runtime_error(fileName + " is not a chunk file");
+  }
+  if (CHUNK_FILE_VERSION != header.version)
+  {
+    throw std::runtime_error(fileName + " is chunk file version " + std::to_string(header.version) + ", only " +
+                             std::to_string(CHUNK_FILE_VERSION) + " is supported");
+  }
+
+  if (header.textureOffset > header.tableOffset || header.tableOffset > fileSize ||
+      header.chunkCount > (fileSize - header.tableOffset) / sizeof(chunkRecord) ||
+      header.proxyOffset > fileSize || header.proxyBytes > fileSize - header.proxyOffset)
+  {
+    throw std::runtime_error(fileName + " is truncated");
+  }
+
+  // texture names, null terminated and back to back between the header and the table
+  const char* name = reinterpret_cast<const char*>(file + header.textureOffset);
+  const char* namesEnd = reinterpret_cast<const char*>(file + header.tableOffset);
+  for (uint32_t ndx = 0; ndx < header.textureCount; ndx++)
+  {
+    const char* end = static_cast<const char*>(memchr(name, '\0', namesEnd - name));
+    if (nullptr == end) throw std::runtime_error(fileName + " has a bad texture table");
+
+    m_textureNames.push_back(std::string(name, end - name));
+    name = end + 1;
+  }
+
+  m_chunks.resize(header.chunkCount);
+  memcpy(m_chunks.data(), file + header.tableOffset, m_chunks.size() * sizeof(chunkRecord));
+
+  uint64_t proxyEnd = header.proxyOffset + header.proxyBytes;
+  for (const chunkRecord& chunk : m_chunks)
+  {
+    uint64_t bytes = (uint64_t)chunk.vertexCount * sizeof(vertex) + (uint64_t)chunk.indexCount * sizeof(uint32_t);
+    uint64_t proxyBytes = (uint64_t)chunk.proxyVertexCount * sizeof(vertex) + (uint64_t)chunk.proxyIndexCount * sizeof(uint32_t);
+
+    if (chunk.offset > fileSize || bytes > fileSize - chunk.offset ||
+        chunk.proxyOffset < header.proxyOffset || chunk.proxyOffset > proxyEnd || proxyBytes > proxyEnd - chunk.proxyOffset)
+    {
+      throw std::runtime_error(fileName + " has a chunk that runs past the end of the file");
+    }
+    if (chunk.texture >= (int32_t)m_textureNames.size() || !(chunk.sphere[3] >= 0.0f))
+    {
+      throw std::runtime_error(fileName + " has a bad chunk record");
+    }
+
+    const uint8_t* proxyIndices = proxyData(chunk) + (size_t)chunk.proxyVertexCount * sizeof(vertex);
+    for (uint32_t ndx = 0; ndx < chunk.proxyIndexCount; ndx++)
+    {
+      uint32_t index;
+      memcpy(&index, proxyIndices + ndx * sizeof(uint32_t), sizeof(index));
+      if (index >= chunk.proxyVertexCount) throw std::runtime_error(fileName + " has a bad proxy index");
+    }
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : build
+ *
+ * abstract  : Preprocesses a model into a chunk file.  The model is loaded as createMeshModel would (objLoader for
+ *             .obj, Assimp for the rest, node transforms applied) and merged by texture, then each texture group is
+ *             split spatially into chunks (see splitGroup).  Each chunk gets its own compact vertex list, a bounding
+ *             sphere and a proxy (see buildProxy).  Chunks are written as they are made, each starting on a page so the
+ *             stream can fault one in without its neighbours; the proxies follow them and the header and table, whose
+ *             size is known before any chunk is written, are filled in last.
+ *
+ * parameters: modelFile -- [in] any file createMeshModel can read
+ *             chunkFileName -- [in] file to write
+ *
+ * returns   : void, throws std::runtime_error if the model can not be read or the output written
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void chunkFile::build(const std::string& modelFile, const std::string& chunkFileName)
+{
+  meshMerger               merger;
+  std::vector<std::string> textureNames;
+  loadForChunking(modelFile, &merger, &textureNames);
+
+  // split every group first, the table has to be sized before any chunk data is written
+  std::vector<std::vector<uint32_t>> orders(merger.getGroupCount());
+  std::vector<chunkRange>            ranges;
+  for (size_t group = 0; group < merger.getGroupCount(); group++)
+  {
+    splitGroup(*merger.getGroupVertices(group), *merger.getGroupIndices(group), group, &orders[group], &ranges);
+  }
+
+  chunkFileHeader header = {};
+  memcpy(header.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+  header.version = CHUNK_FILE_VERSION;
+  header.chunkCount = (uint32_t)ranges.size();
+  header.textureCount = (uint32_t)textureNames.size();
+  header.pageSize = CHUNK_PAGE_SIZE;
+  header.textureOffset = sizeof(header);
+  header.tableOffset = header.textureOffset;
+  for (const std::string& name : textureNames) header.tableOffset += name.size() + 1;
+  header.tableOffset = (header.tableOffset + 7) & ~(uint64_t)7;
+
+  std::ofstream file(chunkFileName, std::ios::binary);
+  if (!file) throw std::runtime_error("failed to create " + chunkFileName);
+
+  std::vector<chunkRecord> table(ranges.size());
+  std::vector<uint8_t>     proxies;
+  std::vector<uint32_t>    localIndex;
+  std::vector<vertex>      vertices;
+  std::vector<uint32_t>    indices;
+  std::vector<vertex>      proxyVertices;
+  std::vector<uint32_t>    proxyIndices;
+  const char               padding[CHUNK_PAGE_SIZE] = {};
+  uint64_t                 offset = pageAlign(header.tableOffset + table.size() * sizeof(chunkRecord));
+  size_t                   triangles = 0;
+  size_t                   proxyTriangles = 0;
+
+  for (size_t c = 0; c < ranges.size(); c++)
+  {
+    const chunkRange&            range = ranges[c];
+    const std::vector<vertex>&   groupVertices = *merger.getGroupVertices(range.group);
+    const std::vector<uint32_t>& groupIndices = *merger.getGroupIndices(range.group);
+    const std::vector<uint32_t>& order = orders[range.group];
+
+    // the chunk's own vertices, numbered in the order its triangles first use them
+    localIndex.assign(groupVertices.size(), UINT32_MAX);
+    vertices.clear();
+    indices.clear();
+    for (size_t t = range.first; t < range.first + range.count; t++)
+    {
+      for (int corner = 0; corner < 3; corner++)
+      {
+        uint32_t source = groupIndices[order[t] * 3 + corner];
+        if (UINT32_MAX == localIndex[source])
+        {
+          localIndex[source] = (uint32_t)vertices.size();
+          vertices.push_back(groupVertices[source]);
+        }
+        indices.push_back(localIndex[source]);
+      }
+    }
+
+    // bounding sphere about the centre of the box, as for meshlets
+    glm::vec3 lo = vertices[0].pos, hi = vertices[0].pos;
+    for (const vertex& v : vertices)
+    {
+      lo = glm::min(lo, v.pos);
+      hi = glm::max(hi, v.pos);
+    }
+    glm::vec3 centre = (lo + hi) * 0.5f;
+    float     radius = 0.0f;
+    for (const vertex& v : vertices)
+    {
+      glm::vec3 d = v.pos - centre;
+      radius = std::max(radius, d.x * d.x + d.y * d.y + d.z * d.z);
+    }
+
+    buildProxy(vertices, indices, lo, hi, &proxyVertices, &proxyIndices);
+
+    chunkRecord& record = table[c];
+    record.sphere[0] = centre.x;
+    record.sphere[1] = centre.y;
+    record.sphere[2] = centre.z;
+    record.sphere[3] = std::sqrt(radius);
+    record.texture = merger.getGroupTexture(range.group);
+    record.vertexCount = (uint32_t)vertices.size();
+    record.indexCount = (uint32_t)indices.size();
+    record.proxyVertexCount = (uint32_t)proxyVertices.size();
+    record.proxyIndexCount = (uint32_t)proxyIndices.size();
+    record.offset = offset;
+    record.proxyOffset = proxies.size();                // made absolute once the proxy block is placed
+
+    size_t proxyBase = proxies.size();
+    proxies.resize(proxyBase + proxyVertices.size() * sizeof(vertex) + proxyIndices.size() * sizeof(uint32_t));
+    if (!proxyVertices.empty())
+    {
+      memcpy(&proxies[proxyBase], proxyVertices.data(), proxyVertices.size() * sizeof(vertex));
+      memcpy(&proxies[proxyBase + proxyVertices.size() * sizeof(vertex)], proxyIndices.data(), proxyIndices.size() * sizeof(uint32_t));
+    }
+
+    uint64_t bytes = vertices.size() * sizeof(vertex) + indices.size() * sizeof(uint32_t);
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(vertex));
+    file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t));
+    offset = pageAlign(offset + bytes);
+
+    triangles += indices.size() / 3;
+    proxyTriangles += proxyIndices.size() / 3;
+  }
+
+  header.proxyOffset = offset;
+  header.proxyBytes = proxies.size();
+  for (chunkRecord& record : table) record.proxyOffset += header.proxyOffset;
+
+  file.seekp(header.proxyOffset);
+  file.write(reinterpret_cast<const char*>(proxies.data()), proxies.size());
+
+  file.seekp(0);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const std::string& name : textureNames) file.write(name.c_str(), name.size() + 1);
+  file.write(padding, header.tableOffset - (uint64_t)file.tellp());
+  file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(chunkRecord));
+
+  if (!file) throw std::runtime_error("failed to write " + chunkFileName);
+
+  std::cerr << "[+] wrote " << chunkFileName << " (" << ranges.size() << " chunks, " << triangles << " triangles, proxies "
+            << proxyTriangles << " triangles, " << (header.proxyOffset + header.proxyBytes) / (1024 * 1024) << " MB)" << std::endl;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : loadForChunking
+ *
+ * abstract  : Loads a model into a merger, one group per texture, with the file's texture name table.  Materials that
+ *             share a texture file share a table entry (and so a group), those without one use -1, the default texture.
+ *
+ * parameters: modelFile -- [in] .obj (read by objLoader) or anything Assimp reads
+ *             merger -- [out] the model's triangles in model space, grouped by texture table entry
+ *             textureNames -- [out] the texture table
+ *
+ * returns   : void, throws std::runtime_error if the model can not be read
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+static void loadForChunking(const std::string& modelFile, meshMerger* merger, std::vector<std::string>* textureNames)
+{
+  std::map<std::string, int> tableIndex;
+  auto textureOf = [&](const std::string& name)
+  {
+    if (name.empty()) return -1;
+
+    auto found = tableIndex.find(name);
+    if (tableIndex.end() != found) return found->second;
+
+    textureNames->push_back(name);
+    return tableIndex[name] = (int)textureNames->size() - 1;
+  };
+
+  size_t dot = modelFile.find_last_of('.');
+  std::string extension = (std::string::npos == dot) ? "" : modelFile.substr(dot);
+  std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+
+  if (".obj" == extension)
+  {
+    jobSystem jobs;
+    objModel  model;
+    objLoader(jobs).load(modelFile, &model);
+
+    for (objMesh& source : model.meshes)
+    {
+      int texture = (source.material >= 0) ? textureOf(model.textureNames[source.material]) : -1;
+      merger->add(source.vertices.data(), (uint32_t)source.vertices.size(), source.indices.data(), (uint32_t)source.indices.size(), texture);
+      std::vector<vertex>().swap(source.vertices);
+      std::vector<uint32_t>().swap(source.indices);
+    }
+    return;
+  }
+
+  Assimp::Importer importer;
+  const aiScene* scene = importer.ReadFile(modelFile, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
+  if (!scene)
+  {
+    throw std::runtime_error("Failed to load model! (" + modelFile + ")");
+  }
+
+  std::vector<std::string> materials = MeshModel::LoadMaterials(scene);
+  std::vector<int>         matToTex(materials.size());
+  for (size_t m = 0; m < materials.size(); m++) matToTex[m] = textureOf(materials[m]);
+
+  MeshModel::mergeNode(scene->mRootNode, scene, matToTex, glm::mat4(1.0f), merger);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : splitGroup
+ *
+ * abstract  : Splits one texture group into chunks of at most CHUNK_MAX_TRIANGLES triangles.  A piece that is too big
+ *             is cut in two at the median triangle centre along the longest axis of its centres' bounding box (with
+ *             nth_element, so each level is linear), giving spatially compact chunks of about equal size.  The
+ *             triangles are reordered in place in 'order' and each chunk is a range of it.
+ *
+ * parameters: vertices, indices -- [in] the group's triangle list
+ *             group -- [in] index of the group, recorded in each chunk
+ *             order -- [out] the group's triangle numbers, reordered so each chunk is contiguous
+ *             chunks -- [in/out] the group's chunks are appended
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+static void splitGroup(const std::vector<vertex>& vertices, const std::vector<uint32_t>& indices, size_t group,
+                       std::vector<uint32_t>* order, std::vector<chunkRange>* chunks)
+{
+  size_t triangleCount = indices.size() / 3;
+  if (0 == triangleCount) return;
+
+  std::vector<glm::vec3> centres(triangleCount);
+  order->resize(triangleCount);
+  for (size_t t = 0; t < triangleCount; t++)
+  {
+    centres[t] = (vertices[indices[t * 3]].pos + vertices[indices[t * 3 + 1]].pos + vertices[indices[t * 3 + 2]].pos) / 3.0f;
+    (*order)[t] = (uint32_t)t;
+  }
+
+  // pieces still to split, the lower half is pushed last so chunks come out in order along each cut
+  std::vector<std::pair<size_t, size_t>> pending = { { 0, triangleCount } };
+  while (!pending.empty())
+  {
+    size_t first = pending.back().first;
+    size_t count = pending.back().second;
+    pending.pop_back();
+
+    if (count <= CHUNK_MAX_TRIANGLES)
+    {
+      chunks->push_back({ group, first, count });
+      continue;
+    }
+
+    uint32_t* piece = order->data() + first;
+    glm::vec3 lo = centres[piece[0]], hi = lo;
+    for (size_t t = 1; t < count; t++)
+    {
+      lo = glm::min(lo, centres[piece[t]]);
+      hi = glm::max(hi, centres[piece[t]]);
+    }
+
+    glm::vec3 extent = hi - lo;
+    int       axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z) ? 1 : 2;
+    size_t    half = count / 2;
+    std::nth_element(piece, piece + half, piece + count,
+      [&centres, axis](uint32_t a, uint32_t b) { return centres[a][axis] < centres[b][axis]; });
+
+    pending.push_back({ first + half, count - half });
+    pending.push_back({ first, half });
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : buildProxy
+ *
+ * abstract  : Makes the coarse stand in drawn while a chunk is not resident, by vertex clustering: the chunk's box is
+ *             cut into CHUNK_PROXY_GRID^3 cells, the vertices in a cell become one vertex at their average position
+ *             (taking the colour and UV of the first) and triangles whose corners are no longer in three different
+ *             cells are dropped.  Crude, but linear, never more than a few hundred vertices and keeps the silhouette.
+ *
+ * parameters: vertices, indices -- [in] the chunk's triangle list
+ *             lo, hi -- [in] the chunk's bounding box
+ *             proxyVertices, proxyIndices -- [out] the proxy's triangle list, replace anything already there
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+static void buildProxy(const std::vector<vertex>& vertices, const std::vector<uint32_t>& indices, const glm::vec3& lo,
+                       const glm::vec3& hi, std::vector<vertex>* proxyVertices, std::vector<uint32_t>* proxyIndices)
+{
+  const uint32_t cells = CHUNK_PROXY_GRID;
+
+  std::vector<uint32_t> proxyOfCell(cells * cells * cells, UINT32_MAX);
+  std::vector<uint32_t> clusterSize;
+  std::vector<uint32_t> proxyOfVertex(vertices.size());
+  proxyVertices->clear();
+  proxyIndices->clear();
+
+  glm::vec3 extent = hi - lo;
+  for (size_t v = 0; v < vertices.size(); v++)
+  {
+    uint32_t cell = 0;
+    for (int axis = 2; axis >= 0; axis--)
+    {
+      float    t = (extent[axis] > 0.0f) ? (vertices[v].pos[axis] - lo[axis]) / extent[axis] : 0.0f;
+      uint32_t c = std::min(cells - 1, (uint32_t)std::max(0.0f, t * cells));
+      cell = cell * cells + c;
+    }
+
+    if (UINT32_MAX == proxyOfCell[cell])
+    {
+      proxyOfCell[cell] = (uint32_t)proxyVertices->size();
+      proxyVertices->push_back(vertices[v]);
+      clusterSize.push_back(1);
+    }
+    else
+    {
+      (*proxyVertices)[proxyOfCell[cell]].pos += vertices[v].pos;
+      clusterSize[proxyOfCell[cell]]++;
+    }
+    proxyOfVertex[v] = proxyOfCell[cell];
+  }
+
+  for (size_t p = 0; p < proxyVertices->size(); p++)
+  {
+    if (clusterSize[p] > 1) (*proxyVertices)[p].pos /= (float)clusterSize[p];
+  }
+
+  for (size_t t = 0; t + 2 < indices.size(); t += 3)
+  {
+    uint32_t a = proxyOfVertex[indices[t]];
+    uint32_t b = proxyOfVertex[indices[t + 1]];
+    uint32_t c = proxyOfVertex[indices[t + 2]];
+    if (a == b || b == c || a == c) continue;
+
+    proxyIndices->push_back(a);
+    proxyIndices->push_back(b);
+    proxyIndices->push_back(c);
+  }
+
+  // a chunk that collapses completely (smaller than a cell in every direction it spans) has no proxy at all
+  if (proxyIndices->empty()) proxyVertices->clear();
+}
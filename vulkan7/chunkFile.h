@@ -0,0 +1,75 @@
+#ifndef _chunkFile_h_
+#define _chunkFile_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utilities.h"
+#include "mappedFile.h"
+
+const uint32_t CHUNK_FILE_VERSION = 1;
+const uint32_t CHUNK_PAGE_SIZE = 4096;           // chunk data starts on a page, so one chunk can be paged in on its own
+const uint32_t CHUNK_MAX_TRIANGLES = 16384;      // largest chunk, about 0.5 to 1 MB of vertex and index data
+const uint32_t CHUNK_PROXY_GRID = 8;             // cells along each axis of the grid a chunk's proxy is clustered on
+
+// header of a chunked geometry file (.vkc), at offset 0.  The file is laid out as header, texture names, chunk table,
+// then each chunk's vertices and indices (starting on a page boundary), then every proxy back to back.
+struct chunkFileHeader
+{
+  char     magic[8];                  // "VKCHUNK\0"
+  uint32_t version;
+  uint32_t chunkCount;
+  uint32_t textureCount;
+  uint32_t pageSize;
+  uint64_t textureOffset;             // textureCount null terminated file names, back to back
+  uint64_t tableOffset;               // chunkCount chunkRecords
+  uint64_t proxyOffset;               // the proxy block, read whole when the file is opened
+  uint64_t proxyBytes;
+};
+
+// one entry of the chunk table
+struct chunkRecord
+{
+  float    sphere[4];                 // bounding sphere in model space, centre and radius
+  int32_t  texture;                   // into the texture name table, -1 => the default texture
+  uint32_t vertexCount;
+  uint32_t indexCount;
+  uint32_t proxyVertexCount;
+  uint32_t proxyIndexCount;
+  uint32_t unused;
+  uint64_t offset;                    // page aligned, vertexCount vertices then indexCount uint32_t indices
+  uint64_t proxyOffset;               // inside the proxy block, vertices then indices, as above
+};
+
+// Chunked geometry for models too large to upload whole (see geometryStream).  build() preprocesses any model we can
+// load: its triangles are grouped by texture, each group is split at the median of the longest axis of its triangle
+// centres until no piece has more than CHUNK_MAX_TRIANGLES, and each piece is written as a self contained mesh (its own
+// vertices, so a chunk can be uploaded without the rest) with a bounding sphere and a coarse proxy made by clustering
+// its vertices on a CHUNK_PROXY_GRID grid.  open() memory maps a built file and checks that the header and table
+// describe data inside it; the chunk data itself is left to the OS to page in as it is touched.
+class chunkFile
+{
+public:
+  chunkFile();
+  ~chunkFile();
+
+  void open(const std::string& fileName);            // throws std::runtime_error if it is not a valid chunk file
+  void close();
+
+  const std::vector<chunkRecord>& getChunks() const { return m_chunks; }
+  const std::vector<std::string>& getTextureNames() const { return m_textureNames; }
+
+  const uint8_t* chunkData(const chunkRecord& chunk) const { return m_file.data() + chunk.offset; }
+  const uint8_t* proxyData(const chunkRecord& chunk) const { return m_file.data() + chunk.proxyOffset; }
+
+  static void build(const std::string& modelFile, const std::string& chunkFileName);    // any model -> .vkc
+
+private:
+  mappedFile                m_file;
+  std::vector<chunkRecord>  m_chunks;
+  std::vector<std::string>  m_textureNames;
+};
+
+#endif
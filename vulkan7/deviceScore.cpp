@@ -0,0 +1,383 @@
+#include "deviceScore.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+
+
+
+// name of a VkPhysicalDeviceType, for the log
+static const char* deviceTypeName(VkPhysicalDeviceType type)
+{
+  switch (type)
+  {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   return "discrete GPU";
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    return "virtual GPU";
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated GPU";
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:            return "CPU";
+    default:                                     return "other device";
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : scoreDevice
+ *
+ * abstract  : Scores a device for rendering.  The type gives 0 (CPU) to 8000 (discrete GPU) in steps of
+ *             DEVICE_TYPE_STEP, and everything else together adds at most 1200 (less than a step) so it can only order
+ *             devices of the same type;
+ *               (a) device local memory, a point per 8 MB up to 1024 (8 GB).  Integrated GPUs report shared system
+ *                   memory here, which is why the type has to come first
+ *               (b) up to 64 for limits, maxImageDimension2D and the push constant space (the cull pass uses 128 bytes)
+ *               (c) up to 112 for optional features the renderer uses if they are there, pipeline statistics for
+ *                   --stats, timestamps on graphics queues, multi draw indirect and BC textures
+ *
+ * parameters: candidate -- [in] the device
+ *
+ * returns   : deviceScore, -1 and "not suitable" if candidate.suitable is false
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) types 2000 apart, 1000 was less than the extras can add
+************************************************************************************************************************/
+deviceScore scoreDevice(const deviceCandidate& candidate)
+{
+  deviceScore result = { -1, "not suitable" };
+  if (!candidate.suitable) return result;
+
+  const VkPhysicalDeviceProperties& properties = candidate.properties;
+  const VkPhysicalDeviceFeatures&   features = candidate.features;
+
+  switch (properties.deviceType)
+  {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   result.score = 4 * DEVICE_TYPE_STEP; break;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    result.score = 3 * DEVICE_TYPE_STEP; break;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: result.score = 2 * DEVICE_TYPE_STEP; break;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:            result.score = 0;                    break;
+    default:                                     result.score = 1 * DEVICE_TYPE_STEP; break;
+  }
+  result.reason = deviceTypeName(properties.deviceType);
+
+  uint64_t localBytes = 0;
+  uint32_t heapCount = std::min<uint32_t>(candidate.memory.memoryHeapCount, VK_MAX_MEMORY_HEAPS);
+  for (uint32_t ndx = 0; ndx < heapCount; ndx++)
+  {
+    if (candidate.memory.memoryHeaps[ndx].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) localBytes += candidate.memory.memoryHeaps[ndx].size;
+  }
+  uint64_t localMB = localBytes / (1024 * 1024);
+  result.score += (int64_t)std::min<uint64_t>(localMB / 8, 1024);
+  result.reason += ", " + std::to_string(localMB) + " MB device local";
+
+  result.score += std::min<uint32_t>(properties.limits.maxImageDimension2D / 1024, 32);
+  if (properties.limits.maxPushConstantsSize >= 256) result.score += 32;
+  else if (properties.limits.maxPushConstantsSize >= 128) result.score += 16;
+
+  if (VK_TRUE == features.pipelineStatisticsQuery)           { result.score += 48; result.reason += ", pipeline statistics"; }
+  if (VK_TRUE == properties.limits.timestampComputeAndGraphics) { result.score += 32; result.reason += ", timestamps"; }
+  if (VK_TRUE == features.multiDrawIndirect)                 { result.score += 16; result.reason += ", multi draw indirect"; }
+  if (VK_TRUE == features.textureCompressionBC)              { result.score += 16; result.reason += ", BC textures"; }
+
+  return result;
+}
+
+
+
+// lower case copy of s
+static std::string lowerCase(const std::string& s)
+{
+  std::string lower(s);
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+  return lower;
+}
+
+
+
+// parses a UUID of 32 hex digits, dashes anywhere are skipped.  False if s is not one
+static bool parseUuid(const std::string& s, uint8_t* uuid)
+{
+  std::string digits;
+  for (char c : s)
+  {
+    if ('-' == c) continue;
+    if (!std::isxdigit((unsigned char)c)) return false;
+    digits += c;
+  }
+  if (digits.size() != 2 * VK_UUID_SIZE) return false;
+
+  for (size_t ndx = 0; ndx < VK_UUID_SIZE; ndx++)
+  {
+    uuid[ndx] = (uint8_t)std::strtoul(digits.substr(2 * ndx, 2).c_str(), nullptr, 16);
+  }
+  return true;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : selectDevice
+ *
+ * abstract  : Picks the device to render on.  Without an override it is the suitable device with the highest score
+ *             (the first of equals, so the driver's order breaks ties).  An override is tried as;
+ *               (a) a UUID, if it is 32 hex digits once dashes are removed.  Only devices with hasUuid can match
+ *               (b) an index, if it is all digits
+ *               (c) otherwise part of the device name, in any case.  If it is in several names the best of them wins
+ *             An override that matches nothing, or only devices that are not suitable, falls back to the scores; the
+ *             reason says why so the caller can log it.
+ *
+ * parameters: candidates -- [in] the devices, in the order vkEnumeratePhysicalDevices gave them
+ *             overrideSpec -- [in] the override, empty for none
+ *             reason -- [out] why the device was chosen, may be nullptr
+ *
+ * returns   : int, index into candidates, -1 if none is suitable
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+int selectDevice(const std::vector<deviceCandidate>& candidates, const std::string& overrideSpec, std::string* reason)
+{
+  std::vector<deviceScore> scores;
+  for (const deviceCandidate& candidate : candidates) scores.push_back(scoreDevice(candidate));
+
+  // best of the candidates match accepts, -1 if it accepts no suitable one
+  auto best = [&](auto match) -> int
+  {
+    int chosen = -1;
+    for (size_t ndx = 0; ndx < candidates.size(); ndx++)
+    {
+      if (scores[ndx].score < 0 || !match(ndx)) continue;
+      if (chosen < 0 || scores[ndx].score > scores[chosen].score) chosen = (int)ndx;
+    }
+    return chosen;
+  };
+
+  std::string note;
+  if (!overrideSpec.empty())
+  {
+    int chosen = -1;
+    uint8_t uuid[VK_UUID_SIZE];
+
+    if (parseUuid(overrideSpec, uuid))
+    {
+      chosen = best([&](size_t ndx) { return candidates[ndx].hasUuid && 0 == memcmp(candidates[ndx].uuid, uuid, VK_UUID_SIZE); });
+      note = "device UUID " + overrideSpec;
+    }
+    else if (std::all_of(overrideSpec.begin(), overrideSpec.end(), [](unsigned char c) { return std::isdigit(c); }))
+    {
+      size_t index = (size_t)std::strtoull(overrideSpec.c_str(), nullptr, 10);
+      chosen = best([&](size_t ndx) { return ndx == index; });
+      note = "device index " + overrideSpec;
+    }
+    else
+    {
+      std::string name = lowerCase(overrideSpec);
+      chosen = best([&](size_t ndx) { return std::string::npos != lowerCase(candidates[ndx].properties.deviceName).find(name); });
+      note = "device name \"" + overrideSpec + "\"";
+    }
+
+    if (chosen >= 0)
+    {
+      if (reason) *reason = "selected by " + note + ", " + scores[chosen].reason;
+      return chosen;
+    }
+    note = note + " matches no suitable device, ignored; ";
+  }
+
+  int chosen = best([](size_t) { return true; });
+  if (reason) *reason = (chosen < 0) ? note + "no suitable device" : note + "highest score " + std::to_string(scores[chosen].score) + ", " + scores[chosen].reason;
+  return chosen;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : deviceIdsAvailable
+ *
+ * abstract  : Device UUIDs are core in Vulkan 1.1 but the instance asks for 1.0, where they come from
+ *             VK_KHR_get_physical_device_properties2 with VK_KHR_external_memory_capabilities (which defines
+ *             VkPhysicalDeviceIDProperties).  Both are instance extensions that are not always there, so the context only
+ *             enables them when this says they are.
+ *
+ * parameters: none
+ *
+ * returns   : bool, true if both extensions are supported
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+bool deviceIdsAvailable()
+{
+  uint32_t extensionCnt = 0;
+  vkEnumerateInstanceExtensionProperties(nullptr, &extensionCnt, nullptr);
+  std::vector<VkExtensionProperties> extensions(extensionCnt);
+  vkEnumerateInstanceExtensionProperties(nullptr, &extensionCnt, extensions.data());
+
+  auto has = [&](const char* name)
+  {
+    for (const VkExtensionProperties& ext : extensions)
+    {
+      if (0 == strcmp(name, ext.extensionName)) return true;
+    }
+    return false;
+  };
+
+  return has(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) && has(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : describeDevice
+ *
+ * abstract  : Fills in a candidate from a device, except suitable which is up to the caller.
+ *
+ * parameters: instance -- [in] instance the device came from
+ *             device -- [in] the device
+ *             deviceIds -- [in] true if the instance was created with the extensions deviceIdsAvailable checks for
+ *             candidate -- [out] the device's description
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void describeDevice(VkInstance instance, VkPhysicalDevice device, bool deviceIds, deviceCandidate* candidate)
+{
+  memset(candidate, 0, sizeof(deviceCandidate));
+  vkGetPhysicalDeviceProperties(device, &candidate->properties);
+  vkGetPhysicalDeviceMemoryProperties(device, &candidate->memory);
+  vkGetPhysicalDeviceFeatures(device, &candidate->features);
+
+  if (!deviceIds) return;
+
+  PFN_vkGetPhysicalDeviceProperties2KHR getProperties2 =
+    (PFN_vkGetPhysicalDeviceProperties2KHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR");
+  if (nullptr == getProperties2) return;
+
+  VkPhysicalDeviceIDPropertiesKHR ids = {};
+  ids.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES_KHR;
+
+  VkPhysicalDeviceProperties2KHR properties = {};
+  properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+  properties.pNext = &ids;
+  getProperties2(device, &properties);
+
+  memcpy(candidate->uuid, ids.deviceUUID, VK_UUID_SIZE);
+  candidate->hasUuid = true;
+}
+
+
+
+// the usual 8-4-4-4-12 form
+std::string formatUuid(const uint8_t* uuid)
+{
+  static const char digits[] = "0123456789abcdef";
+
+  std::string s;
+  for (size_t ndx = 0; ndx < VK_UUID_SIZE; ndx++)
+  {
+    if (4 == ndx || 6 == ndx || 8 == ndx || 10 == ndx) s += '-';
+    s += digits[uuid[ndx] >> 4];
+    s += digits[uuid[ndx] & 0x0f];
+  }
+  return s;
+}
+
+
+
+std::string getDeviceOverride(const std::string& option)
+{
+  if (!option.empty()) return option;
+
+  const char* env = getenv(DEVICE_OVERRIDE_ENV);
+  return (nullptr == env) ? std::string() : std::string(env);
+}
+
+
+
+// a suitable device of the given type, with the least (best false) or the most everything else can add
+static deviceCandidate syntheticDevice(VkPhysicalDeviceType type, const char* name, bool best)
+{
+  deviceCandidate candidate;
+  memset(&candidate, 0, sizeof(deviceCandidate));
+  candidate.suitable = true;
+  candidate.properties.deviceType = type;
+  strncpy(candidate.properties.deviceName, name, VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+
+  if (best)
+  {
+    candidate.memory.memoryHeapCount = 1;
+    candidate.memory.memoryHeaps[0].size = 64ull * 1024 * 1024 * 1024;
+    candidate.memory.memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    candidate.properties.limits.maxImageDimension2D = 65536;
+    candidate.properties.limits.maxPushConstantsSize = 256;
+    candidate.properties.limits.timestampComputeAndGraphics = VK_TRUE;
+    candidate.features.pipelineStatisticsQuery = VK_TRUE;
+    candidate.features.multiDrawIndirect = VK_TRUE;
+    candidate.features.textureCompressionBC = VK_TRUE;
+  }
+  return candidate;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : checkDeviceScore
+ *
+ * abstract  : Self test of scoreDevice and selectDevice on synthetic candidates, no GPU needed.  Checks that
+ *               (a) for each pair of adjacent types, the better type with nothing else beats the worse type with
+ *                   everything else (so the extras can never reorder types)
+ *               (b) an unsuitable device scores -1 and is never chosen, even when an override names it
+ *               (c) overrides by index, name (any case) and UUID pick the device they name
+ *
+ * parameters: os -- [in] where to write each failure and the summary
+ *
+ * returns   : bool, true if every check passed
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+bool checkDeviceScore(std::ostream& os)
+{
+  int failures = 0;
+  auto check = [&](bool ok, const std::string& what)
+  {
+    if (!ok) { os << "[-] device score check failed: " << what << std::endl; failures++; }
+  };
+
+  // best to worst
+  const VkPhysicalDeviceType types[] = { VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU,
+                                         VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU, VK_PHYSICAL_DEVICE_TYPE_OTHER,
+                                         VK_PHYSICAL_DEVICE_TYPE_CPU };
+  const size_t typeCount = sizeof(types) / sizeof(types[0]);
+
+  for (size_t ndx = 0; ndx + 1 < typeCount; ndx++)
+  {
+    deviceScore better = scoreDevice(syntheticDevice(types[ndx], "better", false));
+    deviceScore worse = scoreDevice(syntheticDevice(types[ndx + 1], "worse", true));
+    check(better.score > worse.score, deviceTypeName(types[ndx]) + std::string(" (") + std::to_string(better.score) +
+          ") does not beat " + deviceTypeName(types[ndx + 1]) + " with every extra (" + std::to_string(worse.score) + ")");
+  }
+
+  // the driver lists the worst device first; the best type wins on score alone
+  std::vector<deviceCandidate> candidates;
+  for (size_t ndx = typeCount; ndx-- > 0; ) candidates.push_back(syntheticDevice(types[ndx], deviceTypeName(types[ndx]), ndx > 0));
+  for (size_t ndx = 0; ndx < candidates.size(); ndx++) candidates[ndx].uuid[0] = (uint8_t)(ndx + 1);
+  for (deviceCandidate& candidate : candidates) candidate.hasUuid = true;
+
+  std::string reason;
+  int discrete = (int)typeCount - 1;
+  check(discrete == selectDevice(candidates, "", &reason), "the discrete GPU is not chosen by score");
+
+  candidates[2].suitable = false;                                // the integrated GPU
+  check(-1 == scoreDevice(candidates[2]).score, "an unsuitable device does not score -1");
+  check(discrete == selectDevice(candidates, "Integrated", &reason), "an override naming an unsuitable device is not ignored");
+  check(0 == selectDevice(candidates, "0", &reason), "an override by index does not pick that device");
+  check(1 == selectDevice(candidates, "OTHER", &reason), "an override by name is not case insensitive");
+
+  std::string uuid = formatUuid(candidates[3].uuid);
+  check(3 == selectDevice(candidates, uuid, &reason), "an override by UUID does not pick that device");
+
+  for (deviceCandidate& candidate : candidates) candidate.suitable = false;
+  check(-1 == selectDevice(candidates, "", &reason), "a device is chosen when none is suitable");
+
+  if (0 == failures) os << "[+] device score checks passed" << std::endl;
+  return 0 == failures;
+}
@@ -0,0 +1,50 @@
+#ifndef _deviceScore_h_
+#define _deviceScore_h_
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+const char* const DEVICE_OVERRIDE_ENV = "VULKAN7_DEVICE";  // same as --device=, which wins if both are given
+const int64_t     DEVICE_TYPE_STEP = 2000;                 // between device types' scores, more than the rest adds (1200)
+
+// what is known about one physical device when choosing between them.  describeDevice fills one in from the device,
+// but nothing else here calls Vulkan, so scoring can be tried on hand-made candidates without a GPU.
+struct deviceCandidate
+{
+  VkPhysicalDeviceProperties       properties;
+  VkPhysicalDeviceMemoryProperties memory;
+  VkPhysicalDeviceFeatures         features;
+  uint8_t                          uuid[VK_UUID_SIZE];
+  bool                             hasUuid;         // needs VK_KHR_get_physical_device_properties2 on the instance
+  bool                             suitable;        // meets the caller's hard requirements (queues, swapchain, ...)
+};
+
+struct deviceScore
+{
+  int64_t     score;                                // -1 if the device is not suitable
+  std::string reason;                               // what the score is made of, for the log
+};
+
+// Scores a device for rendering: its type counts for most (discrete > virtual > integrated > other > CPU, with the gap
+// between types, DEVICE_TYPE_STEP, larger than anything else can add) then device local memory, a few limits, and the
+// optional features the renderer uses when they are there.
+deviceScore scoreDevice(const deviceCandidate& candidate);
+
+// Picks a device, the highest scoring suitable one unless overrideSpec names one.  overrideSpec is an index into
+// candidates, a UUID (32 hex digits, dashes allowed) or part of a device name (any case).  An override that matches no
+// suitable device is ignored, and reason says so.  Returns the index chosen, -1 if no device is suitable.
+int selectDevice(const std::vector<deviceCandidate>& candidates, const std::string& overrideSpec, std::string* reason);
+
+bool        deviceIdsAvailable();                   // true if the instance extensions describeDevice needs for UUIDs exist
+void        describeDevice(VkInstance instance, VkPhysicalDevice device, bool deviceIds, deviceCandidate* candidate);
+std::string formatUuid(const uint8_t* uuid);
+std::string getDeviceOverride(const std::string& option);  // option if not empty, else $VULKAN7_DEVICE
+
+bool        checkDeviceScore(std::ostream& os);     // self test on synthetic candidates (--check-device-score)
+
+#endif
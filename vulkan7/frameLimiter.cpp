@@ -0,0 +1,211 @@
+#include "frameLimiter.h"
+
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// never sleep closer than this to the deadline, and never trust the scheduler by more than the max
+static const std::chrono::microseconds minSpinMargin(200);
+static const std::chrono::microseconds maxSpinMargin(4000);
+
+
+/************************************************************************************************************************
+ * function  : ctor
+ *
+ * abstract  : Constructs a frame limiter.  A target of zero frames per second disables the limiting, the limiter will
+ *             then only measure the frame interval and CPU utilisation.
+ *
+ * parameters: targetFps -- [in] desired frame rate, zero for unlimited
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+frameLimiter::frameLimiter(double targetFps) : m_framePeriod(clock::duration::zero()), m_spinMargin(std::chrono::milliseconds(1))
+{
+  setTargetFps(targetFps);
+
+  m_nextFrame = clock::now();
+  m_lastFrame = clock::time_point();
+  resetWindow(m_nextFrame);
+}
+
+frameLimiter::~frameLimiter()
+{
+
+}
+
+
+
+void frameLimiter::setTargetFps(double targetFps)
+{
+  if (targetFps > 0.0)
+  {
+    m_framePeriod = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+  }
+  else
+  {
+    m_framePeriod = clock::duration::zero();
+  }
+
+  m_nextFrame = clock::now();
+}
+
+double frameLimiter::getTargetFps()
+{
+  if (m_framePeriod == clock::duration::zero()) return 0.0;
+
+  return 1.0 / std::chrono::duration<double>(m_framePeriod).count();
+}
+
+
+
+/************************************************************************************************************************
+ * function  : waitForNextFrame
+ *
+ * abstract  : Blocks until it is time to start the next frame, then records the interval since the previous frame.  We
+ *             use a sleep-then-spin approach;
+ *               (a) sleep until m_spinMargin before the deadline.  The OS scheduler is only accurate to about a
+ *                   millisecond (worse on Windows) so we can not sleep right up to the deadline.
+ *               (b) spin (yielding) for the remaining time, this is precise but burns CPU, so the margin is kept small.
+ *               (c) the margin adapts, each time the sleep overshoots we widen it by the overshoot, otherwise it slowly
+ *                   shrinks back down.
+ *             If we fall more than a frame behind the deadline is reset rather than trying to catch up with a burst
+ *             of frames.
+ *
+ * parameters: void
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void frameLimiter::waitForNextFrame()
+{
+  if (m_framePeriod != clock::duration::zero())
+  {
+    clock::time_point now = clock::now();
+
+    if (now - m_nextFrame > m_framePeriod)
+    {
+      m_nextFrame = now;                                         // too far behind, don't try to catch up
+    }
+
+    if (m_nextFrame - now > m_spinMargin)
+    {
+      std::this_thread::sleep_for(m_nextFrame - now - m_spinMargin);
+
+      clock::time_point woke = clock::now();
+      if (woke > m_nextFrame)
+      {
+        m_spinMargin = std::min<clock::duration>(m_spinMargin + (woke - m_nextFrame), maxSpinMargin);
+      }
+      else
+      {
+        m_spinMargin = std::max<clock::duration>(m_spinMargin - m_spinMargin / 16, minSpinMargin);
+      }
+    }
+
+    while (clock::now() < m_nextFrame)
+    {
+      std::this_thread::yield();
+    }
+
+    m_nextFrame += m_framePeriod;
+  }
+
+  // record the interval since the last frame
+  clock::time_point now = clock::now();
+  if (m_lastFrame != clock::time_point())
+  {
+    double intervalMs = std::chrono::duration<double, std::milli>(now - m_lastFrame).count();
+
+    m_sumIntervalMs += intervalMs;
+    m_minIntervalMs = (m_frames == 0) ? intervalMs : std::min(m_minIntervalMs, intervalMs);
+    m_maxIntervalMs = std::max(m_maxIntervalMs, intervalMs);
+    m_frames++;
+  }
+  m_lastFrame = now;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : getStats
+ *
+ * abstract  : Returns the frame timing over the current measurement window, optionally starting a new window.
+ *
+ * parameters: stats -- [out] pointer to structure to populate
+ *             reset -- [in] if true start a new measurement window
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void frameLimiter::getStats(frameTimingStats* stats, bool reset)
+{
+  if (nullptr == stats) return;
+
+  clock::time_point now = clock::now();
+  double wallSeconds = std::chrono::duration<double>(now - m_windowStart).count();
+  double cpuSeconds = processCpuSeconds() - m_windowCpuStart;
+
+  stats->frames = m_frames;
+  stats->avgIntervalMs = (m_frames > 0) ? m_sumIntervalMs / m_frames : 0.0;
+  stats->minIntervalMs = m_minIntervalMs;
+  stats->maxIntervalMs = m_maxIntervalMs;
+  stats->fps = (stats->avgIntervalMs > 0.0) ? 1000.0 / stats->avgIntervalMs : 0.0;
+  stats->cpuUtilisation = (wallSeconds > 0.0) ? cpuSeconds / wallSeconds : 0.0;
+
+  if (reset) resetWindow(now);
+}
+
+
+
+void frameLimiter::resetWindow(clock::time_point now)
+{
+  m_windowStart = now;
+  m_windowCpuStart = processCpuSeconds();
+  m_sumIntervalMs = 0.0;
+  m_minIntervalMs = 0.0;
+  m_maxIntervalMs = 0.0;
+  m_frames = 0;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : processCpuSeconds
+ *
+ * abstract  : returns the CPU time (user + kernel, all threads) consumed by this process.  std::clock can not be used as
+ *             the MSVC runtime implements it as wall time.
+ *
+ * parameters: void
+ *
+ * returns   : double, CPU time in seconds
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+double frameLimiter::processCpuSeconds()
+{
+#ifdef _WIN32
+  FILETIME creation, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0.0;
+
+  ULARGE_INTEGER k, u;
+  k.LowPart = kernel.dwLowDateTime;  k.HighPart = kernel.dwHighDateTime;
+  u.LowPart = user.dwLowDateTime;    u.HighPart = user.dwHighDateTime;
+
+  return (double)(k.QuadPart + u.QuadPart) * 100.0e-9;             // FILETIME is in 100ns units
+#else
+  struct timespec ts;
+  if (0 != clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts)) return 0.0;
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#endif
+}
@@ -0,0 +1,51 @@
+#ifndef _frameLimiter_h_
+#define _frameLimiter_h_
+
+#include <chrono>
+#include <cstddef>
+
+// timing of the frames seen by the limiter over the last reporting window
+struct frameTimingStats
+{
+  double  avgIntervalMs = 0.0;      // average time between successive frames (the present interval)
+  double  minIntervalMs = 0.0;
+  double  maxIntervalMs = 0.0;
+  double  fps = 0.0;
+  double  cpuUtilisation = 0.0;     // process CPU time / wall time, 1.0 == one core fully busy
+  size_t  frames = 0;
+};
+
+class frameLimiter
+{
+public:
+  frameLimiter(double targetFps = 0.0);
+  ~frameLimiter();
+
+  void   setTargetFps(double targetFps);
+  double getTargetFps();
+
+  void   waitForNextFrame();
+  void   getStats(frameTimingStats* stats, bool reset = true);
+
+private:
+  typedef std::chrono::steady_clock  clock;
+
+  clock::duration   m_framePeriod;       // zero => limiter disabled, just measure
+  clock::time_point m_nextFrame;         // deadline for the start of the next frame
+  clock::duration   m_spinMargin;        // how early to wake from sleep and start spinning
+
+  // measurement window
+  clock::time_point m_lastFrame;
+  clock::time_point m_windowStart;
+  double            m_windowCpuStart;    // process CPU time, in seconds, at the start of the window
+  double            m_sumIntervalMs;
+  double            m_minIntervalMs;
+  double            m_maxIntervalMs;
+  size_t            m_frames;
+
+  void   resetWindow(clock::time_point now);
+
+  static double processCpuSeconds();
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef _frameStats_h_
+#define _frameStats_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+const size_t FRAME_STATS_HISTORY = 128;           // frames kept by vkContext, see getFrameStats
+
+// What one frame did, counted by vkContext as it records and submits.  Counting is an increment per command recorded,
+// the totals of bytes uploaded and queue submits made outside the frame (loaders, streams) are kept by the helpers in
+// utilities.h and taken into the next frame drawn.
+struct frameStats
+{
+  uint64_t frame = 0;                   // frames drawn before this one
+  uint32_t drawCalls = 0;               // direct and indirect, the post-process and HUD draws included
+  uint64_t triangles = 0;               // indexed triangles submitted; a meshlet culled draw counts its whole mesh
+  uint32_t pipelineBinds = 0;           // graphics and compute
+  uint32_t descriptorBinds = 0;         // vkCmdBindDescriptorSets calls
+  uint32_t vertexBufferBinds = 0;
+  uint32_t indexBufferBinds = 0;
+  uint32_t pushConstantBytes = 0;
+  uint64_t uploadBytes = 0;             // host to device; staged copies since the last frame, uniforms and HUD quads
+  uint32_t queueSubmits = 0;            // the frame's own and any made since the last frame
+  double   fenceWaitMs = 0.0;           // waiting for the frame's fence before recording
+};
+
+// The last FRAME_STATS_HISTORY frames, newest first.  A fixed ring, pushing a frame overwrites the oldest, so keeping
+// it costs nothing per frame beyond the copy.
+class frameStatsHistory
+{
+public:
+  size_t            size() const { return m_count; }
+  const frameStats& operator[](size_t age) const             // 0 is the newest frame
+  {
+    return m_frames[(m_next + FRAME_STATS_HISTORY - 1 - age) % FRAME_STATS_HISTORY];
+  }
+  const frameStats& latest() const { return (*this)[0]; }    // all zero before the first frame
+
+  void push(const frameStats& stats)
+  {
+    m_frames[m_next] = stats;
+    m_next = (m_next + 1) % FRAME_STATS_HISTORY;
+    m_count = std::min(m_count + 1, FRAME_STATS_HISTORY);
+  }
+
+  // the mean of each counter over the newest frames (as many as there are, if fewer); frame is the newest frame's
+  frameStats average(size_t frames = FRAME_STATS_HISTORY) const
+  {
+    frameStats mean;
+    frames = std::min(frames, m_count);
+    if (0 == frames) return mean;
+
+    uint64_t draws = 0, pipelines = 0, descriptors = 0, vertexBinds = 0, indexBinds = 0, pushBytes = 0, submits = 0;
+    for (size_t age = 0; age < frames; age++)
+    {
+      const frameStats& s = (*this)[age];
+      draws += s.drawCalls;
+      mean.triangles += s.triangles;
+      pipelines += s.pipelineBinds;
+      descriptors += s.descriptorBinds;
+      vertexBinds += s.vertexBufferBinds;
+      indexBinds += s.indexBufferBinds;
+      pushBytes += s.pushConstantBytes;
+      mean.uploadBytes += s.uploadBytes;
+      submits += s.queueSubmits;
+      mean.fenceWaitMs += s.fenceWaitMs;
+    }
+
+    mean.frame = latest().frame;
+    mean.drawCalls = static_cast<uint32_t>(draws / frames);
+    mean.triangles /= frames;
+    mean.pipelineBinds = static_cast<uint32_t>(pipelines / frames);
+    mean.descriptorBinds = static_cast<uint32_t>(descriptors / frames);
+    mean.vertexBufferBinds = static_cast<uint32_t>(vertexBinds / frames);
+    mean.indexBufferBinds = static_cast<uint32_t>(indexBinds / frames);
+    mean.pushConstantBytes = static_cast<uint32_t>(pushBytes / frames);
+    mean.uploadBytes /= frames;
+    mean.queueSubmits = static_cast<uint32_t>(submits / frames);
+    mean.fenceWaitMs /= frames;
+    return mean;
+  }
+
+private:
+  frameStats m_frames[FRAME_STATS_HISTORY] = {};
+  size_t     m_next = 0;                          // oldest frame once the ring is full
+  size_t     m_count = 0;
+};
+
+#endif
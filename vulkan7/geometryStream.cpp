@@ -0,0 +1,359 @@
+#include "geometryStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+
+geometryStream::geometryStream(VkPhysicalDevice physical, VkDevice device, VkQueue xferQueue, VkCommandPool xferCmdPool, jobSystem& jobs)
+  : m_physical(physical), m_device(device), m_xferQueue(xferQueue), m_xferCmdPool(xferCmdPool), m_jobs(jobs)
+{
+}
+
+
+
+// the paging jobs read the mapped file, so they have to finish before it is unmapped
+geometryStream::~geometryStream()
+{
+  m_jobs.wait(&m_loads);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : open
+ *
+ * abstract  : Maps a chunk file and sizes everything the frame loop uses for its chunk count, so that update never
+ *             allocates.  Nothing is uploaded until createProxies is called with the textures.
+ *
+ * parameters: fileName -- [in] .vkc file written by chunkFile::build
+ *
+ * returns   : void, throws std::runtime_error if the file can not be read
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void geometryStream::open(const std::string& fileName)
+{
+  m_file.open(fileName);
+
+  size_t chunkCount = m_file.getChunks().size();
+  m_slots.reset(new chunkSlot[chunkCount]);
+  m_draws.reserve(chunkCount);
+  m_wanted.reserve(chunkCount);
+  m_retired.reserve(chunkCount);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createProxies
+ *
+ * abstract  : Uploads every chunk's proxy, they are what is drawn for a chunk that is not resident so have to be there
+ *             from the start.  They are small (a few hundred vertices per chunk at most) and not counted in the budget.
+ *
+ * parameters: textures -- [in] texture for each of the file's texture names, as returned by createTexture
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void geometryStream::createProxies(const std::vector<textureHandle>& textures)
+{
+  const std::vector<chunkRecord>& chunks = m_file.getChunks();
+
+  for (size_t c = 0; c < chunks.size(); c++)
+  {
+    const chunkRecord& chunk = chunks[c];
+    chunkSlot&         slot = m_slots[c];
+
+    slot.texture = (chunk.texture >= 0 && chunk.texture < (int32_t)textures.size()) ? textures[chunk.texture] : textureHandle();
+    slot.bytes = (uint64_t)chunk.vertexCount * sizeof(vertex) + (uint64_t)chunk.indexCount * sizeof(uint32_t);
+
+    if (0 == chunk.proxyIndexCount) continue;
+
+    const uint8_t* data = m_file.proxyData(chunk);
+    slot.proxy = mesh(m_physical, m_device, m_xferQueue, m_xferCmdPool, data, chunk.proxyVertexCount,
+      data + (size_t)chunk.proxyVertexCount * sizeof(vertex), chunk.proxyIndexCount, slot.texture);
+    slot.hasProxy = true;
+
+    m_proxyBytes += (uint64_t)chunk.proxyVertexCount * sizeof(vertex) + (uint64_t)chunk.proxyIndexCount * sizeof(uint32_t);
+  }
+}
+
+
+
+// the stream is made before its model has a handle, so the context says who owns it once it does
+void geometryStream::setMemoryOwner(deviceMemoryOwner owner)
+{
+  m_owner = owner;
+
+  size_t chunks = m_file.getChunks().size();
+  for (size_t c = 0; c < chunks; c++)
+  {
+    if (m_slots[c].hasProxy) m_slots[c].proxy.setMemoryOwner(owner);
+    if (CHUNK_RESIDENT == m_slots[c].state.load(std::memory_order_relaxed)) m_slots[c].full.setMemoryOwner(owner);
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : update
+ *
+ * abstract  : Chooses this frame's draws and moves chunks towards residency.  Called once per frame, after the frame's
+ *             fence has been waited on (so frames up to frame - MAX_FRAME_DRAWS are known to be finished):
+ *              (a) destroys evicted meshes that no unfinished frame can be drawing
+ *              (b) tests each chunk's sphere against the frustum, a visible chunk is drawn full if it is resident and
+ *                  as its proxy otherwise, in which case it is wanted
+ *              (c) goes through the wanted chunks nearest first, uploading those that are paged in (making room in the
+ *                  budget if need be) and starting paging jobs for those still on disk
+ *             A chunk uploaded this frame is first drawn full next frame, so the stream stays busy (see isBusy) for
+ *             that frame and while any chunk is being paged in.
+ *
+ * parameters: frame -- [in] frame number, increasing by one each frame
+ *             mvp -- [in] the model's model-view-projection matrix
+ *             camera -- [in] camera position in model space
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) notes whether the stream is busy, for drawing on demand
+************************************************************************************************************************/
+void geometryStream::update(uint64_t frame, const glm::mat4& mvp, const glm::vec3& camera)
+{
+  retire(frame);
+
+  glm::vec4 planes[6];
+  frustumPlanes(mvp, planes);
+
+  const std::vector<chunkRecord>& chunks = m_file.getChunks();
+  m_draws.clear();
+  m_wanted.clear();
+  m_visible = 0;
+  m_proxiesDrawn = 0;
+
+  for (size_t c = 0; c < chunks.size(); c++)
+  {
+    const float* sphere = chunks[c].sphere;
+    bool inside = true;
+    for (int p = 0; p < 6 && inside; p++)
+    {
+      inside = planes[p].x * sphere[0] + planes[p].y * sphere[1] + planes[p].z * sphere[2] + planes[p].w >= -sphere[3];
+    }
+    if (!inside) continue;
+
+    chunkSlot& slot = m_slots[c];
+    slot.lastVisible = frame;
+    m_visible++;
+
+    int state = slot.state.load(std::memory_order_acquire);
+    if (CHUNK_RESIDENT == state)
+    {
+      m_draws.push_back(&slot.full);
+      continue;
+    }
+
+    if (slot.hasProxy)
+    {
+      m_draws.push_back(&slot.proxy);
+      m_proxiesDrawn++;
+    }
+
+    if (CHUNK_ON_DISK == state || CHUNK_PAGED_IN == state)
+    {
+      glm::vec3 toChunk(sphere[0] - camera.x, sphere[1] - camera.y, sphere[2] - camera.z);
+      float     distance = std::sqrt(toChunk.x * toChunk.x + toChunk.y * toChunk.y + toChunk.z * toChunk.z) - sphere[3];
+      m_wanted.push_back({ std::max(0.0f, distance), (uint32_t)c });
+    }
+  }
+
+  std::sort(m_wanted.begin(), m_wanted.end());
+
+  size_t uploads = 0;
+  for (const std::pair<float, uint32_t>& wanted : m_wanted)
+  {
+    uint32_t   c = wanted.second;
+    chunkSlot& slot = m_slots[c];
+    int        state = slot.state.load(std::memory_order_acquire);
+
+    if (CHUNK_PAGED_IN == state && uploads < STREAM_MAX_UPLOADS && makeRoom(slot.bytes, frame))
+    {
+      const chunkRecord& chunk = chunks[c];
+      const uint8_t*     data = m_file.chunkData(chunk);
+      slot.full = mesh(m_physical, m_device, m_xferQueue, m_xferCmdPool, data, chunk.vertexCount,
+        data + (size_t)chunk.vertexCount * sizeof(vertex), chunk.indexCount, slot.texture);
+      slot.full.setMemoryOwner(m_owner);
+      slot.state.store(CHUNK_RESIDENT, std::memory_order_relaxed);
+
+      m_residentBytes += slot.bytes;
+      m_uploads++;
+      uploads++;
+    }
+    else if (CHUNK_ON_DISK == state && m_loadsInFlight.load(std::memory_order_relaxed) < STREAM_MAX_LOADS)
+    {
+      slot.state.store(CHUNK_LOADING, std::memory_order_relaxed);
+      m_loadsInFlight++;
+      m_jobs.run([this, c]() { pageIn(c); }, &m_loads);
+    }
+  }
+
+  m_busy = uploads > 0 || m_loadsInFlight.load(std::memory_order_relaxed) > 0;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : pageIn
+ *
+ * abstract  : Job that brings a chunk's data into memory by reading it, a page at a time for the vertices and every
+ *             index (which are checked against the vertex count on the way, a chunk with a bad index is never uploaded
+ *             and keeps drawing its proxy).  Runs on a worker, so only touches the chunk's state.
+ *
+ * parameters: chunk -- [in] index of the chunk
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void geometryStream::pageIn(uint32_t chunk)
+{
+  const chunkRecord& record = m_file.getChunks()[chunk];
+  const uint8_t*     data = m_file.chunkData(record);
+  size_t             vertexBytes = (size_t)record.vertexCount * sizeof(vertex);
+
+  volatile uint8_t touch = 0;
+  for (size_t offset = 0; offset < vertexBytes; offset += CHUNK_PAGE_SIZE) touch += data[offset];
+
+  bool valid = true;
+  for (uint32_t ndx = 0; ndx < record.indexCount; ndx++)
+  {
+    uint32_t index;
+    memcpy(&index, data + vertexBytes + ndx * sizeof(uint32_t), sizeof(index));
+    valid = valid && (index < record.vertexCount);
+  }
+
+  m_slots[chunk].state.store(valid ? CHUNK_PAGED_IN : CHUNK_FAILED, std::memory_order_release);
+  m_loadsInFlight--;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : makeRoom
+ *
+ * abstract  : Evicts resident chunks, least recently visible first, until 'bytes' more fit in the budget.  Chunks that
+ *             are visible this frame are never evicted (they are about to be drawn), so this can fail.  An evicted
+ *             chunk goes back on disk (its pages may be dropped by the OS) and its mesh onto the retired list.
+ *
+ * parameters: bytes -- [in] size of the chunk to be uploaded
+ *             frame -- [in] current frame number
+ *
+ * returns   : bool, true if there is now room, false otherwise
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+bool geometryStream::makeRoom(uint64_t bytes, uint64_t frame)
+{
+  if (bytes > m_budget) return false;
+
+  size_t chunkCount = m_file.getChunks().size();
+  while (m_residentBytes + bytes > m_budget)
+  {
+    size_t oldest = chunkCount;
+    for (size_t c = 0; c < chunkCount; c++)
+    {
+      const chunkSlot& slot = m_slots[c];
+      if (CHUNK_RESIDENT != slot.state.load(std::memory_order_relaxed) || slot.lastVisible >= frame) continue;
+      if (chunkCount == oldest || slot.lastVisible < m_slots[oldest].lastVisible) oldest = c;
+    }
+    if (chunkCount == oldest) return false;
+
+    chunkSlot& victim = m_slots[oldest];
+    m_retired.push_back({ std::move(victim.full), victim.lastVisible });
+    victim.state.store(CHUNK_ON_DISK, std::memory_order_relaxed);
+
+    m_residentBytes -= victim.bytes;
+    m_evictions++;
+  }
+
+  return true;
+}
+
+
+
+// destroys retired meshes last drawn in a frame that has finished
+void geometryStream::retire(uint64_t frame)
+{
+  size_t kept = 0;
+  for (size_t r = 0; r < m_retired.size(); r++)
+  {
+    if (m_retired[r].lastVisible + MAX_FRAME_DRAWS <= frame) m_retired[r].full.destroyBuffers();
+    else
+    {
+      if (kept != r) m_retired[kept] = std::move(m_retired[r]);
+      kept++;
+    }
+  }
+  m_retired.resize(kept);
+}
+
+
+
+streamStats geometryStream::getStats()
+{
+  streamStats stats;
+  stats.chunks = m_file.getChunks().size();
+  for (size_t c = 0; c < stats.chunks; c++)
+  {
+    int state = m_slots[c].state.load(std::memory_order_relaxed);
+    if (CHUNK_RESIDENT == state) stats.resident++;
+    if (CHUNK_LOADING == state) stats.loading++;
+  }
+  stats.visible = m_visible;
+  stats.proxies = m_proxiesDrawn;
+  stats.residentBytes = m_residentBytes;
+  stats.budgetBytes = m_budget;
+  stats.proxyBytes = m_proxyBytes;
+  stats.uploads = m_uploads;
+  stats.evictions = m_evictions;
+
+  return stats;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : destroy
+ *
+ * abstract  : Waits for any paging jobs, then destroys every mesh the stream made (resident, retired and proxies) and
+ *             unmaps the file.  The caller has to make sure the GPU is idle first (cleanupContext does).
+ *
+ * parameters: void
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void geometryStream::destroy()
+{
+  m_jobs.wait(&m_loads);
+
+  for (size_t c = 0; c < m_file.getChunks().size(); c++)
+  {
+    chunkSlot& slot = m_slots[c];
+    if (CHUNK_RESIDENT == slot.state.load(std::memory_order_relaxed)) slot.full.destroyBuffers();
+    if (slot.hasProxy) slot.proxy.destroyBuffers();
+
+    slot.state.store(CHUNK_ON_DISK, std::memory_order_relaxed);
+    slot.hasProxy = false;
+  }
+
+  for (retiredMesh& retired : m_retired) retired.full.destroyBuffers();
+  m_retired.clear();
+  m_draws.clear();
+  m_residentBytes = 0;
+  m_proxyBytes = 0;
+
+  m_file.close();
+}
@@ -0,0 +1,117 @@
+#ifndef _geometryStream_h_
+#define _geometryStream_h_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mesh.h"
+#include "chunkFile.h"
+#include "jobSystem.h"
+
+const size_t   STREAM_MAX_LOADS = 8;                   // chunks being paged in at once
+const size_t   STREAM_MAX_UPLOADS = 4;                 // chunks made resident per frame, each one stalls the queue
+const uint64_t STREAM_DEFAULT_BUDGET = 256ull * 1024 * 1024;
+
+// what a geometry stream is doing, see vkContext::reportStreaming
+struct streamStats
+{
+  size_t   chunks = 0;
+  size_t   resident = 0;                 // full detail chunks on the GPU
+  size_t   loading = 0;                  // being paged in from the file
+  size_t   visible = 0;                  // chunks in the frustum last frame
+  size_t   proxies = 0;                  // of those, drawn as their proxy
+  uint64_t residentBytes = 0;
+  uint64_t budgetBytes = 0;
+  uint64_t proxyBytes = 0;               // always resident, not counted against the budget
+  uint64_t uploads = 0;                  // since the stream was opened
+  uint64_t evictions = 0;
+};
+
+// Draws a chunk file (see chunkFile) that may be much larger than GPU memory.  Every chunk's proxy is uploaded when the
+// stream is opened and stays resident; each frame update() tests the chunks' spheres against the frustum and draws a
+// visible chunk at full detail if it is resident, otherwise its proxy.  Visible chunks that are not resident are
+// requested nearest first: a job on the job system pages the chunk's data in from the mapped file (and checks its
+// indices), then the next update uploads it, at most STREAM_MAX_UPLOADS a frame.  Resident chunks count against a
+// byte budget, when an upload would go over it the chunks least recently visible are evicted; their buffers are kept
+// until the frames that may have drawn them are done.  The frame loop does not allocate, every list is sized when the
+// stream is opened.
+class geometryStream
+{
+public:
+  geometryStream(VkPhysicalDevice, VkDevice, VkQueue xferQueue, VkCommandPool xferCmdPool, jobSystem& jobs);
+  ~geometryStream();
+
+  geometryStream(const geometryStream&) = delete;
+  geometryStream& operator=(const geometryStream&) = delete;
+
+  void open(const std::string& fileName);                         // throws std::runtime_error, see chunkFile::open
+  const std::vector<std::string>& getTextureNames() { return m_file.getTextureNames(); }
+  void createProxies(const std::vector<textureHandle>& textures); // texture for each name, uploads every proxy
+  void setBudget(uint64_t bytes) { m_budget = bytes; }
+  void setMemoryOwner(deviceMemoryOwner owner);                   // charges the proxies, and chunks uploaded later, to owner
+
+  void update(uint64_t frame, const glm::mat4& mvp, const glm::vec3& camera);     // camera in model space
+  size_t getDrawCount() { return m_draws.size(); }
+  mesh*  getDraw(size_t ndx) { return m_draws[ndx]; }
+
+  size_t      getChunkCount() { return m_file.getChunks().size(); }
+  streamStats getStats();
+  bool        isBusy() { return m_busy; }             // chunks are being paged in or were uploaded by the last update
+
+  void destroy();                                                 // the GPU must be done with every frame drawn
+
+private:
+  enum chunkState { CHUNK_ON_DISK, CHUNK_LOADING, CHUNK_PAGED_IN, CHUNK_RESIDENT, CHUNK_FAILED };
+
+  struct chunkSlot
+  {
+    std::atomic<int> state{ CHUNK_ON_DISK };     // written by the paging job, everything else only by update
+    mesh             full;                       // valid when CHUNK_RESIDENT
+    mesh             proxy;                      // valid when hasProxy
+    bool             hasProxy = false;
+    textureHandle    texture;
+    uint64_t         lastVisible = 0;            // frame number
+    uint64_t         bytes = 0;                  // of the full mesh
+  };
+
+  // an evicted mesh, destroyed once no frame still in flight can be drawing it
+  struct retiredMesh
+  {
+    mesh     full;
+    uint64_t lastVisible;
+  };
+
+  VkPhysicalDevice     m_physical;
+  VkDevice             m_device;
+  VkQueue              m_xferQueue;
+  VkCommandPool        m_xferCmdPool;
+  jobSystem&           m_jobs;
+
+  chunkFile                    m_file;
+  std::unique_ptr<chunkSlot[]> m_slots;
+  jobCounter                   m_loads;
+  std::atomic<size_t>          m_loadsInFlight{ 0 };
+
+  std::vector<mesh*>                      m_draws;       // this frame's draws
+  std::vector<std::pair<float, uint32_t>> m_wanted;      // visible chunks that are not resident, by distance
+  std::vector<retiredMesh>                m_retired;
+
+  deviceMemoryOwner    m_owner;
+
+  uint64_t   m_budget = STREAM_DEFAULT_BUDGET;
+  uint64_t   m_residentBytes = 0;
+  uint64_t   m_proxyBytes = 0;
+  uint64_t   m_uploads = 0;
+  uint64_t   m_evictions = 0;
+  size_t     m_visible = 0;
+  size_t     m_proxiesDrawn = 0;
+  bool       m_busy = false;
+
+  void pageIn(uint32_t chunk);
+  bool makeRoom(uint64_t bytes, uint64_t frame);
+  void retire(uint64_t frame);
+};
+
+#endif
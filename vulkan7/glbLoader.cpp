@@ -0,0 +1,1186 @@
+#include "glbLoader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include "MeshModel.h"
+#include "assetPack.h"
+
+static const uint32_t GLB_MAGIC = 0x46546C67;          // "glTF"
+static const uint32_t GLB_CHUNK_JSON = 0x4E4F534A;     // "JSON"
+static const uint32_t GLB_CHUNK_BIN = 0x004E4942;      // "BIN\0"
+
+static const int COMPONENT_BYTE = 5120;
+static const int COMPONENT_UNSIGNED_BYTE = 5121;
+static const int COMPONENT_SHORT = 5122;
+static const int COMPONENT_UNSIGNED_SHORT = 5123;
+static const int COMPONENT_UNSIGNED_INT = 5125;
+static const int COMPONENT_FLOAT = 5126;
+
+static const int TARGET_ARRAY_BUFFER = 34962;
+static const int TARGET_ELEMENT_ARRAY_BUFFER = 34963;
+
+static const int MODE_TRIANGLES = 4;
+
+// the converter writes 'vertex' as is and the loader memcpy's it back, so it must be three tightly packed attributes
+static_assert(sizeof(vertex) == 32, "vertex is expected to be pos/col/tex with no padding");
+static_assert(offsetof(vertex, pos) == 0 && offsetof(vertex, col) == 12 && offsetof(vertex, tex) == 24, "unexpected vertex layout");
+
+
+// just enough JSON for a glTF header, object members are kept in file order
+struct jsonValue
+{
+  enum jsonType { JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT };
+
+  jsonType                 type = JSON_NULL;
+  bool                     boolean = false;
+  double                   number = 0.0;
+  std::string              string;
+  std::vector<std::string> names;          // object member names, names[i] goes with items[i]
+  std::vector<jsonValue>   items;          // array elements or object member values
+
+  const jsonValue* get(const char* name) const
+  {
+    if (JSON_OBJECT != type) return nullptr;
+    for (size_t ndx = 0; ndx < names.size(); ndx++)
+    {
+      if (names[ndx] == name) return &items[ndx];
+    }
+    return nullptr;
+  }
+
+  // element ndx of an array, nullptr if this is not an array or ndx is out of range
+  const jsonValue* at(int ndx) const
+  {
+    if (JSON_ARRAY != type || ndx < 0 || ndx >= (int)items.size()) return nullptr;
+    return &items[ndx];
+  }
+};
+
+// recursive descent parser for jsonValue, throws std::runtime_error on malformed input
+class jsonParser
+{
+public:
+  jsonParser(const char* text, size_t length) : m_p(text), m_end(text + length) { }
+
+  jsonValue parse()
+  {
+    jsonValue value = parseValue(0);
+
+    // GLB pads the JSON chunk with spaces, some writers use NULs
+    while (m_p < m_end && (isSpace(*m_p) || '\0' == *m_p)) m_p++;
+    if (m_p != m_end) fail("unexpected characters after the value");
+
+    return value;
+  }
+
+private:
+  const char* m_p;
+  const char* m_end;
+
+  static const int MAX_DEPTH = 64;
+
+  static bool isSpace(char c) { return ' ' == c || '\t' == c || '\n' == c || '\r' == c; }
+
+  void fail(const char* what)
+  {
+    throw std::runtime_error(std::string("bad JSON in glb: ") + what);
+  }
+
+  void skipSpace()
+  {
+    while (m_p < m_end && isSpace(*m_p)) m_p++;
+  }
+
+  void expect(char c)
+  {
+    skipSpace();
+    if (m_p >= m_end || *m_p != c) fail("unexpected character");
+    m_p++;
+  }
+
+  bool matchWord(const char* word)
+  {
+    size_t length = strlen(word);
+    if ((size_t)(m_end - m_p) < length || 0 != strncmp(m_p, word, length)) return false;
+    m_p += length;
+    return true;
+  }
+
+  jsonValue parseValue(int depth);
+  void      parseString(std::string* out);
+  void      parseNumber(jsonValue* value);
+  void      appendUtf8(std::string* out, uint32_t codePoint);
+  uint32_t  parseHex4();
+};
+
+
+
+jsonValue jsonParser::parseValue(int depth)
+{
+  if (depth > MAX_DEPTH) fail("nested too deeply");
+
+  skipSpace();
+  if (m_p >= m_end) fail("unexpected end of input");
+
+  jsonValue value;
+  char c = *m_p;
+
+  if ('{' == c)
+  {
+    value.type = jsonValue::JSON_OBJECT;
+    m_p++;
+    skipSpace();
+    if (m_p < m_end && '}' == *m_p) { m_p++; return value; }
+
+    while (true)
+    {
+      skipSpace();
+      std::string name;
+      parseString(&name);
+      expect(':');
+
+      value.names.push_back(name);
+      value.items.push_back(parseValue(depth + 1));
+
+      skipSpace();
+      if (m_p < m_end && ',' == *m_p) { m_p++; continue; }
+      expect('}');
+      break;
+    }
+  }
+  else if ('[' == c)
+  {
+    value.type = jsonValue::JSON_ARRAY;
+    m_p++;
+    skipSpace();
+    if (m_p < m_end && ']' == *m_p) { m_p++; return value; }
+
+    while (true)
+    {
+      value.items.push_back(parseValue(depth + 1));
+
+      skipSpace();
+      if (m_p < m_end && ',' == *m_p) { m_p++; continue; }
+      expect(']');
+      break;
+    }
+  }
+  else if ('"' == c)
+  {
+    value.type = jsonValue::JSON_STRING;
+    parseString(&value.string);
+  }
+  else if (matchWord("true"))
+  {
+    value.type = jsonValue::JSON_BOOL;
+    value.boolean = true;
+  }
+  else if (matchWord("false"))
+  {
+    value.type = jsonValue::JSON_BOOL;
+  }
+  else if (matchWord("null"))
+  {
+    value.type = jsonValue::JSON_NULL;
+  }
+  else
+  {
+    parseNumber(&value);
+  }
+
+  return value;
+}
+
+
+
+void jsonParser::parseString(std::string* out)
+{
+  if (m_p >= m_end || '"' != *m_p) fail("expected a string");
+  m_p++;
+
+  while (m_p < m_end && '"' != *m_p)
+  {
+    char c = *m_p++;
+    if ('\\' != c)
+    {
+      out->push_back(c);
+      continue;
+    }
+
+    if (m_p >= m_end) break;
+    c = *m_p++;
+    switch (c)
+    {
+      case '"':  out->push_back('"'); break;
+      case '\\': out->push_back('\\'); break;
+      case '/':  out->push_back('/'); break;
+      case 'b':  out->push_back('\b'); break;
+      case 'f':  out->push_back('\f'); break;
+      case 'n':  out->push_back('\n'); break;
+      case 'r':  out->push_back('\r'); break;
+      case 't':  out->push_back('\t'); break;
+      case 'u':
+      {
+        uint32_t codePoint = parseHex4();
+
+        // a high surrogate should be followed by \u and the low surrogate
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF && m_end - m_p >= 6 && '\\' == m_p[0] && 'u' == m_p[1])
+        {
+          m_p += 2;
+          uint32_t low = parseHex4();
+          if (low >= 0xDC00 && low <= 0xDFFF) codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        }
+        appendUtf8(out, codePoint);
+        break;
+      }
+      default:   fail("bad escape in string");
+    }
+  }
+
+  if (m_p >= m_end) fail("unterminated string");
+  m_p++;
+}
+
+
+
+uint32_t jsonParser::parseHex4()
+{
+  if (m_end - m_p < 4) fail("short \\u escape");
+
+  uint32_t value = 0;
+  for (int ndx = 0; ndx < 4; ndx++)
+  {
+    char c = *m_p++;
+    value <<= 4;
+    if (c >= '0' && c <= '9') value |= (uint32_t)(c - '0');
+    else if (c >= 'a' && c <= 'f') value |= (uint32_t)(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F') value |= (uint32_t)(c - 'A' + 10);
+    else fail("bad \\u escape");
+  }
+
+  return value;
+}
+
+
+
+void jsonParser::appendUtf8(std::string* out, uint32_t codePoint)
+{
+  if (codePoint < 0x80)
+  {
+    out->push_back((char)codePoint);
+  }
+  else if (codePoint < 0x800)
+  {
+    out->push_back((char)(0xC0 | (codePoint >> 6)));
+    out->push_back((char)(0x80 | (codePoint & 0x3F)));
+  }
+  else if (codePoint < 0x10000)
+  {
+    out->push_back((char)(0xE0 | (codePoint >> 12)));
+    out->push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+    out->push_back((char)(0x80 | (codePoint & 0x3F)));
+  }
+  else
+  {
+    out->push_back((char)(0xF0 | (codePoint >> 18)));
+    out->push_back((char)(0x80 | ((codePoint >> 12) & 0x3F)));
+    out->push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+    out->push_back((char)(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+
+
+void jsonParser::parseNumber(jsonValue* value)
+{
+  // the chunk is not NUL terminated, so copy the number out for strtod
+  char buffer[64];
+  size_t length = 0;
+  while (m_p < m_end && length < sizeof(buffer) - 1 && (isdigit((unsigned char)*m_p) || strchr("+-.eE", *m_p)))
+  {
+    buffer[length++] = *m_p++;
+  }
+  buffer[length] = '\0';
+
+  char* end = nullptr;
+  value->number = strtod(buffer, &end);
+  if (0 == length || end != buffer + length) fail("bad number");
+
+  value->type = jsonValue::JSON_NUMBER;
+}
+
+
+
+// member helpers, a missing member (or one of the wrong type) gives the default
+static const jsonValue* getMember(const jsonValue* object, const char* name)
+{
+  return (nullptr != object) ? object->get(name) : nullptr;
+}
+
+static double getNumber(const jsonValue* object, const char* name, double def)
+{
+  const jsonValue* value = getMember(object, name);
+  return (nullptr != value && jsonValue::JSON_NUMBER == value->type) ? value->number : def;
+}
+
+static int getInt(const jsonValue* object, const char* name, int def)
+{
+  return (int)getNumber(object, name, def);
+}
+
+static size_t getSize(const jsonValue* object, const char* name, size_t def)
+{
+  double value = getNumber(object, name, (double)def);
+  if (value < 0.0) throw std::runtime_error(std::string("negative ") + name + " in glb");
+  return (size_t)value;
+}
+
+static std::string getString(const jsonValue* object, const char* name)
+{
+  const jsonValue* value = getMember(object, name);
+  return (nullptr != value && jsonValue::JSON_STRING == value->type) ? value->string : std::string();
+}
+
+// element ndx of the top level array 'name' (e.g. "accessors"), nullptr if there is no such element
+static const jsonValue* getElement(const jsonValue& root, const char* name, int ndx)
+{
+  const jsonValue* array = root.get(name);
+  return (nullptr != array) ? array->at(ndx) : nullptr;
+}
+
+static uint32_t read32(const uint8_t* p)
+{
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static void write32(std::ostream& os, uint32_t value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static size_t componentSize(int componentType)
+{
+  switch (componentType)
+  {
+    case COMPONENT_BYTE:
+    case COMPONENT_UNSIGNED_BYTE:  return 1;
+    case COMPONENT_SHORT:
+    case COMPONENT_UNSIGNED_SHORT: return 2;
+    case COMPONENT_UNSIGNED_INT:
+    case COMPONENT_FLOAT:          return 4;
+    default:                       return 0;
+  }
+}
+
+// one component of an attribute as a float, applying the normalisation rules for integer types
+static float readComponent(const uint8_t* p, int componentType, bool normalized)
+{
+  switch (componentType)
+  {
+    case COMPONENT_FLOAT:
+    {
+      float value;
+      memcpy(&value, p, sizeof(value));
+      return value;
+    }
+    case COMPONENT_UNSIGNED_BYTE:
+      return normalized ? p[0] / 255.0f : (float)p[0];
+    case COMPONENT_UNSIGNED_SHORT:
+    {
+      uint16_t value;
+      memcpy(&value, p, sizeof(value));
+      return normalized ? value / 65535.0f : (float)value;
+    }
+    case COMPONENT_BYTE:
+      return normalized ? std::max((int8_t)p[0] / 127.0f, -1.0f) : (float)(int8_t)p[0];
+    case COMPONENT_SHORT:
+    {
+      int16_t value;
+      memcpy(&value, p, sizeof(value));
+      return normalized ? std::max(value / 32767.0f, -1.0f) : (float)value;
+    }
+    default:
+      return 0.0f;
+  }
+}
+
+
+
+// state shared while reading one file
+struct glbView
+{
+  const uint8_t* data;
+  size_t         length;
+  size_t         stride;               // zero => tightly packed
+};
+
+struct glbParse
+{
+  const jsonValue*     root;
+  std::vector<glbView> views;
+};
+
+
+
+/************************************************************************************************************************
+ * function  : readAccessor
+ *
+ * abstract  : Resolves an accessor to a pointer into the BIN chunk, checking that every element lies inside its buffer
+ *             view so the copies that follow need no further checks.
+ *
+ * parameters: parse -- [in] the JSON and the resolved buffer views
+ *             ndx -- [in] index of the accessor
+ *
+ * returns   : glbAccessor, throws std::runtime_error if the accessor is invalid or uses an unsupported feature
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+static glbAccessor readAccessor(const glbParse& parse, int ndx)
+{
+  const jsonValue* accessor = getElement(*parse.root, "accessors", ndx);
+  if (nullptr == accessor) throw std::runtime_error("glb: accessor " + std::to_string(ndx) + " does not exist");
+
+  if (nullptr != accessor->get("sparse")) throw std::runtime_error("glb: sparse accessors are not supported");
+
+  int viewNdx = getInt(accessor, "bufferView", -1);
+  if (viewNdx < 0 || viewNdx >= (int)parse.views.size())
+  {
+    throw std::runtime_error("glb: accessors without a buffer view are not supported");
+  }
+  const glbView& view = parse.views[viewNdx];
+
+  glbAccessor result;
+  result.componentType = getInt(accessor, "componentType", 0);
+  result.count = getSize(accessor, "count", 0);
+  result.normalized = (nullptr != accessor->get("normalized") && accessor->get("normalized")->boolean);
+
+  std::string type = getString(accessor, "type");
+  if ("SCALAR" == type) result.components = 1;
+  else if ("VEC2" == type) result.components = 2;
+  else if ("VEC3" == type) result.components = 3;
+  else if ("VEC4" == type) result.components = 4;
+  else throw std::runtime_error("glb: unsupported accessor type '" + type + "'");
+
+  size_t elementSize = componentSize(result.componentType) * result.components;
+  if (0 == elementSize) throw std::runtime_error("glb: bad component type " + std::to_string(result.componentType));
+
+  result.stride = (view.stride > 0) ? view.stride : elementSize;
+
+  size_t offset = getSize(accessor, "byteOffset", 0);
+  if (result.count > 0)
+  {
+    // (count - 1) * stride + elementSize bytes from offset, checked without overflowing
+    if (offset > view.length || result.count - 1 > (view.length - offset) / result.stride ||
+        (result.count - 1) * result.stride + elementSize > view.length - offset)
+    {
+      throw std::runtime_error("glb: accessor " + std::to_string(ndx) + " runs past the end of its buffer view");
+    }
+  }
+
+  result.data = view.data + offset;
+  return result;
+}
+
+
+
+// true when the three attributes sit in one buffer view with exactly the 'vertex' layout
+static bool matchesVertexLayout(const glbPrimitive& primitive)
+{
+  const glbAccessor& pos = primitive.position;
+  const glbAccessor& col = primitive.color;
+  const glbAccessor& tex = primitive.texcoord;
+
+  return COMPONENT_FLOAT == pos.componentType && 3 == pos.components && sizeof(vertex) == pos.stride &&
+         COMPONENT_FLOAT == col.componentType && 3 == col.components && sizeof(vertex) == col.stride &&
+         COMPONENT_FLOAT == tex.componentType && 2 == tex.components && sizeof(vertex) == tex.stride &&
+         col.data == pos.data + offsetof(vertex, col) && tex.data == pos.data + offsetof(vertex, tex) &&
+         col.count == pos.count && tex.count == pos.count;
+}
+
+
+
+// index ndx of an index accessor, whatever its component type
+static uint32_t readIndex(const glbAccessor& indices, size_t ndx)
+{
+  const uint8_t* p = indices.data + ndx * indices.stride;
+  if (COMPONENT_UNSIGNED_BYTE == indices.componentType) return p[0];
+
+  if (COMPONENT_UNSIGNED_SHORT == indices.componentType)
+  {
+    uint16_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : readPrimitive
+ *
+ * abstract  : Resolves the accessors of one mesh primitive.  Primitives that are not triangle lists or have no
+ *             positions are skipped (with a warning) rather than failing the whole file.  Triangles with an index past
+ *             the positions are counted in badTriangles, for indexData to drop.
+ *
+ * parameters: parse -- [in] the JSON and the resolved buffer views
+ *             object -- [in] the primitive's JSON
+ *             primitive -- [out] the resolved primitive
+ *
+ * returns   : bool, true if the primitive should be loaded
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+static bool readPrimitive(const glbParse& parse, const jsonValue* object, glbPrimitive* primitive)
+{
+  int mode = getInt(object, "mode", MODE_TRIANGLES);
+  if (MODE_TRIANGLES != mode)
+  {
+    std::cerr << "[?] skipping a glb primitive with mode " << mode << ", only triangle lists are supported" << std::endl;
+    return false;
+  }
+
+  const jsonValue* attributes = getMember(object, "attributes");
+  int position = getInt(attributes, "POSITION", -1);
+  if (position < 0)
+  {
+    std::cerr << "[?] skipping a glb primitive with no POSITION attribute" << std::endl;
+    return false;
+  }
+
+  primitive->position = readAccessor(parse, position);
+  if (COMPONENT_FLOAT != primitive->position.componentType || 3 != primitive->position.components)
+  {
+    throw std::runtime_error("glb: POSITION must be a float VEC3");
+  }
+
+  int color = getInt(attributes, "COLOR_0", -1);
+  if (color >= 0)
+  {
+    primitive->color = readAccessor(parse, color);
+    if (primitive->color.components < 3 || primitive->color.count != primitive->position.count ||
+        COMPONENT_UNSIGNED_INT == primitive->color.componentType)
+    {
+      throw std::runtime_error("glb: COLOR_0 does not match POSITION");
+    }
+  }
+
+  int texcoord = getInt(attributes, "TEXCOORD_0", -1);
+  if (texcoord >= 0)
+  {
+    primitive->texcoord = readAccessor(parse, texcoord);
+    if (2 != primitive->texcoord.components || primitive->texcoord.count != primitive->position.count ||
+        COMPONENT_UNSIGNED_INT == primitive->texcoord.componentType)
+    {
+      throw std::runtime_error("glb: TEXCOORD_0 does not match POSITION");
+    }
+  }
+
+  int indices = getInt(object, "indices", -1);
+  if (indices >= 0)
+  {
+    primitive->indices = readAccessor(parse, indices);
+    int type = primitive->indices.componentType;
+    if (1 != primitive->indices.components ||
+        (COMPONENT_UNSIGNED_BYTE != type && COMPONENT_UNSIGNED_SHORT != type && COMPONENT_UNSIGNED_INT != type))
+    {
+      throw std::runtime_error("glb: indices must be an unsigned SCALAR");
+    }
+
+    // a triangle with an index past the positions would have the GPU read outside the vertex buffer
+    for (size_t first = 0; first + 3 <= primitive->indices.count; first += 3)
+    {
+      if (readIndex(primitive->indices, first) >= primitive->position.count ||
+          readIndex(primitive->indices, first + 1) >= primitive->position.count ||
+          readIndex(primitive->indices, first + 2) >= primitive->position.count)
+      {
+        primitive->badTriangles++;
+      }
+    }
+  }
+
+  primitive->material = getInt(object, "material", -1);
+
+  if (matchesVertexLayout(*primitive)) primitive->interleaved = primitive->position.data;
+
+  return true;
+}
+
+
+
+glbLoader::glbLoader() { }
+
+glbLoader::~glbLoader()
+{
+  close();
+}
+
+void glbLoader::close()
+{
+  m_primitives.clear();
+  m_images.clear();
+  m_materialImages.clear();
+  m_file.close();
+}
+
+
+
+/************************************************************************************************************************
+ * function  : open
+ *
+ * abstract  : Maps a .glb file and resolves its meshes, images and materials.  Nothing is copied, the primitives and
+ *             images point into the mapping and stay valid until close (or the loader is destroyed).  Each node of the
+ *             default scene that has a mesh contributes that mesh's primitives, depth first in file order; a file
+ *             with no scenes contributes every mesh once.
+ *
+ * parameters: fileName -- [in] path of the .glb file
+ *
+ * returns   : void, throws std::runtime_error if the file is not a glb that can be read
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) reports the triangles dropped for indices out of range
+************************************************************************************************************************/
+void glbLoader::open(const std::string& fileName)
+{
+  close();
+  mapAsset(fileName, &m_file);
+
+  const uint8_t* file = m_file.data();
+  size_t         fileSize = m_file.size();
+
+  // 12 byte header, then chunks of { length, type, data } each padded to 4 bytes
+  if (fileSize < 20 || GLB_MAGIC != read32(file))
+  {
+    throw std::runtime_error(fileName + " is not a binary glTF file");
+  }
+  if (2 != read32(file + 4))
+  {
+    throw std::runtime_error(fileName + " is glTF version " + std::to_string(read32(file + 4)) + ", only 2 is supported");
+  }
+
+  size_t length = read32(file + 8);
+  if (length > fileSize) throw std::runtime_error(fileName + " is truncated");
+
+  const char*    json = nullptr;
+  size_t         jsonLength = 0;
+  const uint8_t* bin = nullptr;
+  size_t         binLength = 0;
+
+  size_t offset = 12;
+  while (offset + 8 <= length)
+  {
+    size_t   chunkLength = read32(file + offset);
+    uint32_t chunkType = read32(file + offset + 4);
+    offset += 8;
+
+    if (chunkLength > length - offset) throw std::runtime_error(fileName + " has a chunk that runs past the end of the file");
+
+    if (GLB_CHUNK_JSON == chunkType && nullptr == json)
+    {
+      json = reinterpret_cast<const char*>(file + offset);
+      jsonLength = chunkLength;
+    }
+    else if (GLB_CHUNK_BIN == chunkType && nullptr == bin)
+    {
+      bin = file + offset;
+      binLength = chunkLength;
+    }
+
+    // unknown chunks are skipped, as the spec requires
+    offset += (chunkLength + 3) & ~(size_t)3;
+  }
+
+  if (nullptr == json) throw std::runtime_error(fileName + " has no JSON chunk");
+
+  jsonValue root = jsonParser(json, jsonLength).parse();
+
+  glbParse parse;
+  parse.root = &root;
+
+  // only the GLB's own BIN chunk is supported as a buffer
+  const jsonValue* buffers = root.get("buffers");
+  if (nullptr != buffers)
+  {
+    for (size_t ndx = 0; ndx < buffers->items.size(); ndx++)
+    {
+      const jsonValue* buffer = &buffers->items[ndx];
+      if (ndx > 0 || nullptr != buffer->get("uri") || nullptr == bin)
+      {
+        throw std::runtime_error(fileName + " uses external buffers, only the embedded BIN chunk is supported");
+      }
+      if (getSize(buffer, "byteLength", 0) > binLength) throw std::runtime_error(fileName + " has a truncated BIN chunk");
+    }
+  }
+
+  const jsonValue* views = root.get("bufferViews");
+  if (nullptr != views)
+  {
+    for (const jsonValue& view : views->items)
+    {
+      size_t viewOffset = getSize(&view, "byteOffset", 0);
+      size_t viewLength = getSize(&view, "byteLength", 0);
+      if (0 != getInt(&view, "buffer", 0) || nullptr == bin || viewOffset > binLength || viewLength > binLength - viewOffset)
+      {
+        throw std::runtime_error(fileName + " has a buffer view outside the BIN chunk");
+      }
+
+      parse.views.push_back({ bin + viewOffset, viewLength, getSize(&view, "byteStride", 0) });
+    }
+  }
+
+  // images, embedded ones are left encoded for the image decoder
+  const jsonValue* images = root.get("images");
+  if (nullptr != images)
+  {
+    for (const jsonValue& object : images->items)
+    {
+      glbImage image;
+      image.mimeType = getString(&object, "mimeType");
+
+      int viewNdx = getInt(&object, "bufferView", -1);
+      std::string uri = getString(&object, "uri");
+      if (viewNdx >= 0 && viewNdx < (int)parse.views.size())
+      {
+        image.data = parse.views[viewNdx].data;
+        image.size = parse.views[viewNdx].length;
+      }
+      else if (0 == uri.compare(0, 5, "data:"))
+      {
+        std::cerr << "[?] " << fileName << " has a data: URI image, these are not supported" << std::endl;
+      }
+      else if (!uri.empty())
+      {
+        // only the file name is used, as MeshModel::LoadMaterials does
+        image.uri = uri.substr(uri.find_last_of("/\\") + 1);
+      }
+
+      m_images.push_back(image);
+    }
+  }
+
+  // material -> base colour image
+  const jsonValue* materials = root.get("materials");
+  if (nullptr != materials)
+  {
+    for (const jsonValue& material : materials->items)
+    {
+      const jsonValue* baseColor = getMember(getMember(&material, "pbrMetallicRoughness"), "baseColorTexture");
+      const jsonValue* texture = getElement(root, "textures", getInt(baseColor, "index", -1));
+      int image = getInt(texture, "source", -1);
+
+      m_materialImages.push_back((image >= 0 && image < (int)m_images.size()) ? image : -1);
+    }
+  }
+
+  // meshes in node order (an explicit stack rather than recursion, and a guard against cyclic node graphs)
+  std::vector<int> meshOrder;
+  const jsonValue* scene = getElement(root, "scenes", getInt(&root, "scene", 0));
+  if (nullptr != scene)
+  {
+    const jsonValue* nodes = root.get("nodes");
+    size_t nodeCount = (nullptr != nodes) ? nodes->items.size() : 0;
+    std::vector<bool> visited(nodeCount, false);
+    std::vector<int>  stack;
+
+    const jsonValue* sceneNodes = scene->get("nodes");
+    if (nullptr != sceneNodes)
+    {
+      for (size_t ndx = sceneNodes->items.size(); ndx > 0; ndx--) stack.push_back((int)sceneNodes->items[ndx - 1].number);
+    }
+
+    while (!stack.empty())
+    {
+      int nodeNdx = stack.back();
+      stack.pop_back();
+      if (nodeNdx < 0 || nodeNdx >= (int)nodeCount || visited[nodeNdx]) continue;
+      visited[nodeNdx] = true;
+
+      const jsonValue* node = &nodes->items[nodeNdx];
+      int meshNdx = getInt(node, "mesh", -1);
+      if (meshNdx >= 0) meshOrder.push_back(meshNdx);
+
+      const jsonValue* children = node->get("children");
+      if (nullptr != children)
+      {
+        for (size_t ndx = children->items.size(); ndx > 0; ndx--) stack.push_back((int)children->items[ndx - 1].number);
+      }
+    }
+  }
+  else if (nullptr != root.get("meshes"))
+  {
+    for (size_t ndx = 0; ndx < root.get("meshes")->items.size(); ndx++) meshOrder.push_back((int)ndx);
+  }
+
+  size_t badTriangles = 0;
+  for (int meshNdx : meshOrder)
+  {
+    const jsonValue* primitives = getMember(getElement(root, "meshes", meshNdx), "primitives");
+    if (nullptr == primitives) continue;
+
+    for (const jsonValue& object : primitives->items)
+    {
+      glbPrimitive primitive;
+      if (readPrimitive(parse, &object, &primitive))
+      {
+        m_primitives.push_back(primitive);
+        badTriangles += primitive.badTriangles;
+      }
+    }
+  }
+
+  if (badTriangles > 0)
+  {
+    std::cerr << "[?] " << fileName << ": dropped " << badTriangles << " triangles with indices out of range" << std::endl;
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : vertexData
+ *
+ * abstract  : Returns the primitive's vertices in the 'vertex' layout.  When the file already has that layout this is
+ *             a pointer into the mapping (to be memcpy'd into the staging buffer), otherwise the attributes are
+ *             gathered into scratch.
+ *
+ * parameters: primitive -- [in] a primitive returned by getPrimitives
+ *             scratch -- [in/out] used when the vertices have to be converted
+ *
+ * returns   : const void*, vertexCount(primitive) vertices, not necessarily aligned
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+const void* glbLoader::vertexData(const glbPrimitive& primitive, std::vector<vertex>* scratch)
+{
+  if (nullptr != primitive.interleaved) return primitive.interleaved;
+
+  const glbAccessor& pos = primitive.position;
+  const glbAccessor& col = primitive.color;
+  const glbAccessor& tex = primitive.texcoord;
+
+  scratch->resize(pos.count);
+  for (size_t ndx = 0; ndx < pos.count; ndx++)
+  {
+    vertex& v = (*scratch)[ndx];
+
+    memcpy(&v.pos, pos.data + ndx * pos.stride, sizeof(v.pos));
+
+    if (nullptr != col.data)
+    {
+      const uint8_t* p = col.data + ndx * col.stride;
+      size_t size = componentSize(col.componentType);
+      v.col = { readComponent(p, col.componentType, col.normalized), readComponent(p + size, col.componentType, col.normalized),
+                readComponent(p + 2 * size, col.componentType, col.normalized) };
+    }
+    else
+    {
+      v.col = { 1.0f, 1.0f, 1.0f };
+    }
+
+    if (nullptr != tex.data)
+    {
+      const uint8_t* p = tex.data + ndx * tex.stride;
+      v.tex = { readComponent(p, tex.componentType, tex.normalized),
+                readComponent(p + componentSize(tex.componentType), tex.componentType, tex.normalized) };
+    }
+    else
+    {
+      v.tex = { 0.0f, 0.0f };
+    }
+  }
+
+  return scratch->data();
+}
+
+
+
+// 32 bit indices straight from the mapping when possible, otherwise widened (or generated) into scratch, less any
+// triangles with an index out of range and a trailing partial triangle
+const void* glbLoader::indexData(const glbPrimitive& primitive, std::vector<uint32_t>* scratch)
+{
+  const glbAccessor& indices = primitive.indices;
+
+  if (nullptr == indices.data)
+  {
+    scratch->resize(primitive.position.count);
+    for (size_t ndx = 0; ndx < scratch->size(); ndx++) (*scratch)[ndx] = (uint32_t)ndx;
+    return scratch->data();
+  }
+
+  if (COMPONENT_UNSIGNED_INT == indices.componentType && sizeof(uint32_t) == indices.stride && 0 == primitive.badTriangles &&
+      0 == indices.count % 3)
+  {
+    return indices.data;
+  }
+
+  scratch->resize(indexCount(primitive));
+  size_t kept = 0;
+  for (size_t first = 0; first + 3 <= indices.count; first += 3)
+  {
+    uint32_t triangle[3] = { readIndex(indices, first), readIndex(indices, first + 1), readIndex(indices, first + 2) };
+    if (triangle[0] >= primitive.position.count || triangle[1] >= primitive.position.count || triangle[2] >= primitive.position.count)
+    {
+      continue;
+    }
+
+    memcpy(&(*scratch)[kept], triangle, sizeof(triangle));
+    kept += 3;
+  }
+
+  return scratch->data();
+}
+
+size_t glbLoader::indexCount(const glbPrimitive& primitive)
+{
+  if (nullptr == primitive.indices.data) return primitive.position.count;
+
+  return 3 * (primitive.indices.count / 3 - primitive.badTriangles);
+}
+
+
+
+// appends the meshes referenced by node and its children (depth first, the order MeshModel::loadNode uses)
+static void collectMeshes(const aiNode* node, std::vector<unsigned int>* meshes)
+{
+  for (unsigned int ndx = 0; ndx < node->mNumMeshes; ndx++) meshes->push_back(node->mMeshes[ndx]);
+  for (unsigned int ndx = 0; ndx < node->mNumChildren; ndx++) collectMeshes(node->mChildren[ndx], meshes);
+}
+
+// appends data to the BIN chunk (padded to 4 bytes) and describes it as a buffer view, returns the view's index
+static int appendView(std::vector<uint8_t>* bin, std::vector<std::string>* views, const void* data, size_t size, size_t stride, int target)
+{
+  size_t offset = bin->size();
+  bin->insert(bin->end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+  bin->resize((bin->size() + 3) & ~(size_t)3, 0);
+
+  std::ostringstream view;
+  view << "{\"buffer\":0,\"byteOffset\":" << offset << ",\"byteLength\":" << size;
+  if (stride > 0) view << ",\"byteStride\":" << stride;
+  if (target > 0) view << ",\"target\":" << target;
+  view << "}";
+
+  views->push_back(view.str());
+  return (int)views->size() - 1;
+}
+
+static std::string joinJson(const std::vector<std::string>& items)
+{
+  std::string result = "[";
+  for (size_t ndx = 0; ndx < items.size(); ndx++)
+  {
+    if (ndx > 0) result += ",";
+    result += items[ndx];
+  }
+  return result + "]";
+}
+
+// escapes a string for a JSON string literal
+static std::string jsonString(const std::string& text)
+{
+  std::string result = "\"";
+  for (char c : text)
+  {
+    if ('"' == c || '\\' == c) { result += '\\'; result += c; }
+    else if ((unsigned char)c < 0x20) { char buffer[8]; snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned)c); result += buffer; }
+    else result += c;
+  }
+  return result + "\"";
+}
+
+
+
+/************************************************************************************************************************
+ * function  : convert
+ *
+ * abstract  : Loads a model through Assimp exactly as vkContext::createMeshModel does (same post processing, the
+ *             vertices built as MeshModel::loadMesh builds them) and writes it as a .glb the loader can memcpy.  Each
+ *             mesh's vertices go into one buffer view with the 'vertex' layout (POSITION, COLOR_0 and TEXCOORD_0
+ *             accessors at offsets 0, 12 and 24, stride 32) and its indices into another as UNSIGNED_INT.  UVs are
+ *             already flipped by aiProcess_FlipUVs, which is also glTF's convention.  Diffuse textures are read from
+ *             ./Textures/ and embedded as they are; glTF only defines PNG and JPEG, other formats (the TGAs) are
+ *             given an image/x-<ext> mime type, fine for stb_image which looks at the content but not for every
+ *             other viewer.  Faces that are not triangles after aiProcess_Triangulate (points, lines) are dropped.
+ *
+ * parameters: modelFile -- [in] any file Assimp can read
+ *             glbFile -- [in] file to write
+ *
+ * returns   : void, throws std::runtime_error if the model can not be read or the output written
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void glbLoader::convert(const std::string& modelFile, const std::string& glbFile)
+{
+  Assimp::Importer importer;
+  const aiScene* scene = importer.ReadFile(modelFile, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
+  if (!scene)
+  {
+    throw std::runtime_error("Failed to load model! (" + modelFile + ")");
+  }
+
+  std::vector<uint8_t>     bin;
+  std::vector<std::string> views;
+  std::vector<std::string> accessors;
+  std::vector<std::string> meshes;
+  std::vector<std::string> nodes;
+  std::vector<std::string> materials;
+  std::vector<std::string> textures;
+  std::vector<std::string> images;
+
+  // materials, one per Assimp material so mMaterialIndex carries over, sharing an image per texture file
+  std::vector<std::string>   textureNames = MeshModel::LoadMaterials(scene);
+  std::map<std::string, int> textureIndex;
+  for (const std::string& name : textureNames)
+  {
+    if (!name.empty() && 0 == textureIndex.count(name))
+    {
+      std::vector<char> bytes;
+      try
+      {
+        bytes = readAsset("./Textures/" + name);
+      }
+      catch (const std::exception&) { }
+      if (bytes.empty())
+      {
+        std::cerr << "[?] could not read ./Textures/" << name << ", the material will use the default texture" << std::endl;
+        textureIndex[name] = -1;
+        continue;
+      }
+
+      std::string extension = name.substr(name.find_last_of('.') + 1);
+      std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+      std::string mimeType = ("png" == extension) ? "image/png" : ("jpg" == extension || "jpeg" == extension) ? "image/jpeg" : "image/x-" + extension;
+
+      int view = appendView(&bin, &views, bytes.data(), bytes.size(), 0, 0);
+      images.push_back("{\"bufferView\":" + std::to_string(view) + ",\"mimeType\":" + jsonString(mimeType) + ",\"name\":" + jsonString(name) + "}");
+      textures.push_back("{\"source\":" + std::to_string(images.size() - 1) + "}");
+      textureIndex[name] = (int)textures.size() - 1;
+    }
+
+    int texture = name.empty() ? -1 : textureIndex[name];
+    if (texture >= 0) materials.push_back("{\"pbrMetallicRoughness\":{\"baseColorTexture\":{\"index\":" + std::to_string(texture) + "}}}");
+    else              materials.push_back("{}");
+  }
+
+  // meshes, written once each however many nodes use them, a node per use so the loader sees the same order
+  std::vector<unsigned int> meshOrder;
+  collectMeshes(scene->mRootNode, &meshOrder);
+
+  std::vector<int> meshIndex(scene->mNumMeshes, -2);         // -2 not written yet, -1 empty
+  std::vector<vertex>   vertices;
+  std::vector<uint32_t> indices;
+
+  for (unsigned int aiNdx : meshOrder)
+  {
+    if (-2 == meshIndex[aiNdx])
+    {
+      const aiMesh* source = scene->mMeshes[aiNdx];
+
+      vertices.resize(source->mNumVertices);
+      glm::vec3 minPos(0.0f), maxPos(0.0f);
+      for (unsigned int ndx = 0; ndx < source->mNumVertices; ndx++)
+      {
+        vertices[ndx].pos = { source->mVertices[ndx].x, source->mVertices[ndx].y, source->mVertices[ndx].z };
+        vertices[ndx].col = { 1.0f, 1.0f, 1.0f };
+        if (source->mTextureCoords[0]) vertices[ndx].tex = { source->mTextureCoords[0][ndx].x, source->mTextureCoords[0][ndx].y };
+        else                           vertices[ndx].tex = { 0.0f, 0.0f };
+
+        minPos = (0 == ndx) ? vertices[ndx].pos : glm::min(minPos, vertices[ndx].pos);
+        maxPos = (0 == ndx) ? vertices[ndx].pos : glm::max(maxPos, vertices[ndx].pos);
+      }
+
+      indices.clear();
+      for (unsigned int ndx = 0; ndx < source->mNumFaces; ndx++)
+      {
+        const aiFace& face = source->mFaces[ndx];
+        if (3 == face.mNumIndices) indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+      }
+
+      if (vertices.empty() || indices.empty())
+      {
+        meshIndex[aiNdx] = -1;
+        continue;
+      }
+
+      int vertexView = appendView(&bin, &views, vertices.data(), vertices.size() * sizeof(vertex), sizeof(vertex), TARGET_ARRAY_BUFFER);
+      int indexView = appendView(&bin, &views, indices.data(), indices.size() * sizeof(uint32_t), 0, TARGET_ELEMENT_ARRAY_BUFFER);
+
+      std::ostringstream bounds;
+      bounds << std::setprecision(9) << ",\"min\":[" << minPos.x << "," << minPos.y << "," << minPos.z << "],\"max\":["
+             << maxPos.x << "," << maxPos.y << "," << maxPos.z << "]";
+
+      std::string count = std::to_string(vertices.size());
+      int first = (int)accessors.size();
+      accessors.push_back("{\"bufferView\":" + std::to_string(vertexView) + ",\"byteOffset\":0,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC3\"" + bounds.str() + "}");
+      accessors.push_back("{\"bufferView\":" + std::to_string(vertexView) + ",\"byteOffset\":12,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC3\"}");
+      accessors.push_back("{\"bufferView\":" + std::to_string(vertexView) + ",\"byteOffset\":24,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC2\"}");
+      accessors.push_back("{\"bufferView\":" + std::to_string(indexView) + ",\"componentType\":5125,\"count\":" + std::to_string(indices.size()) + ",\"type\":\"SCALAR\"}");
+
+      std::ostringstream primitive;
+      primitive << "{\"primitives\":[{\"attributes\":{\"POSITION\":" << first << ",\"COLOR_0\":" << first + 1 << ",\"TEXCOORD_0\":"
+                << first + 2 << "},\"indices\":" << first + 3 << ",\"material\":" << source->mMaterialIndex << "}]}";
+      meshes.push_back(primitive.str());
+
+      meshIndex[aiNdx] = (int)meshes.size() - 1;
+    }
+
+    if (meshIndex[aiNdx] >= 0) nodes.push_back("{\"mesh\":" + std::to_string(meshIndex[aiNdx]) + "}");
+  }
+
+  std::vector<std::string> sceneNodes;
+  for (size_t ndx = 0; ndx < nodes.size(); ndx++) sceneNodes.push_back(std::to_string(ndx));
+
+  std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"vulkan7 glbLoader::convert\"},\"scene\":0,\"scenes\":[{\"nodes\":" +
+                     joinJson(sceneNodes) + "}],\"nodes\":" + joinJson(nodes) + ",\"meshes\":" + joinJson(meshes) +
+                     ",\"materials\":" + joinJson(materials) + ",\"accessors\":" + joinJson(accessors) +
+                     ",\"bufferViews\":" + joinJson(views);
+  if (!textures.empty()) json += ",\"textures\":" + joinJson(textures) + ",\"images\":" + joinJson(images);
+  if (!bin.empty()) json += ",\"buffers\":[{\"byteLength\":" + std::to_string(bin.size()) + "}]";
+  json += "}";
+  json.resize((json.size() + 3) & ~(size_t)3, ' ');
+
+  uint64_t total = 12 + 8 + json.size() + (bin.empty() ? 0 : 8 + bin.size());
+  if (total > UINT32_MAX) throw std::runtime_error(modelFile + " is too big for a glb");
+
+  std::ofstream file(glbFile, std::ios::binary);
+  if (!file) throw std::runtime_error("failed to create " + glbFile);
+
+  write32(file, GLB_MAGIC);
+  write32(file, 2);
+  write32(file, (uint32_t)total);
+  write32(file, (uint32_t)json.size());
+  write32(file, GLB_CHUNK_JSON);
+  file.write(json.data(), json.size());
+  if (!bin.empty())
+  {
+    write32(file, (uint32_t)bin.size());
+    write32(file, GLB_CHUNK_BIN);
+    file.write(reinterpret_cast<const char*>(bin.data()), bin.size());
+  }
+
+  if (!file) throw std::runtime_error("failed to write " + glbFile);
+
+  std::cerr << "[+] wrote " << glbFile << " (" << meshes.size() << " meshes, " << images.size() << " images, "
+            << total / 1024 << " KB)" << std::endl;
+}
@@ -0,0 +1,77 @@
+#ifndef _glbLoader_h_
+#define _glbLoader_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utilities.h"
+#include "mappedFile.h"
+
+// a strided view of one accessor inside the mapped file
+struct glbAccessor
+{
+  const uint8_t* data = nullptr;       // first element, nullptr if the primitive does not have the attribute
+  size_t         count = 0;
+  size_t         stride = 0;           // bytes from one element to the next
+  int            componentType = 0;    // GL enum, 5121 UNSIGNED_BYTE, 5123 UNSIGNED_SHORT, 5125 UNSIGNED_INT, 5126 FLOAT
+  int            components = 0;       // 1 SCALAR, 2 VEC2, 3 VEC3, 4 VEC4
+  bool           normalized = false;
+};
+
+// one triangle list, becomes one mesh
+struct glbPrimitive
+{
+  glbAccessor    position;
+  glbAccessor    color;                // COLOR_0, white if not present (as the Assimp path)
+  glbAccessor    texcoord;             // TEXCOORD_0
+  glbAccessor    indices;              // not present => 0 .. n-1
+  size_t         badTriangles = 0;     // triangles with an index past the positions, dropped by indexData
+  int            material = -1;
+  const uint8_t* interleaved = nullptr;   // set when the attributes are already laid out exactly as 'vertex'
+};
+
+// an image, either embedded (encoded PNG/JPEG bytes in the BIN chunk) or referenced by file name
+struct glbImage
+{
+  const uint8_t* data = nullptr;
+  size_t         size = 0;
+  std::string    mimeType;
+  std::string    uri;                  // external file, looked for in ./Textures/ like the Assimp path
+};
+
+// Reads binary glTF 2.0 (.glb) files without going through Assimp.  The file is memory mapped and the accessors point
+// straight into the BIN chunk, so when a mesh's vertex buffer view already has the 'vertex' layout (as written by
+// convert) it is memcpy'd from the mapping into the staging buffer with no per-vertex loop.  Node transforms are
+// ignored and each node's mesh is loaded in scene order, as the Assimp path does.  Sparse accessors, external or
+// data: URI buffers and primitives other than triangle lists are not supported.  Triangles with an index past the end
+// of the positions are counted when the file is opened and left out of indexData, so they never reach the GPU.
+class glbLoader
+{
+public:
+  glbLoader();
+  ~glbLoader();
+
+  void open(const std::string& fileName);            // throws std::runtime_error on anything it can not read
+  void close();
+
+  const std::vector<glbPrimitive>& getPrimitives() const { return m_primitives; }
+  const std::vector<glbImage>&     getImages() const { return m_images; }
+  const std::vector<int>&          getMaterialImages() const { return m_materialImages; }   // -1 => no base colour texture
+
+  static const void* vertexData(const glbPrimitive& primitive, std::vector<vertex>* scratch);
+  static const void* indexData(const glbPrimitive& primitive, std::vector<uint32_t>* scratch);
+  static size_t      vertexCount(const glbPrimitive& primitive) { return primitive.position.count; }
+  static size_t      indexCount(const glbPrimitive& primitive);
+
+  static void convert(const std::string& modelFile, const std::string& glbFile);         // any Assimp format -> .glb
+
+private:
+  mappedFile                 m_file;
+  std::vector<glbPrimitive>  m_primitives;
+  std::vector<glbImage>      m_images;
+  std::vector<int>           m_materialImages;
+};
+
+#endif
@@ -0,0 +1,280 @@
+#include "gpuMemoryTracker.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  struct allocation
+  {
+    VkDeviceSize      size;
+    uint32_t          memoryType;
+    uint32_t          heap;
+    deviceMemoryTag   tag;
+    deviceMemoryOwner owner;
+  };
+
+  // buffers and images are made from the job system's workers as well as the main thread (see vkContext::initContext)
+  struct tracker
+  {
+    std::mutex                                     lock;
+    std::unordered_map<VkDeviceMemory, allocation> live;
+    uint64_t                                       bytes = 0;
+    uint64_t                                       peakBytes = 0;
+    uint64_t                                       totalAllocations = 0;
+    uint64_t                                       heapBytes[VK_MAX_MEMORY_HEAPS] = {};
+    uint64_t                                       heapPeakBytes[VK_MAX_MEMORY_HEAPS] = {};
+  };
+
+  tracker& getTracker()
+  {
+    static tracker t;
+    return t;
+  }
+
+  double toMB(uint64_t bytes) { return (double)bytes / (1024.0 * 1024.0); }
+
+  // e.g. "model 3", "texture 12", "-"
+  std::ostream& operator<<(std::ostream& os, const deviceMemoryOwner& owner)
+  {
+    switch (owner.kind)
+    {
+      case OWNER_MODEL:   return os << "model " << owner.id;
+      case OWNER_TEXTURE: return os << "texture " << owner.id;
+      default:            return os << "-";
+    }
+  }
+}
+
+
+
+const char* deviceMemoryTagName(deviceMemoryTag tag)
+{
+  switch (tag)
+  {
+    case MEMORY_VERTEX:     return "vertex";
+    case MEMORY_INDEX:      return "index";
+    case MEMORY_TEXTURE:    return "texture";
+    case MEMORY_STAGING:    return "staging";
+    case MEMORY_ATTACHMENT: return "attachment";
+    case MEMORY_UNIFORM:    return "uniform";
+    case MEMORY_STORAGE:    return "storage";
+    default:                return "other";
+  }
+}
+
+
+
+// a buffer that is only ever copied from is staging, otherwise the first of vertex, index, uniform and storage it is
+deviceMemoryTag bufferMemoryTag(VkBufferUsageFlags usage)
+{
+  if (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)   return MEMORY_VERTEX;
+  if (usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)    return MEMORY_INDEX;
+  if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)  return MEMORY_UNIFORM;
+  if (usage & (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT)) return MEMORY_STORAGE;
+  if (VK_BUFFER_USAGE_TRANSFER_SRC_BIT == usage)   return MEMORY_STAGING;
+  return MEMORY_OTHER;
+}
+
+
+
+deviceMemoryTag imageMemoryTag(VkImageUsageFlags usage)
+{
+  if (usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT))
+  {
+    return MEMORY_ATTACHMENT;
+  }
+  if (usage & VK_IMAGE_USAGE_SAMPLED_BIT) return MEMORY_TEXTURE;
+  return MEMORY_OTHER;
+}
+
+
+
+void trackDeviceMemory(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryType, uint32_t heap, deviceMemoryTag tag)
+{
+  tracker& t = getTracker();
+  std::lock_guard<std::mutex> guard(t.lock);
+
+  heap = std::min<uint32_t>(heap, VK_MAX_MEMORY_HEAPS - 1);
+  t.live[memory] = { size, memoryType, heap, tag, deviceMemoryOwner() };
+  t.totalAllocations++;
+
+  t.bytes += size;
+  t.peakBytes = std::max(t.peakBytes, t.bytes);
+  t.heapBytes[heap] += size;
+  t.heapPeakBytes[heap] = std::max(t.heapPeakBytes[heap], t.heapBytes[heap]);
+}
+
+
+
+void untrackDeviceMemory(VkDeviceMemory memory)
+{
+  tracker& t = getTracker();
+  std::lock_guard<std::mutex> guard(t.lock);
+
+  auto found = t.live.find(memory);
+  if (t.live.end() == found) return;
+
+  t.bytes -= found->second.size;
+  t.heapBytes[found->second.heap] -= found->second.size;
+  t.live.erase(found);
+}
+
+
+
+void setDeviceMemoryOwner(VkDeviceMemory memory, deviceMemoryOwner owner)
+{
+  tracker& t = getTracker();
+  std::lock_guard<std::mutex> guard(t.lock);
+
+  auto found = t.live.find(memory);
+  if (t.live.end() != found) found->second.owner = owner;
+}
+
+
+
+// the live totals only; unlike getDeviceMemoryReport this does not allocate, the HUD calls it every frame
+void getDeviceMemoryInUse(uint64_t* bytes, uint32_t* allocations)
+{
+  tracker& t = getTracker();
+  std::lock_guard<std::mutex> guard(t.lock);
+
+  *bytes = t.bytes;
+  *allocations = static_cast<uint32_t>(t.live.size());
+}
+
+
+
+/************************************************************************************************************************
+ * function  : getDeviceMemoryReport
+ *
+ * abstract  : Totals the live allocations by heap, by tag and by owner.  The live and peak totals are kept as memory
+ *             is allocated and freed, the rest is added up here from the allocations, so this is for reports (a few
+ *             hundred allocations at most in this program) rather than every frame.
+ *
+ * parameters: none
+ *
+ * returns   : deviceMemoryReport
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+deviceMemoryReport getDeviceMemoryReport()
+{
+  tracker& t = getTracker();
+  std::lock_guard<std::mutex> guard(t.lock);
+
+  deviceMemoryReport report;
+  report.bytes = t.bytes;
+  report.peakBytes = t.peakBytes;
+  report.allocations = static_cast<uint32_t>(t.live.size());
+  report.totalAllocations = t.totalAllocations;
+  std::copy(t.heapBytes, t.heapBytes + VK_MAX_MEMORY_HEAPS, report.heapBytes);
+  std::copy(t.heapPeakBytes, t.heapPeakBytes + VK_MAX_MEMORY_HEAPS, report.heapPeakBytes);
+
+  std::map<std::pair<int, uint32_t>, deviceMemoryOwnerTotal> owners;
+  for (const auto& entry : t.live)
+  {
+    const allocation& a = entry.second;
+    report.heapAllocations[a.heap]++;
+    report.tagBytes[a.tag] += a.size;
+    report.tagAllocations[a.tag]++;
+
+    if (OWNER_NONE == a.owner.kind) continue;
+    deviceMemoryOwnerTotal& total = owners[std::make_pair((int)a.owner.kind, a.owner.id)];
+    total.owner = a.owner;
+    total.bytes += a.size;
+    total.allocations++;
+  }
+
+  for (const auto& entry : owners) report.owners.push_back(entry.second);
+  std::stable_sort(report.owners.begin(), report.owners.end(),
+    [](const deviceMemoryOwnerTotal& a, const deviceMemoryOwnerTotal& b) { return a.bytes > b.bytes; });
+
+  return report;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : writeDeviceMemoryReport
+ *
+ * abstract  : Writes a report as a few lines; the totals, one line per heap that has been used, the tags that have
+ *             memory and the ten largest owners.
+ *
+ * parameters: os -- [in] stream to write to
+ *             report -- [in] as returned by getDeviceMemoryReport
+ *             properties -- [in] the device's memory properties, for each heap's size and flags; may be nullptr
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void writeDeviceMemoryReport(std::ostream& os, const deviceMemoryReport& report, const VkPhysicalDeviceMemoryProperties* properties)
+{
+  const size_t ownerLines = 10;
+
+  std::ios::fmtflags flags = os.flags();
+  os << std::fixed << std::setprecision(1);
+
+  os << "[?] device memory: " << toMB(report.bytes) << " MB in " << report.allocations << " allocations, peak "
+     << toMB(report.peakBytes) << " MB, " << report.totalAllocations << " allocations made" << std::endl;
+
+  for (uint32_t heap = 0; heap < VK_MAX_MEMORY_HEAPS; heap++)
+  {
+    if (0 == report.heapPeakBytes[heap]) continue;
+
+    os << "[?]   heap " << heap << ": " << toMB(report.heapBytes[heap]) << " MB in " << report.heapAllocations[heap]
+       << " allocations, peak " << toMB(report.heapPeakBytes[heap]) << " MB";
+    if (nullptr != properties && heap < properties->memoryHeapCount)
+    {
+      os << " of " << toMB(properties->memoryHeaps[heap].size) << " MB"
+         << ((properties->memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? " (device local)" : " (host)");
+    }
+    os << std::endl;
+  }
+
+  const char* separator = " ";
+  os << "[?]   by use:";
+  for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++)
+  {
+    if (0 == report.tagAllocations[tag]) continue;
+    os << separator << deviceMemoryTagName((deviceMemoryTag)tag) << " " << toMB(report.tagBytes[tag]) << " MB ("
+       << report.tagAllocations[tag] << ")";
+    separator = ", ";
+  }
+  os << std::endl;
+
+  if (!report.owners.empty())
+  {
+    os << "[?]   largest owners:";
+    for (size_t ndx = 0; ndx < std::min(report.owners.size(), ownerLines); ndx++)
+    {
+      const deviceMemoryOwnerTotal& total = report.owners[ndx];
+      os << (ndx ? ", " : " ") << total.owner << " " << toMB(total.bytes) << " MB (" << total.allocations << ")";
+    }
+    os << std::endl;
+  }
+
+  os.flags(flags);
+}
+
+
+
+// meant to be called just before the device is destroyed, when everything should have been freed
+size_t reportDeviceMemoryLeaks(std::ostream& os)
+{
+  tracker& t = getTracker();
+  std::lock_guard<std::mutex> guard(t.lock);
+
+  for (const auto& entry : t.live)
+  {
+    const allocation& a = entry.second;
+    os << "[-] device memory not freed: " << a.size << " bytes, " << deviceMemoryTagName(a.tag) << ", heap " << a.heap
+       << ", type " << a.memoryType << ", owner " << a.owner << std::endl;
+  }
+
+  return t.live.size();
+}
@@ -0,0 +1,74 @@
+#ifndef _gpuMemoryTracker_h_
+#define _gpuMemoryTracker_h_
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Device memory accounting.  Every vkAllocateMemory goes through createBuffer or allocateDeviceMemory (utilities.h),
+// which record the allocation here with its size, memory type, heap and what it is for; freeDeviceMemory removes it.
+// The model or texture that owns an allocation is filled in once it is known (the meshes of a model are made before
+// the model has a handle).  Unlike allocTracker, which replaces operator new in debug builds, this is always on; it
+// is a map insert per vkAllocateMemory, which is nothing next to the call itself.
+
+enum deviceMemoryTag
+{
+  MEMORY_VERTEX,
+  MEMORY_INDEX,
+  MEMORY_TEXTURE,
+  MEMORY_STAGING,
+  MEMORY_ATTACHMENT,
+  MEMORY_UNIFORM,
+  MEMORY_STORAGE,                     // meshlet and cull buffers
+  MEMORY_OTHER,
+  MEMORY_TAG_COUNT
+};
+
+enum deviceMemoryOwnerKind { OWNER_NONE, OWNER_MODEL, OWNER_TEXTURE };
+
+struct deviceMemoryOwner
+{
+  deviceMemoryOwnerKind kind = OWNER_NONE;
+  uint32_t              id = 0;       // index of the model's or texture's handle
+};
+
+struct deviceMemoryOwnerTotal
+{
+  deviceMemoryOwner owner;
+  uint64_t          bytes = 0;
+  uint32_t          allocations = 0;
+};
+
+struct deviceMemoryReport
+{
+  uint64_t bytes = 0;                                   // live
+  uint64_t peakBytes = 0;
+  uint32_t allocations = 0;                             // live
+  uint64_t totalAllocations = 0;                        // made since the start
+  uint64_t heapBytes[VK_MAX_MEMORY_HEAPS] = {};
+  uint64_t heapPeakBytes[VK_MAX_MEMORY_HEAPS] = {};
+  uint32_t heapAllocations[VK_MAX_MEMORY_HEAPS] = {};
+  uint64_t tagBytes[MEMORY_TAG_COUNT] = {};
+  uint32_t tagAllocations[MEMORY_TAG_COUNT] = {};
+  std::vector<deviceMemoryOwnerTotal> owners;           // largest first, allocations with no owner are left out
+};
+
+const char*     deviceMemoryTagName(deviceMemoryTag tag);
+deviceMemoryTag bufferMemoryTag(VkBufferUsageFlags usage);      // what a buffer is for, from its usage flags
+deviceMemoryTag imageMemoryTag(VkImageUsageFlags usage);
+
+void trackDeviceMemory(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryType, uint32_t heap, deviceMemoryTag tag);
+void untrackDeviceMemory(VkDeviceMemory memory);
+void setDeviceMemoryOwner(VkDeviceMemory memory, deviceMemoryOwner owner);
+
+void               getDeviceMemoryInUse(uint64_t* bytes, uint32_t* allocations);     // cheap enough for every frame
+deviceMemoryReport getDeviceMemoryReport();
+void               writeDeviceMemoryReport(std::ostream& os, const deviceMemoryReport& report,
+                                           const VkPhysicalDeviceMemoryProperties* properties = nullptr);
+size_t             reportDeviceMemoryLeaks(std::ostream& os);   // a line per live allocation, returns how many
+
+#endif
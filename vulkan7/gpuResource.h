@@ -0,0 +1,113 @@
+#ifndef _gpuResource_h_
+#define _gpuResource_h_
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <utility>
+
+#include "utilities.h"
+
+// Owning wrappers for the Vulkan objects that a mesh or texture holds.  Each destroys what it owns when it goes (or on
+// reset), and can be moved but not copied, so a buffer has exactly one owner and containers of them never duplicate a
+// handle.  The device has to outlive them; the context empties everything that holds one in cleanupContext, before it
+// destroys the device.
+
+// a buffer and the memory bound to it, as made by createBuffer
+class gpuBuffer
+{
+public:
+  gpuBuffer() = default;
+  gpuBuffer(VkDevice device, VkBuffer buffer, VkDeviceMemory memory) : m_buffer(buffer), m_memory(memory), m_device(device) { }
+  ~gpuBuffer() { reset(); }
+
+  gpuBuffer(const gpuBuffer&) = delete;
+  gpuBuffer& operator=(const gpuBuffer&) = delete;
+
+  gpuBuffer(gpuBuffer&& other) noexcept
+    : m_buffer(std::exchange(other.m_buffer, VK_NULL_HANDLE)), m_memory(std::exchange(other.m_memory, VK_NULL_HANDLE)),
+      m_device(other.m_device) { }
+
+  gpuBuffer& operator=(gpuBuffer&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      m_buffer = std::exchange(other.m_buffer, VK_NULL_HANDLE);
+      m_memory = std::exchange(other.m_memory, VK_NULL_HANDLE);
+      m_device = other.m_device;
+    }
+    return *this;
+  }
+
+  VkBuffer       get() const { return m_buffer; }
+  VkDeviceMemory getMemory() const { return m_memory; }
+  bool           empty() const { return VK_NULL_HANDLE == m_buffer; }
+  void           setOwner(deviceMemoryOwner owner) const { setDeviceMemoryOwner(m_memory, owner); }     // for the memory report
+
+  void reset()                                       // destroys the buffer now, the GPU must be done with it
+  {
+    if (VK_NULL_HANDLE != m_buffer) vkDestroyBuffer(m_device, m_buffer, nullptr);
+    freeDeviceMemory(m_device, m_memory);
+    m_buffer = VK_NULL_HANDLE;
+    m_memory = VK_NULL_HANDLE;
+  }
+
+private:
+  VkBuffer       m_buffer = VK_NULL_HANDLE;          // first, it is what the draw loop reads
+  VkDeviceMemory m_memory = VK_NULL_HANDLE;
+  VkDevice       m_device = VK_NULL_HANDLE;
+};
+
+// an image, its memory and a view of it
+class gpuImage
+{
+public:
+  gpuImage() = default;
+  gpuImage(VkDevice device, VkImage image, VkDeviceMemory memory, VkImageView view)
+    : m_image(image), m_memory(memory), m_view(view), m_device(device) { }
+  ~gpuImage() { reset(); }
+
+  gpuImage(const gpuImage&) = delete;
+  gpuImage& operator=(const gpuImage&) = delete;
+
+  gpuImage(gpuImage&& other) noexcept
+    : m_image(std::exchange(other.m_image, VK_NULL_HANDLE)), m_memory(std::exchange(other.m_memory, VK_NULL_HANDLE)),
+      m_view(std::exchange(other.m_view, VK_NULL_HANDLE)), m_device(other.m_device) { }
+
+  gpuImage& operator=(gpuImage&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      m_image = std::exchange(other.m_image, VK_NULL_HANDLE);
+      m_memory = std::exchange(other.m_memory, VK_NULL_HANDLE);
+      m_view = std::exchange(other.m_view, VK_NULL_HANDLE);
+      m_device = other.m_device;
+    }
+    return *this;
+  }
+
+  VkImage     get() const { return m_image; }
+  VkImageView getView() const { return m_view; }
+  bool        empty() const { return VK_NULL_HANDLE == m_image; }
+  void        setOwner(deviceMemoryOwner owner) const { setDeviceMemoryOwner(m_memory, owner); }
+
+  void reset()                                       // destroys the view and image now, the GPU must be done with them
+  {
+    if (VK_NULL_HANDLE != m_view) vkDestroyImageView(m_device, m_view, nullptr);
+    if (VK_NULL_HANDLE != m_image) vkDestroyImage(m_device, m_image, nullptr);
+    freeDeviceMemory(m_device, m_memory);
+    m_image = VK_NULL_HANDLE;
+    m_memory = VK_NULL_HANDLE;
+    m_view = VK_NULL_HANDLE;
+  }
+
+private:
+  VkImage        m_image = VK_NULL_HANDLE;
+  VkDeviceMemory m_memory = VK_NULL_HANDLE;
+  VkImageView    m_view = VK_NULL_HANDLE;
+  VkDevice       m_device = VK_NULL_HANDLE;
+};
+
+#endif
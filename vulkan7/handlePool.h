@@ -0,0 +1,142 @@
+#ifndef _handlePool_h_
+#define _handlePool_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+const uint32_t HANDLE_NULL_INDEX = 0xffffffff;
+
+// A reference to an object in a handlePool: the object's slot and the slot's generation when the object was created.
+// Destroying the object moves the slot's generation on, so old handles stop resolving rather than reaching whatever
+// reuses the slot.  The tag only makes the handles of different pools different types, a texture handle can not be
+// passed where a model handle is wanted.  A default constructed handle is null and never resolves.
+template <typename Tag>
+struct handle
+{
+  uint32_t index = HANDLE_NULL_INDEX;
+  uint32_t generation = 0;
+
+  bool isNull() const { return HANDLE_NULL_INDEX == index; }
+  bool operator==(const handle& other) const { return index == other.index && generation == other.generation; }
+  bool operator!=(const handle& other) const { return !(*this == other); }
+};
+
+// Objects addressed by handle, kept densely packed so they can be iterated as plain arrays.  Each object is split into
+// a hot part (what is read every frame, e.g. by the draw loop) and a cold part (what is only needed to create and
+// destroy it), held in separate arrays so iterating the hot parts does not drag the cold ones through the cache.
+// Handles go through a slot table to the dense index; create and destroy are O(1), destroy moving the last object into
+// the hole.  Freed slots are reused, most recently freed first, with their generation bumped.
+//
+// Anything the owner keeps per object outside the pool (indexed by dense index) has to follow the same move, destroy
+// returns the index that was filled so it can.
+template <typename Tag, typename Hot, typename Cold>
+class handlePool
+{
+public:
+  typedef handle<Tag> handleType;
+
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  handleType create(Hot hot, Cold cold)
+  {
+    uint32_t slotIndex;
+    if (HANDLE_NULL_INDEX != m_freeSlot)
+    {
+      slotIndex = m_freeSlot;
+      m_freeSlot = m_slots[slotIndex].dense;
+    }
+    else
+    {
+      slotIndex = static_cast<uint32_t>(m_slots.size());
+      m_slots.push_back({ 0, 1 });
+    }
+
+    m_slots[slotIndex].dense = static_cast<uint32_t>(m_hot.size());
+    m_hot.push_back(std::move(hot));
+    m_cold.push_back(std::move(cold));
+    m_slotOf.push_back(slotIndex);
+
+    handleType h;
+    h.index = slotIndex;
+    h.generation = m_slots[slotIndex].generation;
+    return h;
+  }
+
+  // removes the object, returns the dense index it had (now holding what was the last object), npos if h is stale
+  size_t destroy(handleType h)
+  {
+    size_t ndx = indexOf(h);
+    if (npos == ndx) return npos;
+
+    size_t last = m_hot.size() - 1;
+    if (ndx != last)
+    {
+      m_hot[ndx] = std::move(m_hot[last]);
+      m_cold[ndx] = std::move(m_cold[last]);
+      m_slotOf[ndx] = m_slotOf[last];
+      m_slots[m_slotOf[ndx]].dense = static_cast<uint32_t>(ndx);
+    }
+    m_hot.pop_back();
+    m_cold.pop_back();
+    m_slotOf.pop_back();
+
+    slot& freed = m_slots[h.index];
+    freed.generation++;
+    if (0 == freed.generation) freed.generation = 1;    // 0 is never handed out
+    freed.dense = m_freeSlot;
+    m_freeSlot = h.index;
+
+    return ndx;
+  }
+
+  // dense index of the object, npos if the handle is null or stale
+  size_t indexOf(handleType h) const
+  {
+    if (h.index >= m_slots.size() || m_slots[h.index].generation != h.generation) return npos;
+    return m_slots[h.index].dense;
+  }
+
+  bool  isValid(handleType h) const { return npos != indexOf(h); }
+  Hot*  getHot(handleType h) { size_t ndx = indexOf(h); return (npos == ndx) ? nullptr : &m_hot[ndx]; }
+  Cold* getCold(handleType h) { size_t ndx = indexOf(h); return (npos == ndx) ? nullptr : &m_cold[ndx]; }
+
+  // dense access, for iterating every object
+  size_t     size() const { return m_hot.size(); }
+  Hot&       hotAt(size_t ndx) { return m_hot[ndx]; }
+  Cold&      coldAt(size_t ndx) { return m_cold[ndx]; }
+  handleType handleAt(size_t ndx) const
+  {
+    handleType h;
+    h.index = m_slotOf[ndx];
+    h.generation = m_slots[h.index].generation;
+    return h;
+  }
+
+  void clear()                                      // invalidates every handle
+  {
+    while (!m_hot.empty()) destroy(handleAt(m_hot.size() - 1));
+  }
+
+private:
+  struct slot
+  {
+    uint32_t dense;                   // index into the dense arrays, or the next free slot when free
+    uint32_t generation;
+  };
+
+  std::vector<Hot>      m_hot;
+  std::vector<Cold>     m_cold;
+  std::vector<uint32_t> m_slotOf;     // dense index -> slot
+  std::vector<slot>     m_slots;
+  uint32_t              m_freeSlot = HANDLE_NULL_INDEX;
+};
+
+// the handles the context gives out
+struct textureTag;
+struct modelTag;
+typedef handle<textureTag> textureHandle;
+typedef handle<modelTag>   modelHandle;
+
+#endif
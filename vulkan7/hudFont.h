@@ -0,0 +1,113 @@
+#ifndef _hudFont_h_
+#define _hudFont_h_
+
+#include <cstdint>
+
+// The performance HUD's font, 8x16 cells for printable ASCII (' ' to '~') in order.  Each glyph is 16 rows of one
+// byte, top row first, leftmost pixel in the high bit.  Baked from Source Code Pro Bold (SIL Open Font License 1.1) at
+// 13 px and thresholded, perfHud::buildAtlas turns it into the atlas texture.
+const uint32_t HUD_GLYPH_WIDTH = 8;
+const uint32_t HUD_GLYPH_HEIGHT = 16;
+const uint32_t HUD_FIRST_CHAR = 32;
+const uint32_t HUD_GLYPH_COUNT = 95;
+
+static const uint8_t hudFontGlyphs[HUD_GLYPH_COUNT][HUD_GLYPH_HEIGHT] =
+{
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // ' '
+  { 0x00, 0x00, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1c, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '!'
+  { 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '"'
+  { 0x00, 0x00, 0x34, 0x34, 0x7e, 0x7e, 0x24, 0x7e, 0x7e, 0x2c, 0x68, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '#'
+  { 0x00, 0x10, 0x10, 0x7e, 0x64, 0x70, 0x3c, 0x0e, 0x46, 0x7e, 0x38, 0x10, 0x10, 0x00, 0x00, 0x00 },    // '$'
+  { 0x00, 0x00, 0x70, 0x4b, 0x4e, 0x70, 0x06, 0x19, 0x29, 0x4b, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '%'
+  { 0x00, 0x00, 0x18, 0x3c, 0x3c, 0x38, 0x33, 0x7b, 0x6e, 0x7f, 0x3d, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '&'
+  { 0x00, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '\''
+  { 0x00, 0x0c, 0x0c, 0x18, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x18, 0x18, 0x0c, 0x00, 0x00, 0x00 },    // '('
+  { 0x00, 0x30, 0x30, 0x18, 0x1c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x18, 0x18, 0x30, 0x00, 0x00, 0x00 },    // ')'
+  { 0x00, 0x00, 0x00, 0x10, 0x10, 0xfc, 0x38, 0x38, 0x6c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '*'
+  { 0x00, 0x00, 0x00, 0x18, 0x18, 0x18, 0x7e, 0x7e, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '+'
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x3c, 0x1c, 0x0c, 0x18, 0x10, 0x00, 0x00 },    // ','
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '-'
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '.'
+  { 0x00, 0x06, 0x04, 0x0c, 0x0c, 0x08, 0x18, 0x18, 0x10, 0x30, 0x30, 0x20, 0x60, 0x60, 0x00, 0x00 },    // '/'
+  { 0x00, 0x00, 0x3c, 0x3c, 0x66, 0x7e, 0x7e, 0x66, 0x66, 0x3c, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '0'
+  { 0x00, 0x00, 0x38, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7e, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '1'
+  { 0x00, 0x00, 0x3c, 0x7e, 0x06, 0x06, 0x0c, 0x1c, 0x38, 0x7e, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '2'
+  { 0x00, 0x00, 0x78, 0x7c, 0x0c, 0x38, 0x38, 0x0c, 0x0c, 0xfc, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '3'
+  { 0x00, 0x00, 0x0e, 0x1e, 0x1e, 0x36, 0x26, 0x7f, 0x7f, 0x06, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '4'
+  { 0x00, 0x00, 0x7c, 0x7c, 0x60, 0x7c, 0x7e, 0x06, 0x06, 0xfe, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '5'
+  { 0x00, 0x00, 0x1c, 0x3e, 0x60, 0x6c, 0x7e, 0x66, 0x66, 0x3e, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '6'
+  { 0x00, 0x00, 0x7e, 0x7e, 0x04, 0x0c, 0x0c, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '7'
+  { 0x00, 0x00, 0x3c, 0x7e, 0x66, 0x76, 0x3c, 0x6e, 0x66, 0x7e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '8'
+  { 0x00, 0x00, 0x38, 0x7c, 0x66, 0x66, 0x7e, 0x36, 0x06, 0x7c, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '9'
+  { 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0x00, 0x00, 0x38, 0x38, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00 },    // ':'
+  { 0x00, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0x00, 0x30, 0x38, 0x38, 0x08, 0x18, 0x30, 0x00, 0x00 },    // ';'
+  { 0x00, 0x00, 0x00, 0x06, 0x0e, 0x38, 0x30, 0x38, 0x0e, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '<'
+  { 0x00, 0x00, 0x00, 0x00, 0x7e, 0x7e, 0x00, 0x7e, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '='
+  { 0x00, 0x00, 0x00, 0x60, 0x70, 0x1c, 0x0c, 0x1c, 0x70, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '>'
+  { 0x00, 0x00, 0x38, 0x7c, 0x0c, 0x18, 0x30, 0x00, 0x30, 0x38, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '?'
+  { 0x00, 0x00, 0x1e, 0x23, 0x63, 0x4f, 0x5f, 0x5b, 0x5f, 0x40, 0x60, 0x32, 0x1e, 0x00, 0x00, 0x00 },    // '@'
+  { 0x00, 0x00, 0x18, 0x3c, 0x3c, 0x2c, 0x6c, 0x7e, 0x7e, 0xe6, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'A'
+  { 0x00, 0x00, 0x7c, 0x7e, 0x66, 0x7c, 0x7c, 0x66, 0x66, 0x7e, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'B'
+  { 0x00, 0x00, 0x1e, 0x3e, 0x70, 0x60, 0x60, 0x60, 0x70, 0x3e, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'C'
+  { 0x00, 0x00, 0x78, 0x7c, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7c, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'D'
+  { 0x00, 0x00, 0x7e, 0x7c, 0x60, 0x7c, 0x7c, 0x60, 0x60, 0x7c, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'E'
+  { 0x00, 0x00, 0x7e, 0x7c, 0x60, 0x60, 0x7c, 0x7c, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'F'
+  { 0x00, 0x00, 0x1e, 0x3e, 0x70, 0x60, 0x67, 0x67, 0x73, 0x3f, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'G'
+  { 0x00, 0x00, 0x66, 0x66, 0x66, 0x7e, 0x7e, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'H'
+  { 0x00, 0x00, 0x7e, 0x7e, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7e, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'I'
+  { 0x00, 0x00, 0x7e, 0x3e, 0x06, 0x06, 0x06, 0x06, 0x06, 0x7e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'J'
+  { 0x00, 0x00, 0x66, 0x6e, 0x6c, 0x78, 0x7c, 0x7c, 0x6e, 0x66, 0x67, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'K'
+  { 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x7c, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'L'
+  { 0x00, 0x00, 0x77, 0x77, 0x77, 0x7f, 0x7f, 0x6b, 0x6b, 0x63, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'M'
+  { 0x00, 0x00, 0x66, 0x76, 0x76, 0x76, 0x7e, 0x6e, 0x6e, 0x6e, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'N'
+  { 0x00, 0x00, 0x1c, 0x3e, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3e, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'O'
+  { 0x00, 0x00, 0x7c, 0x7e, 0x66, 0x66, 0x7e, 0x7c, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'P'
+  { 0x00, 0x00, 0x1c, 0x3e, 0x63, 0x63, 0x63, 0x63, 0x63, 0x77, 0x3e, 0x1c, 0x0f, 0x07, 0x00, 0x00 },    // 'Q'
+  { 0x00, 0x00, 0x7c, 0x7e, 0x66, 0x66, 0x7c, 0x7c, 0x6c, 0x6e, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'R'
+  { 0x00, 0x00, 0x3c, 0x7e, 0x60, 0x78, 0x3c, 0x0e, 0x06, 0x7e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'S'
+  { 0x00, 0x00, 0x7f, 0x7f, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'T'
+  { 0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'U'
+  { 0x00, 0x00, 0xc7, 0x66, 0x66, 0x66, 0x64, 0x3c, 0x3c, 0x3c, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'V'
+  { 0x00, 0x00, 0xc7, 0xc6, 0xde, 0xde, 0xfe, 0xfe, 0x6e, 0x6e, 0x6e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'W'
+  { 0x00, 0x00, 0x66, 0x66, 0x3c, 0x3c, 0x38, 0x3c, 0x7c, 0x66, 0xe6, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'X'
+  { 0x00, 0x00, 0xe7, 0x66, 0x66, 0x3c, 0x3c, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'Y'
+  { 0x00, 0x00, 0x7e, 0x7e, 0x0c, 0x1c, 0x18, 0x30, 0x30, 0x7e, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'Z'
+  { 0x00, 0x1e, 0x1e, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1e, 0x1e, 0x00, 0x00 },    // '['
+  { 0x00, 0x60, 0x60, 0x20, 0x30, 0x30, 0x10, 0x18, 0x18, 0x08, 0x0c, 0x0c, 0x04, 0x06, 0x00, 0x00 },    // '\\'
+  { 0x00, 0x3c, 0x3c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x3c, 0x3c, 0x00, 0x00 },    // ']'
+  { 0x00, 0x10, 0x18, 0x38, 0x3c, 0x24, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '^'
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e, 0x7e, 0x00, 0x00, 0x00 },    // '_'
+  { 0x30, 0x30, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },    // '`'
+  { 0x00, 0x00, 0x00, 0x00, 0x3c, 0x7e, 0x06, 0x3e, 0x66, 0x7e, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'a'
+  { 0x00, 0x60, 0x60, 0x60, 0x7c, 0x7e, 0x66, 0x66, 0x66, 0x7e, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'b'
+  { 0x00, 0x00, 0x00, 0x00, 0x1e, 0x3e, 0x60, 0x60, 0x60, 0x3e, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'c'
+  { 0x00, 0x06, 0x06, 0x06, 0x3e, 0x7e, 0x66, 0x66, 0x66, 0x7e, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'd'
+  { 0x00, 0x00, 0x00, 0x00, 0x3c, 0x7e, 0x7e, 0x7e, 0x60, 0x7e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'e'
+  { 0x00, 0x0f, 0x1e, 0x18, 0x7e, 0x7e, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'f'
+  { 0x00, 0x00, 0x00, 0x00, 0x3f, 0x7f, 0x66, 0x66, 0x3c, 0x7e, 0x3f, 0x63, 0x7f, 0x3e, 0x00, 0x00 },    // 'g'
+  { 0x00, 0x60, 0x60, 0x60, 0x7c, 0x7e, 0x66, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'h'
+  { 0x18, 0x18, 0x00, 0x00, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'i'
+  { 0x18, 0x18, 0x00, 0x00, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x78, 0x70, 0x00, 0x00 },    // 'j'
+  { 0x00, 0x60, 0x60, 0x60, 0x66, 0x6c, 0x78, 0x7c, 0x7c, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'k'
+  { 0x00, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1e, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'l'
+  { 0x00, 0x00, 0x00, 0x00, 0x7e, 0x7f, 0x7b, 0x7b, 0x7b, 0x7b, 0x7b, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'm'
+  { 0x00, 0x00, 0x00, 0x00, 0x7c, 0x7e, 0x66, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'n'
+  { 0x00, 0x00, 0x00, 0x00, 0x1c, 0x3e, 0x63, 0x63, 0x63, 0x3e, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'o'
+  { 0x00, 0x00, 0x00, 0x00, 0x7c, 0x7e, 0x66, 0x66, 0x66, 0x7e, 0x7c, 0x60, 0x60, 0x60, 0x00, 0x00 },    // 'p'
+  { 0x00, 0x00, 0x00, 0x00, 0x3e, 0x7e, 0x66, 0x66, 0x66, 0x7e, 0x3e, 0x06, 0x06, 0x06, 0x00, 0x00 },    // 'q'
+  { 0x00, 0x00, 0x00, 0x00, 0x37, 0x3e, 0x38, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'r'
+  { 0x00, 0x00, 0x00, 0x00, 0x3c, 0x7e, 0x60, 0x3c, 0x06, 0x7e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 's'
+  { 0x00, 0x00, 0x18, 0x18, 0x7e, 0x7e, 0x18, 0x18, 0x18, 0x1e, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 't'
+  { 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7e, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'u'
+  { 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x2c, 0x3c, 0x3c, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'v'
+  { 0x00, 0x00, 0x00, 0x00, 0x43, 0x6b, 0x7b, 0x7f, 0x7f, 0x77, 0x76, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'w'
+  { 0x00, 0x00, 0x00, 0x00, 0x66, 0x7c, 0x3c, 0x38, 0x3c, 0x6c, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'x'
+  { 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x3c, 0x3c, 0x1c, 0x18, 0x18, 0x70, 0x70, 0x00, 0x00 },    // 'y'
+  { 0x00, 0x00, 0x00, 0x00, 0x7e, 0x7e, 0x1c, 0x18, 0x30, 0x7e, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00 },    // 'z'
+  { 0x00, 0x0e, 0x1e, 0x18, 0x18, 0x18, 0x18, 0x70, 0x18, 0x18, 0x18, 0x18, 0x1e, 0x0e, 0x00, 0x00 },    // '{'
+  { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00 },    // '|'
+  { 0x00, 0x70, 0x78, 0x18, 0x18, 0x18, 0x18, 0x0e, 0x18, 0x18, 0x18, 0x18, 0x78, 0x70, 0x00, 0x00 },    // '}'
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x32, 0x7e, 0x4c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }     // '~'
+};
+
+#endif
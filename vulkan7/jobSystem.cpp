@@ -0,0 +1,456 @@
+#include "jobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+// identifies the job system (and queue) the current thread is a worker of, if any
+struct workerIdentity
+{
+  jobSystem* owner;
+  unsigned   index;
+};
+
+static thread_local workerIdentity t_worker = { nullptr, 0 };
+
+
+/************************************************************************************************************************
+ * function  : ctor
+ *
+ * abstract  : Creates the worker threads and their queues.  One extra queue is created to receive jobs submitted from
+ *             threads that are not part of the pool (e.g. the main thread).
+ *
+ * parameters: workerCount -- [in] number of worker threads, zero to use one per hardware thread less one for the
+ *                            calling thread (which helps out whenever it waits).
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+jobSystem::jobSystem(unsigned workerCount) : m_running(true), m_queued(0), m_sleeping(0)
+{
+  if (0 == workerCount)
+  {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    workerCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+  }
+
+  for (unsigned ndx = 0; ndx < workerCount + 1; ndx++)
+  {
+    m_queues.push_back(std::unique_ptr<workerQueue>(new workerQueue));
+  }
+
+  for (unsigned ndx = 0; ndx < workerCount; ndx++)
+  {
+    m_threads.push_back(std::thread(&jobSystem::workerLoop, this, ndx));
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : dtor
+ *
+ * abstract  : Stops and joins the worker threads.  Any jobs still queued are discarded, callers are expected to wait on
+ *             their counters before the job system is destroyed.
+ *
+ * parameters: void
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+jobSystem::~jobSystem()
+{
+  m_running = false;
+  {
+    std::lock_guard<std::mutex> guard(m_wakeLock);
+    m_wake.notify_all();
+  }
+
+  for (auto& t : m_threads)
+  {
+    t.join();
+  }
+}
+
+
+
+unsigned jobSystem::getWorkerCount()
+{
+  return static_cast<unsigned>(m_threads.size());
+}
+
+
+
+/************************************************************************************************************************
+ * function  : run
+ *
+ * abstract  : Queues a job.  If called from a worker the job goes on the back of that worker's own queue, otherwise it
+ *             goes into the injection queue.
+ *
+ * parameters: fn -- [in] the work to perform
+ *             counter -- [in] optional counter, incremented now and decremented when the job completes
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void jobSystem::run(jobFunc fn, jobCounter* counter)
+{
+  if (nullptr != counter)
+  {
+    counter->m_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  push(job{ std::move(fn), counter });
+}
+
+
+
+/************************************************************************************************************************
+ * function  : runAfter
+ *
+ * abstract  : Queues a job that may not start until every job counted by 'dependency' has completed.  The job is parked
+ *             on the dependency and released by whichever thread finishes the last job, so nothing blocks or polls
+ *             while waiting.
+ *
+ * parameters: dependency -- [in] counter that must reach zero before the job is started
+ *             fn -- [in] the work to perform
+ *             counter -- [in] optional counter, incremented now and decremented when the job completes
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void jobSystem::runAfter(jobCounter* dependency, jobFunc fn, jobCounter* counter)
+{
+  if (nullptr != counter)
+  {
+    counter->m_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (nullptr != dependency)
+  {
+    std::unique_lock<std::mutex> guard(dependency->m_lock);
+    if (0 != dependency->m_count.load(std::memory_order_acquire))
+    {
+      dependency->m_waiting.push_back(jobCounter::continuation{ std::move(fn), counter });
+      return;
+    }
+  }
+
+  push(job{ std::move(fn), counter });
+}
+
+
+
+/************************************************************************************************************************
+ * function  : wait
+ *
+ * abstract  : Waits for all jobs counted by 'counter' to complete.  Rather than blocking the calling thread runs queued
+ *             jobs (its own first, then stolen ones) until the counter reaches zero.  Once this returns the counter may
+ *             be safely destroyed.
+ *
+ * parameters: counter -- [in] counter to wait on
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void jobSystem::wait(jobCounter* counter)
+{
+  if (nullptr == counter) return;
+
+  while (!counter->isDone())
+  {
+    if (!runOne())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  // the thread that finished the last job may still be releasing the counter's lock, don't return until it has
+  std::lock_guard<std::mutex> guard(counter->m_lock);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : parallelFor
+ *
+ * abstract  : Splits the range [begin, end) into chunks of 'grain' items and runs fn(chunkBegin, chunkEnd) on each chunk
+ *             in parallel.  The calling thread takes part and the function returns once every chunk is complete.
+ *
+ * parameters: begin -- [in] first index of the range
+ *             end -- [in] one past the last index of the range
+ *             grain -- [in] items per job, zero to pick a size giving about four chunks per thread
+ *             fn -- [in] function called for each chunk
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void jobSystem::parallelFor(size_t begin, size_t end, size_t grain, rangeFunc fn)
+{
+  if (end <= begin) return;
+
+  if (0 == grain)
+  {
+    size_t chunks = (m_threads.size() + 1) * 4;
+    grain = std::max<size_t>(1, (end - begin + chunks - 1) / chunks);
+  }
+
+  jobCounter counter;
+  for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grain)
+  {
+    size_t chunkEnd = std::min(end, chunkBegin + grain);
+    run([&fn, chunkBegin, chunkEnd]() { fn(chunkBegin, chunkEnd); }, &counter);
+  }
+
+  wait(&counter);
+}
+
+
+
+void jobSystem::workerLoop(unsigned index)
+{
+  t_worker.owner = this;
+  t_worker.index = index;
+
+  while (m_running)
+  {
+    if (runOne()) continue;
+
+    // nothing to do, sleep until work is queued.  No timeout: push counts the job before it looks for sleepers and we
+    // count ourselves a sleeper before looking for jobs, so one of us always sees the other, and an idle worker (drawing
+    // on demand) costs no CPU at all
+    std::unique_lock<std::mutex> guard(m_wakeLock);
+    m_sleeping++;
+    m_wake.wait(guard, [this]() { return m_queued > 0 || !m_running; });
+    m_sleeping--;
+  }
+}
+
+
+
+unsigned jobSystem::currentQueue()
+{
+  if (t_worker.owner == this) return t_worker.index;
+
+  return static_cast<unsigned>(m_queues.size() - 1);        // injection queue
+}
+
+
+
+void jobSystem::push(job&& j)
+{
+  workerQueue* q = m_queues[currentQueue()].get();
+  {
+    std::lock_guard<std::mutex> guard(q->lock);
+    q->jobs.push_back(std::move(j));
+  }
+  m_queued++;
+
+  if (m_sleeping > 0)
+  {
+    std::lock_guard<std::mutex> guard(m_wakeLock);
+    m_wake.notify_one();
+  }
+}
+
+
+
+// take the newest job from the back of our own queue
+bool jobSystem::pop(unsigned index, job* j)
+{
+  workerQueue* q = m_queues[index].get();
+
+  std::lock_guard<std::mutex> guard(q->lock);
+  if (q->jobs.empty()) return false;
+
+  *j = std::move(q->jobs.back());
+  q->jobs.pop_back();
+  m_queued--;
+
+  return true;
+}
+
+
+
+// take the oldest job from the front of some other queue, starting with our neighbour so thieves spread out
+bool jobSystem::steal(unsigned thief, job* j)
+{
+  size_t queueCount = m_queues.size();
+
+  for (size_t offset = 1; offset < queueCount; offset++)
+  {
+    workerQueue* q = m_queues[(thief + offset) % queueCount].get();
+
+    std::unique_lock<std::mutex> guard(q->lock, std::try_to_lock);
+    if (!guard.owns_lock() || q->jobs.empty()) continue;
+
+    *j = std::move(q->jobs.front());
+    q->jobs.pop_front();
+    m_queued--;
+
+    return true;
+  }
+
+  return false;
+}
+
+
+
+bool jobSystem::runOne()
+{
+  if (0 == m_queued) return false;
+
+  unsigned index = currentQueue();
+  job      j;
+
+  if (pop(index, &j) || steal(index, &j))
+  {
+    execute(j);
+    return true;
+  }
+
+  return false;
+}
+
+
+
+void jobSystem::execute(job& j)
+{
+  j.fn();
+  finish(j.counter);
+}
+
+
+
+// decrement the counter, the thread that takes it to zero releases any jobs parked on it
+void jobSystem::finish(jobCounter* counter)
+{
+  if (nullptr == counter) return;
+
+  std::vector<jobCounter::continuation> released;
+  {
+    std::lock_guard<std::mutex> guard(counter->m_lock);
+    if (1 == counter->m_count.fetch_sub(1, std::memory_order_acq_rel))
+    {
+      released.swap(counter->m_waiting);
+    }
+  }
+
+  for (auto& c : released)
+  {
+    push(job{ std::move(c.fn), c.counter });
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : benchmark
+ *
+ * abstract  : Micro-benchmarks for the job system, results are written to the given stream;
+ *               (a) spawn overhead -- cost per job of queueing and running empty jobs from an external thread, and
+ *                   from inside a job (the worker's own queue).
+ *               (b) dependency overhead -- cost per job of a chain of runAfter continuations.
+ *               (c) scaling -- a fixed compute bound parallelFor, run with 1 worker up to one per hardware thread,
+ *                   reported as speed up over a plain loop.
+ *
+ * parameters: os -- [in] stream to write results to
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void jobSystem::benchmark(std::ostream& os)
+{
+  typedef std::chrono::steady_clock clock;
+  const int spawnJobs = 200000;
+
+  os << "[?] job system benchmark (" << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+
+  {
+    jobSystem         js;
+    std::atomic<int>  sink(0);
+
+    // (a) spawn from outside the pool
+    jobCounter counter;
+    clock::time_point start = clock::now();
+    for (int i = 0; i < spawnJobs; i++)
+    {
+      js.run([&sink]() { sink.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    js.wait(&counter);
+    double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / spawnJobs;
+    os << "    spawn (external)    : " << std::fixed << std::setprecision(1) << ns << " ns/job" << std::endl;
+
+    // (a) spawn from inside a job, children go on the worker's own deque and are stolen by the others
+    jobCounter outer, inner;
+    start = clock::now();
+    js.run([&js, &inner, &sink]()
+      {
+        for (int i = 0; i < spawnJobs; i++)
+        {
+          js.run([&sink]() { sink.fetch_add(1, std::memory_order_relaxed); }, &inner);
+        }
+      }, &outer);
+    js.wait(&outer);
+    js.wait(&inner);
+    ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / spawnJobs;
+    os << "    spawn (worker)      : " << ns << " ns/job" << std::endl;
+
+    // (b) a chain of dependent jobs, each released by the previous one finishing
+    const int chainLength = 20000;
+    std::vector<jobCounter> chain(chainLength);
+    start = clock::now();
+    js.run([&sink]() { sink++; }, &chain[0]);
+    for (int i = 1; i < chainLength; i++)
+    {
+      js.runAfter(&chain[i - 1], [&sink]() { sink++; }, &chain[i]);
+    }
+    js.wait(&chain[chainLength - 1]);
+    for (auto& c : chain) js.wait(&c);
+    ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / chainLength;
+    os << "    dependency chain    : " << ns << " ns/job" << std::endl;
+  }
+
+  // (c) scaling
+  const size_t items = 1 << 20;
+  std::vector<float> data(items);
+  auto work = [&data](size_t b, size_t e)
+    {
+      for (size_t i = b; i < e; i++)
+      {
+        float x = static_cast<float>(i);
+        for (int k = 0; k < 32; k++) x = std::sqrt(x * 1.0001f + 1.0f);
+        data[i] = x;
+      }
+    };
+
+  clock::time_point start = clock::now();
+  work(0, items);
+  double serialMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  os << "    scaling, serial     : " << std::setprecision(2) << serialMs << " ms" << std::endl;
+
+  unsigned hardwareThreads = std::thread::hardware_concurrency();
+  unsigned maxWorkers = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+  for (unsigned workers = 1; ; workers = std::min(workers * 2, maxWorkers))
+  {
+    jobSystem js(workers);
+
+    start = clock::now();
+    js.parallelFor(0, items, 4096, work);
+    double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    os << "    scaling, " << std::setw(3) << workers + 1 << " threads: " << ms << " ms, speed up " << serialMs / ms << "x" << std::endl;
+
+    if (workers == maxWorkers) break;
+  }
+
+  os.unsetf(std::ios::floatfield);
+}
@@ -0,0 +1,94 @@
+#ifndef _jobSystem_h_
+#define _jobSystem_h_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// A job counter tracks a group of outstanding jobs.  It reaches zero when every job that was run against it has
+// finished, at which point any jobs that were queued to run after it (see jobSystem::runAfter) are released.
+class jobCounter
+{
+public:
+  jobCounter() : m_count(0) { }
+
+  bool isDone() { return 0 == m_count.load(std::memory_order_acquire); }
+
+private:
+  friend class jobSystem;
+
+  struct continuation
+  {
+    std::function<void()> fn;
+    jobCounter*           counter;
+  };
+
+  std::atomic<int>           m_count;
+  std::mutex                 m_lock;
+  std::vector<continuation>  m_waiting;          // jobs released when the count reaches zero
+};
+
+// Work-stealing job system.  Each worker thread owns a deque, it pushes and pops work at the back (LIFO, keeps caches
+// warm) while idle workers steal from the front (FIFO, takes the oldest and so usually largest piece of work).  Jobs
+// submitted from threads outside the pool go into a shared injection queue that the workers also steal from.  Threads
+// that wait on a counter help by running jobs rather than blocking.
+class jobSystem
+{
+public:
+  typedef std::function<void()>               jobFunc;
+  typedef std::function<void(size_t, size_t)> rangeFunc;
+
+  jobSystem(unsigned workerCount = 0);          // zero => one worker per hardware thread, less the calling thread
+  ~jobSystem();
+
+  jobSystem(const jobSystem&) = delete;
+  jobSystem& operator=(const jobSystem&) = delete;
+
+  void     run(jobFunc fn, jobCounter* counter = nullptr);
+  void     runAfter(jobCounter* dependency, jobFunc fn, jobCounter* counter = nullptr);
+  void     wait(jobCounter* counter);
+  void     parallelFor(size_t begin, size_t end, size_t grain, rangeFunc fn);
+
+  unsigned getWorkerCount();
+
+  static void benchmark(std::ostream& os);
+
+private:
+  struct job
+  {
+    jobFunc     fn;
+    jobCounter* counter;
+  };
+
+  struct workerQueue
+  {
+    std::mutex       lock;
+    std::deque<job>  jobs;
+  };
+
+  std::vector<std::unique_ptr<workerQueue>> m_queues;     // one per worker, the last one is the injection queue
+  std::vector<std::thread>                  m_threads;
+
+  std::atomic<bool>        m_running;
+  std::atomic<int>         m_queued;                      // jobs sitting in any queue
+  std::atomic<int>         m_sleeping;                    // workers blocked on m_wake
+  std::mutex               m_wakeLock;
+  std::condition_variable  m_wake;
+
+  void     workerLoop(unsigned index);
+  void     push(job&& j);
+  bool     pop(unsigned index, job* j);
+  bool     steal(unsigned thief, job* j);
+  bool     runOne();
+  void     execute(job& j);
+  void     finish(jobCounter* counter);
+  unsigned currentQueue();
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "linearArena.h"
+
+#include <stdexcept>
+
+
+/************************************************************************************************************************
+ * function  : ctor
+ *
+ * abstract  : Constructs the arena, reserving 'capacity' bytes.  This is the only place (along with reserve) that the
+ *             arena touches the heap.
+ *
+ * parameters: capacity -- [in] number of bytes to reserve, may be zero and set later with reserve
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+linearArena::linearArena(size_t capacity) : m_base(nullptr), m_capacity(0), m_used(0), m_highWater(0)
+{
+  reserve(capacity);
+}
+
+linearArena::~linearArena()
+{
+  ::operator delete(m_base);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : reserve
+ *
+ * abstract  : (Re)allocates the backing store.  Anything allocated from the arena is lost, so this should be called
+ *             while setting up, or between frames after reset.
+ *
+ * parameters: capacity -- [in] number of bytes to reserve
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void linearArena::reserve(size_t capacity)
+{
+  ::operator delete(m_base);
+  m_base = (capacity > 0) ? static_cast<uint8_t*>(::operator new(capacity)) : nullptr;
+  m_capacity = capacity;
+  m_used = 0;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : allocate
+ *
+ * abstract  : Returns 'size' bytes aligned to 'alignment' (a power of two) from the arena.  When the arena is full
+ *             nullptr is returned rather than falling back to the heap, the caller decides what to do (record less,
+ *             or throw).  The high water mark is tracked either way so the arena can be sized correctly next run.
+ *
+ * parameters: size -- [in] number of bytes required
+ *             alignment -- [in] required alignment
+ *
+ * returns   : void*, pointer to the memory or nullptr if there is not enough room
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void* linearArena::allocate(size_t size, size_t alignment)
+{
+  uintptr_t base = reinterpret_cast<uintptr_t>(m_base);
+  uintptr_t start = (base + m_used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+  size_t    end = static_cast<size_t>(start - base) + size;
+
+  if (end > m_highWater) m_highWater = end;
+  if (nullptr == m_base || end > m_capacity) return nullptr;
+
+  m_used = end;
+  return reinterpret_cast<void*>(start);
+}
+
+
+
+void linearArena::reset()
+{
+  m_used = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef _linearArena_h_
+#define _linearArena_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// A linear (bump) allocator for transient, per-frame data.  Memory is reserved once up front, allocate() just moves a
+// pointer forward and reset() releases everything at once.  Destructors are never run, so it should only hold
+// trivially destructible types (Vulkan handles, draw lists, ...).
+class linearArena
+{
+public:
+  linearArena(size_t capacity = 0);
+  ~linearArena();
+
+  linearArena(const linearArena&) = delete;
+  linearArena& operator=(const linearArena&) = delete;
+
+  void   reserve(size_t capacity);                 // not for use in the frame loop, allocates
+  void*  allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+  void   reset();
+
+  template <typename T>
+  T* allocArray(size_t count)
+  {
+    void* p = allocate(sizeof(T) * count, alignof(T));
+    return (nullptr == p) ? nullptr : new (p) T[count];
+  }
+
+  size_t getCapacity() { return m_capacity; }
+  size_t getUsed() { return m_used; }
+  size_t getHighWater() { return m_highWater; }   // most ever used between resets, use to size the arena
+
+private:
+  uint8_t* m_base;
+  size_t   m_capacity;
+  size_t   m_used;
+  size_t   m_highWater;
+};
+
+#endif
@@ -0,0 +1,326 @@
+#include "loadBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include "MeshModel.h"
+#include "glbLoader.h"
+#include "objLoader.h"
+
+typedef std::chrono::high_resolution_clock benchClock;
+
+static double elapsedMs(benchClock::time_point start, benchClock::time_point end)
+{
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// copies data into the stand-in staging buffer at offset, growing it if needed, returns the offset after it
+static size_t stageCopy(std::vector<uint8_t>* staging, size_t offset, const void* data, size_t size)
+{
+  if (staging->size() < offset + size) staging->resize(std::max(offset + size, staging->size() * 2));
+  memcpy(staging->data() + offset, data, size);
+  return offset + size;
+}
+
+// the MeshModel::loadNode/loadMesh conversion, with the vectors copied into staging rather than handed to mesh
+static size_t stageNode(std::vector<uint8_t>* staging, size_t offset, const aiNode* node, const aiScene* scene, loadBenchSample* sample)
+{
+  for (unsigned int m = 0; m < node->mNumMeshes; m++)
+  {
+    const aiMesh* source = scene->mMeshes[node->mMeshes[m]];
+
+    std::vector<vertex> vertices(source->mNumVertices);
+    for (unsigned int ndx = 0; ndx < source->mNumVertices; ndx++)
+    {
+      vertices[ndx].pos = { source->mVertices[ndx].x, source->mVertices[ndx].y, source->mVertices[ndx].z };
+      if (source->mTextureCoords[0]) vertices[ndx].tex = { source->mTextureCoords[0][ndx].x, source->mTextureCoords[0][ndx].y };
+      else                           vertices[ndx].tex = { 0.0f, 0.0f };
+      vertices[ndx].col = { 1.0f, 1.0f, 1.0f };
+    }
+
+    std::vector<uint32_t> indices;
+    for (unsigned int ndx = 0; ndx < source->mNumFaces; ndx++)
+    {
+      const aiFace& face = source->mFaces[ndx];
+      for (unsigned int j = 0; j < face.mNumIndices; j++) indices.push_back(face.mIndices[j]);
+    }
+
+    offset = stageCopy(staging, offset, vertices.data(), vertices.size() * sizeof(vertex));
+    offset = stageCopy(staging, offset, indices.data(), indices.size() * sizeof(uint32_t));
+
+    sample->meshes++;
+    sample->vertices += vertices.size();
+    sample->indices += indices.size();
+  }
+
+  for (unsigned int ndx = 0; ndx < node->mNumChildren; ndx++)
+  {
+    offset = stageNode(staging, offset, node->mChildren[ndx], scene, sample);
+  }
+
+  return offset;
+}
+
+static uint64_t fileSize(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  return file ? (uint64_t)file.tellg() : 0;
+}
+
+
+
+loadBench::loadBench(const loadBenchConfig& config) : m_config(config)
+{
+  m_config.runs = std::max(1, m_config.runs);
+}
+
+loadBench::~loadBench() { }
+
+
+
+const char* loadBench::pathName(loadPath path)
+{
+  switch (path)
+  {
+    case LOAD_ASSIMP: return "assimp";
+    case LOAD_GLB:    return "glb";
+    case LOAD_OBJ:    return "obj";
+    default:          return "unknown";
+  }
+}
+
+
+
+// the .glb used for a model, e.g. ./Models/uh60.obj -> ./Models/uh60.glb
+std::string loadBench::glbFileName(const std::string& file)
+{
+  size_t dot = file.find_last_of('.');
+  size_t slash = file.find_last_of("/\\");
+  if (std::string::npos == dot || (std::string::npos != slash && dot < slash)) return file + ".glb";
+  return file.substr(0, dot) + ".glb";
+}
+
+bool loadBench::isObjFile(const std::string& file)
+{
+  return file.size() > 4 && (0 == file.compare(file.size() - 4, 4, ".obj") || 0 == file.compare(file.size() - 4, 4, ".OBJ"));
+}
+
+
+
+/************************************************************************************************************************
+ * function  : run
+ *
+ * abstract  : Converts any model that does not have a .glb yet, then times each path on each model.  A model that
+ *             fails to load (or convert) is reported and skipped.  The results are written to the CSV file and printed
+ *             as a table.
+ *
+ * parameters: os -- [in] stream the table is written to
+ *
+ * returns   : int, EXIT_SUCCESS if every model was measured, EXIT_FAILURE otherwise
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+int loadBench::run(std::ostream& os)
+{
+  int result = EXIT_SUCCESS;
+
+  for (const std::string& file : m_config.files)
+  {
+    try
+    {
+      std::string glbFile = glbFileName(file);
+      if (0 == fileSize(glbFile)) glbLoader::convert(file, glbFile);
+
+      for (int p = 0; p < LOAD_COUNT; p++)
+      {
+        if (LOAD_OBJ == p && !isObjFile(file)) continue;
+        m_samples.push_back(measure((loadPath)p, file));
+      }
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "[-] " << file << ": " << e.what() << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  writeCsv();
+  printSummary(os);
+
+  return result;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : measure
+ *
+ * abstract  : Loads the model once untimed (so the file is in the page cache and the staging stand-in has grown to
+ *             size, neither path pays for the disk or that allocation), then m_config.runs timed loads.
+ *
+ * parameters: path -- [in] which loader to use
+ *             file -- [in] the source model
+ *
+ * returns   : loadBenchSample, best and average time of the timed loads
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+loadBenchSample loadBench::measure(loadPath path, const std::string& file)
+{
+  loadBenchSample sample;
+  sample.file = file;
+  sample.path = path;
+  sample.fileBytes = fileSize((LOAD_GLB == path) ? glbFileName(file) : file);
+
+  load(path, file, &sample);
+
+  double total = 0.0;
+  for (int run = 0; run < m_config.runs; run++)
+  {
+    loadBenchSample counts;
+
+    benchClock::time_point start = benchClock::now();
+    load(path, file, &counts);
+    double ms = elapsedMs(start, benchClock::now());
+
+    total += ms;
+    sample.bestMs = (0 == run) ? ms : std::min(sample.bestMs, ms);
+  }
+
+  sample.avgMs = total / m_config.runs;
+  sample.mbPerSec = (sample.bestMs > 0.0) ? (sample.fileBytes / (1024.0 * 1024.0)) / (sample.bestMs / 1000.0) : 0.0;
+
+  return sample;
+}
+
+
+
+void loadBench::load(loadPath path, const std::string& file, loadBenchSample* sample)
+{
+  sample->meshes = sample->vertices = sample->indices = 0;
+
+  if (LOAD_GLB == path)      loadGlb(glbFileName(file), sample);
+  else if (LOAD_OBJ == path) loadObj(file, sample);
+  else                       loadAssimp(file, sample);
+}
+
+
+
+// what createMeshModel does, less the textures and the GPU copies
+void loadBench::loadAssimp(const std::string& file, loadBenchSample* sample)
+{
+  Assimp::Importer importer;
+  const aiScene* scene = importer.ReadFile(file, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
+  if (!scene)
+  {
+    throw std::runtime_error("Failed to load model! (" + file + ")");
+  }
+
+  std::vector<std::string> textureNames = MeshModel::LoadMaterials(scene);
+
+  stageNode(&m_staging, 0, scene->mRootNode, scene, sample);
+}
+
+
+
+// what createGlbModel does, less the textures and the GPU copies
+void loadBench::loadGlb(const std::string& file, loadBenchSample* sample)
+{
+  glbLoader loader;
+  loader.open(file);
+
+  std::vector<vertex>   vertexScratch;
+  std::vector<uint32_t> indexScratch;
+  size_t offset = 0;
+
+  for (const glbPrimitive& primitive : loader.getPrimitives())
+  {
+    size_t vertexCount = glbLoader::vertexCount(primitive);
+    size_t indexCount = glbLoader::indexCount(primitive);
+
+    offset = stageCopy(&m_staging, offset, glbLoader::vertexData(primitive, &vertexScratch), vertexCount * sizeof(vertex));
+    offset = stageCopy(&m_staging, offset, glbLoader::indexData(primitive, &indexScratch), indexCount * sizeof(uint32_t));
+
+    sample->meshes++;
+    sample->vertices += vertexCount;
+    sample->indices += indexCount;
+  }
+}
+
+
+
+// what createObjModel does, less the textures and the GPU copies
+void loadBench::loadObj(const std::string& file, loadBenchSample* sample)
+{
+  objModel  model;
+  objLoader loader(m_jobs);
+  loader.load(file, &model);
+
+  size_t offset = 0;
+  for (const objMesh& source : model.meshes)
+  {
+    offset = stageCopy(&m_staging, offset, source.vertices.data(), source.vertices.size() * sizeof(vertex));
+    offset = stageCopy(&m_staging, offset, source.indices.data(), source.indices.size() * sizeof(uint32_t));
+
+    sample->meshes++;
+    sample->vertices += source.vertices.size();
+    sample->indices += source.indices.size();
+  }
+}
+
+
+
+void loadBench::writeCsv()
+{
+  if (m_samples.empty()) return;
+
+  std::ofstream csv(m_config.csvFile);
+  if (!csv)
+  {
+    std::cerr << "[-] unable to write " << m_config.csvFile << std::endl;
+    return;
+  }
+
+  csv << "file,path,file_bytes,meshes,vertices,indices,best_ms,avg_ms,mb_per_s" << std::endl;
+
+  for (const loadBenchSample& s : m_samples)
+  {
+    csv << "\"" << s.file << "\"," << pathName(s.path) << "," << s.fileBytes << "," << s.meshes << "," << s.vertices << ","
+        << s.indices << "," << s.bestMs << "," << s.avgMs << "," << s.mbPerSec << std::endl;
+  }
+
+  std::cout << "[+] wrote " << m_samples.size() << " samples to " << m_config.csvFile << std::endl;
+}
+
+
+
+// one line per path per model, with the speed up over Assimp
+void loadBench::printSummary(std::ostream& os)
+{
+  os << "model                      path        file MB  meshes   vertices    indices    best ms     avg ms      MB/s  speed up" << std::endl;
+
+  double assimpMs = 0.0;
+  for (const loadBenchSample& s : m_samples)
+  {
+    if (LOAD_ASSIMP == s.path) assimpMs = s.bestMs;
+
+    std::string name = s.file.substr(s.file.find_last_of("/\\") + 1);
+    os << std::left << std::setw(27) << name << std::setw(8) << pathName(s.path) << std::right << std::fixed
+       << std::setprecision(2) << std::setw(11) << s.fileBytes / (1024.0 * 1024.0) << std::setw(8) << s.meshes
+       << std::setw(11) << s.vertices << std::setw(11) << s.indices << std::setw(11) << s.bestMs << std::setw(11) << s.avgMs
+       << std::setprecision(1) << std::setw(10) << s.mbPerSec;
+    if (LOAD_ASSIMP != s.path && s.bestMs > 0.0) os << std::setprecision(2) << std::setw(9) << assimpMs / s.bestMs << "x";
+    os << std::endl;
+    os.unsetf(std::ios::floatfield);
+  }
+}
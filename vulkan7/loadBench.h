@@ -0,0 +1,76 @@
+#ifndef _loadBench_h_
+#define _loadBench_h_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "jobSystem.h"
+
+// the ways of getting a model file into vertex/index data ready to copy to the GPU that are compared
+enum loadPath
+{
+  LOAD_ASSIMP,                // Assimp::Importer then the MeshModel::loadMesh conversion (createMeshModel for other formats)
+  LOAD_GLB,                   // glbLoader on the converted .glb, memcpy from the mapping where the layout matches
+  LOAD_OBJ,                   // objLoader, parsed and welded in parallel (OBJ files only)
+  LOAD_COUNT
+};
+
+// settings for a benchmark run, see loadBench::run
+struct loadBenchConfig
+{
+  std::vector<std::string> files = { "./Models/x-wing.obj", "./Models/uh60.obj", "./Models/Seahawk.obj" };
+  int                      runs = 5;         // timed loads of each file on each path, after one untimed load
+  std::string              csvFile = "load.csv";
+};
+
+// what was measured for one path on one model
+struct loadBenchSample
+{
+  std::string    file;                       // the source model, the .glb sits next to it
+  loadPath       path = LOAD_ASSIMP;
+  uint64_t       fileBytes = 0;              // size of the file this path reads
+  size_t         meshes = 0;
+  size_t         vertices = 0;
+  size_t         indices = 0;
+  double         bestMs = 0.0;
+  double         avgMs = 0.0;
+  double         mbPerSec = 0.0;             // fileBytes over the best time
+  bool           failed = false;
+};
+
+// CPU-only benchmark of model loading (no device is created).  Each path ends with every mesh's vertices and indices
+// copied into one host buffer, standing in for the staging buffers, so the GPU side that both paths share is left
+// out.  Texture decoding is the same stb_image work on both paths and is left out as well.  A model's .glb is made
+// with glbLoader::convert the first time it is needed.
+class loadBench
+{
+public:
+  loadBench(const loadBenchConfig& config);
+  ~loadBench();
+
+  int run(std::ostream& os);
+
+  static const char* pathName(loadPath path);
+
+private:
+  loadBenchConfig              m_config;
+  std::vector<loadBenchSample> m_samples;
+  std::vector<uint8_t>         m_staging;              // stands in for the staging buffers, reused between loads
+  jobSystem                    m_jobs;                 // for objLoader, as vkContext's pool
+
+  loadBenchSample measure(loadPath path, const std::string& file);
+  void            load(loadPath path, const std::string& file, loadBenchSample* sample);
+  void            loadAssimp(const std::string& file, loadBenchSample* sample);
+  void            loadGlb(const std::string& file, loadBenchSample* sample);
+  void            loadObj(const std::string& file, loadBenchSample* sample);
+
+  void writeCsv();
+  void printSummary(std::ostream& os);
+
+  static std::string glbFileName(const std::string& file);
+  static bool        isObjFile(const std::string& file);
+};
+
+#endif
@@ -11,20 +11,35 @@
 #include <glm/vec4.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include <stdexcept>
 #include <iostream>
 #include <vector>
+#include <cstring>
+#include <cstdlib>
 
 
 #include "vkContext.h"
+#include "frameLimiter.h"
+#include "allocTracker.h"
+#include "stressScene.h"
+#include "objectBench.h"
+#include "uploadBench.h"
+#include "loadBench.h"
+#include "chunkFile.h"
+#include "assetPack.h"
+#include "deviceScore.h"
 
 const std::string windowName = "Vulkan Test Window";
 const uint32_t windowWidth = 1366;
 const uint32_t windowHeight = 768;
 
 
-void initWindow(std::string, const uint32_t, const uint32_t height, GLFWwindow**);
+void initWindow(std::string, const uint32_t, const uint32_t height, GLFWwindow**, bool visible = true);
+void parseCounts(const char* list, std::vector<int>* counts);
+void parseNames(const char* list, std::vector<std::string>* names);
+std::string changeExtension(const std::string& fileName, const char* extension);
 
 
 /************************************************************************************************************************
@@ -37,6 +52,76 @@ void initWindow(std::string, const uint32_t, const uint32_t height, GLFWwindow**
  *             update == added code to change the model matrix causing the images to rotate about the Z-axis.  We use 
  *             a standard construct to ensure the rotation speed is constant regardless of the CPU speed or processor load.
  *
+ *             update == added '--stats' command line option, gathers per-model pipeline statistics and reports them
+ *             every few seconds.
+ *
+ *             update == added '--present=immediate|fifo|relaxed|mailbox' to select the presentation policy and 
+ *             '--fps=N' to limit the frame rate.  The present interval and CPU utilisation are reported with the stats.
+ *
+ *             update == added '--bench-jobs', runs the job system micro-benchmarks and exits without opening a window.
+ *
+ *             update == heap allocations are counted for each frame and reported with the stats.  '--check-allocs[=N]'
+ *             runs N frames (default 600) after a short warm up and exits with a failure code if any of them allocated.
+ *
+ *             update == the helicopter's transform is passed as position/rotation/scale through updateModels, the MVP
+ *             is composed by the context's transform store.  '--bench-transforms' compares it with the glm path.
+ *
+ *             update == added '--stress=N1,N2,...' and friends, fills a hidden window with N objects for each N and
+ *             writes frame time, record time, memory and resource usage to a CSV file.
+ *
+ *             update == added '--bench-objects[=N1,N2,...]', renders N quads offscreen with push constants, a dynamic
+ *             UBO, SSBO indexing and instancing and reports write/record/GPU time and upload bytes for each.
+ *
+ *             update == added '--bench-upload[=KB1,KB2,...]', times direct, staged, batched, staging ring and transfer
+ *             queue uploads on every device and prints the default upload policy for each device type.
+ *
+ *             update == '--model=FILE' picks the model shown, a .glb is read by our own loader rather than Assimp.
+ *             '--convert-glb=IN[,OUT]' writes a model as .glb and '--bench-load[=FILE1,...]' times both loaders.
+ *
+ *             update == .obj models are read by objLoader (parsed and welded in parallel on the job system) rather
+ *             than Assimp, '--bench-load' times it against the other two.
+ *
+ *             update == added '--meshlets', meshes are split into meshlets as they are loaded and a compute pass culls
+ *             them against the frustum and by normal cone every frame, only the visible clusters are drawn.
+ *
+ *             update == added '--merge-meshes', a model's meshes that share a texture are merged into one as it is
+ *             loaded, the draw calls before and after are reported.
+ *
+ *             update == '--build-chunks=IN[,OUT]' preprocesses a model into a chunk file (.vkc), '--model=FILE.vkc'
+ *             then streams it, paging chunks in by visibility under '--stream-budget=MB'.  Reported with '--stats'.
+ *
+ *             update == '--build-pack=OUT[,DIR,...]' packs the asset directories into one file, '--pack=FILE' then reads
+ *             shaders, textures and models out of it rather than the loose files.
+ *
+ *             update == the context is built as a dependency graph on the job system, the time to the first frame is
+ *             printed and '--stats' adds when each step of initContext ran.
+ *
+ *             update == physical devices are scored (type, device local memory, limits, optional features) and the
+ *             best used, '--device=N|UUID|NAME' or VULKAN7_DEVICE picks one instead.  '--check-device-score' checks
+ *             the scoring on made up devices and exits (non-zero if a check failed).
+ *
+ *             update == models and textures are referred to by generational handles (see handlePool.h) rather than
+ *             indices, so destroying one can not leave a caller pointing at whatever takes its place.
+ *
+ *             update == device memory is tracked as it is allocated (see gpuMemoryTracker.h), '--gpu-memory' reports
+ *             it with the timing every few seconds (as does '--stats').  Leaks are reported by cleanupContext.
+ *
+ *             update == added '--hud', draws the frame rate, a frame time graph, CPU and GPU times per phase, draw
+ *             calls, triangles and device memory over the scene, at the end of the post-process subpass.
+ *
+ *             update == the context counts draws, binds, push constant and upload bytes, submits and fence waits for
+ *             each frame (vkContext::getFrameStats); the HUD, the stress test and the timing report all use them.
+ *
+ *             update == added '--on-demand[=MS]', frames are only drawn when something changes and the loop otherwise
+ *             sleeps on window events (waking every MS ms, 500 by default, for the reports).  The helicopter stands
+ *             still; the left and right arrow keys turn it, up and down move the camera in and out.
+ *
+ *             update == the frame is described as a render graph (renderGraph.h) from which the render pass, its
+ *             dependencies, the cull barriers and the attachments' memory are derived; '--render-graph' prints it.
+ *
+ *             update == added '--views=N', N split screen views of the helicopter side by side, drawn in one pass with
+ *             VK_KHR_multiview (one view if the device does not have it).
+ *
  * parameters: argc -- [in] number of command line arguments
  *             argv -- [in] pointer to a C style string containing the various command line arguments.
  *
@@ -44,58 +129,385 @@ void initWindow(std::string, const uint32_t, const uint32_t height, GLFWwindow**
  *
  * written   : Mar 2024 (GKHuber)
  * modified  : Apr 2024 (GKHuber)
+ *             Oct 2026 (GKHuber)
 ************************************************************************************************************************/
 int main(int argc, char** argv)
 {
   GLFWwindow* window = nullptr;
+  bool        showStats = false;
+  bool        showTiming = false;
+  bool        showMemory = false;
+  bool        showHud = false;
+  bool        showGraph = false;        // print the render graph once the context is up
+  uint32_t    views = 1;                // split screen views, more than one is drawn with multiview
+  bool        onDemand = false;
+  double      idleTimeout = 0.5;        // seconds the loop sleeps waiting for events, drawing on demand
+  double      targetFps = 0.0;
+  presentPolicy policy = PRESENT_MAILBOX;
+  int         checkFrames = 0;          // non-zero => run this many frames checking for heap allocations, then exit
+  const int   warmupFrames = 10;        // frames allowed to allocate (first use of each swapchain image etc.)
+  stressConfig stress;                  // stress.counts non-empty => run the scaling test rather than the demo
+  uint32_t    texturePool = 0;          // zero => default size of the sampler descriptor pool
+  bool        policySet = false;
+  bool        benchObjects = false;
+  objectBenchConfig objectConfig;
+  bool        benchUpload = false;
+  uploadBenchConfig uploadConfig;
+  bool        benchLoad = false;
+  loadBenchConfig loadConfig;
+  std::string modelFile = "./Models/uh60.obj";
+  bool        meshlets = false;
+  bool        mergeMeshes = false;
+  uint64_t    streamBudget = 0;         // zero => the context's default budget for streamed models
+  assetPack   pack;                     // open => assets are read from it
+  std::string deviceSpec;               // empty => $VULKAN7_DEVICE, else the highest scoring device
+
+  for (int ndx = 1; ndx < argc; ndx++)
+  {
+    if (0 == strcmp(argv[ndx], "--stats")) { showStats = true; showTiming = true; }
+    else if (0 == strncmp(argv[ndx], "--fps=", 6)) { targetFps = atof(argv[ndx] + 6); showTiming = true; }
+    else if (0 == strcmp(argv[ndx], "--present=immediate")) { policy = PRESENT_LOW_LATENCY; showTiming = true; policySet = true; }
+    else if (0 == strcmp(argv[ndx], "--present=fifo")) { policy = PRESENT_VSYNC; showTiming = true; policySet = true; }
+    else if (0 == strcmp(argv[ndx], "--present=relaxed")) { policy = PRESENT_VSYNC_RELAXED; showTiming = true; policySet = true; }
+    else if (0 == strcmp(argv[ndx], "--present=mailbox")) { policy = PRESENT_MAILBOX; showTiming = true; policySet = true; }
+    else if (0 == strcmp(argv[ndx], "--bench-jobs")) { jobSystem::benchmark(std::cout); return 0; }
+    else if (0 == strcmp(argv[ndx], "--bench-transforms")) { transformStore::benchmark(std::cout); return 0; }
+    else if (0 == strcmp(argv[ndx], "--check-device-score")) { return checkDeviceScore(std::cout) ? EXIT_SUCCESS : EXIT_FAILURE; }
+    else if (0 == strcmp(argv[ndx], "--check-allocs")) { checkFrames = 600; }
+    else if (0 == strncmp(argv[ndx], "--check-allocs=", 15)) { checkFrames = std::max(1, atoi(argv[ndx] + 15)); }
+    else if (0 == strncmp(argv[ndx], "--stress=", 9)) { parseCounts(argv[ndx] + 9, &stress.counts); }
+    else if (0 == strncmp(argv[ndx], "--stress-model=", 15)) { stress.modelFile = argv[ndx] + 15; }
+    else if (0 == strncmp(argv[ndx], "--stress-textures=", 18)) { stress.textures = std::max(1, atoi(argv[ndx] + 18)); }
+    else if (0 == strncmp(argv[ndx], "--stress-triangles=", 19)) { stress.triangles = std::max(8, atoi(argv[ndx] + 19)); }
+    else if (0 == strcmp(argv[ndx], "--stress-random")) { stress.randomLayout = true; }
+    else if (0 == strncmp(argv[ndx], "--stress-random=", 16)) { stress.randomLayout = true; stress.seed = (unsigned)atoi(argv[ndx] + 16); }
+    else if (0 == strncmp(argv[ndx], "--stress-frames=", 16)) { stress.frames = std::max(1, atoi(argv[ndx] + 16)); }
+    else if (0 == strncmp(argv[ndx], "--stress-csv=", 13)) { stress.csvFile = argv[ndx] + 13; }
+    else if (0 == strcmp(argv[ndx], "--bench-objects")) { benchObjects = true; }
+    else if (0 == strncmp(argv[ndx], "--bench-objects=", 16)) { benchObjects = true; objectConfig.counts.clear(); parseCounts(argv[ndx] + 16, &objectConfig.counts); }
+    else if (0 == strncmp(argv[ndx], "--bench-objects-frames=", 23)) { objectConfig.frames = std::max(1, atoi(argv[ndx] + 23)); }
+    else if (0 == strncmp(argv[ndx], "--bench-objects-csv=", 20)) { objectConfig.csvFile = argv[ndx] + 20; }
+    else if (0 == strcmp(argv[ndx], "--bench-upload")) { benchUpload = true; }
+    else if (0 == strncmp(argv[ndx], "--bench-upload=", 15)) { benchUpload = true; uploadConfig.sizesKB.clear(); parseCounts(argv[ndx] + 15, &uploadConfig.sizesKB); }
+    else if (0 == strncmp(argv[ndx], "--bench-upload-lanes=", 21)) { uploadConfig.lanes = std::max(1, atoi(argv[ndx] + 21)); }
+    else if (0 == strncmp(argv[ndx], "--bench-upload-csv=", 19)) { uploadConfig.csvFile = argv[ndx] + 19; }
+    else if (0 == strcmp(argv[ndx], "--bench-load")) { benchLoad = true; }
+    else if (0 == strncmp(argv[ndx], "--bench-load=", 13)) { benchLoad = true; loadConfig.files.clear(); parseNames(argv[ndx] + 13, &loadConfig.files); }
+    else if (0 == strncmp(argv[ndx], "--bench-load-runs=", 18)) { loadConfig.runs = std::max(1, atoi(argv[ndx] + 18)); }
+    else if (0 == strncmp(argv[ndx], "--bench-load-csv=", 17)) { loadConfig.csvFile = argv[ndx] + 17; }
+    else if (0 == strncmp(argv[ndx], "--model=", 8)) { modelFile = argv[ndx] + 8; }
+    else if (0 == strcmp(argv[ndx], "--meshlets")) { meshlets = true; }
+    else if (0 == strcmp(argv[ndx], "--merge-meshes")) { mergeMeshes = true; }
+    else if (0 == strncmp(argv[ndx], "--convert-glb=", 14))
+    {
+      std::vector<std::string> names;
+      parseNames(argv[ndx] + 14, &names);
+      if (names.empty()) { std::cerr << "[-] --convert-glb needs a model file" << std::endl; return EXIT_FAILURE; }
+
+      std::string glbFile = (names.size() > 1) ? names[1] : changeExtension(names[0], ".glb");
+      try
+      {
+        glbLoader::convert(names[0], glbFile);
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << "[-] " << e.what() << std::endl;
+        return EXIT_FAILURE;
+      }
+      return EXIT_SUCCESS;
+    }
+    else if (0 == strncmp(argv[ndx], "--build-chunks=", 15))
+    {
+      std::vector<std::string> names;
+      parseNames(argv[ndx] + 15, &names);
+      if (names.empty()) { std::cerr << "[-] --build-chunks needs a model file" << std::endl; return EXIT_FAILURE; }
+
+      try
+      {
+        chunkFile::build(names[0], (names.size() > 1) ? names[1] : changeExtension(names[0], ".vkc"));
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << "[-] " << e.what() << std::endl;
+        return EXIT_FAILURE;
+      }
+      return EXIT_SUCCESS;
+    }
+    else if (0 == strncmp(argv[ndx], "--build-pack=", 13))
+    {
+      std::vector<std::string> names;
+      parseNames(argv[ndx] + 13, &names);
+      if (names.empty()) { std::cerr << "[-] --build-pack needs a pack file" << std::endl; return EXIT_FAILURE; }
+
+      std::vector<std::string> directories(names.begin() + 1, names.end());
+      if (directories.empty()) directories = { "./Shaders", "./Textures", "./Models" };
+      try
+      {
+        assetPack::build(names[0], directories);
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << "[-] " << e.what() << std::endl;
+        return EXIT_FAILURE;
+      }
+      return EXIT_SUCCESS;
+    }
+    else if (0 == strncmp(argv[ndx], "--pack=", 7))
+    {
+      try
+      {
+        pack.open(argv[ndx] + 7);
+        assetPack::setCurrent(&pack, nullptr);
+        std::cerr << "[+] reading assets from " << pack.getFileName() << " (" << pack.getEntryCount() << " entries)" << std::endl;
+      }
+      catch (const std::exception& e)
+      {
+        std::cerr << "[-] " << e.what() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    else if (0 == strncmp(argv[ndx], "--stream-budget=", 16)) { streamBudget = (uint64_t)std::max(1, atoi(argv[ndx] + 16)) * 1024 * 1024; }
+    else if (0 == strncmp(argv[ndx], "--device=", 9)) { deviceSpec = argv[ndx] + 9; }
+    else if (0 == strcmp(argv[ndx], "--gpu-memory")) { showMemory = true; showTiming = true; }
+    else if (0 == strcmp(argv[ndx], "--hud")) { showHud = true; }
+    else if (0 == strcmp(argv[ndx], "--render-graph")) { showGraph = true; }
+    else if (0 == strncmp(argv[ndx], "--views=", 8)) { views = static_cast<uint32_t>(std::max(1, atoi(argv[ndx] + 8))); }
+    else if (0 == strcmp(argv[ndx], "--on-demand")) { onDemand = true; }
+    else if (0 == strncmp(argv[ndx], "--on-demand=", 12)) { onDemand = true; idleTimeout = std::max(1, atoi(argv[ndx] + 12)) / 1000.0; }
+    else if (0 == strncmp(argv[ndx], "--texture-pool=", 15)) { texturePool = (uint32_t)std::max(1, atoi(argv[ndx] + 15)); }
+    else std::cerr << "[-] unknown option " << argv[ndx] << std::endl;
+  }
+
+  if (checkFrames > 0 && !allocationTrackingEnabled())
+  {
+    std::cerr << "[-] --check-allocs needs allocation tracking, rebuild without NDEBUG or with TRACK_ALLOCATIONS" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int exitCode = 0;
+
+  if (benchObjects)
+  {
+    objectConfig.device = deviceSpec;
+    objectBench bench(objectConfig);
+    return bench.run(std::cout);
+  }
+
+  if (benchUpload)
+  {
+    uploadBench bench(uploadConfig);
+    return bench.run(std::cout);
+  }
+
+  if (benchLoad)
+  {
+    loadBench bench(loadConfig);
+    return bench.run(std::cout);
+  }
+
+  if (!stress.counts.empty())
+  {
+    // scaling test; no vsync unless asked for, and room for the procedural textures plus the default one
+    initWindow(windowName, windowWidth, windowHeight, &window, false);
+
+    vkContext ctx(window, false);
+    ctx.setPresentPolicy(policySet ? policy : PRESENT_LOW_LATENCY);
+    ctx.setDeviceOverride(deviceSpec);
+    ctx.setTexturePoolSize((texturePool > 0) ? texturePool : std::max<uint32_t>(MAX_OBJECTS, stress.textures + 1));
+    ctx.setMeshlets(meshlets);
+    ctx.setMergeMeshes(mergeMeshes);
+    if (streamBudget > 0) ctx.setStreamBudget(streamBudget);
+    if (pack.isOpen()) assetPack::setCurrent(&pack, &ctx.getJobSystem());
+    if (EXIT_SUCCESS == ctx.initContext())
+    {
+      stressScene scene(&ctx, window, stress);
+      exitCode = scene.run();
+
+      ctx.cleanupContext();
+      assetPack::setCurrent(nullptr, nullptr);
+    }
+    else
+    {
+      exitCode = EXIT_FAILURE;
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return exitCode;
+  }
 
   initWindow(windowName, windowWidth, windowHeight, &window);
 
   vkContext    ctx(window, true);      // NOTE: the false turns off validation
+  ctx.setPresentPolicy(policy);
+  ctx.setDeviceOverride(deviceSpec);
+  ctx.setHud(showHud);
+  ctx.setOnDemand(onDemand);
+  ctx.setViews(views);
+  if (texturePool > 0) ctx.setTexturePoolSize(texturePool);
+  ctx.setMeshlets(meshlets);
+  ctx.setMergeMeshes(mergeMeshes);
+  if (streamBudget > 0) ctx.setStreamBudget(streamBudget);
+  if (pack.isOpen()) assetPack::setCurrent(&pack, &ctx.getJobSystem());
   if (EXIT_SUCCESS == ctx.initContext())
   {
     float  angle = 0.0f;                // angle that the image should be rotated through
     float  deltaTime = 0.0f;            // time elapse since the last image was drawn
     float  lastTime = 0.0f;             // time last render occured at.
 
-    int helicopter = ctx.createMeshModel("./Models/uh60.obj");
+    modelHandle helicopter = ctx.createMeshModel(modelFile);
+    if (showGraph) ctx.reportRenderGraph(std::cout);
+
+    ctx.enablePipelineStatistics(showStats);
+    float  lastReport = 0.0f;           // time the statistics were last reported
+
+    frameLimiter limiter(targetFps);    // zero => unlimited, but still measures the frame interval
+
+    int      frameNumber = 0;
+    int      failedFrames = 0;           // frames that allocated while checking
+    uint64_t windowAllocs = 0;           // allocations since the last report
+    uint64_t windowFrames = 0;
+    uint64_t windowLoops = 0;            // passes of the loop, drawing on demand most draw nothing
+    float    distance = 10.0f;           // of the camera from the helicopter, drawing on demand
+
+    // a window that has been uncovered or restored must be painted again even if nothing in the scene has changed
+    if (onDemand)
+    {
+      glfwSetWindowUserPointer(window, &ctx);
+      glfwSetWindowRefreshCallback(window, [](GLFWwindow* w) { static_cast<vkContext*>(glfwGetWindowUserPointer(w))->invalidate(); });
+    }
 
     while (!glfwWindowShouldClose(window))
     {
-      glfwPollEvents();
+      allocCounts frameStart = getAllocationCounts();
+
+      // on demand, sleep until there is an event (or it is time for a report) unless a frame is already wanted
+      if (onDemand && !ctx.needsRedraw()) glfwWaitEventsTimeout(idleTimeout);
+      else glfwPollEvents();
 
       float  now = glfwGetTime();              // current time, in seconds of the GLFW timer 
 
       deltaTime = now - lastTime;              // calculate elapsed time
       lastTime = now;                          // update last rendered time
 
-      angle += 10.0f * deltaTime;              // update angle, scaled to elapsed time
+      // on demand the helicopter only turns while an arrow key is held; the first step after sleeping is not the
+      // time slept
+      int  turn = 0;
+      bool moved = !onDemand || 0 == frameNumber;
+      if (onDemand)
+      {
+        float step = std::min(deltaTime, 0.05f);
+        int   zoom = (GLFW_PRESS == glfwGetKey(window, GLFW_KEY_DOWN)) - (GLFW_PRESS == glfwGetKey(window, GLFW_KEY_UP));
+        turn = (GLFW_PRESS == glfwGetKey(window, GLFW_KEY_LEFT)) - (GLFW_PRESS == glfwGetKey(window, GLFW_KEY_RIGHT));
+        angle += 90.0f * step * turn;
+        moved = moved || 0 != turn;
+
+        if (0 != zoom)
+        {
+          distance = std::min(std::max(distance + 10.0f * step * zoom, 2.0f), 40.0f);
+          ctx.setCamera(glm::vec3(distance, 0.0f, 0.2f * distance), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        }
+      }
+      else
+      {
+        angle += 10.0f * deltaTime;            // update angle, scaled to elapsed time
+      }
       if (angle > 360.0f) { angle -= 360.0; }  // clamp angle in range [0,360)
+      if (angle < 0.0f) { angle += 360.0; }
+
+      // same transform as scale(0.4) * rotate(-90, x) * rotate(angle, z), but as TRS so it takes the batched path
+      if (moved)
+      {
+        glm::vec3 position(0.0f, 0.0f, 0.0f);
+        glm::vec3 scale(0.4f, 0.4f, 0.4f);
+        glm::quat rotation = glm::angleAxis(glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f)) *
+                             glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 0.0f, 1.0f));
+        ctx.updateModels(&helicopter, 1, &position, &rotation, &scale);
+      }
+
+      windowLoops++;
+      if (ctx.draw())
+      {
+        limiter.waitForNextFrame();
+
+        allocCounts frameAllocs = allocationsSince(frameStart);
+        frameNumber++;
+        if (showStats && 1 == frameNumber) ctx.reportInitialisation(std::cout);
+        windowAllocs += frameAllocs.allocations;
+        windowFrames++;
 
-      glm::mat4 testMat = glm::scale(glm::mat4(1.0), glm::vec3(0.4f, 0.4f, 0.4f));
-      testMat = glm::rotate(testMat, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-      //testMat = glm::rotate(testMat, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-      testMat = glm::rotate(testMat, glm::radians(angle), glm::vec3(0.0f, 0.0f, 1.0f));
-      ctx.updateModel(helicopter, testMat);
+        if (checkFrames > 0 && frameNumber > warmupFrames)
+        {
+          if (0 != frameAllocs.allocations)
+          {
+            if (failedFrames < 10)
+            {
+              std::cerr << "[-] frame " << frameNumber << " made " << frameAllocs.allocations << " heap allocations ("
+                        << frameAllocs.bytes << " bytes)" << std::endl;
+            }
+            failedFrames++;
+          }
 
-      ctx.draw();
+          if (frameNumber >= warmupFrames + checkFrames)
+          {
+            if (0 == failedFrames)
+            {
+              std::cout << "[+] no heap allocations in " << checkFrames << " frames" << std::endl;
+            }
+            else
+            {
+              std::cerr << "[-] " << failedFrames << " of " << checkFrames << " frames made heap allocations" << std::endl;
+              exitCode = EXIT_FAILURE;
+            }
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+          }
+        }
+      }
+
+      if ((showStats || showTiming) && (now - lastReport) > 5.0f)
+      {
+        if (showStats) ctx.reportPipelineStatistics(std::cout);
+        if (showStats) ctx.reportStreaming(std::cout);
+        if (showStats || showMemory) ctx.reportDeviceMemory(std::cout);
+        ctx.reportFrameStats(std::cout);
+
+        frameTimingStats timing;
+        limiter.getStats(&timing);
+        std::cout << "[?] present mode " << presentModeName(ctx.getPresentMode()) << ", target fps " << limiter.getTargetFps()
+                  << ": interval " << timing.avgIntervalMs << " ms (min " << timing.minIntervalMs << ", max " << timing.maxIntervalMs
+                  << "), " << timing.fps << " fps, cpu " << timing.cpuUtilisation * 100.0 << "%" << std::endl;
+        if (onDemand)
+        {
+          std::cout << "[?] on demand: " << windowFrames << " frames drawn in " << windowLoops << " passes of the loop" << std::endl;
+        }
+        if (allocationTrackingEnabled() && windowFrames > 0)
+        {
+          std::cout << "[?] heap allocations: " << (double)windowAllocs / (double)windowFrames << " per frame" << std::endl;
+        }
+        windowAllocs = 0;
+        windowFrames = 0;
+        windowLoops = 0;
+        lastReport = now;
+      }
     }
 
     ctx.cleanupContext();
+    assetPack::setCurrent(nullptr, nullptr);
     glfwDestroyWindow(window);
     glfwTerminate();
   }
 
-  return 0;
+  return exitCode;
 }
 
-void initWindow(std::string name, const uint32_t width, const uint32_t height, GLFWwindow** ppWindow)
+void initWindow(std::string name, const uint32_t width, const uint32_t height, GLFWwindow** ppWindow, bool visible)
 {
   int ret = glfwInit();
   if (ret == GLFW_TRUE)
   {
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);                  // tell GLFW not to use OpenGL
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);                    // make window non-resizeable
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE); // hidden windows are used for off screen runs
 
     *ppWindow = glfwCreateWindow(width, height, name.c_str(), nullptr, nullptr);
     if (*ppWindow == nullptr)
@@ -109,3 +521,45 @@ void initWindow(std::string name, const uint32_t width, const uint32_t height, G
     std::cerr << "Failed to initialize GLFW" << std::endl;
   }
 }
+
+
+
+// parses a comma separated list of object counts, e.g. "1,10,100,1000"
+void parseCounts(const char* list, std::vector<int>* counts)
+{
+  while (nullptr != list && '\0' != *list)
+  {
+    int count = atoi(list);
+    if (count > 0) counts->push_back(count);
+
+    list = strchr(list, ',');
+    if (nullptr != list) list++;
+  }
+}
+
+
+
+// parses a comma separated list of file names, e.g. "./Models/uh60.obj,./Models/x-wing.obj"
+void parseNames(const char* list, std::vector<std::string>* names)
+{
+  while (nullptr != list && '\0' != *list)
+  {
+    const char* comma = strchr(list, ',');
+    std::string name = (nullptr != comma) ? std::string(list, comma - list) : std::string(list);
+    if (!name.empty()) names->push_back(name);
+
+    list = (nullptr != comma) ? comma + 1 : nullptr;
+  }
+}
+
+
+
+// replaces a file name's extension (or adds one if it has none), e.g. changeExtension("./Models/uh60.obj", ".vkc")
+std::string changeExtension(const std::string& fileName, const char* extension)
+{
+  size_t dot = fileName.find_last_of('.');
+  size_t slash = fileName.find_last_of("/\\");
+  bool   hasExtension = (std::string::npos != dot && (std::string::npos == slash || dot > slash));
+
+  return fileName.substr(0, hasExtension ? dot : fileName.size()) + extension;
+}
@@ -0,0 +1,171 @@
+#include "mappedFile.h"
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+mappedFile::mappedFile() : m_data(nullptr), m_size(0), m_lead(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr) { }
+#else
+mappedFile::mappedFile() : m_data(nullptr), m_size(0), m_lead(0) { }
+#endif
+
+mappedFile::~mappedFile()
+{
+  close();
+}
+
+
+
+// maps the whole file
+void mappedFile::open(const std::string& fileName)
+{
+  open(fileName, 0, SIZE_MAX);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : open
+ *
+ * abstract  : Maps 'length' bytes of fileName from 'offset' read-only.  The view has to start on the OS's mapping
+ *             granularity (a page on POSIX, 64 KB on Windows) so the offset is rounded down and data() points the
+ *             difference in.  An empty range is not an error, data() is then nullptr and size() zero.  Any mapping
+ *             already held is released first.
+ *
+ * parameters: fileName -- [in] path of the file to map
+ *             offset -- [in] first byte of the range
+ *             length -- [in] bytes in the range, SIZE_MAX => to the end of the file
+ *
+ * returns   : void, throws std::runtime_error if the file can not be opened or mapped, or the range is not inside it
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) maps a range of the file, for asset pack entries
+************************************************************************************************************************/
+void mappedFile::open(const std::string& fileName, uint64_t offset, size_t length)
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (INVALID_HANDLE_VALUE == file)
+  {
+    std::cerr << "[-] failed to open " << fileName << std::endl;
+    throw std::runtime_error("failed to open " + fileName);
+  }
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize))
+  {
+    CloseHandle(file);
+    throw std::runtime_error("failed to get the size of " + fileName);
+  }
+
+  m_file = file;
+  uint64_t total = static_cast<uint64_t>(fileSize.QuadPart);
+  if (offset > total || (SIZE_MAX != length && length > total - offset))
+  {
+    close();
+    throw std::runtime_error("range is not inside " + fileName);
+  }
+
+  m_size = (SIZE_MAX == length) ? static_cast<size_t>(total - offset) : length;
+  if (0 == m_size) return;
+
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  m_lead = static_cast<size_t>(offset % info.dwAllocationGranularity);
+  uint64_t viewOffset = offset - m_lead;
+
+  m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (nullptr == m_mapping)
+  {
+    close();
+    throw std::runtime_error("failed to create a file mapping for " + fileName);
+  }
+
+  const uint8_t* view = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, static_cast<DWORD>(viewOffset >> 32),
+                                                                  static_cast<DWORD>(viewOffset), m_lead + m_size));
+  if (nullptr == view)
+  {
+    close();
+    throw std::runtime_error("failed to map " + fileName);
+  }
+  m_data = view + m_lead;
+#else
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cerr << "[-] failed to open " << fileName << std::endl;
+    throw std::runtime_error("failed to open " + fileName);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    throw std::runtime_error("failed to get the size of " + fileName);
+  }
+
+  uint64_t total = static_cast<uint64_t>(st.st_size);
+  if (offset > total || (SIZE_MAX != length && length > total - offset))
+  {
+    ::close(fd);
+    throw std::runtime_error("range is not inside " + fileName);
+  }
+
+  m_size = (SIZE_MAX == length) ? static_cast<size_t>(total - offset) : length;
+  if (0 == m_size)
+  {
+    ::close(fd);
+    return;
+  }
+
+  m_lead = static_cast<size_t>(offset % static_cast<uint64_t>(sysconf(_SC_PAGESIZE)));
+
+  // the mapping keeps its own reference to the file, so the descriptor can be closed straight away
+  void* p = mmap(nullptr, m_lead + m_size, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(offset - m_lead));
+  ::close(fd);
+  if (MAP_FAILED == p)
+  {
+    m_size = 0;
+    m_lead = 0;
+    throw std::runtime_error("failed to map " + fileName);
+  }
+
+  // the loaders read front to back
+  madvise(p, m_lead + m_size, MADV_SEQUENTIAL);
+  m_data = static_cast<const uint8_t*>(p) + m_lead;
+#endif
+}
+
+
+
+void mappedFile::close()
+{
+#ifdef _WIN32
+  if (nullptr != m_data) UnmapViewOfFile(m_data - m_lead);
+  if (nullptr != m_mapping) CloseHandle(m_mapping);
+  if (INVALID_HANDLE_VALUE != m_file) CloseHandle(m_file);
+  m_mapping = nullptr;
+  m_file = INVALID_HANDLE_VALUE;
+#else
+  if (nullptr != m_data) munmap(const_cast<uint8_t*>(m_data - m_lead), m_lead + m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+  m_lead = 0;
+}
@@ -0,0 +1,40 @@
+#ifndef _mappedFile_h_
+#define _mappedFile_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap on POSIX, a file mapping object on Windows).  The loaders read
+// straight out of the mapping, the OS pages the file in as it is touched and nothing is copied into a heap buffer
+// first.  A range of a file can be mapped as well, so an entry of an asset pack reads like a file of its own.  Not
+// copyable, the mapping is released by close or the destructor.
+class mappedFile
+{
+public:
+  mappedFile();
+  ~mappedFile();
+
+  mappedFile(const mappedFile&) = delete;
+  mappedFile& operator=(const mappedFile&) = delete;
+
+  void open(const std::string& fileName);            // throws std::runtime_error if the file can not be mapped
+  void open(const std::string& fileName, uint64_t offset, size_t length);      // maps part of a file, e.g. a pack entry
+  void close();
+
+  const uint8_t* data() const { return m_data; }
+  size_t         size() const { return m_size; }
+  bool           isOpen() const { return nullptr != m_data; }
+
+private:
+  const uint8_t* m_data;
+  size_t         m_size;
+  size_t         m_lead;                              // bytes mapped before m_data, the view starts on a granule
+
+#ifdef _WIN32
+  void*          m_file;                              // HANDLEs, kept as void* so windows.h stays out of the header
+  void*          m_mapping;
+#endif
+};
+
+#endif
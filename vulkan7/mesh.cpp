@@ -4,19 +4,34 @@
 
 mesh::mesh() { }
 
-mesh::mesh(VkPhysicalDevice phyDevice, VkDevice logDevice, VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<vertex>* vertices, std::vector<uint32_t>* indices, int newTexId)
+mesh::mesh(VkPhysicalDevice phyDevice, VkDevice logDevice, VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<vertex>* vertices, std::vector<uint32_t>* indices, textureHandle texture,
+           bool buildMeshlets)
+  : mesh(phyDevice, logDevice, xferQueue, xferCmdPool, vertices->data(), (uint32_t)vertices->size(), indices->data(), (uint32_t)indices->size(), texture,
+         buildMeshlets)
 {
-  m_vertexCount = (int)vertices->size();
-	m_indexCount = (int)indices->size();
+}
+
+mesh::mesh(VkPhysicalDevice phyDevice, VkDevice logDevice, VkQueue xferQueue, VkCommandPool xferCmdPool, const void* vertexData, uint32_t vertexCount,
+           const void* indexData, uint32_t indexCount, textureHandle texture, bool buildMeshlets)
+{
+  m_vertexCount = (int)vertexCount;
+	m_indexCount = (int)indexCount;
 
   m_physical = phyDevice;
   m_device = logDevice;
 
-  createVertexBuffer(xferQueue, xferCmdPool, vertices);
-	createIndexBuffer(xferQueue, xferCmdPool, indices);
+  createVertexBuffer(xferQueue, xferCmdPool, vertexData, vertexCount);
+	createIndexBuffer(xferQueue, xferCmdPool, indexData, indexCount);
 
 	m_model.model = glm::mat4(1.0f);
-	m_texId = newTexId;
+	m_texture = texture;
+
+  if (buildMeshlets)
+  {
+    m_meshletData.reset(new meshletData);
+    meshletBuilder::build(vertexData, vertexCount, indexData, indexCount, m_meshletData.get());
+    m_meshletCount = (int)m_meshletData->meshlets.size();
+  }
 }
 
 mesh::~mesh()
@@ -34,9 +49,9 @@ Model mesh::getModel()
 	return m_model;
 }
 
-int mesh::getTexId()
+textureHandle mesh::getTexture()
 {
-	return m_texId;
+	return m_texture;
 }
 
 int mesh::getVertexCount()
@@ -51,22 +66,26 @@ int mesh::getIndexCount()
 
 VkBuffer mesh::getVertexBuffer()
 {
-  return m_vertexBuffer;
+  return m_vertexBuffer.get();
 }
 
 VkBuffer mesh::getIndexBuffer()
 {
-	return m_indexBuffer;
+	return m_indexBuffer.get();
 }
 
 
 void mesh::destroyBuffers()
 {
-  vkDestroyBuffer(m_device, m_vertexBuffer, nullptr);
-  vkFreeMemory(m_device, m_vertexBufferMemory, nullptr);
+  m_vertexBuffer.reset();
+	m_indexBuffer.reset();
+}
+
 
-	vkDestroyBuffer(m_device, m_indexBuffer, nullptr);
-	vkFreeMemory(m_device, m_indexBufferMemory, nullptr);
+void mesh::setMemoryOwner(deviceMemoryOwner owner)
+{
+  m_vertexBuffer.setOwner(owner);
+  m_indexBuffer.setOwner(owner);
 }
 
 /************************************************************************************************************************
@@ -80,16 +99,19 @@ void mesh::destroyBuffers()
  * parameters: xferQueue -- [in] a Vulkan object that represents the transfer queue to use for the operation (by standard
  *                          the graphics queue must support a transfer operation).
  *             xferCmdPool -- [in] a command pool to use to created the command executed on the xferQueue
- *             vertices -- [in] pointer to a std::vector containing the vertex data for each point 
+ *             vertices -- [in] pointer to the vertex data for each point, copied with memcpy so it need not be aligned
+ *             vertexCount -- [in] number of vertices
  *
  * returns   : void, modifies m_vertexBuffer.
  *
  * written   : Mar 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) takes a pointer and count so a mapped file can be copied straight into staging
+ * modified  : Oct 2026 (GKHuber) the buffer is held by a gpuBuffer, which destroys it with the mesh
 ************************************************************************************************************************/
-void mesh::createVertexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<vertex>* vertices)
+void mesh::createVertexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, const void* vertices, size_t vertexCount)
 {
 	// Get size of buffer needed for vertices
-	VkDeviceSize bufferSize = sizeof(vertex) * vertices->size();
+	VkDeviceSize bufferSize = sizeof(vertex) * vertexCount;
 
 	// Temporary buffer to "stage" vertex data before transferring to GPU
 	VkBuffer stagingBuffer;
@@ -103,26 +125,29 @@ void mesh::createVertexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, std:
 	// MAP MEMORY TO VERTEX BUFFER
 	void* data;																// 1. Create pointer to a point in normal memory
 	vkMapMemory(m_device, stagingBufferMemory, 0, bufferSize, 0, &data);			// 2. "Map" the vertex buffer memory to that point
-	memcpy(data, vertices->data(), (size_t)bufferSize);							// 3. Copy memory from vertices vector to the point
+	memcpy(data, vertices, (size_t)bufferSize);							// 3. Copy memory from vertices to the point
 	vkUnmapMemory(m_device, stagingBufferMemory);									// 4. Unmap the vertex buffer memory
 
 	// Create buffer with TRANSFER_DST_BIT to mark as recipient of transfer data (also VERTEX_BUFFER)
 	// Buffer memory is to be DEVICE_LOCAL_BIT meaning memory is on the GPU and only accessible by it and not CPU (host)
+	VkBuffer vertexBuffer;
+	VkDeviceMemory vertexBufferMemory;
 	createBuffer(m_physical, m_device, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_vertexBuffer, &m_vertexBufferMemory);
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &vertexBuffer, &vertexBufferMemory);
+	m_vertexBuffer = gpuBuffer(m_device, vertexBuffer, vertexBufferMemory);
 
 	// Copy staging buffer to vertex buffer on GPU
-	copyBuffer(m_device, xferQueue, xferCmdPool, stagingBuffer, m_vertexBuffer, bufferSize);
+	copyBuffer(m_device, xferQueue, xferCmdPool, stagingBuffer, m_vertexBuffer.get(), bufferSize);
 
 	// Clean up staging buffer parts
 	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+	freeDeviceMemory(m_device, stagingBufferMemory);
 }
 
-void mesh::createIndexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<uint32_t>* indices)
+void mesh::createIndexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, const void* indices, size_t indexCount)
 {
 	// Get size of buffer needed for indices
-	VkDeviceSize bufferSize = sizeof(uint32_t) * indices->size();
+	VkDeviceSize bufferSize = sizeof(uint32_t) * indexCount;
 
 	// Temporary buffer to "stage" index data before transferring to GPU
 	VkBuffer stagingBuffer;
@@ -133,19 +158,22 @@ void mesh::createIndexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, std::
 	// MAP MEMORY TO INDEX BUFFER
 	void* data;
 	vkMapMemory(m_device, stagingBufferMemory, 0, bufferSize, 0, &data);
-	memcpy(data, indices->data(), (size_t)bufferSize);
+	memcpy(data, indices, (size_t)bufferSize);
 	vkUnmapMemory(m_device, stagingBufferMemory);
 
 	// Create buffer for INDEX data on GPU access only area
+	VkBuffer indexBuffer;
+	VkDeviceMemory indexBufferMemory;
 	createBuffer(m_physical, m_device, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_indexBuffer, &m_indexBufferMemory);
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &indexBuffer, &indexBufferMemory);
+	m_indexBuffer = gpuBuffer(m_device, indexBuffer, indexBufferMemory);
 
 	// Copy from staging buffer to GPU access buffer
-	copyBuffer(m_device, xferQueue, xferCmdPool, stagingBuffer, m_indexBuffer, bufferSize);
+	copyBuffer(m_device, xferQueue, xferCmdPool, stagingBuffer, m_indexBuffer.get(), bufferSize);
 
 	// Destroy + Release Staging Buffer resources
 	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+	freeDeviceMemory(m_device, stagingBufferMemory);
 }
 
 
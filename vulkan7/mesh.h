@@ -4,51 +4,76 @@
 #define GLFW_INCLUDE_VULKAN
 #include<GLFW/glfw3.h>
 
+#include <memory>
 #include <vector>
 
 #include "utilities.h"
+#include "meshletBuilder.h"
+#include "handlePool.h"
+#include "gpuResource.h"
 
+// push constant, holds the model matrix already multiplied by projection * view (see transformStore)
 struct Model {
   glm::mat4 model;
 };
 
+// A mesh owns its vertex and index buffers, they are destroyed with it.  Meshes can be moved but not copied, models
+// that share a mesh list share it through MeshModel.
 class mesh
 {
 public:
   mesh();
-  mesh(VkPhysicalDevice, VkDevice, VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<vertex>*, std::vector<uint32_t>*, int newTexId);
+  mesh(VkPhysicalDevice, VkDevice, VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<vertex>*, std::vector<uint32_t>*, textureHandle texture,
+       bool buildMeshlets = false);
+  mesh(VkPhysicalDevice, VkDevice, VkQueue xferQueue, VkCommandPool xferCmdPool, const void* vertexData, uint32_t vertexCount,
+       const void* indexData, uint32_t indexCount, textureHandle texture, bool buildMeshlets = false);     // raw data, need not be aligned (e.g. a mapped file)
   ~mesh();
 
+  mesh(const mesh&) = delete;
+  mesh& operator=(const mesh&) = delete;
+  mesh(mesh&&) noexcept = default;
+  mesh& operator=(mesh&&) noexcept = default;
+
   void setModel(glm::mat4 newModel);
   Model getModel();
 
   int getVertexCount();
   int getIndexCount();
-  int getTexId();
+  textureHandle getTexture();                      // null => drawn with the default texture
 
 
   VkBuffer getVertexBuffer();
   VkBuffer getIndexBuffer();
+
+  // meshlets, built on the CPU by the constructor and handed to the context (which owns the GPU copy) by addModel
+  const meshletData* getMeshletData() { return m_meshletData.get(); }
+  void releaseMeshletData() { m_meshletData.reset(); }
+  int  getFirstMeshlet() { return m_firstMeshlet; }
+  int  getMeshletCount() { return m_meshletCount; }
+  void setFirstMeshlet(int first) { m_firstMeshlet = first; }
   
-  void destroyBuffers();
+  void destroyBuffers();                           // early, e.g. a chunk evicted by a stream; the destructor does it otherwise
+  void setMemoryOwner(deviceMemoryOwner owner);    // who the device memory report charges the buffers to
 
 private:
-  Model            m_model;
-  int              m_texId;
+  // what recordcommands reads for every draw, together at the front
+  gpuBuffer        m_vertexBuffer;
+  gpuBuffer        m_indexBuffer;
+  int              m_indexCount = 0;
+  textureHandle    m_texture;
+  int              m_firstMeshlet = -1;             // in the context's meshlet buffer, -1 => drawn whole
+  int              m_meshletCount = 0;
 
-  int              m_vertexCount;
-  VkBuffer         m_vertexBuffer;
-  VkDeviceMemory   m_vertexBufferMemory;
+  int              m_vertexCount = 0;
 
-  int              m_indexCount;
-  VkBuffer         m_indexBuffer;
-  VkDeviceMemory   m_indexBufferMemory;
+  VkPhysicalDevice m_physical = VK_NULL_HANDLE;
+  VkDevice         m_device = VK_NULL_HANDLE;
 
-  VkPhysicalDevice m_physical;
-  VkDevice         m_device;
+  Model            m_model;
+  std::unique_ptr<meshletData> m_meshletData;
 
-  void      createVertexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<vertex>* vertices);
-  void      createIndexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, std::vector<uint32_t>* indices);
+  void      createVertexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, const void* vertices, size_t vertexCount);
+  void      createIndexBuffer(VkQueue xferQueue, VkCommandPool xferCmdPool, const void* indices, size_t indexCount);
 
 };
 
@@ -0,0 +1,107 @@
+#include "meshMerger.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+
+
+/************************************************************************************************************************
+ * function  : add
+ *
+ * abstract  : Appends one mesh to the group for its texture.  Vertices are copied (with memcpy, so the data may come
+ *             straight from a mapped file) and, if a transform is given, their positions are transformed into model
+ *             space.  Indices are rebased onto the group's vertices; a triangle with an index out of range is dropped.
+ *
+ * parameters: vertexData -- [in] vertexCount vertices, as given to the mesh constructor
+ *             vertexCount -- [in] number of vertices
+ *             indexData -- [in] indexCount uint32_t indices, a triangle list
+ *             indexCount -- [in] number of indices
+ *             texId -- [in] texture of the mesh as an index into the caller's table, meshes with the same texture are
+ *                      merged
+ *             transform -- [in] places the mesh in the model, nullptr if it is already in model space
+ *
+ * returns   : void, throws a runtime error if a group would need more than 2^32 vertices
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void meshMerger::add(const void* vertexData, uint32_t vertexCount, const void* indexData, uint32_t indexCount, int texId,
+                     const glm::mat4* transform)
+{
+  m_sourceCount++;
+  if (0 == vertexCount || indexCount < 3) return;
+
+  auto found = m_groupOfTexture.find(texId);
+  if (m_groupOfTexture.end() == found)
+  {
+    found = m_groupOfTexture.emplace(texId, m_groups.size()).first;
+    m_groups.push_back(meshGroup());
+    m_groups.back().texId = texId;
+  }
+  meshGroup& group = m_groups[found->second];
+
+  size_t base = group.vertices.size();
+  if (base + vertexCount > std::numeric_limits<uint32_t>::max())
+  {
+    throw std::runtime_error("too many vertices to merge into one mesh");
+  }
+
+  group.vertices.resize(base + vertexCount);
+  memcpy(&group.vertices[base], vertexData, vertexCount * sizeof(vertex));
+  if (nullptr != transform)
+  {
+    for (size_t v = base; v < group.vertices.size(); v++)
+    {
+      group.vertices[v].pos = glm::vec3(*transform * glm::vec4(group.vertices[v].pos, 1.0f));
+    }
+  }
+
+  const uint8_t* indexBytes = static_cast<const uint8_t*>(indexData);
+  group.indices.reserve(group.indices.size() + indexCount);
+  for (uint32_t t = 0; t + 2 < indexCount; t += 3)
+  {
+    uint32_t tri[3];
+    memcpy(tri, indexBytes + t * sizeof(uint32_t), sizeof(tri));
+    if (tri[0] >= vertexCount || tri[1] >= vertexCount || tri[2] >= vertexCount) continue;
+
+    for (uint32_t corner : tri) group.indices.push_back(static_cast<uint32_t>(base + corner));
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : build
+ *
+ * abstract  : Creates one mesh per texture group, in the order the groups were started.  The merged data is released
+ *             as each mesh is made, so the merger is empty afterwards (the counts are kept for reporting).
+ *
+ * parameters: physical, device -- [in] device to create the buffers on
+ *             xferQueue, xferCmdPool -- [in] queue and command pool for the staging copies
+ *             textures -- [in] the texture of each index given to add, one out of range gets the default texture
+ *             buildMeshlets -- [in] also split the merged meshes into meshlets (see vkContext::setMeshlets)
+ *
+ * returns   : std::vector<mesh>, the merged meshes
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) textures are looked up in a table, meshes hold texture handles
+************************************************************************************************************************/
+std::vector<mesh> meshMerger::build(VkPhysicalDevice physical, VkDevice device, VkQueue xferQueue, VkCommandPool xferCmdPool,
+                                    const std::vector<textureHandle>& textures, bool buildMeshlets)
+{
+  std::vector<mesh> meshes;
+  meshes.reserve(m_groups.size());
+
+  for (meshGroup& group : m_groups)
+  {
+    if (group.indices.empty()) continue;
+
+    textureHandle texture = (group.texId >= 0 && group.texId < (int)textures.size()) ? textures[group.texId] : textureHandle();
+    meshes.emplace_back(physical, device, xferQueue, xferCmdPool, &group.vertices, &group.indices, texture, buildMeshlets);
+
+    std::vector<vertex>().swap(group.vertices);
+    std::vector<uint32_t>().swap(group.indices);
+  }
+
+  return meshes;
+}
@@ -0,0 +1,45 @@
+#ifndef _meshMerger_h_
+#define _meshMerger_h_
+
+#include <unordered_map>
+#include <vector>
+
+#include "mesh.h"
+
+// Merges the meshes of one model that share a texture into a single vertex/index range each, so the model is drawn
+// with one call per distinct texture rather than one per mesh.  Meshes are given to add() as the loaders produce them,
+// with the transform that places them in the model (their node's, for formats that have a node hierarchy); positions
+// are pre-transformed by it as they are copied, so the merged meshes are all in model space.  Groups keep the order of
+// their first mesh, so the draw order stays close to the unmerged one.  Textures are given as an index into a table
+// of the caller's (its materials, or the texture names of a chunk file), build() turns them into texture handles.
+class meshMerger
+{
+public:
+  void add(const void* vertexData, uint32_t vertexCount, const void* indexData, uint32_t indexCount, int texId,
+           const glm::mat4* transform = nullptr);   // nullptr => already in model space
+
+  std::vector<mesh> build(VkPhysicalDevice, VkDevice, VkQueue xferQueue, VkCommandPool xferCmdPool,
+                          const std::vector<textureHandle>& textures, bool buildMeshlets);
+
+  size_t getSourceCount() { return m_sourceCount; }    // meshes added, i.e. draws without merging
+  size_t getGroupCount() { return m_groups.size(); }   // draws after merging
+
+  // the merged data, for callers that write it out rather than upload it (see chunkFile::build)
+  int                    getGroupTexture(size_t group) { return m_groups[group].texId; }
+  std::vector<vertex>*   getGroupVertices(size_t group) { return &m_groups[group].vertices; }
+  std::vector<uint32_t>* getGroupIndices(size_t group) { return &m_groups[group].indices; }
+
+private:
+  struct meshGroup
+  {
+    int                   texId;
+    std::vector<vertex>   vertices;
+    std::vector<uint32_t> indices;
+  };
+
+  std::vector<meshGroup>       m_groups;
+  std::unordered_map<int, size_t> m_groupOfTexture;
+  size_t                       m_sourceCount = 0;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "meshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+static const uint32_t NOT_IN_MESHLET = 0xffffffff;
+
+static_assert(sizeof(meshlet) == 48, "meshlet must match the layout Shaders/cull.comp reads");
+
+
+
+/************************************************************************************************************************
+ * function  : build
+ *
+ * abstract  : Splits a mesh into meshlets.  Triangles are added to the current meshlet in index order, its vertices
+ *             being given local numbers through a table indexed by mesh vertex (reset for just the vertices used when the
+ *             meshlet is closed, so the whole build is linear in the size of the mesh).  A meshlet is closed when the
+ *             next triangle would take it past MESHLET_MAX_VERTICES or MESHLET_MAX_TRIANGLES, and its bounding sphere
+ *             and normal cone are computed then.  Triangles with an index out of range are dropped.
+ *
+ * parameters: vertexData -- [in] vertexCount vertices, as given to the mesh constructor
+ *             vertexCount -- [in] number of vertices
+ *             indexData -- [in] indexCount uint32_t indices, a triangle list
+ *             indexCount -- [in] number of indices
+ *             out -- [out] the meshlets, replaces anything already there
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void meshletBuilder::build(const void* vertexData, uint32_t vertexCount, const void* indexData, uint32_t indexCount, meshletData* out)
+{
+  out->meshlets.clear();
+  out->vertices.clear();
+  out->triangles.clear();
+
+  // positions only, the bounds need nothing else
+  std::vector<glm::vec3> positions(vertexCount);
+  const uint8_t* src = static_cast<const uint8_t*>(vertexData);
+  for (uint32_t v = 0; v < vertexCount; v++)
+  {
+    memcpy(&positions[v], src + v * sizeof(vertex) + offsetof(vertex, pos), sizeof(glm::vec3));
+  }
+
+  std::vector<uint32_t> localIndex(vertexCount, NOT_IN_MESHLET);
+  meshlet current = {};
+
+  const uint8_t* indexBytes = static_cast<const uint8_t*>(indexData);
+  for (uint32_t t = 0; t + 2 < indexCount; t += 3)
+  {
+    uint32_t tri[3];
+    memcpy(tri, indexBytes + t * sizeof(uint32_t), sizeof(tri));
+    if (tri[0] >= vertexCount || tri[1] >= vertexCount || tri[2] >= vertexCount) continue;
+
+    uint32_t newVertices = 0;
+    for (int c = 0; c < 3; c++)
+    {
+      if (NOT_IN_MESHLET == localIndex[tri[c]] && (c < 1 || tri[c] != tri[0]) && (c < 2 || tri[c] != tri[1])) newVertices++;
+    }
+
+    if (current.vertexCount + newVertices > MESHLET_MAX_VERTICES || current.triangleCount + 1 > MESHLET_MAX_TRIANGLES)
+    {
+      computeBounds(positions, out, &current);
+      for (uint32_t v = 0; v < current.vertexCount; v++) localIndex[out->vertices[current.vertexOffset + v]] = NOT_IN_MESHLET;
+      out->meshlets.push_back(current);
+
+      current = {};
+      current.vertexOffset = static_cast<uint32_t>(out->vertices.size());
+      current.triangleOffset = static_cast<uint32_t>(out->triangles.size());
+    }
+
+    uint32_t packed = 0;
+    for (int c = 0; c < 3; c++)
+    {
+      if (NOT_IN_MESHLET == localIndex[tri[c]])
+      {
+        localIndex[tri[c]] = current.vertexCount++;
+        out->vertices.push_back(tri[c]);
+      }
+      packed |= localIndex[tri[c]] << (8 * c);
+    }
+
+    out->triangles.push_back(packed);
+    current.triangleCount++;
+  }
+
+  if (current.triangleCount > 0)
+  {
+    computeBounds(positions, out, &current);
+    out->meshlets.push_back(current);
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : computeBounds
+ *
+ * abstract  : Fills in a meshlet's bounding sphere and normal cone.  The sphere is centred on the middle of the
+ *             vertices' bounding box, which is not the smallest sphere but is never more than a little larger.  The cone
+ *             axis is the average of the (unit) triangle normals and its spread the largest angle between the axis and
+ *             any triangle normal.  As the cull test uses the sphere rather than an apex, the stored cutoff is the sine
+ *             of that angle, i.e. the cosine of the angle of the cone of view directions from which every triangle is
+ *             seen from behind.  If the normals spread over more than about 84 degrees (or the triangles are all
+ *             degenerate) the cone would hardly ever cull, and the cutoff is set to 1 so that it never does.
+ *
+ * parameters: positions -- [in] the mesh's vertex positions
+ *             data -- [in] the meshlet vertex and triangle lists m points into
+ *             m -- [in/out] the meshlet
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void meshletBuilder::computeBounds(const std::vector<glm::vec3>& positions, meshletData* data, meshlet* m)
+{
+  glm::vec3 lo = positions[data->vertices[m->vertexOffset]];
+  glm::vec3 hi = lo;
+  for (uint32_t v = 1; v < m->vertexCount; v++)
+  {
+    const glm::vec3& p = positions[data->vertices[m->vertexOffset + v]];
+    lo = glm::min(lo, p);
+    hi = glm::max(hi, p);
+  }
+
+  glm::vec3 centre = (lo + hi) * 0.5f;
+  float     radius = 0.0f;
+  for (uint32_t v = 0; v < m->vertexCount; v++)
+  {
+    glm::vec3 d = positions[data->vertices[m->vertexOffset + v]] - centre;
+    radius = std::max(radius, d.x * d.x + d.y * d.y + d.z * d.z);
+  }
+  m->sphere = glm::vec4(centre, std::sqrt(radius));
+
+  // unit normal of each triangle, zero for a degenerate one
+  glm::vec3 normals[MESHLET_MAX_TRIANGLES];
+  glm::vec3 axis(0.0f);
+  for (uint32_t t = 0; t < m->triangleCount; t++)
+  {
+    uint32_t packed = data->triangles[m->triangleOffset + t];
+    const glm::vec3& a = positions[data->vertices[m->vertexOffset + (packed & 0xff)]];
+    const glm::vec3& b = positions[data->vertices[m->vertexOffset + ((packed >> 8) & 0xff)]];
+    const glm::vec3& c = positions[data->vertices[m->vertexOffset + ((packed >> 16) & 0xff)]];
+
+    glm::vec3 e1 = b - a;
+    glm::vec3 e2 = c - a;
+    glm::vec3 n(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x);
+    float     length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+
+    normals[t] = (length > 0.0f) ? n / length : glm::vec3(0.0f);
+    axis += normals[t];
+  }
+
+  float axisLength = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+  if (axisLength <= 0.0f)
+  {
+    m->cone = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    return;
+  }
+  axis /= axisLength;
+
+  float minDot = 1.0f;
+  for (uint32_t t = 0; t < m->triangleCount; t++)
+  {
+    if (normals[t].x == 0.0f && normals[t].y == 0.0f && normals[t].z == 0.0f) continue;
+    minDot = std::min(minDot, axis.x * normals[t].x + axis.y * normals[t].y + axis.z * normals[t].z);
+  }
+
+  float cutoff = (minDot <= 0.1f) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+  m->cone = glm::vec4(axis, cutoff);
+}
@@ -0,0 +1,48 @@
+#ifndef _meshletBuilder_h_
+#define _meshletBuilder_h_
+
+#include <cstdint>
+#include <vector>
+
+#include "utilities.h"
+
+const uint32_t MESHLET_MAX_VERTICES = 64;
+const uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+// One cluster of a mesh's triangles.  Laid out as the cull shader (Shaders/cull.comp) reads it, std430 with no padding.
+// The cone is the backface cone of the cluster's triangle normals: the whole cluster faces away from a camera at c when
+// dot(centre - c, axis) >= cutoff * |centre - c| + radius.  A cutoff of 1 means the cluster is never backface culled.
+struct meshlet
+{
+  glm::vec4 sphere;                   // xyz centre, w radius (model space)
+  glm::vec4 cone;                     // xyz axis, w cutoff
+  uint32_t  vertexOffset;             // into meshletData::vertices
+  uint32_t  vertexCount;
+  uint32_t  triangleOffset;           // into meshletData::triangles
+  uint32_t  triangleCount;
+};
+
+// The meshlets of one mesh.  Each meshlet has its own list of (mesh) vertex indices and its triangles index into that
+// list, three 8 bit local indices packed in a uint32_t per triangle (a layout a mesh shader can read as it is).
+struct meshletData
+{
+  std::vector<meshlet>  meshlets;
+  std::vector<uint32_t> vertices;
+  std::vector<uint32_t> triangles;
+};
+
+// Splits an indexed triangle list into meshlets of at most MESHLET_MAX_VERTICES vertices and MESHLET_MAX_TRIANGLES
+// triangles.  Triangles are taken greedily in index order, a meshlet is closed when the next triangle would not fit, so
+// the quality of the clusters depends on the locality of the index buffer (Assimp and objLoader both emit faces in
+// file order, which is usually spatially coherent).  Vertex and index data are read with memcpy, so may come straight
+// from a mapped file.
+class meshletBuilder
+{
+public:
+  static void build(const void* vertexData, uint32_t vertexCount, const void* indexData, uint32_t indexCount, meshletData* out);
+
+private:
+  static void computeBounds(const std::vector<glm::vec3>& positions, meshletData* data, meshlet* m);
+};
+
+#endif
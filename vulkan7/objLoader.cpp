@@ -0,0 +1,604 @@
+#include "objLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "mappedFile.h"
+#include "assetPack.h"
+
+static const int32_t NO_INDEX = INT32_MIN;           // a corner with no texture coordinate
+static const int32_t RELATIVE_BIAS = 1 << 30;        // relative indices are kept as (chunk local index - bias) until the chunk's base is known
+static const size_t  MIN_CHUNK = 256 * 1024;         // smaller pieces of the file are not worth a job
+
+// one corner of a triangle, 0 based indices into the whole file's positions and texture coordinates
+struct objCorner
+{
+  int32_t v;
+  int32_t vt;
+};
+
+enum objEventType { EVENT_GROUP, EVENT_MATERIAL };
+
+// a 'g'/'o' or 'usemtl' line, corner is the number of corners the chunk had read when it was seen
+struct objEvent
+{
+  size_t       corner;
+  objEventType type;
+  std::string  name;
+};
+
+// what one job read from its piece of the file
+struct objChunk
+{
+  const char*              begin = nullptr;
+  const char*              end = nullptr;
+
+  std::vector<glm::vec3>   positions;
+  std::vector<glm::vec2>   texcoords;
+  std::vector<objCorner>   corners;           // three per triangle
+  std::vector<objEvent>    events;
+  std::vector<std::string> libraries;         // mtllib lines
+
+  size_t                   positionBase = 0;  // index of this chunk's first position in the whole file
+  size_t                   texcoordBase = 0;
+  size_t                   skippedFaces = 0;  // malformed, or points/lines
+};
+
+// the part of a mesh's triangles that lies in one chunk
+struct objRange
+{
+  size_t chunk;
+  size_t begin;
+  size_t end;
+};
+
+struct objSegment
+{
+  int                   material = -1;
+  size_t                corners = 0;
+  std::vector<objRange> ranges;
+};
+
+// open addressing (linear probing) hash map from a (position, texture coordinate) pair to the vertex made for it
+class weldMap
+{
+public:
+  weldMap(size_t expected) : m_mask(0)
+  {
+    size_t capacity = 16;
+    while (capacity < expected * 2) capacity <<= 1;
+
+    m_keys.assign(capacity, EMPTY);
+    m_values.resize(capacity);
+    m_mask = capacity - 1;
+  }
+
+  // the vertex already made for key, or 'next' (which the caller must then make) if there is none
+  uint32_t findOrInsert(uint64_t key, uint32_t next, bool* inserted)
+  {
+    size_t slot = hash(key) & m_mask;
+    while (true)
+    {
+      if (m_keys[slot] == key)
+      {
+        *inserted = false;
+        return m_values[slot];
+      }
+      if (m_keys[slot] == EMPTY)
+      {
+        m_keys[slot] = key;
+        m_values[slot] = next;
+        *inserted = true;
+        return next;
+      }
+      slot = (slot + 1) & m_mask;
+    }
+  }
+
+private:
+  static constexpr uint64_t EMPTY = ~0ull;      // never a key, position indices are below 2^31
+
+  std::vector<uint64_t> m_keys;
+  std::vector<uint32_t> m_values;
+  size_t                m_mask;
+
+  // murmur3 finaliser, the keys are small consecutive integers which would cluster badly as they are
+  static size_t hash(uint64_t key)
+  {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return (size_t)key;
+  }
+};
+
+
+
+static inline const char* skipBlanks(const char* p, const char* end)
+{
+  while (p < end && (' ' == *p || '\t' == *p)) p++;
+  return p;
+}
+
+// true if the line starting at p is 'word' followed by a blank or the end of the line
+static inline bool isKeyword(const char* p, const char* end, const char* word, size_t length)
+{
+  return (size_t)(end - p) >= length && 0 == memcmp(p, word, length) && (p + length == end || ' ' == p[length] || '\t' == p[length]);
+}
+
+// the rest of the line with the blanks either side removed
+static std::string restOfLine(const char* p, const char* end)
+{
+  p = skipBlanks(p, end);
+  while (end > p && isspace((unsigned char)end[-1])) end--;
+  return std::string(p, end);
+}
+
+// reads a float, leaving value alone (and returning p) if there isn't one
+static inline const char* parseFloat(const char* p, const char* end, float* value)
+{
+  p = skipBlanks(p, end);
+  if (p < end && '+' == *p) p++;
+
+  std::from_chars_result result = std::from_chars(p, end, *value);
+  return (std::errc() == result.ec) ? result.ptr : p;
+}
+
+// 1 based absolute indices become 0 based, negative (relative to the last one read) ones are finished by the fix up
+static inline int32_t resolveIndex(int index, size_t localCount)
+{
+  return (index > 0) ? index - 1 : (int32_t)localCount + index - RELATIVE_BIAS;
+}
+
+static inline int32_t fixIndex(int32_t index, size_t base)
+{
+  return (index < 0 && NO_INDEX != index) ? (int32_t)(index + RELATIVE_BIAS + (int64_t)base) : index;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : parseFace
+ *
+ * abstract  : Reads the corners of an 'f' line (v, v/vt, v//vn or v/vt/vn) and adds it to the chunk as a triangle fan.
+ *             A face with a bad corner, or fewer than three, is counted and skipped.
+ *
+ * parameters: p -- [in] first character after the 'f'
+ *             end -- [in] end of the line
+ *             chunk -- [in/out] chunk being read
+ *             face -- [in/out] scratch, reused from line to line
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+static void parseFace(const char* p, const char* end, objChunk* chunk, std::vector<objCorner>* face)
+{
+  face->clear();
+
+  while (true)
+  {
+    p = skipBlanks(p, end);
+    if (p >= end) break;
+
+    int v = 0;
+    int vt = 0;
+    std::from_chars_result result = std::from_chars(p, end, v);
+    if (std::errc() != result.ec || 0 == v)
+    {
+      chunk->skippedFaces++;
+      return;
+    }
+    p = result.ptr;
+
+    if (p < end && '/' == *p)
+    {
+      p++;
+      if (p < end && '/' != *p)
+      {
+        result = std::from_chars(p, end, vt);
+        if (std::errc() == result.ec) p = result.ptr;
+      }
+      if (p < end && '/' == *p)
+      {
+        int vn;
+        result = std::from_chars(p + 1, end, vn);
+        p = (std::errc() == result.ec) ? result.ptr : p + 1;
+      }
+    }
+
+    if (p < end && ' ' != *p && '\t' != *p)
+    {
+      chunk->skippedFaces++;
+      return;
+    }
+
+    face->push_back({ resolveIndex(v, chunk->positions.size()), (0 == vt) ? NO_INDEX : resolveIndex(vt, chunk->texcoords.size()) });
+  }
+
+  if (face->size() < 3)
+  {
+    chunk->skippedFaces++;
+    return;
+  }
+
+  for (size_t ndx = 1; ndx + 1 < face->size(); ndx++)
+  {
+    chunk->corners.push_back((*face)[0]);
+    chunk->corners.push_back((*face)[ndx]);
+    chunk->corners.push_back((*face)[ndx + 1]);
+  }
+}
+
+
+
+// reads one line (leading blanks and the line end already removed), anything not needed is ignored
+static void parseLine(const char* p, const char* end, objChunk* chunk, std::vector<objCorner>* face)
+{
+  if (isKeyword(p, end, "v", 1))
+  {
+    glm::vec3 position(0.0f);
+    p = parseFloat(p + 1, end, &position.x);
+    p = parseFloat(p, end, &position.y);
+    parseFloat(p, end, &position.z);
+    chunk->positions.push_back(position);
+  }
+  else if (isKeyword(p, end, "vt", 2))
+  {
+    // flipped as aiProcess_FlipUVs does
+    glm::vec2 texcoord(0.0f);
+    p = parseFloat(p + 2, end, &texcoord.x);
+    parseFloat(p, end, &texcoord.y);
+    texcoord.y = 1.0f - texcoord.y;
+    chunk->texcoords.push_back(texcoord);
+  }
+  else if (isKeyword(p, end, "f", 1))
+  {
+    parseFace(p + 1, end, chunk, face);
+  }
+  else if (isKeyword(p, end, "g", 1) || isKeyword(p, end, "o", 1))
+  {
+    chunk->events.push_back({ chunk->corners.size(), EVENT_GROUP, restOfLine(p + 1, end) });
+  }
+  else if (isKeyword(p, end, "usemtl", 6))
+  {
+    chunk->events.push_back({ chunk->corners.size(), EVENT_MATERIAL, restOfLine(p + 6, end) });
+  }
+  else if (isKeyword(p, end, "mtllib", 6))
+  {
+    chunk->libraries.push_back(restOfLine(p + 6, end));
+  }
+}
+
+
+
+// reads every line of a chunk, runs on a worker
+static void parseChunk(objChunk* chunk)
+{
+  std::vector<objCorner> face;
+
+  const char* p = chunk->begin;
+  while (p < chunk->end)
+  {
+    const char* lineEnd = static_cast<const char*>(memchr(p, '\n', chunk->end - p));
+    if (nullptr == lineEnd) lineEnd = chunk->end;
+    const char* next = (lineEnd < chunk->end) ? lineEnd + 1 : chunk->end;
+
+    if (lineEnd > p && '\r' == lineEnd[-1]) lineEnd--;
+
+    p = skipBlanks(p, lineEnd);
+    if (p < lineEnd && '#' != *p) parseLine(p, lineEnd, chunk, &face);
+
+    p = next;
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : weldSegment
+ *
+ * abstract  : Builds one mesh from its triangles, giving each distinct (position, texture coordinate) pair one vertex.
+ *             Triangles with an index outside the file's positions or texture coordinates are counted and dropped.
+ *
+ * parameters: segment -- [in] the triangles of the mesh, as ranges of chunk corners
+ *             chunks -- [in] every chunk, with the relative indices already fixed up
+ *             positions -- [in] the whole file's positions
+ *             texcoords -- [in] the whole file's (flipped) texture coordinates
+ *             mesh -- [out] the mesh
+ *             badTriangles -- [in/out] running count of dropped triangles
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+static void weldSegment(const objSegment& segment, const std::vector<objChunk>& chunks, const std::vector<glm::vec3>& positions,
+                        const std::vector<glm::vec2>& texcoords, objMesh* mesh, std::atomic<size_t>* badTriangles)
+{
+  mesh->material = segment.material;
+  mesh->indices.reserve(segment.corners);
+  mesh->vertices.reserve(segment.corners / 2);
+
+  weldMap map(segment.corners);
+  size_t  bad = 0;
+
+  for (const objRange& range : segment.ranges)
+  {
+    const objCorner* corners = chunks[range.chunk].corners.data();
+
+    for (size_t first = range.begin; first < range.end; first += 3)
+    {
+      bool valid = true;
+      for (size_t ndx = first; ndx < first + 3; ndx++)
+      {
+        if (corners[ndx].v < 0 || (size_t)corners[ndx].v >= positions.size()) valid = false;
+        if (NO_INDEX != corners[ndx].vt && (corners[ndx].vt < 0 || (size_t)corners[ndx].vt >= texcoords.size())) valid = false;
+      }
+      if (!valid)
+      {
+        bad++;
+        continue;
+      }
+
+      for (size_t ndx = first; ndx < first + 3; ndx++)
+      {
+        uint64_t key = ((uint64_t)(uint32_t)corners[ndx].v << 32) | (uint32_t)corners[ndx].vt;
+
+        bool inserted;
+        uint32_t index = map.findOrInsert(key, (uint32_t)mesh->vertices.size(), &inserted);
+        if (inserted)
+        {
+          vertex v;
+          v.pos = positions[corners[ndx].v];
+          v.col = { 1.0f, 1.0f, 1.0f };
+          v.tex = (NO_INDEX == corners[ndx].vt) ? glm::vec2(0.0f, 0.0f) : texcoords[corners[ndx].vt];
+          mesh->vertices.push_back(v);
+        }
+
+        mesh->indices.push_back(index);
+      }
+    }
+  }
+
+  if (bad > 0) *badTriangles += bad;
+}
+
+
+
+objLoader::objLoader(jobSystem& jobs) : m_jobs(jobs) { }
+
+
+
+/************************************************************************************************************************
+ * function  : load
+ *
+ * abstract  : Reads an OBJ file and the material libraries it names.  The mapped file is cut into line aligned chunks
+ *             (about four per thread, none under 256 KB) that are parsed in parallel.  Once every chunk is done the
+ *             positions and texture coordinates are gathered (in parallel) into whole-file arrays, using each chunk's
+ *             base to finish relative indices.  A new mesh starts at every 'g', 'o' or 'usemtl' line that follows
+ *             some faces; the meshes are welded in parallel.
+ *
+ * parameters: fileName -- [in] the .obj file, material libraries are looked for in the same directory
+ *             model -- [out] the meshes and their materials
+ *
+ * returns   : void, throws std::runtime_error if the file can not be read
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void objLoader::load(const std::string& fileName, objModel* model)
+{
+  mappedFile file;
+  mapAsset(fileName, &file);
+  if (0 == file.size()) throw std::runtime_error(fileName + " is empty");
+
+  const char* text = reinterpret_cast<const char*>(file.data());
+  const char* fileEnd = text + file.size();
+
+  // line aligned chunks
+  size_t threads = m_jobs.getWorkerCount() + 1;
+  size_t chunkCount = std::max<size_t>(1, std::min(threads * 4, file.size() / MIN_CHUNK));
+  std::vector<objChunk> chunks(chunkCount);
+
+  const char* start = text;
+  for (size_t ndx = 0; ndx < chunkCount; ndx++)
+  {
+    const char* stop = fileEnd;
+    if (ndx + 1 < chunkCount)
+    {
+      stop = std::max(start, text + file.size() * (ndx + 1) / chunkCount);
+      const char* newline = (stop < fileEnd) ? static_cast<const char*>(memchr(stop, '\n', fileEnd - stop)) : nullptr;
+      stop = (nullptr != newline) ? newline + 1 : fileEnd;
+    }
+
+    chunks[ndx].begin = start;
+    chunks[ndx].end = stop;
+    start = stop;
+  }
+
+  m_jobs.parallelFor(0, chunkCount, 1, [&chunks](size_t first, size_t last)
+  {
+    for (size_t ndx = first; ndx < last; ndx++) parseChunk(&chunks[ndx]);
+  });
+
+  // number the positions and texture coordinates across the chunks, then gather them and finish relative indices
+  size_t positionCount = 0;
+  size_t texcoordCount = 0;
+  size_t skippedFaces = 0;
+  for (objChunk& chunk : chunks)
+  {
+    chunk.positionBase = positionCount;
+    chunk.texcoordBase = texcoordCount;
+    positionCount += chunk.positions.size();
+    texcoordCount += chunk.texcoords.size();
+    skippedFaces += chunk.skippedFaces;
+  }
+
+  if (positionCount > (size_t)INT32_MAX || texcoordCount > (size_t)INT32_MAX) throw std::runtime_error(fileName + " is too big");
+
+  std::vector<glm::vec3> positions(positionCount);
+  std::vector<glm::vec2> texcoords(texcoordCount);
+  m_jobs.parallelFor(0, chunkCount, 1, [&](size_t first, size_t last)
+  {
+    for (size_t ndx = first; ndx < last; ndx++)
+    {
+      objChunk& chunk = chunks[ndx];
+      std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + chunk.positionBase);
+      std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), texcoords.begin() + chunk.texcoordBase);
+
+      for (objCorner& corner : chunk.corners)
+      {
+        corner.v = fixIndex(corner.v, chunk.positionBase);
+        corner.vt = fixIndex(corner.vt, chunk.texcoordBase);
+      }
+    }
+  });
+
+  // materials, from every library named (once each), in the OBJ's directory
+  model->meshes.clear();
+  model->materialNames.clear();
+  model->textureNames.clear();
+
+  size_t slash = fileName.find_last_of("/\\");
+  std::string directory = (std::string::npos != slash) ? fileName.substr(0, slash + 1) : std::string();
+
+  std::vector<std::string> libraries;
+  for (const objChunk& chunk : chunks)
+  {
+    for (const std::string& library : chunk.libraries)
+    {
+      if (std::find(libraries.begin(), libraries.end(), library) != libraries.end()) continue;
+      libraries.push_back(library);
+      loadMaterials(directory + library, model);
+    }
+  }
+
+  std::unordered_map<std::string, int> materialIndex;
+  for (size_t ndx = 0; ndx < model->materialNames.size(); ndx++) materialIndex[model->materialNames[ndx]] = (int)ndx;
+
+  // split the triangles into meshes at each group/material change
+  std::vector<objSegment> segments(1);
+  for (size_t c = 0; c < chunkCount; c++)
+  {
+    size_t position = 0;
+    for (const objEvent& event : chunks[c].events)
+    {
+      if (event.corner > position)
+      {
+        segments.back().ranges.push_back({ c, position, event.corner });
+        segments.back().corners += event.corner - position;
+        position = event.corner;
+      }
+
+      if (segments.back().corners > 0)
+      {
+        objSegment next;
+        next.material = segments.back().material;
+        segments.push_back(next);
+      }
+
+      if (EVENT_MATERIAL == event.type)
+      {
+        auto found = materialIndex.find(event.name);
+        if (found == materialIndex.end())
+        {
+          std::cerr << "[?] " << fileName << " uses material '" << event.name << "' which is not in its libraries" << std::endl;
+          segments.back().material = -1;
+        }
+        else
+        {
+          segments.back().material = found->second;
+        }
+      }
+    }
+
+    if (chunks[c].corners.size() > position)
+    {
+      segments.back().ranges.push_back({ c, position, chunks[c].corners.size() });
+      segments.back().corners += chunks[c].corners.size() - position;
+    }
+  }
+  if (0 == segments.back().corners) segments.pop_back();
+
+  std::atomic<size_t> badTriangles(0);
+  model->meshes.resize(segments.size());
+  m_jobs.parallelFor(0, segments.size(), 1, [&](size_t first, size_t last)
+  {
+    for (size_t ndx = first; ndx < last; ndx++) weldSegment(segments[ndx], chunks, positions, texcoords, &model->meshes[ndx], &badTriangles);
+  });
+
+  model->meshes.erase(std::remove_if(model->meshes.begin(), model->meshes.end(), [](const objMesh& m) { return m.indices.empty(); }),
+                      model->meshes.end());
+
+  if (skippedFaces > 0 || badTriangles > 0)
+  {
+    std::cerr << "[?] " << fileName << ": skipped " << skippedFaces << " faces (malformed, points or lines) and "
+              << badTriangles << " triangles with indices out of range" << std::endl;
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : loadMaterials
+ *
+ * abstract  : Adds the materials of an MTL library to the model.  Only the name and the diffuse texture (map_Kd, file
+ *             name only, any directory is cut off as MeshModel::LoadMaterials does) are kept; map options are not
+ *             supported.  A library that can not be read is reported and the model keeps going without it.
+ *
+ * parameters: fileName -- [in] the .mtl file
+ *             model -- [in/out] materialNames and textureNames are appended to
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void objLoader::loadMaterials(const std::string& fileName, objModel* model)
+{
+  mappedFile file;
+  try
+  {
+    mapAsset(fileName, &file);
+  }
+  catch (const std::exception&)
+  {
+    std::cerr << "[?] could not read material library " << fileName << std::endl;
+    return;
+  }
+
+  const char* p = reinterpret_cast<const char*>(file.data());
+  const char* end = p + file.size();
+  size_t first = model->materialNames.size();
+
+  while (p < end)
+  {
+    const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+    if (nullptr == lineEnd) lineEnd = end;
+    const char* next = (lineEnd < end) ? lineEnd + 1 : end;
+
+    if (lineEnd > p && '\r' == lineEnd[-1]) lineEnd--;
+    p = skipBlanks(p, lineEnd);
+
+    if (isKeyword(p, lineEnd, "newmtl", 6))
+    {
+      model->materialNames.push_back(restOfLine(p + 6, lineEnd));
+      model->textureNames.push_back(std::string());
+    }
+    else if (lineEnd - p > 6 && 0 == strncmp(p, "map_", 4) && 'k' == tolower((unsigned char)p[4]) && 'd' == tolower((unsigned char)p[5]) &&
+             (' ' == p[6] || '\t' == p[6]) && model->materialNames.size() > first)
+    {
+      std::string path = restOfLine(p + 6, lineEnd);
+      model->textureNames.back() = path.substr(path.find_last_of("/\\") + 1);
+    }
+
+    p = next;
+  }
+}
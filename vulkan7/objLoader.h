@@ -0,0 +1,45 @@
+#ifndef _objLoader_h_
+#define _objLoader_h_
+
+#include <string>
+#include <vector>
+
+#include "utilities.h"
+#include "jobSystem.h"
+
+// one mesh of an OBJ file, a run of faces with the same group and material, welded and ready for the mesh constructor
+struct objMesh
+{
+  std::vector<vertex>   vertices;
+  std::vector<uint32_t> indices;
+  int                   material = -1;     // index into objModel::textureNames, -1 => the default texture
+};
+
+struct objModel
+{
+  std::vector<objMesh>     meshes;
+  std::vector<std::string> materialNames;
+  std::vector<std::string> textureNames;   // diffuse texture of each material (file name only, as LoadMaterials), "" => none
+};
+
+// Reads Wavefront OBJ files (and their MTL libraries) without Assimp.  The file is memory mapped and split into line
+// aligned chunks that are parsed in parallel on the job system with std::from_chars.  Positions and texture
+// coordinates are then numbered across the chunks, and each mesh is triangulated (as a fan) and welded in parallel,
+// a hash map on the (position, texture coordinate) pair giving one vertex per distinct pair.  Normals are not read
+// since 'vertex' has no normal, so vertices that differ only by normal are welded as well (Assimp keeps them apart).
+// UVs are flipped as aiProcess_FlipUVs does and every vertex is white, as MeshModel::loadMesh.  Points, lines, free
+// form geometry and line continuations are not supported.
+class objLoader
+{
+public:
+  objLoader(jobSystem& jobs);
+
+  void load(const std::string& fileName, objModel* model);      // throws std::runtime_error if the file can not be read
+
+private:
+  jobSystem&  m_jobs;
+
+  void loadMaterials(const std::string& fileName, objModel* model);
+};
+
+#endif
@@ -0,0 +1,1055 @@
+#include "objectBench.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "assetPack.h"
+#include "deviceScore.h"
+
+typedef std::chrono::high_resolution_clock benchClock;
+
+static double elapsedMs(benchClock::time_point start, benchClock::time_point end)
+{
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+/************************************************************************************************************************
+ * function  : ctor
+ *
+ * abstract  : Stores the settings for the run; the Vulkan objects are created by run() so that failures are reported
+ *             through its return code.
+ *
+ * parameters: config -- [in] object counts, frame counts and where to write the results
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+objectBench::objectBench(const objectBenchConfig& config) : m_config(config)
+{
+  std::sort(m_config.counts.begin(), m_config.counts.end());
+}
+
+objectBench::~objectBench()
+{
+  cleanup();
+}
+
+
+
+const char* objectBench::strategyName(objectStrategy strategy)
+{
+  switch (strategy)
+  {
+    case STRATEGY_PUSH:        return "push constant";
+    case STRATEGY_DYNAMIC_UBO: return "dynamic UBO";
+    case STRATEGY_SSBO:        return "SSBO index";
+    case STRATEGY_INSTANCED:   return "instanced";
+    default:                   return "unknown";
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : run
+ *
+ * abstract  : Creates a headless device, then for each object count measures every strategy in turn.  The results are
+ *             written to the CSV file and printed as a table, together with the cheapest strategy at each count.
+ *
+ * parameters: os -- [in] stream the table is written to
+ *
+ * returns   : int, EXIT_SUCCESS if every count was measured, EXIT_FAILURE otherwise
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+int objectBench::run(std::ostream& os)
+{
+  int result = EXIT_SUCCESS;
+
+  try
+  {
+    createDevice();
+    createTarget();
+    createDescriptorSetLayouts();
+    createPipelines();
+    createQuad();
+    createCommandObjects();
+
+    for (int count : m_config.counts)
+    {
+      if (count <= 0) continue;
+
+      createObjects(count);
+
+      for (int s = 0; s < STRATEGY_COUNT; s++)
+      {
+        objectBenchSample sample = measure((objectStrategy)s, count);
+        m_samples.push_back(sample);
+
+        std::cout << "[?] N=" << count << " " << strategyName(sample.strategy) << ": write " << sample.writeMs
+                  << " ms, record " << sample.recordMs << " ms, gpu " << sample.gpuMs << " ms" << std::endl;
+      }
+    }
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cerr << "[-] object benchmark stopped: " << e.what() << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  writeCsv();
+  printSummary(os);
+
+  cleanup();
+  return result;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createDevice
+ *
+ * abstract  : Creates an instance (nothing is presented, so the only extensions are those for device UUIDs if there),
+ *             picks a device with a graphics queue, the highest scoring unless m_config.device names one (see
+ *             selectDevice), and creates a logical device with a single graphics queue.  Also reads the limits the
+ *             benchmark depends on: the time stamp period and the dynamic uniform buffer alignment.
+ *
+ * parameters: void
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) devices are scored rather than taking the first discrete GPU
+************************************************************************************************************************/
+void objectBench::createDevice()
+{
+  VkApplicationInfo appInfo = {};
+  appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+  appInfo.pApplicationName = "object data benchmark";
+  appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+  appInfo.pEngineName = "No Engine";
+  appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+  appInfo.apiVersion = VK_API_VERSION_1_0;
+
+  VkInstanceCreateInfo instanceInfo = {};
+  instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+  instanceInfo.pApplicationInfo = &appInfo;
+
+  bool deviceIds = deviceIdsAvailable();
+  const char* idExtensions[] = { VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME };
+  if (deviceIds)
+  {
+    instanceInfo.enabledExtensionCount = 2;
+    instanceInfo.ppEnabledExtensionNames = idExtensions;
+  }
+
+  if (vkCreateInstance(&instanceInfo, nullptr, &m_instance) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create a Vulkan instance" << std::endl;
+    throw std::runtime_error("Failed to create a Vulkan instance!");
+  }
+
+  uint32_t deviceCnt = 0;
+  vkEnumeratePhysicalDevices(m_instance, &deviceCnt, nullptr);
+  std::vector<VkPhysicalDevice> deviceList(deviceCnt);
+  vkEnumeratePhysicalDevices(m_instance, &deviceCnt, deviceList.data());
+
+  // a device is suitable if it has a graphics queue, the first such family is the one used
+  std::vector<deviceCandidate> candidates(deviceCnt);
+  std::vector<uint32_t>        graphicsFamily(deviceCnt, 0);
+  std::vector<uint32_t>        timestampBits(deviceCnt, 0);
+  for (size_t device = 0; device < deviceList.size(); device++)
+  {
+    describeDevice(m_instance, deviceList[device], deviceIds, &candidates[device]);
+
+    uint32_t familyCnt = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(deviceList[device], &familyCnt, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCnt);
+    vkGetPhysicalDeviceQueueFamilyProperties(deviceList[device], &familyCnt, families.data());
+
+    for (uint32_t ndx = 0; ndx < familyCnt; ndx++)
+    {
+      if (families[ndx].queueCount == 0 || !(families[ndx].queueFlags & VK_QUEUE_GRAPHICS_BIT)) continue;
+
+      candidates[device].suitable = true;
+      graphicsFamily[device] = ndx;
+      timestampBits[device] = families[ndx].timestampValidBits;
+      break;
+    }
+  }
+
+  std::string reason;
+  int chosen = selectDevice(candidates, getDeviceOverride(m_config.device), &reason);
+  if (chosen < 0)
+  {
+    std::cerr << "[-] no device with a graphics queue found" << std::endl;
+    throw std::runtime_error("No suitable physical device found");
+  }
+
+  const VkPhysicalDeviceProperties& deviceProperties = candidates[chosen].properties;
+  m_physical = deviceList[chosen];
+  m_queueFamily = graphicsFamily[chosen];
+  m_timestampPeriod = (timestampBits[chosen] > 0) ? deviceProperties.limits.timestampPeriod : 0.0f;
+  std::cout << "[?] device " << chosen << " chosen: " << reason << std::endl;
+
+  VkDeviceSize minAlignment = std::max<VkDeviceSize>(1, deviceProperties.limits.minUniformBufferOffsetAlignment);
+  m_uboAlignment = ((sizeof(glm::mat4) + minAlignment - 1) / minAlignment) * minAlignment;
+
+  std::cout << "[+] benchmarking on " << deviceProperties.deviceName << ", dynamic UBO stride " << m_uboAlignment << " bytes"
+            << (m_timestampPeriod > 0.0f ? "" : ", no time stamp support (GPU time not measured)") << std::endl;
+
+  float priority = 1.0f;
+  VkDeviceQueueCreateInfo queueInfo = {};
+  queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+  queueInfo.queueFamilyIndex = m_queueFamily;
+  queueInfo.queueCount = 1;
+  queueInfo.pQueuePriorities = &priority;
+
+  VkPhysicalDeviceFeatures features = {};
+
+  VkDeviceCreateInfo deviceInfo = {};
+  deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+  deviceInfo.queueCreateInfoCount = 1;
+  deviceInfo.pQueueCreateInfos = &queueInfo;
+  deviceInfo.pEnabledFeatures = &features;
+
+  if (vkCreateDevice(m_physical, &deviceInfo, nullptr, &m_device) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create a logical device" << std::endl;
+    throw std::runtime_error("Failed to create a logical device!");
+  }
+
+  vkGetDeviceQueue(m_device, m_queueFamily, 0, &m_queue);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createTarget
+ *
+ * abstract  : Creates the offscreen colour image, a single subpass render pass that clears it, and its framebuffer.
+ *             The image is never read back, the store is kept so the driver cannot skip the work.
+ *
+ * parameters: void
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void objectBench::createTarget()
+{
+  const VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+
+  VkImageCreateInfo imageInfo = {};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.extent = { TARGET_SIZE, TARGET_SIZE, 1 };
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.format = format;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  if (vkCreateImage(m_device, &imageInfo, nullptr, &m_target) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create the offscreen image" << std::endl;
+    throw std::runtime_error("Failed to create an image!");
+  }
+
+  VkMemoryRequirements memRequirements;
+  vkGetImageMemoryRequirements(m_device, m_target, &memRequirements);
+
+  if (allocateDeviceMemory(m_physical, m_device, memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MEMORY_ATTACHMENT, &m_targetMemory) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to allocate memory for the offscreen image" << std::endl;
+    throw std::runtime_error("Failed to allocate memory for image!");
+  }
+  vkBindImageMemory(m_device, m_target, m_targetMemory, 0);
+
+  VkImageViewCreateInfo viewInfo = {};
+  viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.image = m_target;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = format;
+  viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+  if (vkCreateImageView(m_device, &viewInfo, nullptr, &m_targetView) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create the offscreen image view" << std::endl;
+    throw std::runtime_error("Failed to create an image view!");
+  }
+
+  VkAttachmentDescription colourAttachment = {};
+  colourAttachment.format = format;
+  colourAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+  colourAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+  colourAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+  colourAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+  colourAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+  colourAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  colourAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+  VkAttachmentReference colourReference = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+  VkSubpassDescription subpass = {};
+  subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+  subpass.colorAttachmentCount = 1;
+  subpass.pColorAttachments = &colourReference;
+
+  VkRenderPassCreateInfo renderPassInfo = {};
+  renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+  renderPassInfo.attachmentCount = 1;
+  renderPassInfo.pAttachments = &colourAttachment;
+  renderPassInfo.subpassCount = 1;
+  renderPassInfo.pSubpasses = &subpass;
+
+  if (vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &m_renderPass) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create the render pass" << std::endl;
+    throw std::runtime_error("Failed to create a render pass!");
+  }
+
+  VkFramebufferCreateInfo framebufferInfo = {};
+  framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+  framebufferInfo.renderPass = m_renderPass;
+  framebufferInfo.attachmentCount = 1;
+  framebufferInfo.pAttachments = &m_targetView;
+  framebufferInfo.width = TARGET_SIZE;
+  framebufferInfo.height = TARGET_SIZE;
+  framebufferInfo.layers = 1;
+
+  if (vkCreateFramebuffer(m_device, &framebufferInfo, nullptr, &m_framebuffer) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create the framebuffer" << std::endl;
+    throw std::runtime_error("Failed to create a framebuffer!");
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createDescriptorSetLayouts
+ *
+ * abstract  : One layout with a dynamic uniform buffer and one with a storage buffer, both a single matrix per object
+ *             read by the vertex shader.  One set of each is allocated here and pointed at the object buffer whenever
+ *             it is recreated.
+ *
+ * parameters: void
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void objectBench::createDescriptorSetLayouts()
+{
+  VkDescriptorSetLayoutBinding binding = {};
+  binding.binding = 0;
+  binding.descriptorCount = 1;
+  binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.bindingCount = 1;
+  layoutInfo.pBindings = &binding;
+
+  binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+  VkResult result = vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr, &m_uboSetLayout);
+
+  binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  if (result == VK_SUCCESS) result = vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr, &m_ssboSetLayout);
+
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create the descriptor set layouts" << std::endl;
+    throw std::runtime_error("Failed to create a descriptor set layout!");
+  }
+
+  VkDescriptorPoolSize poolSizes[2] = { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 }, { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 } };
+
+  VkDescriptorPoolCreateInfo poolInfo = {};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.maxSets = 2;
+  poolInfo.poolSizeCount = 2;
+  poolInfo.pPoolSizes = poolSizes;
+
+  if (vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create the descriptor pool" << std::endl;
+    throw std::runtime_error("Failed to create a Descriptor Pool!");
+  }
+
+  VkDescriptorSetLayout layouts[2] = { m_uboSetLayout, m_ssboSetLayout };
+  VkDescriptorSet sets[2];
+
+  VkDescriptorSetAllocateInfo setAllocInfo = {};
+  setAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  setAllocInfo.descriptorPool = m_descriptorPool;
+  setAllocInfo.descriptorSetCount = 2;
+  setAllocInfo.pSetLayouts = layouts;
+
+  if (vkAllocateDescriptorSets(m_device, &setAllocInfo, sets) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to allocate the descriptor sets" << std::endl;
+    throw std::runtime_error("Failed to allocate Descriptor Sets!");
+  }
+
+  m_uboSet = sets[0];
+  m_ssboSet = sets[1];
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createPipelines
+ *
+ * abstract  : Builds one pipeline per strategy.  They share the fragment shader, the fixed function state and the quad's
+ *             vertex layout (a vec2 position); they differ in the vertex shader and how the matrix reaches it:
+ *                push constant -- 64 byte push constant range
+ *                dynamic UBO   -- the dynamic uniform buffer set
+ *                SSBO index    -- the storage buffer set
+ *                instanced     -- a second, per-instance, vertex binding holding the matrix as four vec4 attributes
+ *
+ * parameters: void
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void objectBench::createPipelines()
+{
+  const char* vertexShaders[STRATEGY_COUNT] = { "Shaders/bench_push.spv", "Shaders/bench_ubo.spv", "Shaders/bench_ssbo.spv", "Shaders/bench_instanced.spv" };
+
+  VkShaderModule fragmentModule = createShaderModule("Shaders/bench_frag.spv");
+
+  // vertex layouts, binding 0 is the quad and binding 1 the per-instance matrix
+  VkVertexInputBindingDescription bindings[2] = {
+    { 0, sizeof(glm::vec2), VK_VERTEX_INPUT_RATE_VERTEX },
+    { 1, sizeof(glm::mat4), VK_VERTEX_INPUT_RATE_INSTANCE }
+  };
+
+  VkVertexInputAttributeDescription attributes[5] = {
+    { 0, 0, VK_FORMAT_R32G32_SFLOAT, 0 },
+    { 1, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 0 },
+    { 2, 1, VK_FORMAT_R32G32B32A32_SFLOAT, sizeof(glm::vec4) },
+    { 3, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 2 * sizeof(glm::vec4) },
+    { 4, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 3 * sizeof(glm::vec4) }
+  };
+
+  VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+  inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+  inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+  VkViewport viewport = { 0.0f, 0.0f, (float)TARGET_SIZE, (float)TARGET_SIZE, 0.0f, 1.0f };
+  VkRect2D   scissor = { { 0, 0 }, { TARGET_SIZE, TARGET_SIZE } };
+
+  VkPipelineViewportStateCreateInfo viewportState = {};
+  viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+  viewportState.viewportCount = 1;
+  viewportState.pViewports = &viewport;
+  viewportState.scissorCount = 1;
+  viewportState.pScissors = &scissor;
+
+  VkPipelineRasterizationStateCreateInfo rasterizer = {};
+  rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+  rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+  rasterizer.lineWidth = 1.0f;
+  rasterizer.cullMode = VK_CULL_MODE_NONE;
+  rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+  VkPipelineMultisampleStateCreateInfo multisampling = {};
+  multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+  multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+  VkPipelineColorBlendAttachmentState blendAttachment = {};
+  blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+  VkPipelineColorBlendStateCreateInfo colourBlending = {};
+  colourBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+  colourBlending.attachmentCount = 1;
+  colourBlending.pAttachments = &blendAttachment;
+
+  VkPushConstantRange pushRange = { VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4) };
+
+  for (int s = 0; s < STRATEGY_COUNT; s++)
+  {
+    VkPipelineLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    if (s == STRATEGY_PUSH)
+    {
+      layoutInfo.pushConstantRangeCount = 1;
+      layoutInfo.pPushConstantRanges = &pushRange;
+    }
+    else if (s == STRATEGY_DYNAMIC_UBO)
+    {
+      layoutInfo.setLayoutCount = 1;
+      layoutInfo.pSetLayouts = &m_uboSetLayout;
+    }
+    else if (s == STRATEGY_SSBO)
+    {
+      layoutInfo.setLayoutCount = 1;
+      layoutInfo.pSetLayouts = &m_ssboSetLayout;
+    }
+
+    if (vkCreatePipelineLayout(m_device, &layoutInfo, nullptr, &m_layouts[s]) != VK_SUCCESS)
+    {
+      vkDestroyShaderModule(m_device, fragmentModule, nullptr);
+      std::cerr << "[-] failed to create the " << strategyName((objectStrategy)s) << " pipeline layout" << std::endl;
+      throw std::runtime_error("Failed to create Pipeline Layout!");
+    }
+
+    VkShaderModule vertexModule = createShaderModule(vertexShaders[s]);
+
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertexModule;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName = "main";
+
+    VkPipelineVertexInputStateCreateInfo vertexInput = {};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount = (s == STRATEGY_INSTANCED) ? 2 : 1;
+    vertexInput.pVertexBindingDescriptions = bindings;
+    vertexInput.vertexAttributeDescriptionCount = (s == STRATEGY_INSTANCED) ? 5 : 1;
+    vertexInput.pVertexAttributeDescriptions = attributes;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pColorBlendState = &colourBlending;
+    pipelineInfo.layout = m_layouts[s];
+    pipelineInfo.renderPass = m_renderPass;
+    pipelineInfo.subpass = 0;
+
+    VkResult result = vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipelines[s]);
+    vkDestroyShaderModule(m_device, vertexModule, nullptr);
+
+    if (result != VK_SUCCESS)
+    {
+      vkDestroyShaderModule(m_device, fragmentModule, nullptr);
+      std::cerr << "[-] failed to create the " << strategyName((objectStrategy)s) << " pipeline" << std::endl;
+      throw std::runtime_error("Failed to create a Graphics Pipeline!");
+    }
+  }
+
+  vkDestroyShaderModule(m_device, fragmentModule, nullptr);
+}
+
+
+
+// the one quad every object draws, vertices followed by indices in a single host visible buffer
+void objectBench::createQuad()
+{
+  const glm::vec2 vertices[4] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+  const uint32_t  indices[6] = { 0, 1, 2, 2, 3, 0 };
+
+  m_quadIndexOffset = sizeof(vertices);
+  createBuffer(m_physical, m_device, sizeof(vertices) + sizeof(indices), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &m_quadBuffer, &m_quadMemory);
+
+  void* data;
+  vkMapMemory(m_device, m_quadMemory, 0, sizeof(vertices) + sizeof(indices), 0, &data);
+  memcpy(data, vertices, sizeof(vertices));
+  memcpy((uint8_t*)data + m_quadIndexOffset, indices, sizeof(indices));
+  vkUnmapMemory(m_device, m_quadMemory);
+}
+
+
+
+// command pool/buffer, the fence every frame waits on and two time stamp queries around the render pass
+void objectBench::createCommandObjects()
+{
+  VkCommandPoolCreateInfo poolInfo = {};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+  poolInfo.queueFamilyIndex = m_queueFamily;
+
+  VkCommandBufferAllocateInfo bufferInfo = {};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  bufferInfo.commandBufferCount = 1;
+
+  VkFenceCreateInfo fenceInfo = {};
+  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+  VkQueryPoolCreateInfo queryInfo = {};
+  queryInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  queryInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+  queryInfo.queryCount = 2;
+
+  VkResult result = vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool);
+
+  bufferInfo.commandPool = m_commandPool;
+  if (result == VK_SUCCESS) result = vkAllocateCommandBuffers(m_device, &bufferInfo, &m_commandBuffer);
+  if (result == VK_SUCCESS) result = vkCreateFence(m_device, &fenceInfo, nullptr, &m_fence);
+  if (result == VK_SUCCESS && m_timestampPeriod > 0.0f) result = vkCreateQueryPool(m_device, &queryInfo, nullptr, &m_queryPool);
+
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create the command buffer, fence or query pool" << std::endl;
+    throw std::runtime_error("Failed to create command objects!");
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createObjects
+ *
+ * abstract  : Makes room for N objects.  The object buffer is host visible, coherent and stays mapped; it is sized for
+ *             the largest stride (the dynamic UBO's) and is used as uniform, storage and vertex buffer, so every strategy
+ *             reads the same memory.  The matrices place N small quads at random in the target.
+ *
+ * parameters: objects -- [in] number of objects in the scene
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void objectBench::createObjects(int objects)
+{
+  destroyObjects();
+
+  VkDeviceSize stride = std::max<VkDeviceSize>(m_uboAlignment, sizeof(glm::mat4));
+  VkDeviceSize size = stride * objects;
+
+  createBuffer(m_physical, m_device, size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &m_objectBuffer, &m_objectMemory);
+
+  if (vkMapMemory(m_device, m_objectMemory, 0, VK_WHOLE_SIZE, 0, &m_objectMapped) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to map the object buffer" << std::endl;
+    throw std::runtime_error("Failed to map buffer memory!");
+  }
+
+  VkDescriptorBufferInfo uboInfo = { m_objectBuffer, 0, sizeof(glm::mat4) };
+  VkDescriptorBufferInfo ssboInfo = { m_objectBuffer, 0, sizeof(glm::mat4) * objects };
+
+  VkWriteDescriptorSet writes[2] = {};
+  writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  writes[0].dstSet = m_uboSet;
+  writes[0].descriptorCount = 1;
+  writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+  writes[0].pBufferInfo = &uboInfo;
+  writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  writes[1].dstSet = m_ssboSet;
+  writes[1].descriptorCount = 1;
+  writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  writes[1].pBufferInfo = &ssboInfo;
+
+  vkUpdateDescriptorSets(m_device, 2, writes, 0, nullptr);
+
+  // same layout for a given N, whatever order the counts come in
+  std::mt19937 rng(objects);
+  std::uniform_real_distribution<float> place(-0.95f, 0.95f);
+  std::uniform_real_distribution<float> turn(0.0f, 6.2831853f);
+
+  float size1d = std::max(0.01f, 1.5f / std::sqrt((float)objects));
+  m_matrices.resize(objects);
+  for (int ndx = 0; ndx < objects; ndx++)
+  {
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(place(rng), place(rng), 0.5f));
+    m = glm::rotate(m, turn(rng), glm::vec3(0.0f, 0.0f, 1.0f));
+    m_matrices[ndx] = glm::scale(m, glm::vec3(size1d, size1d, 1.0f));
+  }
+}
+
+
+
+void objectBench::destroyObjects()
+{
+  if (m_objectBuffer == VK_NULL_HANDLE) return;
+
+  vkDeviceWaitIdle(m_device);
+  vkUnmapMemory(m_device, m_objectMemory);
+  vkDestroyBuffer(m_device, m_objectBuffer, nullptr);
+  freeDeviceMemory(m_device, m_objectMemory);
+
+  m_objectBuffer = VK_NULL_HANDLE;
+  m_objectMemory = VK_NULL_HANDLE;
+  m_objectMapped = nullptr;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : writeObjects
+ *
+ * abstract  : The per-frame upload; every object is treated as having moved.  Push constants carry the matrices in
+ *             the command buffer so nothing is written here, the dynamic UBO writes each matrix at its aligned stride,
+ *             the SSBO and instanced strategies write them packed.
+ *
+ * parameters: strategy -- [in] strategy being measured
+ *             objects -- [in] number of objects
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void objectBench::writeObjects(objectStrategy strategy, int objects)
+{
+  uint8_t* dst = (uint8_t*)m_objectMapped;
+
+  switch (strategy)
+  {
+    case STRATEGY_PUSH:
+      break;
+
+    case STRATEGY_DYNAMIC_UBO:
+      for (int ndx = 0; ndx < objects; ndx++)
+      {
+        memcpy(dst + ndx * m_uboAlignment, &m_matrices[ndx], sizeof(glm::mat4));
+      }
+      break;
+
+    default:
+      memcpy(dst, m_matrices.data(), sizeof(glm::mat4) * objects);
+      break;
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : record
+ *
+ * abstract  : Records one frame: reset the time stamps, render pass, bind the strategy's pipeline and quad, then draw
+ *             every object.  Re-recorded every frame, as vkContext does.
+ *
+ * parameters: strategy -- [in] strategy being measured
+ *             objects -- [in] number of objects
+ *
+ * returns   : uint32_t, the number of draw calls recorded
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+uint32_t objectBench::record(objectStrategy strategy, int objects)
+{
+  uint32_t draws = 0;
+
+  vkResetCommandPool(m_device, m_commandPool, 0);
+
+  VkCommandBufferBeginInfo beginInfo = {};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  vkBeginCommandBuffer(m_commandBuffer, &beginInfo);
+
+  if (m_queryPool != VK_NULL_HANDLE)
+  {
+    vkCmdResetQueryPool(m_commandBuffer, m_queryPool, 0, 2);
+    vkCmdWriteTimestamp(m_commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, 0);
+  }
+
+  VkClearValue clearValue = {};
+  clearValue.color = { { 0.6f, 0.65f, 0.4f, 1.0f } };
+
+  VkRenderPassBeginInfo renderBeginInfo = {};
+  renderBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+  renderBeginInfo.renderPass = m_renderPass;
+  renderBeginInfo.framebuffer = m_framebuffer;
+  renderBeginInfo.renderArea = { { 0, 0 }, { TARGET_SIZE, TARGET_SIZE } };
+  renderBeginInfo.clearValueCount = 1;
+  renderBeginInfo.pClearValues = &clearValue;
+
+  vkCmdBeginRenderPass(m_commandBuffer, &renderBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+  vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelines[strategy]);
+
+  VkBuffer     vertexBuffers[2] = { m_quadBuffer, m_objectBuffer };
+  VkDeviceSize offsets[2] = { 0, 0 };
+  vkCmdBindVertexBuffers(m_commandBuffer, 0, (strategy == STRATEGY_INSTANCED) ? 2 : 1, vertexBuffers, offsets);
+  vkCmdBindIndexBuffer(m_commandBuffer, m_quadBuffer, m_quadIndexOffset, VK_INDEX_TYPE_UINT32);
+
+  switch (strategy)
+  {
+    case STRATEGY_PUSH:
+      for (int ndx = 0; ndx < objects; ndx++)
+      {
+        vkCmdPushConstants(m_commandBuffer, m_layouts[strategy], VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &m_matrices[ndx]);
+        vkCmdDrawIndexed(m_commandBuffer, 6, 1, 0, 0, 0);
+        draws++;
+      }
+      break;
+
+    case STRATEGY_DYNAMIC_UBO:
+      for (int ndx = 0; ndx < objects; ndx++)
+      {
+        uint32_t dynamicOffset = static_cast<uint32_t>(m_uboAlignment * ndx);
+        vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_layouts[strategy], 0, 1, &m_uboSet, 1, &dynamicOffset);
+        vkCmdDrawIndexed(m_commandBuffer, 6, 1, 0, 0, 0);
+        draws++;
+      }
+      break;
+
+    case STRATEGY_SSBO:
+      vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_layouts[strategy], 0, 1, &m_ssboSet, 0, nullptr);
+      for (int ndx = 0; ndx < objects; ndx++)
+      {
+        vkCmdDrawIndexed(m_commandBuffer, 6, 1, 0, 0, (uint32_t)ndx);       // gl_InstanceIndex picks the matrix
+        draws++;
+      }
+      break;
+
+    default:
+      vkCmdDrawIndexed(m_commandBuffer, 6, (uint32_t)objects, 0, 0, 0);
+      draws++;
+      break;
+  }
+
+  vkCmdEndRenderPass(m_commandBuffer);
+
+  if (m_queryPool != VK_NULL_HANDLE)
+  {
+    vkCmdWriteTimestamp(m_commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, 1);
+  }
+
+  vkEndCommandBuffer(m_commandBuffer);
+
+  return draws;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : measure
+ *
+ * abstract  : Renders the warm up frames, then the measured frames, for one strategy at one object count.  Each frame
+ *             is written, recorded, submitted and waited for before the next, so the GPU time of one frame never
+ *             overlaps the CPU time of the next.
+ *
+ * parameters: strategy -- [in] strategy to measure
+ *             objects -- [in] number of objects
+ *
+ * returns   : objectBenchSample, the averages over the measured frames
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+objectBenchSample objectBench::measure(objectStrategy strategy, int objects)
+{
+  objectBenchSample sample;
+  sample.strategy = strategy;
+  sample.objects = objects;
+
+  double gpuMs = 0.0;
+  int    gpuFrames = 0;
+
+  for (int frame = -m_config.warmupFrames; frame < m_config.frames; frame++)
+  {
+    auto frameStart = benchClock::now();
+
+    writeObjects(strategy, objects);
+    auto writeEnd = benchClock::now();
+
+    uint32_t draws = record(strategy, objects);
+    auto recordEnd = benchClock::now();
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &m_commandBuffer;
+
+    if (vkQueueSubmit(m_queue, 1, &submitInfo, m_fence) != VK_SUCCESS)
+    {
+      std::cerr << "[-] failed to submit the benchmark frame" << std::endl;
+      throw std::runtime_error("Failed to submit Command Buffer to Queue!");
+    }
+    vkWaitForFences(m_device, 1, &m_fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    vkResetFences(m_device, 1, &m_fence);
+
+    auto frameEnd = benchClock::now();
+
+    if (frame < 0) continue;
+
+    sample.draws = draws;
+    sample.writeMs += elapsedMs(frameStart, writeEnd);
+    sample.recordMs += elapsedMs(writeEnd, recordEnd);
+    sample.frameMs += elapsedMs(frameStart, frameEnd);
+
+    uint64_t stamps[2];
+    if (m_queryPool != VK_NULL_HANDLE &&
+        vkGetQueryPoolResults(m_device, m_queryPool, 0, 2, sizeof(stamps), stamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS)
+    {
+      gpuMs += (stamps[1] - stamps[0]) * m_timestampPeriod / 1.0e6;
+      gpuFrames++;
+    }
+  }
+
+  if (m_config.frames > 0)
+  {
+    sample.writeMs /= m_config.frames;
+    sample.recordMs /= m_config.frames;
+    sample.frameMs /= m_config.frames;
+  }
+  if (gpuFrames > 0) sample.gpuMs = gpuMs / gpuFrames;
+
+  sample.pushBytes = (strategy == STRATEGY_PUSH) ? (uint64_t)objects * sizeof(glm::mat4) : 0;
+  sample.mappedBytes = (strategy == STRATEGY_PUSH) ? 0 : (uint64_t)objects * sizeof(glm::mat4);
+
+  return sample;
+}
+
+
+
+void objectBench::writeCsv()
+{
+  if (m_samples.empty()) return;
+
+  std::ofstream csv(m_config.csvFile);
+  if (!csv)
+  {
+    std::cerr << "[-] unable to write " << m_config.csvFile << std::endl;
+    return;
+  }
+
+  csv << "strategy,objects,draws,write_ms,record_ms,gpu_ms,frame_ms,push_bytes,mapped_bytes" << std::endl;
+
+  for (const objectBenchSample& s : m_samples)
+  {
+    csv << strategyName(s.strategy) << "," << s.objects << "," << s.draws << "," << s.writeMs << "," << s.recordMs << ","
+        << s.gpuMs << "," << s.frameMs << "," << s.pushBytes << "," << s.mappedBytes << std::endl;
+  }
+
+  std::cout << "[+] wrote " << m_samples.size() << " samples to " << m_config.csvFile << std::endl;
+}
+
+
+
+// table of the results grouped by N, the cheapest strategy (CPU write + record) at each N is marked with '*'
+void objectBench::printSummary(std::ostream& os)
+{
+  if (m_samples.empty()) return;
+
+  os << "       N  strategy        draws   write ms  record ms     gpu ms   frame ms   upload KB" << std::endl;
+
+  for (size_t first = 0; first < m_samples.size(); )
+  {
+    size_t last = first;
+    size_t best = first;
+    while (last < m_samples.size() && m_samples[last].objects == m_samples[first].objects)
+    {
+      const objectBenchSample& s = m_samples[last];
+      if (s.writeMs + s.recordMs < m_samples[best].writeMs + m_samples[best].recordMs) best = last;
+      last++;
+    }
+
+    for (size_t ndx = first; ndx < last; ndx++)
+    {
+      const objectBenchSample& s = m_samples[ndx];
+
+      os << std::setw(8) << s.objects << "  " << std::left << std::setw(14) << strategyName(s.strategy) << std::right
+         << std::setw(7) << s.draws << std::fixed << std::setprecision(3)
+         << std::setw(11) << s.writeMs << std::setw(11) << s.recordMs;
+      if (s.gpuMs < 0.0) os << std::setw(11) << "n/a";
+      else               os << std::setw(11) << s.gpuMs;
+      os << std::setw(11) << s.frameMs << std::setprecision(1) << std::setw(12) << (s.pushBytes + s.mappedBytes) / 1024.0
+         << ((ndx == best) ? "  *" : "") << std::endl;
+    }
+
+    first = last;
+  }
+  os.unsetf(std::ios::floatfield);
+}
+
+
+
+// loads a SPIR-V file from the Shaders directory
+VkShaderModule objectBench::createShaderModule(const std::string& fileName)
+{
+  std::vector<char> code = readAsset(fileName);
+
+  VkShaderModuleCreateInfo createInfo = {};
+  createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+  createInfo.codeSize = code.size();
+  createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+  VkShaderModule shaderModule;
+  if (vkCreateShaderModule(m_device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create a shader module from " << fileName << std::endl;
+    throw std::runtime_error("Failed to create a shader module!");
+  }
+
+  return shaderModule;
+}
+
+
+
+// destroys whatever was created, safe to call more than once
+void objectBench::cleanup()
+{
+  if (m_device != VK_NULL_HANDLE)
+  {
+    vkDeviceWaitIdle(m_device);
+
+    destroyObjects();
+
+    if (m_quadBuffer != VK_NULL_HANDLE)
+    {
+      vkDestroyBuffer(m_device, m_quadBuffer, nullptr);
+      freeDeviceMemory(m_device, m_quadMemory);
+    }
+
+    if (m_queryPool != VK_NULL_HANDLE) vkDestroyQueryPool(m_device, m_queryPool, nullptr);
+    if (m_fence != VK_NULL_HANDLE) vkDestroyFence(m_device, m_fence, nullptr);
+    if (m_commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(m_device, m_commandPool, nullptr);
+
+    for (int s = 0; s < STRATEGY_COUNT; s++)
+    {
+      if (m_pipelines[s] != VK_NULL_HANDLE) vkDestroyPipeline(m_device, m_pipelines[s], nullptr);
+      if (m_layouts[s] != VK_NULL_HANDLE) vkDestroyPipelineLayout(m_device, m_layouts[s], nullptr);
+    }
+
+    if (m_descriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(m_device, m_descriptorPool, nullptr);
+    if (m_ssboSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(m_device, m_ssboSetLayout, nullptr);
+    if (m_uboSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(m_device, m_uboSetLayout, nullptr);
+
+    if (m_framebuffer != VK_NULL_HANDLE) vkDestroyFramebuffer(m_device, m_framebuffer, nullptr);
+    if (m_renderPass != VK_NULL_HANDLE) vkDestroyRenderPass(m_device, m_renderPass, nullptr);
+    if (m_targetView != VK_NULL_HANDLE) vkDestroyImageView(m_device, m_targetView, nullptr);
+    if (m_target != VK_NULL_HANDLE) vkDestroyImage(m_device, m_target, nullptr);
+    if (m_targetMemory != VK_NULL_HANDLE) freeDeviceMemory(m_device, m_targetMemory);
+
+    vkDestroyDevice(m_device, nullptr);
+  }
+
+  if (m_instance != VK_NULL_HANDLE) vkDestroyInstance(m_instance, nullptr);
+
+  m_quadBuffer = VK_NULL_HANDLE;
+  m_queryPool = VK_NULL_HANDLE;
+  m_fence = VK_NULL_HANDLE;
+  m_commandPool = VK_NULL_HANDLE;
+  for (int s = 0; s < STRATEGY_COUNT; s++) { m_pipelines[s] = VK_NULL_HANDLE; m_layouts[s] = VK_NULL_HANDLE; }
+  m_descriptorPool = VK_NULL_HANDLE;
+  m_ssboSetLayout = VK_NULL_HANDLE;
+  m_uboSetLayout = VK_NULL_HANDLE;
+  m_framebuffer = VK_NULL_HANDLE;
+  m_renderPass = VK_NULL_HANDLE;
+  m_targetView = VK_NULL_HANDLE;
+  m_target = VK_NULL_HANDLE;
+  m_targetMemory = VK_NULL_HANDLE;
+  m_device = VK_NULL_HANDLE;
+  m_instance = VK_NULL_HANDLE;
+}
@@ -0,0 +1,120 @@
+#ifndef _objectBench_h_
+#define _objectBench_h_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "utilities.h"
+
+// the ways of getting a per-object matrix to the vertex shader that are compared
+enum objectStrategy
+{
+  STRATEGY_PUSH,              // vkCmdPushConstants before each draw (triangle3b onward)
+  STRATEGY_DYNAMIC_UBO,       // one dynamic uniform buffer, rebound with a new offset before each draw (triangle3a)
+  STRATEGY_SSBO,              // one storage buffer bound once, indexed with gl_InstanceIndex (firstInstance = object)
+  STRATEGY_INSTANCED,         // per-instance vertex attributes, a single draw for every object
+  STRATEGY_COUNT
+};
+
+// settings for a benchmark run, see objectBench::run
+struct objectBenchConfig
+{
+  std::vector<int> counts = { 10, 100, 1000, 10000, 100000 };
+  int              warmupFrames = 10;
+  int              frames = 100;           // frames measured for each strategy at each N
+  std::string      csvFile = "objects.csv";
+  std::string      device;                 // device override, see selectDevice; empty => $VULKAN7_DEVICE
+};
+
+// what was measured for one strategy at one object count, times are averages per frame
+struct objectBenchSample
+{
+  objectStrategy strategy = STRATEGY_PUSH;
+  int            objects = 0;
+  uint32_t       draws = 0;                // draw calls recorded
+  double         writeMs = 0.0;            // CPU time writing the matrices into mapped memory
+  double         recordMs = 0.0;           // CPU time recording the command buffer
+  double         gpuMs = -1.0;             // time stamp delta around the render pass, negative if not supported
+  double         frameMs = 0.0;            // wall time of the whole frame, submit and fence wait included
+  uint64_t       pushBytes = 0;            // per-object data carried in the command buffer
+  uint64_t       mappedBytes = 0;          // per-object data written to host visible memory
+};
+
+// Headless benchmark of the per-object data strategies.  Creates its own instance and device (no window or swapchain)
+// and renders N small quads into an offscreen image with each strategy, one frame in flight so that every frame is
+// measured on its own.  Every object's matrix is treated as changed every frame.
+class objectBench
+{
+public:
+  objectBench(const objectBenchConfig& config);
+  ~objectBench();
+
+  int run(std::ostream& os);
+
+  static const char* strategyName(objectStrategy strategy);
+
+private:
+  objectBenchConfig              m_config;
+  std::vector<objectBenchSample> m_samples;
+
+  VkInstance                     m_instance = VK_NULL_HANDLE;
+  VkPhysicalDevice               m_physical = VK_NULL_HANDLE;
+  VkDevice                       m_device = VK_NULL_HANDLE;
+  VkQueue                        m_queue = VK_NULL_HANDLE;
+  uint32_t                       m_queueFamily = 0;
+  float                          m_timestampPeriod = 0.0f;   // ns per tick, zero => no time stamps on this queue
+  VkDeviceSize                   m_uboAlignment = 0;         // stride of the dynamic uniform buffer
+
+  VkImage                        m_target = VK_NULL_HANDLE;
+  VkDeviceMemory                 m_targetMemory = VK_NULL_HANDLE;
+  VkImageView                    m_targetView = VK_NULL_HANDLE;
+  VkRenderPass                   m_renderPass = VK_NULL_HANDLE;
+  VkFramebuffer                  m_framebuffer = VK_NULL_HANDLE;
+
+  VkDescriptorSetLayout          m_uboSetLayout = VK_NULL_HANDLE;
+  VkDescriptorSetLayout          m_ssboSetLayout = VK_NULL_HANDLE;
+  VkDescriptorPool               m_descriptorPool = VK_NULL_HANDLE;
+  VkDescriptorSet                m_uboSet = VK_NULL_HANDLE;
+  VkDescriptorSet                m_ssboSet = VK_NULL_HANDLE;
+
+  VkPipelineLayout               m_layouts[STRATEGY_COUNT] = {};
+  VkPipeline                     m_pipelines[STRATEGY_COUNT] = {};
+
+  VkBuffer                       m_quadBuffer = VK_NULL_HANDLE;     // shared vertices then indices
+  VkDeviceMemory                 m_quadMemory = VK_NULL_HANDLE;
+  VkDeviceSize                   m_quadIndexOffset = 0;
+
+  VkBuffer                       m_objectBuffer = VK_NULL_HANDLE;   // per-object matrices, used by every strategy
+  VkDeviceMemory                 m_objectMemory = VK_NULL_HANDLE;
+  void*                          m_objectMapped = nullptr;
+  std::vector<glm::mat4>         m_matrices;
+
+  VkCommandPool                  m_commandPool = VK_NULL_HANDLE;
+  VkCommandBuffer                m_commandBuffer = VK_NULL_HANDLE;
+  VkFence                        m_fence = VK_NULL_HANDLE;
+  VkQueryPool                    m_queryPool = VK_NULL_HANDLE;
+
+  static const uint32_t TARGET_SIZE = 512;
+
+  void createDevice();
+  void createTarget();
+  void createDescriptorSetLayouts();
+  void createPipelines();
+  void createQuad();
+  void createCommandObjects();
+  void createObjects(int objects);
+  void destroyObjects();
+  void cleanup();
+
+  void              writeObjects(objectStrategy strategy, int objects);
+  uint32_t          record(objectStrategy strategy, int objects);
+  objectBenchSample measure(objectStrategy strategy, int objects);
+
+  void writeCsv();
+  void printSummary(std::ostream& os);
+
+  VkShaderModule createShaderModule(const std::string& fileName);
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include "perfHud.h"
+#include "hudFont.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+  const float PANEL_X = 8.0f;                                   // top left of the panel, pixels
+  const float PANEL_Y = 8.0f;
+  const float PANEL_WIDTH = 56.0f * HUD_GLYPH_WIDTH;            // 54 characters and a margin
+  const float LINE_HEIGHT = (float)HUD_GLYPH_HEIGHT;
+  const float GRAPH_HEIGHT = 48.0f;
+  const float GRAPH_BAR = 2.0f;                                 // width of a frame in the graph
+  const float GRAPH_MAX_MS = 50.0f;                             // frame time at the top of the graph
+
+  constexpr uint32_t rgba(uint32_t r, uint32_t g, uint32_t b, uint32_t a) { return r | (g << 8) | (b << 16) | (a << 24); }
+
+  const uint32_t BACKGROUND = rgba(0, 0, 0, 176);
+  const uint32_t WHITE = rgba(255, 255, 255, 255);
+  const uint32_t GREY = rgba(150, 150, 150, 255);
+  const uint32_t GREEN = rgba(64, 224, 64, 255);
+  const uint32_t YELLOW = rgba(240, 208, 48, 255);
+  const uint32_t RED = rgba(255, 64, 64, 255);
+
+  // a frame time against 60 and 30 Hz, with a little slack for vsync jitter
+  uint32_t frameColour(double ms)
+  {
+    if (ms <= 1000.0 / 60.0 + 0.5) return GREEN;
+    if (ms <= 1000.0 / 30.0 + 0.5) return YELLOW;
+    return RED;
+  }
+}
+
+
+
+// the font laid out HUD_ATLAS_COLUMNS cells across, plus the solid cell.  Transparent texels are white too, so filtering
+// never darkens the edges of a glyph
+void perfHud::buildAtlas(std::vector<uint8_t>* rgba, uint32_t* width, uint32_t* height)
+{
+  *width = HUD_ATLAS_COLUMNS * HUD_GLYPH_WIDTH;
+  *height = HUD_ATLAS_ROWS * HUD_GLYPH_HEIGHT;
+  rgba->assign((size_t)*width * *height * 4, 0);
+  for (size_t p = 0; p < rgba->size(); p += 4) (*rgba)[p] = (*rgba)[p + 1] = (*rgba)[p + 2] = 255;
+
+  for (uint32_t cell = 0; cell <= HUD_SOLID_GLYPH; cell++)
+  {
+    uint32_t left = (cell % HUD_ATLAS_COLUMNS) * HUD_GLYPH_WIDTH;
+    uint32_t top = (cell / HUD_ATLAS_COLUMNS) * HUD_GLYPH_HEIGHT;
+
+    for (uint32_t row = 0; row < HUD_GLYPH_HEIGHT; row++)
+    {
+      uint8_t bits = (HUD_SOLID_GLYPH == cell) ? 0xff : hudFontGlyphs[cell][row];
+      for (uint32_t col = 0; col < HUD_GLYPH_WIDTH; col++)
+      {
+        (*rgba)[((size_t)(top + row) * *width + left + col) * 4 + 3] = (bits & (0x80 >> col)) ? 255 : 0;
+      }
+    }
+  }
+}
+
+
+
+void perfHud::addFrame(double frameMs)
+{
+  m_frameMs[m_next] = (float)frameMs;
+  m_next = (m_next + 1) % HUD_GRAPH_FRAMES;
+  m_frames = std::min(m_frames + 1, HUD_GRAPH_FRAMES);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : build
+ *
+ * abstract  : Lays out the HUD into quads, in the order they are drawn (later quads over earlier ones);
+ *               (a) the panel's background
+ *               (b) the frame rate and frame time, averaged over the graph's frames
+ *               (c) the frame time graph, oldest frame on the left and coloured against 60 and 30 Hz (which are marked)
+ *               (d) a line each for the CPU phases, the GPU passes, draws and triangles with the binds, uploads and
+ *                   submits, and device memory
+ *               (e) the HUD's own CPU and GPU time, red when either is over HUD_BUDGET_MS
+ *             Text is formatted into a buffer on the stack, nothing is allocated.  Quads past capacity are dropped.
+ *
+ * parameters: data -- [in] what to show
+ *             quads -- [out] where to write the quads, usually the mapped quad buffer
+ *             capacity -- [in] most quads that can be written
+ *
+ * returns   : size_t, number of quads written
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+size_t perfHud::build(const hudFrameData& data, hudQuad* quads, size_t capacity)
+{
+  m_quads = quads;
+  m_count = 0;
+  m_capacity = capacity;
+
+  const int textLines = 7;
+  float x = PANEL_X + HUD_GLYPH_WIDTH;
+  float y = PANEL_Y + 4.0f;
+  rect(PANEL_X, PANEL_Y, PANEL_WIDTH, textLines * LINE_HEIGHT + GRAPH_HEIGHT + 12.0f, BACKGROUND);
+
+  double total = 0.0;
+  for (size_t f = 0; f < m_frames; f++) total += m_frameMs[f];
+  double average = (m_frames > 0) ? total / m_frames : 0.0;
+
+  char line[96];
+  snprintf(line, sizeof(line), "%6.1f fps %6.2f ms", (average > 0.0) ? 1000.0 / average : 0.0, average);
+  text(x, y, line, WHITE);
+  y += LINE_HEIGHT;
+
+  float bottom = y + GRAPH_HEIGHT;
+  for (size_t f = 0; f < m_frames; f++)
+  {
+    size_t ndx = (m_frames < HUD_GRAPH_FRAMES) ? f : (m_next + f) % HUD_GRAPH_FRAMES;
+    float  height = std::min(m_frameMs[ndx] / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+    rect(x + f * GRAPH_BAR, bottom - height, GRAPH_BAR, height, frameColour(m_frameMs[ndx]));
+  }
+  for (double hz : { 60.0, 30.0 })
+  {
+    rect(x, bottom - (float)(1000.0 / hz) / GRAPH_MAX_MS * GRAPH_HEIGHT, HUD_GRAPH_FRAMES * GRAPH_BAR, 1.0f, GREY);
+  }
+  y = bottom + 4.0f;
+
+  snprintf(line, sizeof(line), "cpu wait %.2f acq %.2f upd %.2f rec %.2f sub %.2f", data.waitMs, data.acquireMs,
+    data.updateMs, data.recordMs, data.submitMs);
+  text(x, y, line, WHITE);
+  y += LINE_HEIGHT;
+
+  if (data.gpuValid) snprintf(line, sizeof(line), "gpu cull %.2f scene %.2f post %.2f", data.cullMs, data.sceneMs, data.postMs);
+  else snprintf(line, sizeof(line), "gpu no timestamps");
+  text(x, y, line, WHITE);
+  y += LINE_HEIGHT;
+
+  const frameStats& frame = data.frame;
+  if (frame.triangles >= 1000000) snprintf(line, sizeof(line), "draws %u tris %.2fM", frame.drawCalls, frame.triangles / 1.0e6);
+  else snprintf(line, sizeof(line), "draws %u tris %.1fK", frame.drawCalls, frame.triangles / 1.0e3);
+  text(x, y, line, WHITE);
+  y += LINE_HEIGHT;
+
+  snprintf(line, sizeof(line), "bind pipe %u set %u vb %u ib %u push %uB", frame.pipelineBinds, frame.descriptorBinds,
+    frame.vertexBufferBinds, frame.indexBufferBinds, frame.pushConstantBytes);
+  text(x, y, line, WHITE);
+  y += LINE_HEIGHT;
+
+  snprintf(line, sizeof(line), "mem %.1f MB in %u allocs up %.1f KB sub %u", data.memoryBytes / (1024.0 * 1024.0),
+    data.memoryAllocations, frame.uploadBytes / 1024.0, frame.queueSubmits);
+  text(x, y, line, WHITE);
+  y += LINE_HEIGHT;
+
+  bool overBudget = data.hudCpuMs > HUD_BUDGET_MS || (data.gpuValid && data.hudGpuMs > HUD_BUDGET_MS);
+  if (data.gpuValid) snprintf(line, sizeof(line), "hud cpu %.3f gpu %.3f ms", data.hudCpuMs, data.hudGpuMs);
+  else snprintf(line, sizeof(line), "hud cpu %.3f ms", data.hudCpuMs);
+  text(x, y, line, overBudget ? RED : GREY);
+
+  return m_count;
+}
+
+
+
+void perfHud::rect(float x, float y, float w, float h, uint32_t colour)
+{
+  if (m_count == m_capacity) return;
+  m_quads[m_count++] = { x, y, w, h, HUD_SOLID_GLYPH, colour };
+}
+
+
+
+// one quad per character that is not a space, anything outside printable ASCII is drawn as '?'
+void perfHud::text(float x, float y, const char* s, uint32_t colour)
+{
+  for (; '\0' != *s && m_count < m_capacity; s++, x += HUD_GLYPH_WIDTH)
+  {
+    uint32_t c = (uint8_t)*s;
+    if (' ' == c) continue;
+    if (c < HUD_FIRST_CHAR || c >= HUD_FIRST_CHAR + HUD_GLYPH_COUNT) c = '?';
+
+    m_quads[m_count++] = { x, y, (float)HUD_GLYPH_WIDTH, (float)HUD_GLYPH_HEIGHT, c - HUD_FIRST_CHAR, colour };
+  }
+}
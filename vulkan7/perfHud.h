@@ -0,0 +1,70 @@
+#ifndef _perfHud_h_
+#define _perfHud_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "frameStats.h"
+
+const uint32_t HUD_MAX_QUADS = 1024;            // per frame, the size of each swapchain image's quad buffer
+const size_t   HUD_GRAPH_FRAMES = 128;          // frames in the frame time graph
+const double   HUD_BUDGET_MS = 0.1;             // the HUD's own CPU or GPU time is shown in red above this
+const uint32_t HUD_TIMESTAMPS = 5;              // per swapchain image; start, after culling, after the scene, post, HUD
+
+const uint32_t HUD_ATLAS_COLUMNS = 16;          // glyph cells across and down the font atlas, see Shaders/hud.vert
+const uint32_t HUD_ATLAS_ROWS = 6;
+const uint32_t HUD_SOLID_GLYPH = 95;            // the cell after '~', filled, for rectangles
+
+// one instance of the HUD's quad draw (Shaders/hud.vert), 24 bytes
+struct hudQuad
+{
+  float    x, y, w, h;              // pixels from the top left of the screen
+  uint32_t glyph;                   // atlas cell, the character - 32 or HUD_SOLID_GLYPH
+  uint32_t colour;                  // RGBA8, red in the low byte
+};
+
+// what the HUD shows, gathered by the context.  Times are in ms
+struct hudFrameData
+{
+  double   waitMs = 0.0;            // CPU phases of the last frame's draw; waiting for its fence,
+  double   acquireMs = 0.0;         // acquiring the image,
+  double   updateMs = 0.0;          // reading back queries, composing transforms and updating streams,
+  double   recordMs = 0.0;          // recording the command buffer,
+  double   submitMs = 0.0;          // updating the uniforms, submitting and presenting
+  bool     gpuValid = false;        // the GPU times below have been read back
+  double   cullMs = 0.0;
+  double   sceneMs = 0.0;
+  double   postMs = 0.0;
+  double   hudGpuMs = 0.0;
+  double   hudCpuMs = 0.0;          // building and recording the HUD
+  frameStats frame;                 // the last whole frame's counters, see vkContext::getFrameStats
+  uint64_t memoryBytes = 0;         // device memory, see gpuMemoryTracker
+  uint32_t memoryAllocations = 0;
+};
+
+// Lays out the performance HUD as quads; text in a baked bitmap font (hudFont.h) and filled rectangles for the
+// background and the frame time graph, all cells of one atlas so the whole HUD is one instanced draw.  Building writes
+// straight into the caller's buffer (the mapped quad buffer) and does not allocate.
+class perfHud
+{
+public:
+  static void buildAtlas(std::vector<uint8_t>* rgba, uint32_t* width, uint32_t* height);     // RGBA8, white with glyph alpha
+
+  void   addFrame(double frameMs);                                        // to the frame time graph
+  size_t build(const hudFrameData& data, hudQuad* quads, size_t capacity);  // returns the number of quads written
+
+private:
+  float    m_frameMs[HUD_GRAPH_FRAMES] = {};
+  size_t   m_next = 0;                              // oldest frame in m_frameMs once it is full
+  size_t   m_frames = 0;
+
+  hudQuad* m_quads = nullptr;                       // while building
+  size_t   m_count = 0;
+  size_t   m_capacity = 0;
+
+  void rect(float x, float y, float w, float h, uint32_t colour);
+  void text(float x, float y, const char* s, uint32_t colour);
+};
+
+#endif
@@ -0,0 +1,848 @@
+#include "renderGraph.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+  // what a usage means to the GPU; access is the whole of it (a destination), its write bits are the source
+  struct usageInfo
+  {
+    bool                 image;
+    bool                 write;
+    rgPassType           passType;
+    VkPipelineStageFlags stage;
+    VkAccessFlags        access;
+    VkImageLayout        layout;
+    VkImageUsageFlags    imageUsage;
+    const char*          name;
+  };
+
+  const usageInfo usages[RG_USAGE_COUNT] =
+  {
+    { true,  true,  RG_GRAPHICS, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+      VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, "colour write" },
+    { true,  true,  RG_GRAPHICS, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+      VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+      VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, "depth write" },
+    { true,  false, RG_GRAPHICS, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_INPUT_ATTACHMENT_READ_BIT,
+      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT, "input read" },
+    { true,  false, RG_GRAPHICS, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT, "sampled read" },
+    { false, false, RG_TRANSFER, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0, "transfer read" },
+    { false, true,  RG_TRANSFER, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0, "transfer write" },
+    { false, false, RG_COMPUTE,  VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0, "storage read" },
+    { false, true,  RG_COMPUTE,  VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0, "storage write" },
+    { false, false, RG_GRAPHICS, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0, "indirect read" },
+    { false, false, RG_GRAPHICS, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0, "index read" },
+  };
+
+  const VkAccessFlags WRITE_ACCESS = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+  const char* passTypeName(rgPassType type)
+  {
+    switch (type)
+    {
+      case RG_GRAPHICS: return "graphics";
+      case RG_COMPUTE:  return "compute";
+      default:          return "transfer";
+    }
+  }
+
+  const char* layoutName(VkImageLayout layout)
+  {
+    switch (layout)
+    {
+      case VK_IMAGE_LAYOUT_UNDEFINED:                        return "undefined";
+      case VK_IMAGE_LAYOUT_GENERAL:                          return "general";
+      case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:         return "colour attachment";
+      case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: return "depth attachment";
+      case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:         return "shader read only";
+      case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:             return "transfer source";
+      case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:             return "transfer destination";
+      case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:                  return "present";
+      default:                                               return "other";
+    }
+  }
+
+  // e.g. "colour output, early tests", "-" for none
+  template <typename T>
+  void writeFlags(std::ostream& os, uint32_t flags, const T& names)
+  {
+    const char* separator = "";
+    for (const auto& name : names)
+    {
+      if (0 == (flags & name.first)) continue;
+      os << separator << name.second;
+      separator = ", ";
+    }
+    if ('\0' == *separator) os << "-";
+  }
+
+  void writeStages(std::ostream& os, VkPipelineStageFlags stages)
+  {
+    static const std::pair<uint32_t, const char*> names[] =
+    {
+      { VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, "top" },
+      { VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, "draw indirect" },
+      { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, "vertex input" },
+      { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, "fragment shader" },
+      { VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, "early tests" },
+      { VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, "late tests" },
+      { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, "colour output" },
+      { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, "compute shader" },
+      { VK_PIPELINE_STAGE_TRANSFER_BIT, "transfer" },
+      { VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, "bottom" },
+    };
+    writeFlags(os, stages, names);
+  }
+
+  void writeAccess(std::ostream& os, VkAccessFlags access)
+  {
+    static const std::pair<uint32_t, const char*> names[] =
+    {
+      { VK_ACCESS_INDIRECT_COMMAND_READ_BIT, "indirect read" },
+      { VK_ACCESS_INDEX_READ_BIT, "index read" },
+      { VK_ACCESS_INPUT_ATTACHMENT_READ_BIT, "input read" },
+      { VK_ACCESS_SHADER_READ_BIT, "shader read" },
+      { VK_ACCESS_SHADER_WRITE_BIT, "shader write" },
+      { VK_ACCESS_COLOR_ATTACHMENT_READ_BIT, "colour read" },
+      { VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, "colour write" },
+      { VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT, "depth read" },
+      { VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, "depth write" },
+      { VK_ACCESS_TRANSFER_READ_BIT, "transfer read" },
+      { VK_ACCESS_TRANSFER_WRITE_BIT, "transfer write" },
+    };
+    writeFlags(os, access, names);
+  }
+
+  void writeSubpass(std::ostream& os, uint32_t subpass)
+  {
+    if (VK_SUBPASS_EXTERNAL == subpass) os << "external";
+    else os << subpass;
+  }
+}
+
+
+
+uint32_t renderGraph::addResource(const char* name, bool image, bool imported)
+{
+  resource r;
+  r.name = name;
+  r.image = image;
+  r.imported = imported;
+  m_resources.push_back(r);
+  return static_cast<uint32_t>(m_resources.size() - 1);
+}
+
+
+
+uint32_t renderGraph::addImage(const char* name, VkFormat format, bool clear)
+{
+  uint32_t ndx = addResource(name, true, false);
+  m_resources[ndx].format = format;
+  m_resources[ndx].clear = clear;
+  return ndx;
+}
+
+
+
+// an image from outside the graph, undefined at the start of the frame (e.g. just acquired) and left in finalLayout
+uint32_t renderGraph::importImage(const char* name, VkFormat format, VkImageLayout finalLayout, bool clear)
+{
+  uint32_t ndx = addResource(name, true, true);
+  m_resources[ndx].format = format;
+  m_resources[ndx].finalLayout = finalLayout;
+  m_resources[ndx].clear = clear;
+  return ndx;
+}
+
+
+
+uint32_t renderGraph::addBuffer(const char* name)
+{
+  return addResource(name, false, false);
+}
+
+
+
+uint32_t renderGraph::importBuffer(const char* name)
+{
+  return addResource(name, false, true);
+}
+
+
+
+uint32_t renderGraph::addPass(const char* name, rgPassType type, uint32_t viewMask)
+{
+  if (0 != viewMask && RG_GRAPHICS != type)
+  {
+    throw std::runtime_error(std::string("render graph: ") + name + " has views but is not a graphics pass");
+  }
+
+  pass p;
+  p.name = name;
+  p.type = type;
+  p.viewMask = viewMask;
+  m_passes.push_back(p);
+  return static_cast<uint32_t>(m_passes.size() - 1);
+}
+
+
+
+// a pass's uses are kept in the order given, which for a graphics pass is the order of its colour and input
+// attachment references (the shaders' locations and input_attachment_index)
+void renderGraph::use(uint32_t pass, uint32_t resource, rgUsage usage)
+{
+  if (pass >= m_passes.size() || resource >= m_resources.size())
+  {
+    throw std::runtime_error("render graph: no such pass or resource");
+  }
+
+  const usageInfo& info = usages[usage];
+  if (info.image != m_resources[resource].image || info.passType != m_passes[pass].type)
+  {
+    throw std::runtime_error("render graph: " + m_passes[pass].name + " can not use " + m_resources[resource].name +
+      " for " + info.name);
+  }
+  if (m_resources[resource].imported && !m_resources[resource].image && info.write)
+  {
+    throw std::runtime_error("render graph: " + m_passes[pass].name + " writes imported buffer " + m_resources[resource].name);
+  }
+
+  m_passes[pass].uses.push_back({ resource, usage });
+}
+
+
+
+/************************************************************************************************************************
+ * function  : compile
+ *
+ * abstract  : Works the graph out from the passes' uses:
+ *               (a) each resource's first and last pass, and the image usage flags its uses need
+ *               (b) checks an image is used once per pass, a graphics pass has an attachment and every image that is
+ *                   not imported is written before it is read
+ *               (c) groups the graphics passes into render passes (see groupPasses)
+ *               (d) gives the images that are not imported alias slots, and marks those used by a single render pass
+ *                   (and not sampled) transient
+ *               (e) describes each render pass (see describeRenderPass) and places the pipeline barriers for the
+ *                   buffers (see placeBarriers)
+ *             Can be called again after passes are added, everything is worked out afresh.
+ *
+ * parameters: none
+ *
+ * returns   : void, throws std::runtime_error if the graph is not one that can be rendered
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void renderGraph::compile()
+{
+  m_renderPasses.clear();
+  for (resource& r : m_resources)
+  {
+    r.firstPass = r.lastPass = npos;
+    r.imageUsage = 0;
+    r.transient = false;
+    r.aliasSlot = npos;
+  }
+
+  for (uint32_t p = 0; p < m_passes.size(); p++)
+  {
+    pass& thisPass = m_passes[p];
+    thisPass.renderPass = thisPass.subpass = npos;
+    thisPass.srcStage = thisPass.dstStage = 0;
+    thisPass.srcAccess = thisPass.dstAccess = 0;
+
+    bool attachments = false;
+    for (size_t u = 0; u < thisPass.uses.size(); u++)
+    {
+      uint32_t  ndx = thisPass.uses[u].first;
+      resource& r = m_resources[ndx];
+      const usageInfo& info = usages[thisPass.uses[u].second];
+
+      if (npos == r.firstPass)
+      {
+        r.firstPass = p;
+        if (r.image && !r.imported && !info.write)
+        {
+          throw std::runtime_error("render graph: " + thisPass.name + " reads " + r.name + " before anything writes it");
+        }
+      }
+      else if (r.image && p == r.lastPass)
+      {
+        throw std::runtime_error("render graph: " + thisPass.name + " uses " + r.name + " more than once");
+      }
+      r.lastPass = p;
+      r.imageUsage |= info.imageUsage;
+      attachments = attachments || (r.image && RG_SAMPLED_READ != thisPass.uses[u].second);
+    }
+
+    if (RG_GRAPHICS == thisPass.type && !attachments)
+    {
+      throw std::runtime_error("render graph: graphics pass " + thisPass.name + " has no attachments");
+    }
+  }
+
+  groupPasses();
+  assignAliasSlots();
+
+  for (resource& r : m_resources)
+  {
+    if (!r.image || r.imported || npos == r.firstPass || (r.imageUsage & VK_IMAGE_USAGE_SAMPLED_BIT)) continue;
+
+    r.transient = m_passes[r.firstPass].renderPass == m_passes[r.lastPass].renderPass;
+    if (r.transient) r.imageUsage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+  }
+
+  for (uint32_t rp = 0; rp < m_renderPasses.size(); rp++) describeRenderPass(rp);
+  placeBarriers();
+}
+
+
+
+/************************************************************************************************************************
+ * function  : groupPasses
+ *
+ * abstract  : Puts each graphics pass in a render pass.  A graphics pass that follows another becomes its next subpass
+ *             unless it samples an image written in the render pass so far (any pixel, so the writes must be done),
+ *             or reads a buffer written by it; barriers can not be recorded inside a render pass.  Anything else
+ *             between two graphics passes ends the render pass, as does a change of view mask.
+ *
+ * parameters: none
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void renderGraph::groupPasses()
+{
+  uint32_t current = npos;
+  for (uint32_t p = 0; p < m_passes.size(); p++)
+  {
+    pass& thisPass = m_passes[p];
+    if (RG_GRAPHICS != thisPass.type)
+    {
+      current = npos;
+      continue;
+    }
+
+    bool join = (npos != current) && m_renderPasses[current].viewMask == thisPass.viewMask;
+    for (size_t u = 0; u < thisPass.uses.size() && join; u++)
+    {
+      uint32_t ndx = thisPass.uses[u].first;
+      if (m_resources[ndx].image && RG_SAMPLED_READ != thisPass.uses[u].second) continue;
+
+      for (uint32_t earlier : m_renderPasses[current].passes)
+      {
+        for (const auto& use : m_passes[earlier].uses)
+        {
+          if (use.first == ndx && usages[use.second].write) join = false;
+        }
+      }
+    }
+
+    if (!join)
+    {
+      m_renderPasses.push_back(renderPassDesc());
+      current = static_cast<uint32_t>(m_renderPasses.size() - 1);
+      m_renderPasses[current].viewMask = thisPass.viewMask;
+    }
+
+    thisPass.renderPass = current;
+    thisPass.subpass = static_cast<uint32_t>(m_renderPasses[current].passes.size());
+    m_renderPasses[current].passes.push_back(p);
+  }
+}
+
+
+
+// first fit by first pass; an image can take a slot once the last image in it is done with
+void renderGraph::assignAliasSlots()
+{
+  std::vector<uint32_t> images;
+  for (uint32_t ndx = 0; ndx < m_resources.size(); ndx++)
+  {
+    if (m_resources[ndx].image && !m_resources[ndx].imported && npos != m_resources[ndx].firstPass) images.push_back(ndx);
+  }
+  std::stable_sort(images.begin(), images.end(),
+    [this](uint32_t a, uint32_t b) { return m_resources[a].firstPass < m_resources[b].firstPass; });
+
+  std::vector<uint32_t> slotEnds;                    // last pass of the image in each slot
+  for (uint32_t ndx : images)
+  {
+    resource& r = m_resources[ndx];
+    for (uint32_t slot = 0; slot < slotEnds.size() && npos == r.aliasSlot; slot++)
+    {
+      if (slotEnds[slot] < r.firstPass) r.aliasSlot = slot;
+    }
+    if (npos == r.aliasSlot)
+    {
+      r.aliasSlot = static_cast<uint32_t>(slotEnds.size());
+      slotEnds.push_back(0);
+    }
+    slotEnds[r.aliasSlot] = r.lastPass;
+  }
+
+  m_aliasSlots = static_cast<uint32_t>(slotEnds.size());
+}
+
+
+
+// adds to the dependency between two subpasses if there is one already, internal ones are by region (and by view, each
+// view only waiting on itself, in a multiview render pass)
+void renderGraph::addDependency(renderPassDesc& desc, uint32_t src, uint32_t dst, VkPipelineStageFlags srcStage,
+  VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+{
+  for (VkSubpassDependency& dependency : desc.dependencies)
+  {
+    if (dependency.srcSubpass != src || dependency.dstSubpass != dst) continue;
+
+    dependency.srcStageMask |= srcStage;
+    dependency.srcAccessMask |= srcAccess;
+    dependency.dstStageMask |= dstStage;
+    dependency.dstAccessMask |= dstAccess;
+    return;
+  }
+
+  VkSubpassDependency dependency = {};
+  dependency.srcSubpass = src;
+  dependency.dstSubpass = dst;
+  dependency.srcStageMask = srcStage;
+  dependency.srcAccessMask = srcAccess;
+  dependency.dstStageMask = dstStage;
+  dependency.dstAccessMask = dstAccess;
+  if (VK_SUBPASS_EXTERNAL != src && VK_SUBPASS_EXTERNAL != dst)
+  {
+    dependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT | ((0 != desc.viewMask) ? VK_DEPENDENCY_VIEW_LOCAL_BIT_KHR : 0);
+  }
+  desc.dependencies.push_back(dependency);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : describeRenderPass
+ *
+ * abstract  : Fills in a render pass's attachments, subpasses and dependencies.  For each image its passes use:
+ *               (a) load op; loaded if an earlier pass used it, else cleared (if asked for) or not cared about
+ *               (b) store op; stored if a later pass uses it or it is imported, else not
+ *               (c) initial layout; that of its last use before the render pass, undefined if there is none
+ *               (d) final layout; that of its next use after the render pass, else the imported image's final layout,
+ *                   else that of its last use in the render pass
+ *               (e) a dependency between subpasses for each write after write, read after write and write after
+ *                   read on it; just the two uses' stages and accesses, by region
+ *               (f) the first use of an image in the frame waits on what last used its memory: the image in the same
+ *                   alias slot before it (in the same render pass, a dependency between the subpasses), else the last
+ *                   image in the slot in the previous frame.  An imported image is handed over by a semaphore, which
+ *                   waits at the stage of its first use
+ *               (g) a use after the render pass waits on the image's last use in it, by an outgoing dependency (so
+ *                   the final layout transition is covered too).  Presenting is left to the semaphore
+ *             Images that are only sampled are not attachments, but (g) still applies to them.
+ *
+ * parameters: renderPass -- [in] index of the render pass
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void renderGraph::describeRenderPass(uint32_t renderPass)
+{
+  renderPassDesc& desc = m_renderPasses[renderPass];
+  uint32_t first = desc.passes.front();
+  uint32_t last = desc.passes.back();
+
+  desc.subpasses.assign(desc.passes.size(), subpassRefs());
+  desc.attachments.clear();
+  desc.descriptions.clear();
+  desc.dependencies.clear();
+
+  for (uint32_t ndx = 0; ndx < m_resources.size(); ndx++)
+  {
+    resource& r = m_resources[ndx];
+    if (!r.image || npos == r.firstPass || r.firstPass > last || r.lastPass < first) continue;
+
+    // this render pass's uses, as (subpass, usage), and the last use before and the next use after it
+    std::vector<std::pair<uint32_t, rgUsage>> inside;
+    const std::pair<uint32_t, rgUsage>* before = nullptr;
+    const std::pair<uint32_t, rgUsage>* after = nullptr;
+    for (uint32_t p = r.firstPass; p <= r.lastPass; p++)
+    {
+      for (const auto& use : m_passes[p].uses)
+      {
+        if (use.first != ndx) continue;
+        if (p < first) before = &use;
+        else if (p <= last) inside.push_back({ m_passes[p].subpass, use.second });
+        else if (nullptr == after) after = &use;
+      }
+    }
+    if (inside.empty()) continue;
+
+    bool attachment = false;
+    for (const auto& use : inside) attachment = attachment || RG_SAMPLED_READ != use.second;
+
+    if (attachment)
+    {
+      uint32_t a = static_cast<uint32_t>(desc.attachments.size());
+      desc.attachments.push_back(ndx);
+
+      const usageInfo& firstUse = usages[inside.front().second];
+      VkAttachmentDescription description = {};
+      description.format = r.format;
+      description.samples = VK_SAMPLE_COUNT_1_BIT;
+      if (nullptr != before) description.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+      else description.loadOp = (r.clear && firstUse.write) ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+      description.storeOp = (nullptr != after || r.imported) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+      description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+      description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+      description.initialLayout = (nullptr != before) ? usages[before->second].layout : VK_IMAGE_LAYOUT_UNDEFINED;
+      if (nullptr != after) description.finalLayout = usages[after->second].layout;
+      else if (r.imported) description.finalLayout = r.finalLayout;
+      else description.finalLayout = usages[inside.back().second].layout;
+      desc.descriptions.push_back(description);
+
+      for (const auto& use : inside)
+      {
+        VkAttachmentReference reference = { a, usages[use.second].layout };
+        subpassRefs& refs = desc.subpasses[use.first];
+        if (RG_COLOUR_WRITE == use.second) refs.colour.push_back(reference);
+        else if (RG_DEPTH_WRITE == use.second) refs.depth = reference;
+        else if (RG_INPUT_READ == use.second) refs.input.push_back(reference);
+      }
+    }
+
+    // (e) hazards between this render pass's subpasses
+    const std::pair<uint32_t, rgUsage>* lastWrite = nullptr;
+    std::vector<const std::pair<uint32_t, rgUsage>*> reads;
+    for (const auto& use : inside)
+    {
+      const usageInfo& info = usages[use.second];
+      if (info.write && !reads.empty())
+      {
+        for (const auto* read : reads)
+        {
+          addDependency(desc, read->first, use.first, usages[read->second].stage, 0, info.stage, info.access);
+        }
+      }
+      else if (nullptr != lastWrite)
+      {
+        const usageInfo& writer = usages[lastWrite->second];
+        addDependency(desc, lastWrite->first, use.first, writer.stage, writer.access & WRITE_ACCESS, info.stage, info.access);
+      }
+
+      if (info.write)
+      {
+        lastWrite = &use;
+        reads.clear();
+      }
+      else
+      {
+        reads.push_back(&use);
+      }
+    }
+
+    // (f) the first use of the image in the frame
+    const usageInfo& firstUse = usages[inside.front().second];
+    if (nullptr == before && r.imported)
+    {
+      addDependency(desc, VK_SUBPASS_EXTERNAL, inside.front().first, firstUse.stage, 0, firstUse.stage, firstUse.access);
+    }
+    else if (nullptr == before)
+    {
+      uint32_t previous = npos;                    // the last image in the slot done before this one starts
+      uint32_t latest = npos;                      // the last image in the slot, i.e. in the previous frame
+      for (uint32_t other = 0; other < m_resources.size(); other++)
+      {
+        const resource& o = m_resources[other];
+        if (!o.image || o.imported || o.aliasSlot != r.aliasSlot) continue;
+
+        if (o.lastPass < r.firstPass && (npos == previous || o.lastPass > m_resources[previous].lastPass)) previous = other;
+        if (npos == latest || o.lastPass > m_resources[latest].lastPass) latest = other;
+      }
+      bool wrapped = (npos == previous);
+      if (wrapped) previous = latest;
+
+      const resource&      p = m_resources[previous];
+      VkPipelineStageFlags stage = 0;
+      VkAccessFlags        access = 0;
+      uint32_t             subpass = m_passes[p.lastPass].subpass;
+      for (const auto& use : m_passes[p.lastPass].uses)
+      {
+        if (use.first != previous) continue;
+        stage |= usages[use.second].stage;
+        access |= usages[use.second].access & WRITE_ACCESS;
+      }
+
+      if (!wrapped && m_passes[p.lastPass].renderPass == renderPass)
+      {
+        addDependency(desc, subpass, inside.front().first, stage, access, firstUse.stage, firstUse.access);
+        for (size_t a = 0; a < desc.attachments.size(); a++)
+        {
+          if (desc.attachments[a] == ndx || desc.attachments[a] == previous) desc.descriptions[a].flags |= VK_ATTACHMENT_DESCRIPTION_MAY_ALIAS_BIT;
+        }
+      }
+      else
+      {
+        addDependency(desc, VK_SUBPASS_EXTERNAL, inside.front().first, stage, access, firstUse.stage, firstUse.access);
+      }
+    }
+
+    // (g) the next use, in a later render pass or pass
+    if (nullptr != after)
+    {
+      const usageInfo&     next = usages[after->second];
+      VkPipelineStageFlags stage = usages[inside.back().second].stage;
+      VkAccessFlags        access = 0;
+      if (nullptr != lastWrite)
+      {
+        stage |= usages[lastWrite->second].stage;
+        access = usages[lastWrite->second].access & WRITE_ACCESS;
+      }
+      addDependency(desc, inside.back().first, VK_SUBPASS_EXTERNAL, stage, access, next.stage, next.access);
+    }
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : placeBarriers
+ *
+ * abstract  : Works out the pipeline barrier recorded after each pass, for the buffers.  Going through each buffer's
+ *             uses in pass order, a use after a write waits on the write (the writer's barrier gets the write's stage
+ *             and access as source, the use's as destination) and a write after reads waits on the reads (execution
+ *             only).  A pass that reads and writes a buffer counts as one write.  Everything a pass's writes are
+ *             waited on for goes in one barrier.
+ *
+ * parameters: none
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void renderGraph::placeBarriers()
+{
+  for (uint32_t ndx = 0; ndx < m_resources.size(); ndx++)
+  {
+    const resource& r = m_resources[ndx];
+    if (r.image || npos == r.firstPass) continue;
+
+    uint32_t              writer = npos;
+    VkPipelineStageFlags  writerStage = 0;
+    VkAccessFlags         writerAccess = 0;
+    std::vector<std::pair<uint32_t, VkPipelineStageFlags>> readers;
+
+    for (uint32_t p = r.firstPass; p <= r.lastPass; p++)
+    {
+      VkPipelineStageFlags stage = 0;
+      VkAccessFlags        access = 0;
+      bool                 write = false;
+      for (const auto& use : m_passes[p].uses)
+      {
+        if (use.first != ndx) continue;
+        stage |= usages[use.second].stage;
+        access |= usages[use.second].access;
+        write = write || usages[use.second].write;
+      }
+      if (0 == stage) continue;
+
+      if (npos != writer)
+      {
+        m_passes[writer].srcStage |= writerStage;
+        m_passes[writer].srcAccess |= writerAccess;
+        m_passes[writer].dstStage |= stage;
+        m_passes[writer].dstAccess |= access;
+      }
+
+      if (write)
+      {
+        for (const auto& reader : readers)
+        {
+          m_passes[reader.first].srcStage |= reader.second;
+          m_passes[reader.first].dstStage |= stage;
+        }
+        readers.clear();
+
+        writer = p;
+        writerStage = stage;
+        writerAccess = access & WRITE_ACCESS;
+      }
+      else
+      {
+        readers.push_back({ p, stage });
+      }
+    }
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createRenderPass
+ *
+ * abstract  : Makes one of the graph's render passes as compile described it.
+ *
+ * parameters: device -- [in] logical device
+ *             renderPass -- [in] index of the render pass, less than getRenderPassCount
+ *
+ * returns   : VkRenderPass, throws std::runtime_error if it can not be created
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+VkRenderPass renderGraph::createRenderPass(VkDevice device, size_t renderPass) const
+{
+  const renderPassDesc& desc = m_renderPasses[renderPass];
+
+  std::vector<VkSubpassDescription> subpasses(desc.subpasses.size());
+  for (size_t s = 0; s < subpasses.size(); s++)
+  {
+    const subpassRefs& refs = desc.subpasses[s];
+    subpasses[s].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpasses[s].colorAttachmentCount = static_cast<uint32_t>(refs.colour.size());
+    subpasses[s].pColorAttachments = refs.colour.data();
+    subpasses[s].inputAttachmentCount = static_cast<uint32_t>(refs.input.size());
+    subpasses[s].pInputAttachments = refs.input.data();
+    subpasses[s].pDepthStencilAttachment = (VK_ATTACHMENT_UNUSED != refs.depth.attachment) ? &refs.depth : nullptr;
+  }
+
+  VkRenderPassCreateInfo renderPassCreateInfo = {};
+  renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+  renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(desc.descriptions.size());
+  renderPassCreateInfo.pAttachments = desc.descriptions.data();
+  renderPassCreateInfo.subpassCount = static_cast<uint32_t>(subpasses.size());
+  renderPassCreateInfo.pSubpasses = subpasses.data();
+  renderPassCreateInfo.dependencyCount = static_cast<uint32_t>(desc.dependencies.size());
+  renderPassCreateInfo.pDependencies = desc.dependencies.data();
+
+  // every subpass draws the same views; they are separate cameras, so no correlation is claimed between them
+  std::vector<uint32_t> viewMasks(subpasses.size(), desc.viewMask);
+  VkRenderPassMultiviewCreateInfoKHR multiviewCreateInfo = {};
+  multiviewCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO_KHR;
+  multiviewCreateInfo.subpassCount = static_cast<uint32_t>(viewMasks.size());
+  multiviewCreateInfo.pViewMasks = viewMasks.data();
+  if (0 != desc.viewMask) renderPassCreateInfo.pNext = &multiviewCreateInfo;
+
+  VkRenderPass result;
+  if (VK_SUCCESS != vkCreateRenderPass(device, &renderPassCreateInfo, nullptr, &result))
+  {
+    throw std::runtime_error("failed to create render pass");
+  }
+  return result;
+}
+
+
+
+// one global memory barrier for the pass's buffers; buffer barriers would buy nothing on the drivers we run on
+void renderGraph::recordBarriers(VkCommandBuffer commandBuffer, uint32_t pass) const
+{
+  const renderGraph::pass& p = m_passes[pass];
+  if (0 == p.srcStage) return;
+
+  VkMemoryBarrier barrier = {};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = p.srcAccess;
+  barrier.dstAccessMask = p.dstAccess;
+  vkCmdPipelineBarrier(commandBuffer, p.srcStage, p.dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : dump
+ *
+ * abstract  : Writes the compiled graph; a summary line, then each pass (or render pass, with its subpasses) in order
+ *             with what it uses, the attachments' ops, layouts and alias slots, the dependencies and the barriers.
+ *
+ * parameters: os -- [in] stream to write to
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void renderGraph::dump(std::ostream& os) const
+{
+  size_t barriers = 0;
+  size_t dependencies = 0;
+  size_t images = 0;
+  size_t transient = 0;
+  for (const pass& p : m_passes) barriers += (0 != p.srcStage);
+  for (const renderPassDesc& desc : m_renderPasses) dependencies += desc.dependencies.size();
+  for (const resource& r : m_resources)
+  {
+    images += (r.image && !r.imported && npos != r.firstPass);
+    transient += r.transient;
+  }
+
+  os << "[?] render graph: " << m_passes.size() << " passes, " << m_renderPasses.size() << " render passes, "
+     << dependencies << " subpass dependencies, " << barriers << " barriers; " << images << " images (" << transient
+     << " transient) in " << m_aliasSlots << " memory slots" << std::endl;
+
+  for (uint32_t p = 0; p < m_passes.size(); p++)
+  {
+    const pass& thisPass = m_passes[p];
+    if (npos != thisPass.renderPass && 0 == thisPass.subpass)
+    {
+      const renderPassDesc& desc = m_renderPasses[thisPass.renderPass];
+      os << "[?]   render pass " << thisPass.renderPass;
+      if (0 != desc.viewMask) os << ", view mask 0x" << std::hex << desc.viewMask << std::dec;
+      os << ":" << std::endl;
+      for (size_t a = 0; a < desc.attachments.size(); a++)
+      {
+        const resource&                r = m_resources[desc.attachments[a]];
+        const VkAttachmentDescription& d = desc.descriptions[a];
+        os << "[?]     attachment " << a << " " << r.name << ": "
+           << (VK_ATTACHMENT_LOAD_OP_LOAD == d.loadOp ? "load" : VK_ATTACHMENT_LOAD_OP_CLEAR == d.loadOp ? "clear" : "don't care")
+           << "/" << (VK_ATTACHMENT_STORE_OP_STORE == d.storeOp ? "store" : "don't care") << ", "
+           << layoutName(d.initialLayout) << " -> " << layoutName(d.finalLayout);
+        if (r.imported) os << ", imported";
+        else os << ", slot " << r.aliasSlot << (r.transient ? ", transient" : "");
+        if (d.flags & VK_ATTACHMENT_DESCRIPTION_MAY_ALIAS_BIT) os << ", may alias";
+        os << std::endl;
+      }
+    }
+
+    os << "[?]   ";
+    if (npos != thisPass.renderPass) os << "  subpass " << thisPass.subpass << " ";
+    os << thisPass.name << " (" << passTypeName(thisPass.type) << "):";
+    for (size_t u = 0; u < thisPass.uses.size(); u++)
+    {
+      os << (u ? ", " : " ") << m_resources[thisPass.uses[u].first].name << " " << usages[thisPass.uses[u].second].name;
+    }
+    os << std::endl;
+
+    if (npos != thisPass.renderPass && thisPass.subpass + 1 == m_renderPasses[thisPass.renderPass].passes.size())
+    {
+      for (const VkSubpassDependency& d : m_renderPasses[thisPass.renderPass].dependencies)
+      {
+        os << "[?]     dependency ";
+        writeSubpass(os, d.srcSubpass);
+        os << " -> ";
+        writeSubpass(os, d.dstSubpass);
+        if (d.dependencyFlags & VK_DEPENDENCY_VIEW_LOCAL_BIT_KHR) os << " (by region and view): ";
+        else os << (d.dependencyFlags & VK_DEPENDENCY_BY_REGION_BIT ? " (by region): " : ": ");
+        writeStages(os, d.srcStageMask);
+        os << " / ";
+        writeAccess(os, d.srcAccessMask);
+        os << " -> ";
+        writeStages(os, d.dstStageMask);
+        os << " / ";
+        writeAccess(os, d.dstAccessMask);
+        os << std::endl;
+      }
+    }
+
+    if (0 != thisPass.srcStage)
+    {
+      os << "[?]     barrier after " << thisPass.name << ": ";
+      writeStages(os, thisPass.srcStage);
+      os << " / ";
+      writeAccess(os, thisPass.srcAccess);
+      os << " -> ";
+      writeStages(os, thisPass.dstStage);
+      os << " / ";
+      writeAccess(os, thisPass.dstAccess);
+      os << std::endl;
+    }
+  }
+}
@@ -0,0 +1,151 @@
+#ifndef _renderGraph_h_
+#define _renderGraph_h_
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum rgPassType { RG_GRAPHICS, RG_COMPUTE, RG_TRANSFER };
+
+// how a pass uses a resource.  Images are attachments of graphics passes (or sampled by them), everything else is a
+// buffer
+enum rgUsage
+{
+  RG_COLOUR_WRITE,              // colour attachment
+  RG_DEPTH_WRITE,               // depth attachment, tested and written
+  RG_INPUT_READ,                // input attachment, only the pixel being shaded, so the writer can be an earlier subpass
+  RG_SAMPLED_READ,              // sampled by fragment shaders, any pixel, so the writer's render pass must have ended
+  RG_TRANSFER_READ,
+  RG_TRANSFER_WRITE,
+  RG_STORAGE_READ,              // by compute shaders
+  RG_STORAGE_WRITE,
+  RG_INDIRECT_READ,             // parameters of indirect draws
+  RG_INDEX_READ,
+  RG_USAGE_COUNT
+};
+
+// A frame described as passes that declare the resources they read and write, in the order they are recorded, from
+// which the graph works out what used to be written by hand in createRenderPass:
+//  - graphics passes that follow one another become subpasses of one render pass as long as they only read what the
+//    earlier ones wrote as input attachments (pixel local); sampling it, or a buffer written in between, ends the
+//    render pass
+//  - each attachment's load and store ops and layouts, from its uses before and after the render pass; contents no
+//    later pass reads are not stored, and contents no earlier pass wrote are not loaded (initial layout undefined)
+//  - a subpass dependency for each pair of subpasses that actually touch the same attachment, by region, with the
+//    stages and accesses of those uses only; external dependencies for the first use of an attachment in the frame and
+//    for a later render pass that reads it
+//  - one pipeline barrier after each transfer or compute pass whose writes are used later (buffers), covering just the
+//    stages that use them
+// Images that are not imported live only within the frame, from the first pass using them to the last.  Those whose
+// lifetimes do not overlap share an alias slot, i.e. the same memory, and those used by only one render pass can be
+// transient attachments (lazily allocated where the device has such memory).  Buffers are taken to be the frame's own
+// (one per swapchain image), hazards with the previous frame's use of them are the fence's business.
+//
+// A graphics pass with a view mask is drawn once for each view in it (VK_KHR_multiview) into layered attachments, and
+// only shares a render pass with passes that have the same mask.  The layers are the caller's to make.
+//
+// A graph is built once, with the swapchain; the frame records its passes in the order they were added and calls
+// recordBarriers after each.  compile() throws std::runtime_error for a graph it can not make sense of, e.g. an image
+// read before anything wrote it.
+class renderGraph
+{
+public:
+  static const uint32_t npos = 0xffffffff;
+
+  uint32_t addImage(const char* name, VkFormat format, bool clear);                // cleared by its first write if clear
+  uint32_t importImage(const char* name, VkFormat format, VkImageLayout finalLayout, bool clear);   // e.g. the swapchain
+  uint32_t addBuffer(const char* name);                                            // written within the frame
+  uint32_t importBuffer(const char* name);                                         // written before it, only read
+  uint32_t addPass(const char* name, rgPassType type, uint32_t viewMask = 0);         // viewMask, multiview (layers drawn)
+  void     use(uint32_t pass, uint32_t resource, rgUsage usage);                  // throws for a usage of the wrong kind
+
+  void     compile();
+
+  // render passes, and the attachments of each in framebuffer order (resource ids, in the order they were added)
+  size_t       getRenderPassCount() const { return m_renderPasses.size(); }
+  VkRenderPass createRenderPass(VkDevice device, size_t renderPass) const;       // throws std::runtime_error
+  const std::vector<uint32_t>& getAttachments(size_t renderPass) const { return m_renderPasses[renderPass].attachments; }
+  uint32_t     getRenderPass(uint32_t pass) const { return m_passes[pass].renderPass; }     // npos if not graphics
+  uint32_t     getSubpass(uint32_t pass) const { return m_passes[pass].subpass; }
+  uint32_t     getViewMask(size_t renderPass) const { return m_renderPasses[renderPass].viewMask; }
+
+  void     recordBarriers(VkCommandBuffer commandBuffer, uint32_t pass) const;    // after pass, or its render pass
+
+  // the images to make; usage from how they are used, and which share memory
+  VkImageUsageFlags getImageUsage(uint32_t resource) const { return m_resources[resource].imageUsage; }
+  bool     isTransient(uint32_t resource) const { return m_resources[resource].transient; }
+  uint32_t getAliasSlot(uint32_t resource) const { return m_resources[resource].aliasSlot; }    // npos if imported
+  uint32_t getAliasSlotCount() const { return m_aliasSlots; }
+
+  void     dump(std::ostream& os) const;            // passes, render passes with their attachments and dependencies, barriers
+
+private:
+  struct resource
+  {
+    std::string       name;
+    bool              image = false;
+    bool              imported = false;
+    bool              clear = false;
+    VkFormat          format = VK_FORMAT_UNDEFINED;
+    VkImageLayout     finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;    // imported images, after the frame
+    uint32_t          firstPass = npos;                           // the frame's uses
+    uint32_t          lastPass = npos;
+    VkImageUsageFlags imageUsage = 0;
+    bool              transient = false;
+    uint32_t          aliasSlot = npos;
+  };
+
+  struct pass
+  {
+    std::string                               name;
+    rgPassType                                type;
+    uint32_t                                  viewMask = 0;
+    std::vector<std::pair<uint32_t, rgUsage>> uses;
+    uint32_t                                  renderPass = npos;
+    uint32_t                                  subpass = npos;
+
+    // barrier recorded after the pass, none if srcStage is 0
+    VkPipelineStageFlags srcStage = 0;
+    VkPipelineStageFlags dstStage = 0;
+    VkAccessFlags        srcAccess = 0;
+    VkAccessFlags        dstAccess = 0;
+  };
+
+  // a render pass's description, kept so createRenderPass can point at it
+  struct subpassRefs
+  {
+    std::vector<VkAttachmentReference> colour;
+    std::vector<VkAttachmentReference> input;
+    VkAttachmentReference              depth = { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED };
+  };
+
+  struct renderPassDesc
+  {
+    std::vector<uint32_t>                passes;
+    std::vector<uint32_t>                attachments;
+    std::vector<VkAttachmentDescription> descriptions;
+    std::vector<subpassRefs>             subpasses;
+    std::vector<VkSubpassDependency>     dependencies;
+    uint32_t                             viewMask = 0;             // of every subpass, non-zero for multiview
+  };
+
+  std::vector<resource>       m_resources;
+  std::vector<pass>           m_passes;
+  std::vector<renderPassDesc> m_renderPasses;
+  uint32_t                    m_aliasSlots = 0;
+
+  uint32_t addResource(const char* name, bool image, bool imported);
+  void     groupPasses();
+  void     describeRenderPass(uint32_t renderPass);
+  void     placeBarriers();
+  void     assignAliasSlots();
+  void     addDependency(renderPassDesc& desc, uint32_t src, uint32_t dst, VkPipelineStageFlags srcStage,
+                         VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+};
+
+#endif
@@ -0,0 +1,460 @@
+#include "stressScene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+static const float sceneExtent = 8.0f;           // the scene fills a cube this size, centred on the origin
+static const int   textureSize = 64;
+
+
+/************************************************************************************************************************
+ * function  : ctor
+ *
+ * abstract  : Sets up a scaling run.  The grid is sized for the largest count up front so objects keep their place as
+ *             more are added.
+ *
+ * parameters: ctx -- [in] initialised context to fill
+ *             window -- [in] window the context renders to (normally hidden)
+ *             config -- [in] settings for the run
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+stressScene::stressScene(vkContext* ctx, GLFWwindow* window, const stressConfig& config) : m_ctx(ctx), m_window(window), m_config(config), m_rng(config.seed)
+{
+  std::sort(m_config.counts.begin(), m_config.counts.end());
+
+  int maxObjects = m_config.counts.empty() ? 1 : std::max(1, m_config.counts.back());
+  while (m_gridSide * m_gridSide * m_gridSide < maxObjects) m_gridSide++;
+  m_cellSize = sceneExtent / m_gridSide;
+
+  m_positions.reserve(maxObjects);
+  m_rotations.reserve(maxObjects);
+  m_scales.reserve(maxObjects);
+  m_spin.reserve(maxObjects);
+}
+
+stressScene::~stressScene()
+{
+
+}
+
+
+
+/************************************************************************************************************************
+ * function  : run
+ *
+ * abstract  : Runs the sweep; for each N adds objects up to N, renders warm up frames, then measures.  The sweep stops
+ *             early if creating objects fails (usually a device limit) or the window is closed.  Results are written to
+ *             the CSV file and summarised on stdout.
+ *
+ * parameters: void
+ *
+ * returns   : int, EXIT_SUCCESS if every count was measured, EXIT_FAILURE otherwise
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+int stressScene::run()
+{
+  int result = EXIT_SUCCESS;
+
+  try
+  {
+    if (m_config.modelFile.empty())
+    {
+      createTextures();
+    }
+    else
+    {
+      m_sourceModel = m_ctx->createMeshModel(m_config.modelFile);
+    }
+
+    for (int count : m_config.counts)
+    {
+      if (glfwWindowShouldClose(m_window)) break;
+
+      if (!addObjects(count))
+      {
+        result = EXIT_FAILURE;
+        break;
+      }
+
+      stressSample sample = measure(count);
+      checkLimits(sample);
+      m_samples.push_back(sample);
+
+      std::cout << "[?] N=" << count << ": frame " << sample.frameMs << " ms, record " << sample.recordMs << " ms, "
+                << sample.usage.meshes << " draws, " << sample.usage.deviceAllocations << " device allocations" << std::endl;
+    }
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cerr << "[-] stress run stopped after " << m_positions.size() << " objects: " << e.what() << std::endl;
+    result = EXIT_FAILURE;
+  }
+
+  writeCsv();
+  printSummary();
+
+  return result;
+}
+
+
+
+// M checkerboard textures, each a different colour.  If none can be made the objects get a null handle, i.e. the
+// context's default texture.
+void stressScene::createTextures()
+{
+  int available = static_cast<int>(m_ctx->getResourceUsage().textureCapacity - m_ctx->getResourceUsage().textures);
+  if (m_config.textures > available)
+  {
+    std::cerr << "[-] " << m_config.textures << " textures requested but the sampler descriptor pool only has room for "
+              << available << ", increase it with --texture-pool" << std::endl;
+    m_config.textures = available;
+  }
+
+  std::vector<uint8_t> pixels;
+  for (int t = 0; t < m_config.textures; t++)
+  {
+    makeTexture(t, textureSize, &pixels);
+
+    textureHandle texture = m_ctx->createTextureFromPixels(pixels.data(), textureSize, textureSize);
+    if (texture.isNull()) break;
+
+    m_textures.push_back(texture);
+  }
+
+  if (m_textures.empty()) m_textures.push_back(textureHandle());
+}
+
+
+
+/************************************************************************************************************************
+ * function  : addObjects
+ *
+ * abstract  : Adds objects until there are 'target' of them.  Object i is placed in cell i of the grid, or at a random
+ *             point in the scene cube, and given a random spin so every transform changes every frame.
+ *
+ * parameters: target -- [in] number of objects wanted
+ *
+ * returns   : bool, false if an object could not be created
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+bool stressScene::addObjects(int target)
+{
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::vector<vertex>   vertices;
+  std::vector<uint32_t> indices;
+
+  if (m_config.modelFile.empty()) makeSphere(m_config.triangles, &vertices, &indices);
+
+  while ((int)m_positions.size() < target)
+  {
+    int ndx = static_cast<int>(m_positions.size());
+    modelHandle model;
+
+    if (!m_config.modelFile.empty())
+    {
+      model = (0 == ndx) ? m_sourceModel : m_ctx->createModelInstance(m_sourceModel);
+    }
+    else
+    {
+      textureHandle texture = m_textures[ndx % m_textures.size()];
+      model = m_ctx->createProceduralModel(&vertices, &indices, texture);
+    }
+
+    if (model.isNull())
+    {
+      std::cerr << "[-] failed to create object " << ndx << std::endl;
+      return false;
+    }
+    m_models.push_back(model);
+
+    glm::vec3 pos;
+    if (m_config.randomLayout)
+    {
+      pos = (glm::vec3(unit(m_rng), unit(m_rng), unit(m_rng)) - glm::vec3(0.5f)) * sceneExtent;
+    }
+    else
+    {
+      int x = ndx % m_gridSide;
+      int y = (ndx / m_gridSide) % m_gridSide;
+      int z = ndx / (m_gridSide * m_gridSide);
+      pos = (glm::vec3((float)x, (float)y, (float)z) + glm::vec3(0.5f)) * m_cellSize - glm::vec3(sceneExtent * 0.5f);
+    }
+
+    // spheres have a radius of 0.5, the bundled models are drawn at 0.4 when they fill the view on their own
+    float scale = m_config.modelFile.empty() ? m_cellSize * 0.8f : 0.4f / m_gridSide;
+
+    m_positions.push_back(pos);
+    m_rotations.push_back(glm::angleAxis(glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f)));
+    m_scales.push_back(glm::vec3(scale));
+    m_spin.push_back(10.0f + 40.0f * unit(m_rng));
+  }
+
+  return true;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : measure
+ *
+ * abstract  : Renders the warm up frames, then times 'frames' frames.  Each frame spins every object and pushes all the
+ *             transforms through updateModels, the same as an application animating the whole scene would.
+ *
+ * parameters: objects -- [in] number of objects in the scene
+ *
+ * returns   : stressSample, the measurements
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+stressSample stressScene::measure(int objects)
+{
+  typedef std::chrono::steady_clock clock;
+
+  stressSample sample;
+  sample.objects = objects;
+
+  const glm::quat upright = glm::angleAxis(glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+  const glm::vec3 zAxis(0.0f, 0.0f, 1.0f);
+
+  double sumFrameMs = 0.0, sumRecordMs = 0.0;
+  int    total = m_config.warmupFrames + m_config.frames;
+
+  for (int frame = 0; frame < total && !glfwWindowShouldClose(m_window); frame++)
+  {
+    clock::time_point start = clock::now();
+
+    glfwPollEvents();
+
+    float now = (float)glfwGetTime();
+    for (int i = 0; i < objects; i++)
+    {
+      m_rotations[i] = upright * glm::angleAxis(glm::radians(now * m_spin[i]), zAxis);
+    }
+    m_ctx->updateModels(m_models.data(), objects, m_positions.data(), m_rotations.data(), m_scales.data());
+
+    m_ctx->draw();
+
+    double frameMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    if (frame >= m_config.warmupFrames)
+    {
+      sumFrameMs += frameMs;
+      sumRecordMs += m_ctx->getLastRecordTime();
+      sample.frameMaxMs = std::max(sample.frameMaxMs, frameMs);
+    }
+  }
+
+  if (m_config.frames > 0)
+  {
+    sample.frameMs = sumFrameMs / m_config.frames;
+    sample.recordMs = sumRecordMs / m_config.frames;
+  }
+  sample.hostMB = hostMemoryMB();
+  sample.usage = m_ctx->getResourceUsage();
+  sample.frame = m_ctx->getFrameStats().average(m_config.frames);       // at most FRAME_STATS_HISTORY of them
+
+  return sample;
+}
+
+
+
+// warn as the scene approaches the limits that will stop it scaling further
+void stressScene::checkLimits(const stressSample& sample)
+{
+  const resourceUsage& usage = sample.usage;
+
+  if (usage.models > usage.statsQueryLimit && (m_samples.empty() || m_samples.back().usage.models <= usage.statsQueryLimit))
+  {
+    std::cout << "[?] N=" << sample.objects << " is past MAX_OBJECTS (" << usage.statsQueryLimit
+              << "), pipeline statistics only cover the first " << usage.statsQueryLimit << " models" << std::endl;
+  }
+
+  if (usage.maxDeviceAllocations > 0 && usage.deviceAllocations * 5 > usage.maxDeviceAllocations * 4)
+  {
+    std::cout << "[-] N=" << sample.objects << " uses " << usage.deviceAllocations << " of the device's "
+              << usage.maxDeviceAllocations << " memory allocations, one allocation per buffer will not scale" << std::endl;
+  }
+
+  if (usage.textures >= usage.textureCapacity)
+  {
+    std::cout << "[?] sampler descriptor pool is full (" << usage.textures << " of " << usage.textureCapacity << ")" << std::endl;
+  }
+}
+
+
+
+void stressScene::writeCsv()
+{
+  std::ofstream csv(m_config.csvFile);
+  if (!csv)
+  {
+    std::cerr << "[-] unable to write " << m_config.csvFile << std::endl;
+    return;
+  }
+
+  csv << "objects,draws,triangles,frame_ms,frame_max_ms,record_ms,fps,textures,texture_capacity,"
+         "device_allocations,max_device_allocations,geometry_mb,texture_mb,host_mb,"
+         "pipeline_binds,descriptor_binds,vertex_binds,index_binds,push_bytes,upload_bytes,submits,fence_wait_ms" << std::endl;
+
+  for (const stressSample& s : m_samples)
+  {
+    csv << s.objects << "," << s.usage.meshes << "," << s.usage.triangles << ","
+        << s.frameMs << "," << s.frameMaxMs << "," << s.recordMs << "," << ((s.frameMs > 0.0) ? 1000.0 / s.frameMs : 0.0) << ","
+        << s.usage.textures << "," << s.usage.textureCapacity << ","
+        << s.usage.deviceAllocations << "," << s.usage.maxDeviceAllocations << ","
+        << s.usage.geometryBytes / (1024.0 * 1024.0) << "," << s.usage.textureBytes / (1024.0 * 1024.0) << "," << s.hostMB << ","
+        << s.frame.pipelineBinds << "," << s.frame.descriptorBinds << "," << s.frame.vertexBufferBinds << ","
+        << s.frame.indexBufferBinds << "," << s.frame.pushConstantBytes << "," << s.frame.uploadBytes << ","
+        << s.frame.queueSubmits << "," << s.frame.fenceWaitMs << std::endl;
+  }
+
+  std::cout << "[+] wrote " << m_samples.size() << " samples to " << m_config.csvFile << std::endl;
+}
+
+
+
+// table of the results with a bar for the frame time (#) and the part of it spent recording (=)
+void stressScene::printSummary()
+{
+  if (m_samples.empty()) return;
+
+  double maxFrameMs = 0.0;
+  for (const stressSample& s : m_samples) maxFrameMs = std::max(maxFrameMs, s.frameMs);
+
+  const int barWidth = 40;
+
+  std::cout << "       N    frame ms   record ms   allocs    host MB" << std::endl;
+  for (const stressSample& s : m_samples)
+  {
+    int frameBar = (maxFrameMs > 0.0) ? (int)std::lround(barWidth * s.frameMs / maxFrameMs) : 0;
+    int recordBar = (maxFrameMs > 0.0) ? std::min(frameBar, (int)std::lround(barWidth * s.recordMs / maxFrameMs)) : 0;
+
+    std::cout << std::setw(8) << s.objects << std::fixed << std::setprecision(3)
+              << std::setw(12) << s.frameMs << std::setw(12) << s.recordMs
+              << std::setw(9) << s.usage.deviceAllocations << std::setprecision(1) << std::setw(11) << s.hostMB << "  "
+              << std::string(recordBar, '=') << std::string(frameBar - recordBar, '#') << std::endl;
+  }
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : makeSphere
+ *
+ * abstract  : Builds a UV sphere of radius 0.5 with about 'triangles' triangles; s stacks by 2s slices gives 4s^2.
+ *
+ * parameters: triangles -- [in] approximate number of triangles wanted
+ *             vertices -- [out] vertex list
+ *             indices -- [out] index list (triangle list)
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void stressScene::makeSphere(int triangles, std::vector<vertex>* vertices, std::vector<uint32_t>* indices)
+{
+  const float pi = 3.14159265358979f;
+
+  int stacks = std::max(2, (int)std::lround(std::sqrt(triangles / 4.0)));
+  int slices = stacks * 2;
+
+  vertices->clear();
+  indices->clear();
+
+  for (int st = 0; st <= stacks; st++)
+  {
+    float phi = pi * st / stacks;
+    for (int sl = 0; sl <= slices; sl++)
+    {
+      float theta = 2.0f * pi * sl / slices;
+
+      vertex v;
+      v.pos = glm::vec3(std::sin(phi) * std::cos(theta), std::sin(phi) * std::sin(theta), std::cos(phi)) * 0.5f;
+      v.col = glm::vec3(1.0f, 1.0f, 1.0f);
+      v.tex = glm::vec2((float)sl / slices, (float)st / stacks);
+      vertices->push_back(v);
+    }
+  }
+
+  for (int st = 0; st < stacks; st++)
+  {
+    for (int sl = 0; sl < slices; sl++)
+    {
+      uint32_t a = st * (slices + 1) + sl;
+      uint32_t b = a + slices + 1;
+
+      indices->push_back(a);  indices->push_back(b);      indices->push_back(a + 1);
+      indices->push_back(b);  indices->push_back(b + 1);  indices->push_back(a + 1);
+    }
+  }
+}
+
+
+
+void stressScene::makeTexture(int ndx, int size, std::vector<uint8_t>* pixels)
+{
+  // a different, saturated colour for each texture, checkered with white
+  float   hue = std::fmod(ndx * 0.61803f, 1.0f) * 6.0f;
+  float   f = hue - std::floor(hue);
+  uint8_t r, g, b;
+  switch ((int)hue)
+  {
+    case 0:  r = 255; g = (uint8_t)(255 * f); b = 0; break;
+    case 1:  r = (uint8_t)(255 * (1 - f)); g = 255; b = 0; break;
+    case 2:  r = 0; g = 255; b = (uint8_t)(255 * f); break;
+    case 3:  r = 0; g = (uint8_t)(255 * (1 - f)); b = 255; break;
+    case 4:  r = (uint8_t)(255 * f); g = 0; b = 255; break;
+    default: r = 255; g = 0; b = (uint8_t)(255 * (1 - f)); break;
+  }
+
+  pixels->resize(size * size * 4);
+  for (int y = 0; y < size; y++)
+  {
+    for (int x = 0; x < size; x++)
+    {
+      bool     white = ((x / 8) + (y / 8)) & 1;
+      uint8_t* p = &(*pixels)[(y * size + x) * 4];
+
+      p[0] = white ? 255 : r;
+      p[1] = white ? 255 : g;
+      p[2] = white ? 255 : b;
+      p[3] = 255;
+    }
+  }
+}
+
+
+
+double stressScene::hostMemoryMB()
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0.0;
+
+  return counters.WorkingSetSize / (1024.0 * 1024.0);
+#else
+  std::ifstream statm("/proc/self/statm");
+  long          pages = 0, resident = 0;
+  if (!(statm >> pages >> resident)) return 0.0;
+
+  return resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+#endif
+}
@@ -0,0 +1,79 @@
+#ifndef _stressScene_h_
+#define _stressScene_h_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "vkContext.h"
+
+// settings for a scaling run, see stressScene::run
+struct stressConfig
+{
+  std::vector<int> counts;                 // object counts (N) to measure, in increasing order
+  std::string      modelFile;              // copies of this model, empty => procedural spheres
+  int              textures = 4;           // M, procedural textures shared round robin between the spheres
+  int              triangles = 1000;       // T, triangles per procedural sphere
+  bool             randomLayout = false;   // false => regular grid
+  unsigned         seed = 1;               // random layout is deterministic for a given seed
+  int              warmupFrames = 20;
+  int              frames = 200;           // frames measured at each N
+  std::string      csvFile = "stress.csv";
+};
+
+// what was measured at one object count
+struct stressSample
+{
+  int           objects = 0;
+  double        frameMs = 0.0;             // average wall time for a whole frame (poll, update, draw)
+  double        frameMaxMs = 0.0;
+  double        recordMs = 0.0;            // average CPU time in recordcommands
+  double        hostMB = 0.0;              // process resident memory
+  resourceUsage usage;
+  frameStats    frame;                     // the context's counters averaged over the last of the measured frames
+};
+
+// Synthetic scene generator for scaling tests.  Fills the scene with N copies of a model (sharing its buffers) or with
+// N procedural spheres (each with its own buffers), then renders a fixed number of frames at each N and records frame
+// time, command recording time, memory and resource usage.  Objects are only ever added, so the counts are measured
+// in increasing order in a single run.
+class stressScene
+{
+public:
+  stressScene(vkContext* ctx, GLFWwindow* window, const stressConfig& config);
+  ~stressScene();
+
+  int run();
+
+private:
+  vkContext*                  m_ctx;
+  GLFWwindow*                 m_window;
+  stressConfig                m_config;
+
+  std::vector<textureHandle>  m_textures;
+  modelHandle                 m_sourceModel;       // model being copied when not procedural
+  std::vector<modelHandle>    m_models;            // one per object, in the order of the arrays below
+  int                         m_gridSide = 1;      // objects per side of the (cubic) grid
+  float                       m_cellSize = 1.0f;
+  std::mt19937                m_rng;
+
+  std::vector<glm::vec3>      m_positions;
+  std::vector<glm::quat>      m_rotations;
+  std::vector<glm::vec3>      m_scales;
+  std::vector<float>          m_spin;              // degrees per second about z, per object
+
+  std::vector<stressSample>   m_samples;
+
+  void         createTextures();
+  bool         addObjects(int target);
+  stressSample measure(int objects);
+  void         checkLimits(const stressSample& sample);
+  void         writeCsv();
+  void         printSummary();
+
+  static void   makeSphere(int triangles, std::vector<vertex>* vertices, std::vector<uint32_t>* indices);
+  static void   makeTexture(int ndx, int size, std::vector<uint8_t>* pixels);
+  static double hostMemoryMB();
+};
+
+#endif
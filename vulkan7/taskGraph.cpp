@@ -0,0 +1,149 @@
+#include "taskGraph.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+
+
+taskGraph::taskGraph() : m_jobs(nullptr), m_elapsedMs(0.0), m_failed(false)
+{
+}
+
+
+
+/************************************************************************************************************************
+ * function  : add
+ *
+ * abstract  : Adds a task.  Its dependencies must already be in the graph, which is what keeps it acyclic.
+ *
+ * parameters: name -- [in] name used by report, not copied so it has to outlive the graph (a string literal)
+ *             fn -- [in] the work, may throw
+ *             dependencies -- [in] ids (as returned by add) of the tasks that must finish before this one starts
+ *
+ * returns   : size_t, id of the task.  Throws std::runtime_error if a dependency is not in the graph
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+size_t taskGraph::add(const char* name, taskFunc fn, std::initializer_list<size_t> dependencies)
+{
+  size_t ndx = m_tasks.size();
+
+  std::unique_ptr<task> t(new task);
+  t->name = name;
+  t->fn = std::move(fn);
+  for (size_t dependency : dependencies)
+  {
+    if (dependency >= ndx) throw std::runtime_error(std::string("task ") + name + " depends on a task not yet added");
+
+    m_tasks[dependency]->dependents.push_back(ndx);
+    t->dependencyCount++;
+  }
+
+  m_tasks.push_back(std::move(t));
+  return ndx;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : run
+ *
+ * abstract  : Runs every task, each as soon as its dependencies have finished, and returns when they all have.  A
+ *             graph can be run more than once.
+ *
+ * parameters: jobs -- [in] job system to run the tasks on, the calling thread takes part
+ *
+ * returns   : void, throws std::runtime_error with the message of the first task that failed
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void taskGraph::run(jobSystem& jobs)
+{
+  m_jobs = &jobs;
+  m_failed = false;
+  m_error.clear();
+  m_start = std::chrono::steady_clock::now();
+
+  for (std::unique_ptr<task>& t : m_tasks)
+  {
+    t->waiting.store(t->dependencyCount, std::memory_order_relaxed);
+    t->ran = false;
+  }
+
+  for (size_t ndx = 0; ndx < m_tasks.size(); ndx++)
+  {
+    if (0 == m_tasks[ndx]->dependencyCount) jobs.run([this, ndx]() { execute(ndx); }, &m_counter);
+  }
+  jobs.wait(&m_counter);
+
+  m_elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+
+  if (m_failed) throw std::runtime_error(m_error);
+}
+
+
+
+// runs one task (unless the graph has failed) then starts the dependents it was the last dependency of
+void taskGraph::execute(size_t ndx)
+{
+  task& t = *m_tasks[ndx];
+
+  if (!m_failed.load(std::memory_order_acquire))
+  {
+    t.startMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    try
+    {
+      t.fn();
+      t.ran = true;
+    }
+    catch (const std::exception& e)
+    {
+      std::lock_guard<std::mutex> guard(m_errorLock);
+      if (!m_failed.exchange(true)) m_error = std::string(t.name) + ": " + e.what();
+    }
+    t.endMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+  }
+
+  for (size_t dependent : t.dependents)
+  {
+    if (1 == m_tasks[dependent]->waiting.fetch_sub(1, std::memory_order_acq_rel))
+    {
+      m_jobs->run([this, dependent]() { execute(dependent); }, &m_counter);
+    }
+  }
+}
+
+
+
+double taskGraph::getWorkMs() const
+{
+  double work = 0.0;
+  for (const std::unique_ptr<task>& t : m_tasks)
+  {
+    if (t->ran) work += t->endMs - t->startMs;
+  }
+  return work;
+}
+
+
+
+// start and end of each task that ran, relative to the start of run
+void taskGraph::report(std::ostream& os) const
+{
+  std::vector<const task*> started;
+  for (const std::unique_ptr<task>& t : m_tasks)
+  {
+    if (t->ran) started.push_back(t.get());
+  }
+  std::sort(started.begin(), started.end(), [](const task* a, const task* b) { return a->startMs < b->startMs; });
+
+  std::ios::fmtflags flags = os.flags();
+  os << std::fixed << std::setprecision(2);
+  for (const task* t : started)
+  {
+    os << "[?]   " << std::left << std::setw(26) << t->name << std::right << std::setw(9) << t->startMs << " -> "
+       << std::setw(9) << t->endMs << " ms" << std::endl;
+  }
+  os.flags(flags);
+}
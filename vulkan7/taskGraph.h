@@ -0,0 +1,64 @@
+#ifndef _taskGraph_h_
+#define _taskGraph_h_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "jobSystem.h"
+
+// A small dependency graph of named tasks run on the job system, used to build the context (see vkContext::initContext)
+// with independent steps overlapping.  Tasks are added in an order where each one's dependencies come first, so the
+// graph can not have a cycle.  run() starts every task that depends on nothing, and a task finishing starts each of
+// its dependents whose last dependency it was; the calling thread helps until all are done.  A task that throws stops
+// the graph from starting anything else (tasks already running finish) and run() throws the first error once the
+// graph is idle.  Each task's start and end are kept for report().
+class taskGraph
+{
+public:
+  typedef std::function<void()> taskFunc;
+
+  taskGraph();
+
+  taskGraph(const taskGraph&) = delete;
+  taskGraph& operator=(const taskGraph&) = delete;
+
+  size_t add(const char* name, taskFunc fn, std::initializer_list<size_t> dependencies = {});
+  void   run(jobSystem& jobs);                        // throws std::runtime_error if a task failed
+
+  double getElapsedMs() const { return m_elapsedMs; }
+  double getWorkMs() const;                           // sum of the tasks' run times
+  void   report(std::ostream& os) const;              // a line per task, in the order they started
+
+private:
+  struct task
+  {
+    const char*         name;
+    taskFunc            fn;
+    std::vector<size_t> dependents;
+    size_t              dependencyCount = 0;
+    std::atomic<size_t> waiting{ 0 };                // dependencies not yet finished
+    double              startMs = 0.0;               // from the start of run
+    double              endMs = 0.0;
+    bool                ran = false;
+  };
+
+  std::vector<std::unique_ptr<task>>    m_tasks;
+  jobSystem*                            m_jobs;
+  jobCounter                            m_counter;
+  std::chrono::steady_clock::time_point m_start;
+  double                                m_elapsedMs;
+  std::atomic<bool>                     m_failed;
+  std::mutex                            m_errorLock;
+  std::string                           m_error;
+
+  void execute(size_t ndx);
+};
+
+#endif
@@ -0,0 +1,607 @@
+#include "transformStore.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <random>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TRANSFORM_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// gcc/clang only allow AVX2/FMA intrinsics in functions compiled for that target, MSVC allows them anywhere.  The
+// kernel is only called after checking the CPU supports it.
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define TARGET_AVX2
+#endif
+
+static const size_t       STREAM_ALIGN = 32;
+static const size_t       STREAM_PAD = 8;           // streams are padded to a whole number of AVX2 batches
+static const std::align_val_t blockAlign = static_cast<std::align_val_t>(STREAM_ALIGN);
+
+
+/************************************************************************************************************************
+ * function  : ctor
+ *
+ * abstract  : Constructs an empty store.  The kernel is chosen from the CPU's capabilities, see setPath to override.
+ *
+ * parameters: void
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+transformStore::transformStore() : m_block(nullptr), m_count(0), m_capacity(0), m_explicitCount(0), m_path(bestPath())
+{
+  for (auto& s : m_streams) s = nullptr;
+}
+
+transformStore::~transformStore()
+{
+  if (nullptr != m_block) ::operator delete(m_block, blockAlign);
+}
+
+
+
+size_t transformStore::add(const glm::vec3& pos, const glm::quat& rot, const glm::vec3& scale)
+{
+  if (m_count == m_capacity)
+  {
+    grow(std::max<size_t>(64, m_capacity * 2));
+  }
+
+  m_explicit.push_back(0);
+  m_explicitModel.push_back(glm::mat4(1.0f));
+  m_model.push_back(glm::mat4(1.0f));
+  m_mvp.push_back(glm::mat4(1.0f));
+
+  set(m_count, pos, rot, scale);
+
+  return m_count++;
+}
+
+
+
+void transformStore::set(size_t ndx, const glm::vec3& pos, const glm::quat& rot, const glm::vec3& scale)
+{
+  m_streams[PX][ndx] = pos.x;  m_streams[PY][ndx] = pos.y;  m_streams[PZ][ndx] = pos.z;
+  m_streams[QX][ndx] = rot.x;  m_streams[QY][ndx] = rot.y;  m_streams[QZ][ndx] = rot.z;  m_streams[QW][ndx] = rot.w;
+  m_streams[SX][ndx] = scale.x;  m_streams[SY][ndx] = scale.y;  m_streams[SZ][ndx] = scale.z;
+
+  if (ndx < m_explicit.size() && 0 != m_explicit[ndx])
+  {
+    m_explicit[ndx] = 0;
+    m_explicitCount--;
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setMany
+ *
+ * abstract  : Bulk update of 'count' consecutive objects, starting at 'first'.  Any of the arrays may be null, in
+ *             which case that component is left unchanged.  Rotations are expected to be unit quaternions.
+ *
+ * parameters: first -- [in] index of the first object to update
+ *             count -- [in] number of objects to update
+ *             pos -- [in] array of 'count' positions, or nullptr
+ *             rot -- [in] array of 'count' rotations, or nullptr
+ *             scale -- [in] array of 'count' scales, or nullptr
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void transformStore::setMany(size_t first, size_t count, const glm::vec3* pos, const glm::quat* rot, const glm::vec3* scale)
+{
+  if (first >= m_count) return;
+  count = std::min(count, m_count - first);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    size_t ndx = first + i;
+
+    if (nullptr != pos)
+    {
+      m_streams[PX][ndx] = pos[i].x;  m_streams[PY][ndx] = pos[i].y;  m_streams[PZ][ndx] = pos[i].z;
+    }
+    if (nullptr != rot)
+    {
+      m_streams[QX][ndx] = rot[i].x;  m_streams[QY][ndx] = rot[i].y;  m_streams[QZ][ndx] = rot[i].z;  m_streams[QW][ndx] = rot[i].w;
+    }
+    if (nullptr != scale)
+    {
+      m_streams[SX][ndx] = scale[i].x;  m_streams[SY][ndx] = scale[i].y;  m_streams[SZ][ndx] = scale[i].z;
+    }
+    if (0 != m_explicit[ndx])
+    {
+      m_explicit[ndx] = 0;
+      m_explicitCount--;
+    }
+  }
+}
+
+
+
+void transformStore::setMatrix(size_t ndx, const glm::mat4& model)
+{
+  if (ndx >= m_count) return;
+
+  if (0 == m_explicit[ndx])
+  {
+    m_explicit[ndx] = 1;
+    m_explicitCount++;
+  }
+  m_explicitModel[ndx] = model;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : remove
+ *
+ * abstract  : Removes an object by moving the last one into its place, so the streams stay packed.  The owner of the
+ *             objects has to move its own per-object data the same way (see handlePool::destroy).
+ *
+ * parameters: ndx -- [in] index of the object to remove
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void transformStore::remove(size_t ndx)
+{
+  if (ndx >= m_count) return;
+
+  size_t last = m_count - 1;
+  if (0 != m_explicit[ndx]) m_explicitCount--;
+
+  for (int s = 0; s < STREAM_COUNT; s++)
+  {
+    m_streams[s][ndx] = m_streams[s][last];
+    m_streams[s][last] = (QW == s || SX == s || SY == s || SZ == s) ? 1.0f : 0.0f;
+  }
+  m_explicit[ndx] = m_explicit[last];
+  m_explicitModel[ndx] = m_explicitModel[last];
+  m_model[ndx] = m_model[last];
+  m_mvp[ndx] = m_mvp[last];
+
+  m_explicit.pop_back();
+  m_explicitModel.pop_back();
+  m_model.pop_back();
+  m_mvp.pop_back();
+  m_count--;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : compose
+ *
+ * abstract  : Builds the model matrix (T * R * S) for every object and pre-multiplies it by the view-projection
+ *             matrix.  The bulk of the objects go through the widest kernel available, whatever is left over at the
+ *             end goes through the narrower ones.  Objects with an explicit matrix are fixed up afterwards.
+ *
+ * parameters: viewProj -- [in] projection * view
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void transformStore::compose(const glm::mat4& viewProj)
+{
+  const float* vp = &viewProj[0][0];
+  size_t       done = 0;
+
+  if (TRANSFORM_AVX2 == m_path)
+  {
+    size_t batch = m_count & ~static_cast<size_t>(7);
+    composeAVX2(vp, 0, batch);
+    done = batch;
+  }
+
+  if (TRANSFORM_AVX2 == m_path || TRANSFORM_SSE == m_path)
+  {
+    size_t batch = m_count & ~static_cast<size_t>(3);
+    composeSSE(vp, done, batch);
+    done = batch;
+  }
+
+  composeScalar(vp, done, m_count);
+
+  if (m_explicitCount > 0)
+  {
+    for (size_t ndx = 0; ndx < m_count; ndx++)
+    {
+      if (0 == m_explicit[ndx]) continue;
+
+      m_model[ndx] = m_explicitModel[ndx];
+      m_mvp[ndx] = viewProj * m_explicitModel[ndx];
+    }
+  }
+}
+
+
+
+void transformStore::setPath(transformPath path)
+{
+  transformPath best = bestPath();
+
+  m_path = (TRANSFORM_AUTO == path || path > best) ? best : path;
+}
+
+
+
+const char* transformStore::pathName(transformPath path)
+{
+  switch (path)
+  {
+    case TRANSFORM_AUTO:   return "auto";
+    case TRANSFORM_SCALAR: return "scalar";
+    case TRANSFORM_SSE:    return "SSE";
+    case TRANSFORM_AVX2:   return "AVX2";
+  }
+
+  return "unknown";
+}
+
+
+
+// reallocate the stream block, new (padding) slots are set to the identity transform
+void transformStore::grow(size_t capacity)
+{
+  capacity = (capacity + STREAM_PAD - 1) & ~(STREAM_PAD - 1);
+
+  float* block = static_cast<float*>(::operator new(capacity * STREAM_COUNT * sizeof(float), blockAlign));
+
+  for (int s = 0; s < STREAM_COUNT; s++)
+  {
+    float* stream = block + s * capacity;
+    float  fill = (QW == s || SX == s || SY == s || SZ == s) ? 1.0f : 0.0f;
+
+    if (m_count > 0) memcpy(stream, m_streams[s], m_count * sizeof(float));
+    std::fill(stream + m_count, stream + capacity, fill);
+
+    m_streams[s] = stream;
+  }
+
+  if (nullptr != m_block) ::operator delete(m_block, blockAlign);
+
+  m_block = block;
+  m_capacity = capacity;
+}
+
+
+
+transformPath transformStore::bestPath()
+{
+#ifdef TRANSFORM_X86
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] >= 7)
+  {
+    __cpuid(info, 1);
+    bool fma = 0 != (info[2] & (1 << 12));
+    bool osxsave = 0 != (info[2] & (1 << 27));
+    bool avx = 0 != (info[2] & (1 << 28));
+
+    __cpuidex(info, 7, 0);
+    bool avx2 = 0 != (info[1] & (1 << 5));
+
+    if (fma && osxsave && avx && avx2 && (6 == (_xgetbv(0) & 6))) return TRANSFORM_AVX2;
+  }
+  return TRANSFORM_SSE;
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return TRANSFORM_AVX2;
+  return TRANSFORM_SSE;
+#endif
+#else
+  return TRANSFORM_SCALAR;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// kernels.  For a unit quaternion (x,y,z,w) and scale s the model matrix columns are;
+//   c0 = s.x * (1 - 2(yy + zz), 2(xy + wz),     2(xz - wy),     0)
+//   c1 = s.y * (2(xy - wz),     1 - 2(xx + zz), 2(yz + wx),     0)
+//   c2 = s.z * (2(xz + wy),     2(yz - wx),     1 - 2(xx + yy), 0)
+//   c3 =       (p.x,            p.y,            p.z,            1)
+// and the last row of the model matrix being (0,0,0,1) means each MVP column only needs three multiply-adds per row.
+void transformStore::composeScalar(const float* vp, size_t first, size_t last)
+{
+  for (size_t i = first; i < last; i++)
+  {
+    float x = m_streams[QX][i], y = m_streams[QY][i], z = m_streams[QZ][i], w = m_streams[QW][i];
+    float sx = m_streams[SX][i], sy = m_streams[SY][i], sz = m_streams[SZ][i];
+
+    float xx = x * x, yy = y * y, zz = z * z;
+    float xy = x * y, xz = x * z, yz = y * z;
+    float wx = w * x, wy = w * y, wz = w * z;
+
+    float m[16] = {
+      (1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx,          2.0f * (xz - wy) * sx,          0.0f,
+      2.0f * (xy - wz) * sy,          (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy,          0.0f,
+      2.0f * (xz + wy) * sz,          2.0f * (yz - wx) * sz,          (1.0f - 2.0f * (xx + yy)) * sz, 0.0f,
+      m_streams[PX][i],               m_streams[PY][i],               m_streams[PZ][i],               1.0f };
+
+    float* model = &m_model[i][0][0];
+    float* mvp = &m_mvp[i][0][0];
+
+    memcpy(model, m, sizeof(m));
+    for (int c = 0; c < 4; c++)
+    {
+      for (int r = 0; r < 4; r++)
+      {
+        mvp[c * 4 + r] = vp[r] * m[c * 4] + vp[4 + r] * m[c * 4 + 1] + vp[8 + r] * m[c * 4 + 2] + vp[12 + r] * m[c * 4 + 3];
+      }
+    }
+  }
+}
+
+
+
+void transformStore::composeSSE(const float* vp, size_t first, size_t last)
+{
+#ifdef TRANSFORM_X86
+  __m128 v[16];
+  for (int e = 0; e < 16; e++) v[e] = _mm_set1_ps(vp[e]);
+
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 two = _mm_set1_ps(2.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (size_t i = first; i < last; i += 4)
+  {
+    __m128 x = _mm_load_ps(m_streams[QX] + i), y = _mm_load_ps(m_streams[QY] + i);
+    __m128 z = _mm_load_ps(m_streams[QZ] + i), w = _mm_load_ps(m_streams[QW] + i);
+    __m128 sx = _mm_load_ps(m_streams[SX] + i), sy = _mm_load_ps(m_streams[SY] + i), sz = _mm_load_ps(m_streams[SZ] + i);
+
+    __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+    __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+    __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+    // model matrix, m[c][r] for the first three rows
+    __m128 m[4][4];
+    m[0][0] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+    m[0][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+    m[0][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+    m[1][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+    m[1][1] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+    m[1][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+    m[2][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+    m[2][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+    m[2][2] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+    m[3][0] = _mm_load_ps(m_streams[PX] + i);
+    m[3][1] = _mm_load_ps(m_streams[PY] + i);
+    m[3][2] = _mm_load_ps(m_streams[PZ] + i);
+    m[0][3] = m[1][3] = m[2][3] = zero;
+    m[3][3] = one;
+
+    // mvp[c][r] = sum_k vp[k][r] * m[c][k]
+    __m128 p[4][4];
+    for (int c = 0; c < 4; c++)
+    {
+      for (int r = 0; r < 4; r++)
+      {
+        __m128 acc = _mm_add_ps(_mm_mul_ps(v[r], m[c][0]), _mm_mul_ps(v[4 + r], m[c][1]));
+        acc = _mm_add_ps(acc, _mm_mul_ps(v[8 + r], m[c][2]));
+        p[c][r] = (3 == c) ? _mm_add_ps(acc, v[12 + r]) : acc;
+      }
+    }
+
+    // SoA -> AoS, each 4x4 transpose turns one column of four objects into that column for each object
+    for (int c = 0; c < 4; c++)
+    {
+      _MM_TRANSPOSE4_PS(m[c][0], m[c][1], m[c][2], m[c][3]);
+      _MM_TRANSPOSE4_PS(p[c][0], p[c][1], p[c][2], p[c][3]);
+
+      for (int o = 0; o < 4; o++)
+      {
+        _mm_storeu_ps(&m_model[i + o][c][0], m[c][o]);
+        _mm_storeu_ps(&m_mvp[i + o][c][0], p[c][o]);
+      }
+    }
+  }
+#else
+  composeScalar(vp, first, last);
+#endif
+}
+
+
+
+#ifdef TRANSFORM_X86
+// 8x8 transpose, on return r[k] holds what was column k
+TARGET_AVX2 static inline void transpose8(__m256 r[8])
+{
+  __m256 t[8], u[8];
+
+  for (int k = 0; k < 8; k += 2)
+  {
+    t[k] = _mm256_unpacklo_ps(r[k], r[k + 1]);
+    t[k + 1] = _mm256_unpackhi_ps(r[k], r[k + 1]);
+  }
+  for (int k = 0; k < 8; k += 4)
+  {
+    u[k] = _mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(1, 0, 1, 0));
+    u[k + 1] = _mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(3, 2, 3, 2));
+    u[k + 2] = _mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(1, 0, 1, 0));
+    u[k + 3] = _mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  for (int k = 0; k < 4; k++)
+  {
+    r[k] = _mm256_permute2f128_ps(u[k], u[k + 4], 0x20);
+    r[k + 4] = _mm256_permute2f128_ps(u[k], u[k + 4], 0x31);
+  }
+}
+#endif
+
+
+
+TARGET_AVX2 void transformStore::composeAVX2(const float* vp, size_t first, size_t last)
+{
+#ifdef TRANSFORM_X86
+  __m256 v[16];
+  for (int e = 0; e < 16; e++) v[e] = _mm256_set1_ps(vp[e]);
+
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 two = _mm256_set1_ps(2.0f);
+  const __m256 zero = _mm256_setzero_ps();
+
+  for (size_t i = first; i < last; i += 8)
+  {
+    __m256 x = _mm256_load_ps(m_streams[QX] + i), y = _mm256_load_ps(m_streams[QY] + i);
+    __m256 z = _mm256_load_ps(m_streams[QZ] + i), w = _mm256_load_ps(m_streams[QW] + i);
+    __m256 sx = _mm256_load_ps(m_streams[SX] + i), sy = _mm256_load_ps(m_streams[SY] + i), sz = _mm256_load_ps(m_streams[SZ] + i);
+
+    __m256 x2 = _mm256_mul_ps(two, x), y2 = _mm256_mul_ps(two, y), z2 = _mm256_mul_ps(two, z);
+    __m256 xx = _mm256_mul_ps(x, x2), yy = _mm256_mul_ps(y, y2), zz = _mm256_mul_ps(z, z2);      // 2xx, 2yy, 2zz
+    __m256 xy = _mm256_mul_ps(x, y2), xz = _mm256_mul_ps(x, z2), yz = _mm256_mul_ps(y, z2);      // 2xy, 2xz, 2yz
+    __m256 wx = _mm256_mul_ps(w, x2), wy = _mm256_mul_ps(w, y2), wz = _mm256_mul_ps(w, z2);      // 2wx, 2wy, 2wz
+
+    // model matrix, e[c * 4 + r]
+    __m256 e[16];
+    e[0] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx);
+    e[1] = _mm256_mul_ps(_mm256_add_ps(xy, wz), sx);
+    e[2] = _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx);
+    e[4] = _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy);
+    e[5] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy);
+    e[6] = _mm256_mul_ps(_mm256_add_ps(yz, wx), sy);
+    e[8] = _mm256_mul_ps(_mm256_add_ps(xz, wy), sz);
+    e[9] = _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz);
+    e[10] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz);
+    e[12] = _mm256_load_ps(m_streams[PX] + i);
+    e[13] = _mm256_load_ps(m_streams[PY] + i);
+    e[14] = _mm256_load_ps(m_streams[PZ] + i);
+    e[3] = e[7] = e[11] = zero;
+    e[15] = one;
+
+    // mvp[c][r] = sum_k vp[k][r] * m[c][k]
+    __m256 p[16];
+    for (int c = 0; c < 4; c++)
+    {
+      for (int r = 0; r < 4; r++)
+      {
+        __m256 acc = (3 == c) ? v[12 + r] : _mm256_setzero_ps();
+        acc = _mm256_fmadd_ps(v[r], e[c * 4], acc);
+        acc = _mm256_fmadd_ps(v[4 + r], e[c * 4 + 1], acc);
+        p[c * 4 + r] = _mm256_fmadd_ps(v[8 + r], e[c * 4 + 2], acc);
+      }
+    }
+
+    // SoA -> AoS, each 8x8 transpose gives two columns (8 floats) of each of the eight objects
+    for (int half = 0; half < 16; half += 8)
+    {
+      transpose8(e + half);
+      transpose8(p + half);
+
+      for (int o = 0; o < 8; o++)
+      {
+        _mm256_storeu_ps(&m_model[i + o][0][0] + half, e[half + o]);
+        _mm256_storeu_ps(&m_mvp[i + o][0][0] + half, p[half + o]);
+      }
+    }
+  }
+#else
+  composeScalar(vp, first, last);
+#endif
+}
+
+
+
+/************************************************************************************************************************
+ * function  : benchmark
+ *
+ * abstract  : Times building model and MVP matrices for 1,000 to 100,000 objects.  The baseline is the glm scalar
+ *             path used by main (translate * mat4_cast * scale, then proj * view * model), compared against each of the
+ *             store's kernels.  The largest difference from the glm result is reported as a sanity check.
+ *
+ * parameters: os -- [in] stream to write the results to
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void transformStore::benchmark(std::ostream& os)
+{
+  typedef std::chrono::steady_clock clock;
+  const int repeats = 20;
+
+  std::mt19937                          rng(1234);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+  glm::mat4 viewProj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+                       glm::lookAt(glm::vec3(10.0f, 0.0f, 2.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+  os << "[?] transform benchmark, best kernel " << pathName(bestPath()) << std::endl;
+
+  for (size_t count = 1000; count <= 100000; count *= 10)
+  {
+    std::vector<glm::vec3> pos(count), scale(count);
+    std::vector<glm::quat> rot(count);
+    for (size_t i = 0; i < count; i++)
+    {
+      pos[i] = glm::vec3(dist(rng), dist(rng), dist(rng)) * 20.0f;
+      rot[i] = glm::normalize(glm::quat(dist(rng), dist(rng), dist(rng), dist(rng)));
+      scale[i] = glm::vec3(0.5f + dist(rng) * 0.25f);
+    }
+
+    // glm scalar baseline
+    std::vector<glm::mat4> models(count), mvps(count);
+    clock::time_point start = clock::now();
+    for (int rep = 0; rep < repeats; rep++)
+    {
+      for (size_t i = 0; i < count; i++)
+      {
+        models[i] = glm::translate(glm::mat4(1.0f), pos[i]) * glm::mat4_cast(rot[i]) * glm::scale(glm::mat4(1.0f), scale[i]);
+        mvps[i] = viewProj * models[i];
+      }
+    }
+    double glmNs = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (double)(repeats * count);
+    os << "    " << std::setw(6) << count << " objects, glm    : " << std::fixed << std::setprecision(2) << glmNs << " ns/object" << std::endl;
+
+    transformStore store;
+    for (size_t i = 0; i < count; i++) store.add(pos[i], rot[i], scale[i]);
+
+    for (transformPath path = TRANSFORM_SCALAR; path <= bestPath(); path = static_cast<transformPath>(path + 1))
+    {
+      store.setPath(path);
+
+      start = clock::now();
+      for (int rep = 0; rep < repeats; rep++) store.compose(viewProj);
+      double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (double)(repeats * count);
+
+      float maxError = 0.0f;
+      for (size_t i = 0; i < count; i++)
+      {
+        for (int c = 0; c < 4; c++)
+        {
+          for (int r = 0; r < 4; r++)
+          {
+            maxError = std::max(maxError, std::fabs(store.getMVP(i)[c][r] - mvps[i][c][r]));
+          }
+        }
+      }
+
+      os << "    " << std::setw(6) << count << " objects, " << std::setw(6) << std::left << pathName(path) << std::right << " : "
+         << ns << " ns/object, " << glmNs / ns << "x glm, max error " << std::scientific << maxError << std::fixed << std::endl;
+    }
+  }
+
+  os.unsetf(std::ios::floatfield);
+}
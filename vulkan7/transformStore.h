@@ -0,0 +1,74 @@
+#ifndef _transformStore_h_
+#define _transformStore_h_
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// which kernel compose() uses, AUTO picks the widest one the CPU supports
+enum transformPath { TRANSFORM_AUTO, TRANSFORM_SCALAR, TRANSFORM_SSE, TRANSFORM_AVX2 };
+
+// Structure-of-arrays store of object transforms (position, rotation quaternion, scale).  compose() builds every
+// object's model matrix from its TRS and pre-multiplies it by the view-projection matrix in a single pass, 4 (SSE) or
+// 8 (AVX2) objects at a time, so the vertex shader only has one matrix multiply left to do.  Objects can also be given
+// an explicit model matrix, those bypass the TRS kernel and are just pre-multiplied.
+class transformStore
+{
+public:
+  transformStore();
+  ~transformStore();
+
+  transformStore(const transformStore&) = delete;
+  transformStore& operator=(const transformStore&) = delete;
+
+  size_t add(const glm::vec3& pos = glm::vec3(0.0f), const glm::quat& rot = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+             const glm::vec3& scale = glm::vec3(1.0f));
+  void   set(size_t ndx, const glm::vec3& pos, const glm::quat& rot, const glm::vec3& scale);
+  void   setMany(size_t first, size_t count, const glm::vec3* pos, const glm::quat* rot, const glm::vec3* scale);
+  void   setMatrix(size_t ndx, const glm::mat4& model);
+  void   remove(size_t ndx);                          // the last object takes its place
+  size_t size() { return m_count; }
+
+  void   compose(const glm::mat4& viewProj);
+
+  const glm::mat4& getModel(size_t ndx) { return m_model[ndx]; }
+  const glm::mat4& getMVP(size_t ndx) { return m_mvp[ndx]; }
+
+  void          setPath(transformPath path);
+  transformPath getPath() { return m_path; }
+
+  static const char* pathName(transformPath path);
+  static void        benchmark(std::ostream& os);
+
+private:
+  // SoA input streams, each m_capacity floats long, 32 byte aligned and padded to a multiple of 8 objects
+  enum stream { PX, PY, PZ, QX, QY, QZ, QW, SX, SY, SZ, STREAM_COUNT };
+
+  float*   m_streams[STREAM_COUNT];
+  float*   m_block;                           // single allocation backing all the streams
+  size_t   m_count;
+  size_t   m_capacity;
+
+  std::vector<uint8_t>    m_explicit;         // non-zero => object uses m_explicitModel rather than its TRS
+  std::vector<glm::mat4>  m_explicitModel;
+  size_t                  m_explicitCount;
+
+  std::vector<glm::mat4>  m_model;            // outputs, one per object
+  std::vector<glm::mat4>  m_mvp;
+
+  transformPath m_path;
+
+  void grow(size_t capacity);
+
+  void composeScalar(const float* vp, size_t first, size_t last);
+  void composeSSE(const float* vp, size_t first, size_t last);
+  void composeAVX2(const float* vp, size_t first, size_t last);
+
+  static transformPath bestPath();
+};
+
+#endif
@@ -0,0 +1,804 @@
+#include "uploadBench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+typedef std::chrono::high_resolution_clock benchClock;
+
+static double elapsedMs(benchClock::time_point start, benchClock::time_point end)
+{
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static const VkDeviceSize streamBytes = 64 * 1024 * 1024;   // each throughput run moves at least this much
+static const int          maxUploads = 256;
+static const int          latencyUploads = 8;
+static const VkDeviceSize smallPayload = 64 * 1024;         // payload classes used for the recommended policy
+static const VkDeviceSize largePayload = 16 * 1024 * 1024;
+
+
+/************************************************************************************************************************
+ * function  : ctor
+ *
+ * abstract  : Stores the settings; the Vulkan objects are created per device by run().  The job system gets one worker
+ *             per transfer lane (the thread waiting on them helps as well).
+ *
+ * parameters: config -- [in] payload sizes, transfer lanes and where to write the results
+ *
+ * returns   : nothing
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+uploadBench::uploadBench(const uploadBenchConfig& config) : m_config(config), m_jobs(std::max(1, config.lanes))
+{
+  m_config.lanes = std::max(1, m_config.lanes);
+  std::sort(m_config.sizesKB.begin(), m_config.sizesKB.end());
+}
+
+uploadBench::~uploadBench()
+{
+  destroyDevice();
+  if (m_instance != VK_NULL_HANDLE) vkDestroyInstance(m_instance, nullptr);
+}
+
+
+
+const char* uploadBench::strategyName(uploadStrategy strategy)
+{
+  switch (strategy)
+  {
+    case UPLOAD_DIRECT:      return "direct";
+    case UPLOAD_STAGED_WAIT: return "staged+wait";
+    case UPLOAD_BATCHED:     return "batched";
+    case UPLOAD_RING:        return "staging ring";
+    case UPLOAD_TRANSFER:    return "transfer lanes";
+    default:                 return "unknown";
+  }
+}
+
+
+
+const char* uploadBench::deviceTypeName(VkPhysicalDeviceType type)
+{
+  switch (type)
+  {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   return "discrete";
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    return "virtual";
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:            return "cpu";
+    default:                                     return "other";
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : run
+ *
+ * abstract  : Creates an instance, then for every device present measures each strategy at each payload size.  A device
+ *             that fails part way is reported and skipped.  The results are written to the CSV file and printed as a
+ *             table, followed by the recommended policy for each device.
+ *
+ * parameters: os -- [in] stream the table is written to
+ *
+ * returns   : int, EXIT_SUCCESS if every device was measured, EXIT_FAILURE otherwise
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+int uploadBench::run(std::ostream& os)
+{
+  int result = EXIT_SUCCESS;
+
+  VkApplicationInfo appInfo = {};
+  appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+  appInfo.pApplicationName = "upload benchmark";
+  appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+  appInfo.pEngineName = "No Engine";
+  appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+  appInfo.apiVersion = VK_API_VERSION_1_0;
+
+  VkInstanceCreateInfo instanceInfo = {};
+  instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+  instanceInfo.pApplicationInfo = &appInfo;
+
+  if (vkCreateInstance(&instanceInfo, nullptr, &m_instance) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create a Vulkan instance" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  uint32_t deviceCnt = 0;
+  vkEnumeratePhysicalDevices(m_instance, &deviceCnt, nullptr);
+  std::vector<VkPhysicalDevice> deviceList(deviceCnt);
+  vkEnumeratePhysicalDevices(m_instance, &deviceCnt, deviceList.data());
+
+  for (VkPhysicalDevice physical : deviceList)
+  {
+    try
+    {
+      createDevice(physical);
+
+      for (int sizeKB : m_config.sizesKB)
+      {
+        if (sizeKB <= 0) continue;
+
+        VkDeviceSize payload = (VkDeviceSize)sizeKB * 1024;
+        m_source.resize((size_t)payload);
+        for (size_t ndx = 0; ndx < m_source.size(); ndx++) m_source[ndx] = (uint8_t)(ndx * 31);
+
+        for (int s = 0; s < UPLOAD_COUNT; s++)
+        {
+          uploadBenchSample sample = measure((uploadStrategy)s, payload);
+          m_samples.push_back(sample);
+
+          if (sample.skipped) continue;
+          std::cout << "[?] " << sizeKB << " KB " << strategyName(sample.strategy) << ": " << sample.mbPerSec << " MB/s, latency "
+                    << sample.latencyMs << " ms" << std::endl;
+        }
+      }
+    }
+    catch (const std::runtime_error& e)
+    {
+      std::cerr << "[-] upload benchmark on " << m_properties.deviceName << " stopped: " << e.what() << std::endl;
+      result = EXIT_FAILURE;
+    }
+
+    destroyDevice();
+  }
+
+  m_source.clear();
+  m_source.shrink_to_fit();
+
+  writeCsv();
+  printSummary(os);
+
+  return result;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createDevice
+ *
+ * abstract  : Creates a logical device on the given physical device with one graphics queue and, for the transfer lanes,
+ *             up to 'lanes' queues from a transfer-only family (one without graphics, preferably without compute too,
+ *             i.e. a DMA engine).  Without such a family the lanes use the graphics family.  Also creates the staging
+ *             ring and the lanes that share it.
+ *
+ * parameters: physical -- [in] device to benchmark
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void uploadBench::createDevice(VkPhysicalDevice physical)
+{
+  m_physical = physical;
+  vkGetPhysicalDeviceProperties(m_physical, &m_properties);
+
+  uint32_t familyCnt = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(m_physical, &familyCnt, nullptr);
+  std::vector<VkQueueFamilyProperties> families(familyCnt);
+  vkGetPhysicalDeviceQueueFamilyProperties(m_physical, &familyCnt, families.data());
+
+  int graphicsFamily = -1;
+  int transferFamily = -1;
+  for (uint32_t ndx = 0; ndx < familyCnt; ndx++)
+  {
+    VkQueueFlags flags = families[ndx].queueFlags;
+    if (families[ndx].queueCount == 0) continue;
+
+    if (graphicsFamily < 0 && (flags & VK_QUEUE_GRAPHICS_BIT)) graphicsFamily = ndx;
+
+    if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+    {
+      if (transferFamily < 0 || !(flags & VK_QUEUE_COMPUTE_BIT)) transferFamily = ndx;
+    }
+  }
+
+  if (graphicsFamily < 0)
+  {
+    std::cerr << "[-] " << m_properties.deviceName << " has no graphics queue" << std::endl;
+    throw std::runtime_error("No graphics queue family found");
+  }
+
+  m_graphicsFamily = (uint32_t)graphicsFamily;
+  m_hasTransferFamily = (transferFamily >= 0);
+  m_transferFamily = m_hasTransferFamily ? (uint32_t)transferFamily : m_graphicsFamily;
+
+  uint32_t transferQueues = std::min<uint32_t>((uint32_t)m_config.lanes, families[m_transferFamily].queueCount);
+
+  std::vector<float> priorities(std::max<uint32_t>(1, transferQueues), 1.0f);
+  std::vector<VkDeviceQueueCreateInfo> queueInfos;
+
+  VkDeviceQueueCreateInfo queueInfo = {};
+  queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+  queueInfo.queueFamilyIndex = m_graphicsFamily;
+  queueInfo.queueCount = m_hasTransferFamily ? 1 : transferQueues;       // lanes share the graphics family otherwise
+  queueInfo.pQueuePriorities = priorities.data();
+  queueInfos.push_back(queueInfo);
+
+  if (m_hasTransferFamily)
+  {
+    queueInfo.queueFamilyIndex = m_transferFamily;
+    queueInfo.queueCount = transferQueues;
+    queueInfos.push_back(queueInfo);
+  }
+
+  VkPhysicalDeviceFeatures features = {};
+
+  VkDeviceCreateInfo deviceInfo = {};
+  deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+  deviceInfo.queueCreateInfoCount = static_cast<uint32_t>(queueInfos.size());
+  deviceInfo.pQueueCreateInfos = queueInfos.data();
+  deviceInfo.pEnabledFeatures = &features;
+
+  if (vkCreateDevice(m_physical, &deviceInfo, nullptr, &m_device) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create a logical device on " << m_properties.deviceName << std::endl;
+    throw std::runtime_error("Failed to create a logical device!");
+  }
+
+  vkGetDeviceQueue(m_device, m_graphicsFamily, 0, &m_graphicsQueue);
+
+  m_transferQueues.resize(transferQueues);
+  m_transferLocks.clear();
+  for (uint32_t ndx = 0; ndx < transferQueues; ndx++)
+  {
+    vkGetDeviceQueue(m_device, m_transferFamily, ndx, &m_transferQueues[ndx]);
+    m_transferLocks.push_back(std::unique_ptr<std::mutex>(new std::mutex));
+  }
+
+  // without a transfer family, lane 0's queue is the graphics queue, so it must share the graphics lock
+  std::mutex* lock0 = m_hasTransferFamily ? m_transferLocks[0].get() : &m_graphicsLock;
+
+  VkCommandPoolCreateInfo poolInfo = {};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+  poolInfo.queueFamilyIndex = m_graphicsFamily;
+
+  if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_graphicsPool) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create a command pool" << std::endl;
+    throw std::runtime_error("Failed to create a command pool!");
+  }
+
+  // is the memory UPLOAD_DIRECT writes to also device local?  If not every read the GPU makes goes over the bus.
+  VkPhysicalDeviceMemoryProperties memoryProperties;
+  vkGetPhysicalDeviceMemoryProperties(m_physical, &memoryProperties);
+
+  uint32_t directType = findMemoryTypeIndex(m_physical, ~0u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+  m_directIsDeviceLocal = (memoryProperties.memoryTypes[directType].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0;
+
+  createBuffer(m_physical, m_device, RING_SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &m_ring, &m_ringMemory);
+
+  void* mapped;
+  if (vkMapMemory(m_device, m_ringMemory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to map the staging ring" << std::endl;
+    throw std::runtime_error("Failed to map buffer memory!");
+  }
+  m_ringMapped = (uint8_t*)mapped;
+
+  createLane(&m_ringLane, m_graphicsFamily, m_graphicsQueue, &m_graphicsLock, 0, RING_SIZE);
+
+  // the lanes split the ring; they never run at the same time as the graphics ring lane.  The ring and destination
+  // buffers are exclusive to a family, but every use starts with fresh host writes and the destination contents are
+  // never read, so no ownership transfers are recorded.
+  VkDeviceSize part = RING_SIZE / m_config.lanes;
+  m_transferLanes.resize(m_config.lanes);
+  for (int ndx = 0; ndx < m_config.lanes; ndx++)
+  {
+    uint32_t q = ndx % transferQueues;
+    createLane(&m_transferLanes[ndx], m_transferFamily, m_transferQueues[q], (q == 0) ? lock0 : m_transferLocks[q].get(), ndx * part, part);
+  }
+
+  std::cout << "[+] benchmarking uploads on " << m_properties.deviceName << " (" << deviceTypeName(m_properties.deviceType) << "), "
+            << transferQueues << (m_hasTransferFamily ? " transfer-only" : " graphics") << " queue(s) for " << m_config.lanes << " lanes" << std::endl;
+}
+
+
+
+void uploadBench::destroyDevice()
+{
+  if (m_device == VK_NULL_HANDLE) return;
+
+  vkDeviceWaitIdle(m_device);
+
+  for (uploadLane& lane : m_transferLanes) destroyLane(&lane);
+  m_transferLanes.clear();
+  destroyLane(&m_ringLane);
+
+  if (m_ring != VK_NULL_HANDLE)
+  {
+    vkUnmapMemory(m_device, m_ringMemory);
+    vkDestroyBuffer(m_device, m_ring, nullptr);
+    freeDeviceMemory(m_device, m_ringMemory);
+  }
+
+  if (m_graphicsPool != VK_NULL_HANDLE) vkDestroyCommandPool(m_device, m_graphicsPool, nullptr);
+
+  vkDestroyDevice(m_device, nullptr);
+
+  m_ring = VK_NULL_HANDLE;
+  m_ringMemory = VK_NULL_HANDLE;
+  m_ringMapped = nullptr;
+  m_graphicsPool = VK_NULL_HANDLE;
+  m_transferQueues.clear();
+  m_device = VK_NULL_HANDLE;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createLane
+ *
+ * abstract  : A lane is a queue, a command pool and two slots; each slot owns half of the lane's part of the staging
+ *             ring, a command buffer and a fence, so one half can be filled while the other is being copied.
+ *
+ * parameters: lane -- [out] lane to set up
+ *             family -- [in] queue family of 'queue'
+ *             queue -- [in] queue the lane submits to
+ *             lock -- [in] mutex guarding 'queue'
+ *             offset -- [in] start of the lane's part of the staging ring
+ *             size -- [in] size of the lane's part of the staging ring
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void uploadBench::createLane(uploadLane* lane, uint32_t family, VkQueue queue, std::mutex* lock, VkDeviceSize offset, VkDeviceSize size)
+{
+  lane->queue = queue;
+  lane->queueLock = lock;
+  lane->current = 0;
+
+  VkCommandPoolCreateInfo poolInfo = {};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+  poolInfo.queueFamilyIndex = family;
+
+  VkResult result = vkCreateCommandPool(m_device, &poolInfo, nullptr, &lane->commandPool);
+
+  VkCommandBuffer buffers[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+  VkCommandBufferAllocateInfo allocInfo = {};
+  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  allocInfo.commandPool = lane->commandPool;
+  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocInfo.commandBufferCount = 2;
+  if (result == VK_SUCCESS) result = vkAllocateCommandBuffers(m_device, &allocInfo, buffers);
+
+  VkFenceCreateInfo fenceInfo = {};
+  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+  for (int ndx = 0; ndx < 2; ndx++)
+  {
+    uploadSlot& slot = lane->slots[ndx];
+    slot.offset = offset + ndx * (size / 2);
+    slot.capacity = size / 2;
+    slot.used = 0;
+    slot.inFlight = false;
+    slot.commandBuffer = buffers[ndx];
+    if (result == VK_SUCCESS) result = vkCreateFence(m_device, &fenceInfo, nullptr, &slot.fence);
+  }
+
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create an upload lane" << std::endl;
+    throw std::runtime_error("Failed to create an upload lane!");
+  }
+}
+
+
+
+void uploadBench::destroyLane(uploadLane* lane)
+{
+  if (m_device == VK_NULL_HANDLE) return;
+
+  for (uploadSlot& slot : lane->slots)
+  {
+    if (slot.fence != VK_NULL_HANDLE) vkDestroyFence(m_device, slot.fence, nullptr);
+    slot.fence = VK_NULL_HANDLE;
+    slot.commandBuffer = VK_NULL_HANDLE;
+  }
+
+  if (lane->commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(m_device, lane->commandPool, nullptr);
+  lane->commandPool = VK_NULL_HANDLE;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : measure
+ *
+ * abstract  : Measures one strategy at one payload size.  The throughput is the bytes moved by a run of back to back
+ *             uploads over its wall time.  The latency is the average of a few single uploads each waited for; for
+ *             the batched strategy nothing is usable until the whole batch is, so its latency is the batch time.
+ *             If the destination buffer cannot be allocated the sample is marked as skipped.
+ *
+ * parameters: strategy -- [in] strategy to measure
+ *             payload -- [in] bytes per upload
+ *
+ * returns   : uploadBenchSample
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+uploadBenchSample uploadBench::measure(uploadStrategy strategy, VkDeviceSize payload)
+{
+  uploadBenchSample sample;
+  sample.device = m_properties.deviceName;
+  sample.deviceType = m_properties.deviceType;
+  sample.strategy = strategy;
+  sample.directDeviceLocal = m_directIsDeviceLocal;
+  sample.payload = payload;
+  sample.uploads = (int)std::min<VkDeviceSize>(maxUploads, std::max<VkDeviceSize>(1, streamBytes / payload));
+
+  VkBuffer       dst = VK_NULL_HANDLE;
+  VkDeviceMemory dstMemory = VK_NULL_HANDLE;
+
+  try
+  {
+    if (strategy == UPLOAD_DIRECT)
+    {
+      createBuffer(m_physical, m_device, payload * sample.uploads, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &dst, &dstMemory);
+    }
+    else
+    {
+      createBuffer(m_physical, m_device, payload * sample.uploads, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &dst, &dstMemory);
+    }
+
+    auto start = benchClock::now();
+    upload(strategy, dst, dstMemory, payload, sample.uploads);
+    double streamMs = elapsedMs(start, benchClock::now());
+
+    sample.mbPerSec = (streamMs > 0.0) ? (payload * sample.uploads / (1024.0 * 1024.0)) / (streamMs / 1000.0) : 0.0;
+
+    if (strategy == UPLOAD_BATCHED)
+    {
+      sample.latencyMs = streamMs;
+    }
+    else
+    {
+      int reps = std::min(sample.uploads, latencyUploads);
+      double latencyMs = 0.0;
+      for (int r = 0; r < reps; r++)
+      {
+        start = benchClock::now();
+        upload(strategy, dst, dstMemory, payload, 1);
+        latencyMs += elapsedMs(start, benchClock::now());
+      }
+      sample.latencyMs = latencyMs / reps;
+    }
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cerr << "[-] " << strategyName(strategy) << " at " << payload / 1024 << " KB skipped: " << e.what() << std::endl;
+    sample.skipped = true;
+  }
+
+  vkDeviceWaitIdle(m_device);
+  if (dst != VK_NULL_HANDLE) vkDestroyBuffer(m_device, dst, nullptr);
+  freeDeviceMemory(m_device, dstMemory);
+
+  return sample;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : upload
+ *
+ * abstract  : Copies 'uploads' payloads into consecutive regions of dst and returns once the GPU has them.
+ *                direct      -- map the region, memcpy, unmap (what triangle2 does when it creates a vertex buffer)
+ *                staged+wait -- new staging buffer, memcpy, copyBuffer (submit and vkQueueWaitIdle), destroy the
+ *                               staging buffer; exactly the createVertexBuffer path of triangle3 onward
+ *                batched     -- one staging buffer for everything, one command buffer with a region per upload, one
+ *                               submit and wait
+ *                ring        -- the persistent staging ring on the graphics queue, see streamLane
+ *                transfer    -- the uploads are cut into chunks dealt round robin to the lanes, each lane streams its
+ *                               chunks from a worker thread to its (transfer) queue
+ *
+ * parameters: strategy -- [in] how to upload
+ *             dst -- [in] destination buffer, at least payload * uploads bytes
+ *             dstMemory -- [in] memory bound to dst, only used by the direct strategy
+ *             payload -- [in] bytes per upload
+ *             uploads -- [in] number of uploads
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void uploadBench::upload(uploadStrategy strategy, VkBuffer dst, VkDeviceMemory dstMemory, VkDeviceSize payload, int uploads)
+{
+  switch (strategy)
+  {
+    case UPLOAD_DIRECT:
+      for (int r = 0; r < uploads; r++)
+      {
+        void* data;
+        vkMapMemory(m_device, dstMemory, r * payload, payload, 0, &data);
+        memcpy(data, m_source.data(), (size_t)payload);
+        vkUnmapMemory(m_device, dstMemory);
+      }
+      break;
+
+    case UPLOAD_STAGED_WAIT:
+      for (int r = 0; r < uploads; r++)
+      {
+        VkBuffer       staging;
+        VkDeviceMemory stagingMemory;
+        createBuffer(m_physical, m_device, payload, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging, &stagingMemory);
+
+        void* data;
+        vkMapMemory(m_device, stagingMemory, 0, payload, 0, &data);
+        memcpy(data, m_source.data(), (size_t)payload);
+        vkUnmapMemory(m_device, stagingMemory);
+
+        copyBuffer(m_device, m_graphicsQueue, m_graphicsPool, staging, dst, payload);
+
+        vkDestroyBuffer(m_device, staging, nullptr);
+        freeDeviceMemory(m_device, stagingMemory);
+      }
+      break;
+
+    case UPLOAD_BATCHED:
+    {
+      VkBuffer       staging;
+      VkDeviceMemory stagingMemory;
+      createBuffer(m_physical, m_device, payload * uploads, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging, &stagingMemory);
+
+      void* data;
+      vkMapMemory(m_device, stagingMemory, 0, VK_WHOLE_SIZE, 0, &data);
+
+      std::vector<VkBufferCopy> regions(uploads);
+      for (int r = 0; r < uploads; r++)
+      {
+        memcpy((uint8_t*)data + r * payload, m_source.data(), (size_t)payload);
+        regions[r] = { r * payload, r * payload, payload };
+      }
+      vkUnmapMemory(m_device, stagingMemory);
+
+      VkCommandBuffer commandBuffer = beginCommandBuffer(m_device, m_graphicsPool);
+      vkCmdCopyBuffer(commandBuffer, staging, dst, static_cast<uint32_t>(regions.size()), regions.data());
+      endAndSubmitCommandBuffer(m_device, m_graphicsPool, m_graphicsQueue, commandBuffer);
+
+      vkDestroyBuffer(m_device, staging, nullptr);
+      freeDeviceMemory(m_device, stagingMemory);
+      break;
+    }
+
+    default:
+    {
+      bool         ring = (strategy == UPLOAD_RING);
+      size_t       lanes = ring ? 1 : m_transferLanes.size();
+      VkDeviceSize chunkSize = ring ? m_ringLane.slots[0].capacity : m_transferLanes[0].slots[0].capacity;
+
+      std::vector<uploadChunk> chunks;
+      for (int r = 0; r < uploads; r++)
+      {
+        for (VkDeviceSize offset = 0; offset < payload; offset += chunkSize)
+        {
+          chunks.push_back({ offset, r * payload + offset, std::min(chunkSize, payload - offset) });
+        }
+      }
+
+      if (ring)
+      {
+        streamLane(&m_ringLane, dst, chunks, 0, 1);
+      }
+      else
+      {
+        jobCounter        counter;
+        std::atomic<bool> failed(false);
+        for (size_t lane = 0; lane < lanes; lane++)
+        {
+          m_jobs.run([this, lane, lanes, dst, &chunks, &failed]()
+          {
+            try { streamLane(&m_transferLanes[lane], dst, chunks, lane, lanes); }
+            catch (const std::runtime_error&) { failed = true; }
+          }, &counter);
+        }
+        m_jobs.wait(&counter);
+
+        if (failed) throw std::runtime_error("Transfer lane failed!");
+      }
+      break;
+    }
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : streamLane
+ *
+ * abstract  : Streams every step'th chunk, starting at 'first', through a lane.  Chunks are packed into the current
+ *             slot until the next one does not fit, then the slot is submitted and filling moves to the other slot
+ *             (waiting for its previous copy first).  Returns when both slots have completed.
+ *
+ * parameters: lane -- [in] lane to use
+ *             dst -- [in] destination buffer
+ *             chunks -- [in] every chunk of the upload
+ *             first -- [in] first chunk for this lane
+ *             step -- [in] number of lanes sharing the chunks
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void uploadBench::streamLane(uploadLane* lane, VkBuffer dst, const std::vector<uploadChunk>& chunks, size_t first, size_t step)
+{
+  VkCommandBufferBeginInfo beginInfo = {};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+  for (size_t ndx = first; ndx < chunks.size(); ndx += step)
+  {
+    const uploadChunk& chunk = chunks[ndx];
+    uploadSlot* slot = &lane->slots[lane->current];
+
+    if (slot->used + chunk.size > slot->capacity)
+    {
+      submitSlot(lane, slot);
+      lane->current ^= 1;
+      slot = &lane->slots[lane->current];
+    }
+
+    if (slot->used == 0)
+    {
+      waitSlot(slot);
+      vkBeginCommandBuffer(slot->commandBuffer, &beginInfo);
+    }
+
+    memcpy(m_ringMapped + slot->offset + slot->used, m_source.data() + chunk.srcOffset, (size_t)chunk.size);
+
+    VkBufferCopy region = { slot->offset + slot->used, chunk.dstOffset, chunk.size };
+    vkCmdCopyBuffer(slot->commandBuffer, m_ring, dst, 1, &region);
+
+    slot->used += chunk.size;
+  }
+
+  if (lane->slots[lane->current].used > 0) submitSlot(lane, &lane->slots[lane->current]);
+
+  waitSlot(&lane->slots[0]);
+  waitSlot(&lane->slots[1]);
+}
+
+
+
+void uploadBench::submitSlot(uploadLane* lane, uploadSlot* slot)
+{
+  vkEndCommandBuffer(slot->commandBuffer);
+
+  VkSubmitInfo submitInfo = {};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &slot->commandBuffer;
+
+  VkResult result;
+  {
+    std::lock_guard<std::mutex> guard(*lane->queueLock);
+    result = vkQueueSubmit(lane->queue, 1, &submitInfo, slot->fence);
+  }
+
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to submit an upload" << std::endl;
+    throw std::runtime_error("Failed to submit Command Buffer to Queue!");
+  }
+
+  slot->inFlight = true;
+  slot->used = 0;
+}
+
+
+
+void uploadBench::waitSlot(uploadSlot* slot)
+{
+  if (!slot->inFlight) return;
+
+  vkWaitForFences(m_device, 1, &slot->fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+  vkResetFences(m_device, 1, &slot->fence);
+  slot->inFlight = false;
+}
+
+
+
+void uploadBench::writeCsv()
+{
+  if (m_samples.empty()) return;
+
+  std::ofstream csv(m_config.csvFile);
+  if (!csv)
+  {
+    std::cerr << "[-] unable to write " << m_config.csvFile << std::endl;
+    return;
+  }
+
+  csv << "device,device_type,strategy,payload_bytes,uploads,mb_per_s,latency_ms,skipped" << std::endl;
+
+  for (const uploadBenchSample& s : m_samples)
+  {
+    csv << "\"" << s.device << "\"," << deviceTypeName(s.deviceType) << "," << strategyName(s.strategy) << "," << s.payload << ","
+        << s.uploads << "," << s.mbPerSec << "," << s.latencyMs << "," << (s.skipped ? 1 : 0) << std::endl;
+  }
+
+  std::cout << "[+] wrote " << m_samples.size() << " samples to " << m_config.csvFile << std::endl;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : printSummary
+ *
+ * abstract  : Prints the results for each device and picks its default upload policy: the strategy with the highest
+ *             average throughput for small (up to 64 KB) and for large (16 MB and up) payloads.  Direct writes are
+ *             only a candidate when HOST_VISIBLE memory is also DEVICE_LOCAL, otherwise the quick write is paid for
+ *             by the GPU reading across the bus on every use.
+ *
+ * parameters: os -- [in] stream to write to
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void uploadBench::printSummary(std::ostream& os)
+{
+  for (size_t first = 0; first < m_samples.size(); )
+  {
+    size_t last = first;
+    while (last < m_samples.size() && m_samples[last].device == m_samples[first].device) last++;
+
+    os << m_samples[first].device << " (" << deviceTypeName(m_samples[first].deviceType) << ")" << std::endl;
+    os << "   payload KB  strategy         uploads       MB/s   latency ms" << std::endl;
+
+    double small[UPLOAD_COUNT] = {}, large[UPLOAD_COUNT] = {};
+    int    smallCnt[UPLOAD_COUNT] = {}, largeCnt[UPLOAD_COUNT] = {};
+
+    for (size_t ndx = first; ndx < last; ndx++)
+    {
+      const uploadBenchSample& s = m_samples[ndx];
+
+      os << std::setw(13) << s.payload / 1024 << "  " << std::left << std::setw(15) << strategyName(s.strategy) << std::right;
+      if (s.skipped)
+      {
+        os << std::setw(9) << "-" << std::setw(11) << "skipped" << std::endl;
+        continue;
+      }
+      os << std::setw(9) << s.uploads << std::fixed << std::setprecision(1) << std::setw(11) << s.mbPerSec
+         << std::setprecision(3) << std::setw(13) << s.latencyMs << std::endl;
+      os.unsetf(std::ios::floatfield);
+
+      if (s.payload <= smallPayload) { small[s.strategy] += s.mbPerSec; smallCnt[s.strategy]++; }
+      if (s.payload >= largePayload) { large[s.strategy] += s.mbPerSec; largeCnt[s.strategy]++; }
+    }
+
+    bool directOk = m_samples[first].directDeviceLocal;
+
+    int bestSmall = -1, bestLarge = -1;
+    for (int s = 0; s < UPLOAD_COUNT; s++)
+    {
+      if (s == UPLOAD_DIRECT && !directOk) continue;
+      if (smallCnt[s] > 0 && (bestSmall < 0 || small[s] / smallCnt[s] > small[bestSmall] / smallCnt[bestSmall])) bestSmall = s;
+      if (largeCnt[s] > 0 && (bestLarge < 0 || large[s] / largeCnt[s] > large[bestLarge] / largeCnt[bestLarge])) bestLarge = s;
+    }
+
+    os << "[+] default upload policy for " << deviceTypeName(m_samples[first].deviceType) << " devices: up to 64 KB -> "
+       << ((bestSmall < 0) ? "not measured" : strategyName((uploadStrategy)bestSmall)) << ", 16 MB and up -> "
+       << ((bestLarge < 0) ? "not measured" : strategyName((uploadStrategy)bestLarge)) << std::endl << std::endl;
+
+    first = last;
+  }
+}
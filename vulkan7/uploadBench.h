@@ -0,0 +1,135 @@
+#ifndef _uploadBench_h_
+#define _uploadBench_h_
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "utilities.h"
+#include "jobSystem.h"
+
+// the ways of getting data into a buffer the GPU reads that are compared
+enum uploadStrategy
+{
+  UPLOAD_DIRECT,              // map/memcpy/unmap straight into HOST_VISIBLE memory (triangle2)
+  UPLOAD_STAGED_WAIT,         // new staging buffer and copyBuffer (vkQueueWaitIdle) per upload (triangle3 onward)
+  UPLOAD_BATCHED,             // one staging buffer, every copy in one command buffer, one wait
+  UPLOAD_RING,                // persistent mapped staging ring, double buffered, on the graphics queue
+  UPLOAD_TRANSFER,            // the ring split between lanes submitting to transfer-only queues from worker threads
+  UPLOAD_COUNT
+};
+
+// settings for a benchmark run, see uploadBench::run
+struct uploadBenchConfig
+{
+  std::vector<int> sizesKB = { 4, 64, 1024, 16384, 262144 };   // payload sizes, 4 KB to 256 MB
+  int              lanes = 4;                                  // threads (and queues, if there are enough) for UPLOAD_TRANSFER
+  std::string      csvFile = "upload.csv";
+};
+
+// what was measured for one strategy at one payload size on one device
+struct uploadBenchSample
+{
+  std::string     device;
+  VkPhysicalDeviceType deviceType = VK_PHYSICAL_DEVICE_TYPE_OTHER;
+  uploadStrategy  strategy = UPLOAD_DIRECT;
+  VkDeviceSize    payload = 0;             // bytes per upload
+  int             uploads = 0;             // uploads streamed back to back for the throughput figure
+  double          mbPerSec = 0.0;          // throughput while streaming
+  double          latencyMs = 0.0;         // average time from starting an upload until the GPU can use it
+  bool            directDeviceLocal = false;  // the memory direct writes go to is DEVICE_LOCAL as well (UMA, resizable BAR)
+  bool            skipped = false;         // not enough memory for the payload
+};
+
+// Headless benchmark of the upload paths.  Runs on every Vulkan device present so that a default policy can be picked
+// for each device type.  For each payload size a number of uploads (enough to move at least 64 MB, at most 256) is
+// streamed into a DEVICE_LOCAL buffer (HOST_VISIBLE for UPLOAD_DIRECT) to get the throughput, then a few single
+// uploads are waited on one at a time to get the latency.
+class uploadBench
+{
+public:
+  uploadBench(const uploadBenchConfig& config);
+  ~uploadBench();
+
+  int run(std::ostream& os);
+
+  static const char* strategyName(uploadStrategy strategy);
+
+private:
+  // one half of a lane's part of the staging ring, filled then submitted while the other half is being filled
+  struct uploadSlot
+  {
+    VkDeviceSize     offset = 0;           // into the staging ring
+    VkDeviceSize     capacity = 0;
+    VkDeviceSize     used = 0;
+    VkCommandBuffer  commandBuffer = VK_NULL_HANDLE;
+    VkFence          fence = VK_NULL_HANDLE;
+    bool             inFlight = false;
+  };
+
+  struct uploadLane
+  {
+    VkQueue          queue = VK_NULL_HANDLE;
+    std::mutex*      queueLock = nullptr;  // lanes can share a queue, vkQueueSubmit needs external synchronisation
+    VkCommandPool    commandPool = VK_NULL_HANDLE;
+    uploadSlot       slots[2];
+    int              current = 0;
+  };
+
+  // a piece of an upload that fits in a slot
+  struct uploadChunk
+  {
+    VkDeviceSize     srcOffset;            // into the source payload
+    VkDeviceSize     dstOffset;            // into the destination buffer
+    VkDeviceSize     size;
+  };
+
+  uploadBenchConfig              m_config;
+  std::vector<uploadBenchSample> m_samples;
+  jobSystem                      m_jobs;                      // runs the transfer lanes
+
+  VkInstance                     m_instance = VK_NULL_HANDLE;
+  VkPhysicalDevice               m_physical = VK_NULL_HANDLE;
+  VkPhysicalDeviceProperties     m_properties = {};
+  VkDevice                       m_device = VK_NULL_HANDLE;
+
+  uint32_t                       m_graphicsFamily = 0;
+  VkQueue                        m_graphicsQueue = VK_NULL_HANDLE;
+  VkCommandPool                  m_graphicsPool = VK_NULL_HANDLE;
+  bool                           m_hasTransferFamily = false;
+  uint32_t                       m_transferFamily = 0;
+  std::vector<VkQueue>           m_transferQueues;
+  std::vector<std::unique_ptr<std::mutex>> m_transferLocks;
+  std::mutex                     m_graphicsLock;
+  bool                           m_directIsDeviceLocal = false;   // HOST_VISIBLE memory is also DEVICE_LOCAL (UMA, resizable BAR)
+
+  VkBuffer                       m_ring = VK_NULL_HANDLE;     // persistent staging ring, shared by the ring lanes
+  VkDeviceMemory                 m_ringMemory = VK_NULL_HANDLE;
+  uint8_t*                       m_ringMapped = nullptr;
+  uploadLane                     m_ringLane;
+  std::vector<uploadLane>        m_transferLanes;
+
+  std::vector<uint8_t>           m_source;                    // the payload every upload copies
+
+  static const VkDeviceSize RING_SIZE = 32 * 1024 * 1024;
+
+  void createDevice(VkPhysicalDevice physical);
+  void destroyDevice();
+  void createLane(uploadLane* lane, uint32_t family, VkQueue queue, std::mutex* lock, VkDeviceSize offset, VkDeviceSize size);
+  void destroyLane(uploadLane* lane);
+
+  uploadBenchSample measure(uploadStrategy strategy, VkDeviceSize payload);
+  void              upload(uploadStrategy strategy, VkBuffer dst, VkDeviceMemory dstMemory, VkDeviceSize payload, int uploads);
+  void              streamLane(uploadLane* lane, VkBuffer dst, const std::vector<uploadChunk>& chunks, size_t first, size_t step);
+  void              submitSlot(uploadLane* lane, uploadSlot* slot);
+  void              waitSlot(uploadSlot* slot);
+
+  void writeCsv();
+  void printSummary(std::ostream& os);
+
+  static const char* deviceTypeName(VkPhysicalDeviceType type);
+};
+
+#endif
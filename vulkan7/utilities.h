@@ -10,9 +10,43 @@
 #include <glm/glm.hpp>
 
 #include <cstring>
+#include <atomic>
+
+#include "gpuMemoryTracker.h"
 
 const int MAX_FRAME_DRAWS = 2;
 const int MAX_OBJECTS = 20;
+const uint32_t MAX_VIEWS = 4;                           // views drawn at once with multiview, see vkContext::setViews
+const size_t FRAME_ARENA_SIZE = 64 * 1024;              // initial size of each per-frame transient arena, in bytes
+
+// pipeline statistics queries -- one query per model plus one for the post-process pass, per swapchain image
+const uint32_t STATS_QUERIES_PER_IMAGE = MAX_OBJECTS + 1;
+const uint32_t STATS_VALUES_PER_QUERY = 5;
+
+// live vkAllocateMemory allocations.  Drivers cap this (maxMemoryAllocationCount, often only 4096), so anything that
+// allocates or frees device memory must go through createBuffer/allocateDeviceMemory and freeDeviceMemory.
+inline std::atomic<uint32_t> g_deviceAllocationCount(0);
+
+// bytes copied to the device and queue submits made by the helpers below, from any thread (loaders and streams upload
+// from the job system's workers).  vkContext::draw takes and clears them once a frame, see frameStats
+inline std::atomic<uint64_t> g_uploadBytes(0);
+inline std::atomic<uint32_t> g_queueSubmits(0);
+
+// what the scene is using against the limits that bound it, see vkContext::getResourceUsage
+struct resourceUsage
+{
+  size_t   models = 0;
+  size_t   meshes = 0;                   // draw calls per frame
+  size_t   triangles = 0;                // per frame
+  size_t   meshlets = 0;                 // culled individually, see vkContext::setMeshlets
+  size_t   textures = 0;
+  size_t   textureCapacity = 0;          // size of the sampler descriptor pool
+  size_t   statsQueryLimit = 0;          // models that get pipeline statistics
+  uint32_t deviceAllocations = 0;
+  uint32_t maxDeviceAllocations = 0;
+  uint64_t geometryBytes = 0;            // unique vertex + index data
+  uint64_t textureBytes = 0;
+};
 
 // SwapChain is an extension, need to see if it is supported.
 const std::vector<const char*> deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
@@ -48,6 +82,63 @@ struct swapChainImage
   VkImageView imageView;
 };
 
+// presentation policy, maps onto a swapchain present mode (falls back to FIFO if the requested mode is unsupported)
+enum presentPolicy
+{
+  PRESENT_LOW_LATENCY,      // VK_PRESENT_MODE_IMMEDIATE_KHR -- no vsync, may tear
+  PRESENT_VSYNC,            // VK_PRESENT_MODE_FIFO_KHR -- always available
+  PRESENT_VSYNC_RELAXED,    // VK_PRESENT_MODE_FIFO_RELAXED_KHR -- vsync, but late frames tear rather than wait
+  PRESENT_MAILBOX           // VK_PRESENT_MODE_MAILBOX_KHR -- no tearing, newest frame replaces queued one
+};
+
+static const char* presentModeName(VkPresentModeKHR mode)
+{
+  switch (mode)
+  {
+    case VK_PRESENT_MODE_IMMEDIATE_KHR:    return "IMMEDIATE";
+    case VK_PRESENT_MODE_MAILBOX_KHR:      return "MAILBOX";
+    case VK_PRESENT_MODE_FIFO_KHR:         return "FIFO";
+    case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "FIFO_RELAXED";
+    default:                               return "unknown";
+  }
+}
+
+// pipeline statistics gathered for a single model (or pass), values are from the most recent completed frame
+struct pipelineStats
+{
+  uint64_t  inputPrimitives = 0;      // primitives read by the input assembler
+  uint64_t  vertexInvocations = 0;    // vertex shader invocations (post-transform cache misses)
+  uint64_t  clippingInvocations = 0;  // primitives sent to the clipper
+  uint64_t  clippingPrimitives = 0;   // primitives that survived clipping
+  uint64_t  fragmentInvocations = 0;  // fragment shader invocations
+
+  size_t    meshCount = 0;            // static geometry counts, from mesh::getIndexCount
+  size_t    indexCount = 0;
+  size_t    triangleCount = 0;
+
+  bool      valid = false;            // false until the first query result comes back from the GPU
+};
+
+// the six frustum planes of a (model-)view-projection matrix, normalised, a point p is inside all of them when
+// dot(plane.xyz, p) + plane.w >= 0.  Depth runs 0..1 (GLM_FORCE_DEPTH_ZERO_TO_ONE), so the near plane is z >= 0.
+static void frustumPlanes(const glm::mat4& mvp, glm::vec4 planes[6])
+{
+  glm::vec4 rows[4];
+  for (int r = 0; r < 4; r++) rows[r] = glm::vec4(mvp[0][r], mvp[1][r], mvp[2][r], mvp[3][r]);
+
+  planes[0] = rows[3] + rows[0];         // left
+  planes[1] = rows[3] - rows[0];         // right
+  planes[2] = rows[3] + rows[1];         // top/bottom
+  planes[3] = rows[3] - rows[1];
+  planes[4] = rows[2];                   // near
+  planes[5] = rows[3] - rows[2];         // far
+  for (int p = 0; p < 6; p++)
+  {
+    float length = glm::length(glm::vec3(planes[p]));
+    if (length > 0.0f) planes[p] /= length;
+  }
+}
+
 static std::vector<char> readFile(const std::string& filename)
 {
   std::ifstream ins(filename, std::ios::binary | std::ios::ate);
@@ -88,6 +179,29 @@ static uint32_t  findMemoryTypeIndex(VkPhysicalDevice physical, uint32_t allowed
 	}
 }
 
+// allocates memory for requirements and records it with the device memory tracker (gpuMemoryTracker.h).  Every
+// vkAllocateMemory in the program is made here, createBuffer included
+static VkResult allocateDeviceMemory(VkPhysicalDevice physicalDevice, VkDevice device, const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, deviceMemoryTag tag, VkDeviceMemory* memory)
+{
+	VkPhysicalDeviceMemoryProperties memoryProperties;
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+	VkMemoryAllocateInfo memoryAllocInfo = {};
+	memoryAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocInfo.allocationSize = requirements.size;
+	memoryAllocInfo.memoryTypeIndex = findMemoryTypeIndex(physicalDevice, requirements.memoryTypeBits, properties);
+
+	VkResult result = vkAllocateMemory(device, &memoryAllocInfo, nullptr, memory);
+	if (VK_SUCCESS != result) return result;
+
+	g_deviceAllocationCount++;
+	trackDeviceMemory(*memory, requirements.size, memoryAllocInfo.memoryTypeIndex,
+	                  memoryProperties.memoryTypes[memoryAllocInfo.memoryTypeIndex].heapIndex, tag);
+	return result;
+}
+
+
+
 static void createBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize bufferSize, VkBufferUsageFlags bufferUsage, VkMemoryPropertyFlags bufferProperties, VkBuffer* buffer, VkDeviceMemory* bufferMemory)
 {
 	// CREATE VERTEX BUFFER
@@ -109,11 +223,7 @@ static void createBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkDev
 	vkGetBufferMemoryRequirements(device, *buffer, &memRequirements);
 
 	// ALLOCATE MEMORY TO BUFFER
-	VkMemoryAllocateInfo memoryAllocInfo = {};
-	memoryAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	memoryAllocInfo.allocationSize = memRequirements.size;
-	memoryAllocInfo.memoryTypeIndex = findMemoryTypeIndex(physicalDevice, memRequirements.memoryTypeBits, bufferProperties);
-	result = vkAllocateMemory(device, &memoryAllocInfo, nullptr, bufferMemory);
+	result = allocateDeviceMemory(physicalDevice, device, memRequirements, bufferProperties, bufferMemoryTag(bufferUsage), bufferMemory);
 	if (result != VK_SUCCESS)
 	{
 		throw std::runtime_error("Failed to allocate Vertex Buffer Memory!");
@@ -125,6 +235,17 @@ static void createBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkDev
 
 
 
+static void freeDeviceMemory(VkDevice device, VkDeviceMemory memory)
+{
+	if (VK_NULL_HANDLE == memory) return;
+
+	untrackDeviceMemory(memory);
+	vkFreeMemory(device, memory, nullptr);
+	g_deviceAllocationCount--;
+}
+
+
+
 static VkCommandBuffer beginCommandBuffer(VkDevice device, VkCommandPool commandPool)
 {
 	// Command buffer to hold transfer commands
@@ -165,6 +286,7 @@ static void endAndSubmitCommandBuffer(VkDevice device, VkCommandPool commandPool
 	// Submit transfer command to transfer queue and wait until it finishes
 	vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
 	vkQueueWaitIdle(queue);
+	g_queueSubmits.fetch_add(1, std::memory_order_relaxed);
 
 	// Free temporary command buffer back to pool
 	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
@@ -184,6 +306,7 @@ static void copyBuffer(VkDevice device, VkQueue transferQueue, VkCommandPool tra
 
 	// Command to copy src buffer to dst buffer
 	vkCmdCopyBuffer(transferCommandBuffer, srcBuffer, dstBuffer, 1, &bufferCopyRegion);
+	g_uploadBytes.fetch_add(bufferSize, std::memory_order_relaxed);
 
 	endAndSubmitCommandBuffer(device, transferCommandPool, transferQueue, transferCommandBuffer);
 }
@@ -207,12 +330,56 @@ static void copyImageBuffer(VkDevice device, VkQueue transferQueue, VkCommandPoo
 	imageRegion.imageExtent = { width, height, 1 };
 
 	vkCmdCopyBufferToImage(transferCommmandBuffer, srcBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageRegion);
+	g_uploadBytes.fetch_add(static_cast<uint64_t>(width) * height * 4, std::memory_order_relaxed);		// textures are RGBA8
 
 	endAndSubmitCommandBuffer(device, transferCommandPool, transferQueue, transferCommmandBuffer);
 }
 
 
 
+// the stages and accesses that use an image in layout, for a barrier that waits on them (leaving the layout) or that
+// they wait on (entering it).  Undefined is nothing, presentation is done outside the pipeline
+static void imageLayoutAccess(VkImageLayout layout, VkPipelineStageFlags* stage, VkAccessFlags* access)
+{
+	switch (layout)
+	{
+	case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+		*stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		*access = VK_ACCESS_TRANSFER_WRITE_BIT;
+		break;
+	case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+		*stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		*access = VK_ACCESS_TRANSFER_READ_BIT;
+		break;
+	case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+		*stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		*access = VK_ACCESS_SHADER_READ_BIT;
+		break;
+	case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+		*stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		*access = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		break;
+	case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+		*stage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		*access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		break;
+	case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+		*stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		*access = 0;
+		break;
+	case VK_IMAGE_LAYOUT_GENERAL:
+		*stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		*access = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		break;
+	default:                                                     // undefined, the contents are not kept
+		*stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		*access = 0;
+		break;
+	}
+}
+
+
+
 static void transitionImageLayout(VkDevice device, VkQueue queue, VkCommandPool commandPool, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout)
 {
 	// Create buffer
@@ -231,27 +398,14 @@ static void transitionImageLayout(VkDevice device, VkQueue queue, VkCommandPool
 	imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;						          // First layer to start alterations on
 	imageMemoryBarrier.subresourceRange.layerCount = 1;							            // Number of layers to alter starting from baseArrayLayer
 
+	// the transition waits for the work that left the image in oldLayout, and the work that uses it in newLayout waits for
+	// the transition
 	VkPipelineStageFlags srcStage;
 	VkPipelineStageFlags dstStage;
-
-	// If transitioning from new image to image ready to receive data...
-	if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-	{
-		imageMemoryBarrier.srcAccessMask = 0;								                // Memory access stage transition must after...
-		imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;		// Memory access stage transition must before...
-
-		srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-		dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-	}
-	// If transitioning from transfer destination to shader readable...
-	else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-	{
-		imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-		srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-	}
+	imageLayoutAccess(oldLayout, &srcStage, &imageMemoryBarrier.srcAccessMask);
+	imageLayoutAccess(newLayout, &dstStage, &imageMemoryBarrier.dstAccessMask);
+	imageMemoryBarrier.srcAccessMask &= VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+	                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;   // only writes need making available
 
 	vkCmdPipelineBarrier(commandBuffer,srcStage, dstStage,0,0, nullptr,0, nullptr,1, &imageMemoryBarrier);
 
@@ -1,9 +1,13 @@
 #include <iostream>
+#include <iomanip>
+#include <cctype>
+#include <chrono>
 #include <set>
 
 #include "vkContext.h"
 #include "vkValidations.h"
 #include "mesh.h"
+#include "assetPack.h"
 
 
 /************************************************************************************************************************
@@ -33,6 +37,14 @@ vkContext::vkContext(GLFWwindow* pWindow, bool v) : m_pWindow(pWindow), m_useVal
     std::cout << "[?] adding " << glfwExtensions[ndx] << " to list of required extenstions" << std::endl;
   }
 
+  // device UUIDs (so a device can be chosen by UUID) need two optional extensions on a 1.0 instance
+  m_deviceIds = deviceIdsAvailable();
+  if (m_deviceIds)
+  {
+    m_instanceExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    m_instanceExtensions.push_back(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
+  }
+
   // add VK_EXT_debug_utils to our list of required extensions, if debugging is enabled.
   if (m_useValidation)
   {
@@ -95,8 +107,19 @@ vkContext::~vkContext()
  *               (s) createDescriptorSets();
  *               (t) record commands to render the scene
  *               (u) create synchronization objects to use along the graphics pipeline
+ *               (v) create the pipeline statistics query pool (if the device supports it)
+ *               (w) create the meshlet cull pipeline (if meshlets were requested, see setMeshlets)
+ *               (x) create the HUD's font atlas, quad buffers and timestamp queries (if the HUD was requested, see setHud)
  *            If any of these steps fails, it will throw a runtime exception and the program will terminate.
  *
+ *            Steps (a) to (e) are a chain and run in order.  The rest only depend on the device and each other, so are
+ *            run as a dependency graph on the job system: the pipelines (and their SPIR-V loads) are compiled and the
+ *            default texture decoded while the swapchain and its attachments are made.  The swapchain's format is
+ *            chosen before the graph, it is all the render pass needs of the swapchain, and the pipelines' viewport
+ *            and scissor are dynamic so they do not need its extent.  Steps that share an externally synchronised
+ *            object (a pool or the queue) are made dependent on each other.  The graph's timings are kept for
+ *            reportInitialisation, and the time from here to the first frame presented is reported by draw.
+ *
  * parameters: void
  *
  * returns   : void.  Throws a runtime exception on error
@@ -105,9 +128,20 @@ vkContext::~vkContext()
  * modified  : Apr 2024 (GKHuber) added support for descriptor sets and modifying the MVP matrix at run time.
  *                                added support for dynamic descriptor sets and push-constants
  *                                added support for depth testing
+ * modified  : Oct 2026 (GKHuber) the steps after the logical device run as a dependency graph on the job system
+ * modified  : Oct 2026 (GKHuber) adds the HUD's resources
+ * modified  : Oct 2026 (GKHuber) the projection is for a view's share of the window (see setViews)
 ************************************************************************************************************************/
 int vkContext::initContext()
 {
+  m_initStart = std::chrono::steady_clock::now();
+
+  // the default "no-texture" texture, decoded on a worker and uploaded once the pools exist
+  stbi_uc*     plainPixels = nullptr;
+  int          plainWidth = 0;
+  int          plainHeight = 0;
+  VkDeviceSize plainSize = 0;
+
   try
   {
     createInstance();
@@ -115,34 +149,64 @@ int vkContext::initContext()
     createSurface();
     getPhysicalDevice();
     createLogicalDevice();
-    createSwapChain();
-    createRenderPass();
-    createDescriptorSetLayout();
-    createPushConstantRange();
-    createGraphicsPipeline();
-    createColourBufferImage();
-    createDepthBufferImage();
-    createFramebuffers();
-    createCommandPool();
-    createCommandBuffers();
-    createTextureSampler();
-    createUniformBuffers();
-    createDescriptorPool();
-    createDescriptorSets();
-    createInputDescriptorSets();
-    createSynchronisations();
-
-    m_uboVP.proj = glm::perspective(glm::radians(45.0f), (float)m_swapChainExtent.width / (float)m_swapChainExtent.height, 0.1f, 100.0f);
+
+    // the cull pass has one frustum to test against, so culls nothing for split screen views
+    if (m_viewCount > 1 && m_useMeshlets)
+    {
+      std::cerr << "[-] meshlet culling is for a single view, turned off for " << m_viewCount << " views" << std::endl;
+      m_useMeshlets = false;
+    }
+
+    m_surfaceFormat = chooseBestSurfaceFormat(getSwapChainDetails(m_device.physical).formats);
+    m_swapChainImageFormat = m_surfaceFormat.format;
+
+    taskGraph& graph = m_initGraph;
+    size_t swapChain = graph.add("createSwapChain", [this]() { createSwapChain(); });
+    size_t renderPass = graph.add("createRenderPass", [this]() { createRenderPass(); });
+    size_t setLayouts = graph.add("createDescriptorSetLayout", [this]() { createDescriptorSetLayout(); });
+    size_t pushConstants = graph.add("createPushConstantRange", [this]() { createPushConstantRange(); });
+    graph.add("createGraphicsPipeline", [this]() { createGraphicsPipeline(); }, { renderPass, setLayouts, pushConstants });
+    if (m_useMeshlets) graph.add("createCullPipeline", [this]() { createCullPipeline(); });
+
+    size_t attachments = graph.add("createAttachmentImages", [this]() { createAttachmentImages(); }, { swapChain, renderPass });
+    size_t framebuffers = graph.add("createFramebuffers", [this]() { createFramebuffers(); }, { renderPass, attachments });
+    size_t commandPool = graph.add("createCommandPool", [this]() { createCommandPool(); });
+    size_t commandBuffers = graph.add("createCommandBuffers", [this]() { createCommandBuffers(); }, { commandPool, framebuffers });
+    size_t sampler = graph.add("createTextureSampler", [this]() { createTextureSampler(); });
+    size_t uniforms = graph.add("createUniformBuffers", [this]() { createUniformBuffers(); }, { swapChain });
+    size_t pools = graph.add("createDescriptorPool", [this]() { createDescriptorPool(); }, { uniforms, attachments });
+    graph.add("createDescriptorSets", [this]() { createDescriptorSets(); }, { pools, setLayouts });
+    graph.add("createInputDescriptorSets", [this]() { createInputDescriptorSets(); }, { pools, setLayouts, sampler });
+    graph.add("createSynchronisations", [this]() { createSynchronisations(); });
+    graph.add("createQueryPool", [this]() { createQueryPool(); }, { swapChain });
+
+    // the upload records into the graphics command pool, so waits for the command buffers to be allocated from it
+    size_t decode = graph.add("decode plain.png", [&]() { plainPixels = loadTextureFile("plain.png", &plainWidth, &plainHeight, &plainSize); });
+    size_t upload = graph.add("upload plain.png", [&]()
+      {
+        m_defaultTexture = createTextureFromPixels(plainPixels, plainWidth, plainHeight);
+        if (m_defaultTexture.isNull()) throw std::runtime_error("failed to create the default texture");
+      }, { decode, commandBuffers, sampler, pools, setLayouts });
+
+    // the atlas upload uses the graphics queue and command pool too, so follows the default texture's
+    if (m_useHud) graph.add("createHudResources", [this]() { createHudResources(); }, { upload, swapChain });
+
+    graph.run(m_jobs);
+    stbi_image_free(plainPixels);
+    plainPixels = nullptr;
+
+    std::cerr << "[+] context initialised in " << graph.getElapsedMs() << " ms (" << graph.getWorkMs() << " ms of work on "
+              << m_jobs.getWorkerCount() + 1 << " threads)" << std::endl;
+
+    m_uboVP.proj = glm::perspective(glm::radians(45.0f), (float)m_sceneExtent.width / (float)m_sceneExtent.height, 0.1f, 100.0f);
     m_uboVP.view = glm::lookAt(glm::vec3(10.0f, 0.0f, 2.0f), glm::vec3(0.0f, 0.0f,0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
     //m_uboVP.view = glm::lookAt(glm::vec3(-2.5f, 0.0f, 3.5f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 
     m_uboVP.proj[1][1] *= -1;               // vulkan reverses the direction of the y-axis
-
-    // create our default "no-texture" texture
-    createTexture("plain.png");
   }
   catch (const std::runtime_error& e)
   {
+    if (nullptr != plainPixels) stbi_image_free(plainPixels);
     std::cout << "[ERROR] " << e.what() << std::endl;
     return EXIT_FAILURE;
   }
@@ -152,10 +216,573 @@ int vkContext::initContext()
 
 
 
-void vkContext::updateModel(int modelId, glm::mat4 newModel)
+void vkContext::updateModel(modelHandle model, glm::mat4 newModel)
+{
+  size_t ndx = m_models.indexOf(model);
+  if (m_models.npos == ndx) return;
+
+  m_models.hotAt(ndx).setModel(newModel);
+  m_transforms.setMatrix(ndx, newModel);
+  m_dirty = true;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : updateModels
+ *
+ * abstract  : Bulk update of the transforms of 'count' models as position, rotation and scale.  This is the fast
+ *             path for large numbers of objects, the model and MVP matrices are built for all of them at once (with
+ *             SSE/AVX2 where available) when the frame is drawn.  Any of the arrays may be null to leave that component
+ *             unchanged.  Models created one after another sit next to each other in the transform store until one is
+ *             destroyed, each run of those is copied in one go; stale handles are skipped.  Drawing on demand, the
+ *             next frame is drawn even if the transforms given are the ones the models already had.
+ *
+ * parameters: models -- [in] array of 'count' models to update
+ *             count -- [in] number of models to update
+ *             positions -- [in] array of 'count' positions, or nullptr
+ *             rotations -- [in] array of 'count' unit quaternions, or nullptr
+ *             scales -- [in] array of 'count' scale factors, or nullptr
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) models are given by handle
+ * modified  : Oct 2026 (GKHuber) marks the scene as changed
+************************************************************************************************************************/
+void vkContext::updateModels(const modelHandle* models, size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales)
+{
+  size_t run = 0;
+  while (run < count)
+  {
+    size_t first = m_models.indexOf(models[run]);
+    size_t length = 1;
+    if (m_models.npos != first)
+    {
+      while (run + length < count && m_models.indexOf(models[run + length]) == first + length) length++;
+
+      m_transforms.setMany(first, length, positions ? positions + run : nullptr, rotations ? rotations + run : nullptr,
+        scales ? scales + run : nullptr);
+    }
+    run += length;
+  }
+  m_dirty = true;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setPresentPolicy
+ *
+ * abstract  : Selects the presentation policy used when the swapchain is created.  The swapchain is only created in
+ *             initContext, so this must be called before then.  The mode actually chosen (after any fall back) can be
+ *             read with getPresentMode.
+ *
+ * parameters: policy -- [in] requested presentation policy
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setPresentPolicy(presentPolicy policy)
+{
+  m_presentPolicy = policy;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setDeviceOverride
+ *
+ * abstract  : Names the physical device to use instead of the highest scoring one, by index, UUID or part of its name
+ *             (see selectDevice).  Without one the VULKAN7_DEVICE environment variable is used, if set.  The device is
+ *             picked in initContext, so this must be called before then.
+ *
+ * parameters: spec -- [in] the device, empty for none
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setDeviceOverride(const std::string& spec)
+{
+  m_deviceOverride = spec;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setHud
+ *
+ * abstract  : Turns the performance HUD on or off; a panel in the top left corner with the frame rate, a graph of the
+ *             last HUD_GRAPH_FRAMES frame times, the CPU time of each phase of draw, the GPU time of each pass (from
+ *             timestamp queries), draw calls and triangles, and device memory.  Its pipeline, atlas and buffers are made
+ *             by initContext, so this must be called before then.
+ *
+ * parameters: enable -- [in] true to draw the HUD
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setHud(bool enable)
+{
+  m_useHud = enable;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setViews
+ *
+ * abstract  : Splits the window between count views of the scene, side by side, each seeing it turned a further
+ *             1/count of a revolution about the y axis.  The scene is recorded once and drawn into every view by
+ *             VK_KHR_multiview: the vertex shader picks its view-projection from UboVP by gl_ViewIndex, and each view
+ *             lands in its own layer of the colour and depth images, which the post-process pass then lays out across
+ *             the swapchain image.  So the CPU's work per frame does not grow with the views.  If the device does not
+ *             have multiview createLogicalDevice falls back to one view.  Meshlet culling is against a single frustum,
+ *             so is turned off, as are the pipeline statistics (see enablePipelineStatistics), and streamed models
+ *             choose their chunks for the first view.
+ *
+ * parameters: count -- [in] views to draw, 1 (the default) to MAX_VIEWS
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setViews(uint32_t count)
+{
+  m_viewCount = std::max(1u, std::min(count, MAX_VIEWS));
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setOnDemand
+ *
+ * abstract  : Turns drawing on demand on or off.  On demand, draw only draws when something has changed what would be
+ *             drawn since the last frame; a model updated, created or destroyed, a texture created or destroyed, the
+ *             camera moved, a streamed model still paging in chunks, or invalidate called (e.g. when the window needs
+ *             repainting).  Otherwise it returns at once, without waiting on a fence, acquiring, recording or
+ *             presenting, so a scene that is not changing costs nothing.  The frame loop should then block on window
+ *             events (see needsRedraw) rather than spin.  The HUD does not count as a change; it is brought up to date
+ *             with the frames that are drawn.
+ *
+ * parameters: enable -- [in] true to draw only when something has changed
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setOnDemand(bool enable)
+{
+  m_onDemand = enable;
+  m_dirty = true;
+}
+
+
+
+// moves the camera, the view half of the view-projection in the uniform buffers
+void vkContext::setCamera(const glm::vec3& eye, const glm::vec3& target, const glm::vec3& up)
+{
+  m_uboVP.view = glm::lookAt(eye, target, up);
+  m_dirty = true;
+}
+
+
+
+void vkContext::invalidate()
+{
+  m_dirty = true;
+}
+
+
+
+// whether draw would draw a frame; a streamed model that is still paging in chunks needs frames until it has them
+bool vkContext::needsRedraw()
+{
+  if (!m_onDemand || m_dirty) return true;
+
+  for (const auto& stream : m_streams)
+  {
+    if (stream->isBusy()) return true;
+  }
+  return false;
+}
+
+
+
+VkPresentModeKHR vkContext::getPresentMode()
+{
+  return m_presentMode;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : getJobSystem
+ *
+ * abstract  : Returns the context's job system.  This is the one thread pool shared by everything that wants to run in
+ *             parallel (model/texture loading, command recording, ...), work should be queued here rather than by
+ *             creating more threads.
+ *
+ * parameters: void
+ *
+ * returns   : jobSystem&, reference to the job system owned by the context
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+jobSystem& vkContext::getJobSystem()
+{
+  return m_jobs;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setTexturePoolSize
+ *
+ * abstract  : Sets the number of sampler descriptor sets, and so the number of textures, the context can hold.  The
+ *             pool is created in initContext, so this must be called before then.
+ *
+ * parameters: textures -- [in] maximum number of textures, including the default texture
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setTexturePoolSize(uint32_t textures)
+{
+  m_texturePoolSize = std::max<uint32_t>(textures, 1);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setMeshlets
+ *
+ * abstract  : Import option, when enabled every mesh loaded after initContext is also split into meshlets (see
+ *             meshletBuilder) and drawn through a compute pass that culls them against the view frustum and by their
+ *             normal cones each frame, so only the triangles of the clusters that can be seen reach the main subpass.
+ *             The cull pipeline is created in initContext, so this must be called before then.  If the graphics queue
+ *             can not run compute work the option is ignored and meshes are drawn whole.
+ *
+ * parameters: enable -- [in] true to build and cull meshlets
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setMeshlets(bool enable)
+{
+  m_useMeshlets = enable;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setMergeMeshes
+ *
+ * abstract  : Import option, when enabled the meshes of each model loaded afterwards that share a texture are merged
+ *             into one mesh (see meshMerger), pre-transformed into model space, so the model is drawn with one call per
+ *             distinct texture.  The draw count before and after is reported as each model is loaded.  The models
+ *             here are all static, so nothing is lost by merging, except that pipeline statistics and meshlet culling
+ *             then see the merged meshes.
+ *
+ * parameters: enable -- [in] true to merge
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setMergeMeshes(bool enable)
 {
-  if (modelId >= m_modelList.size()) return;
-  m_modelList[modelId].setModel(newModel);
+  m_mergeMeshes = enable;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : setStreamBudget
+ *
+ * abstract  : Sets the GPU memory each streamed model may use for full detail chunks (their proxies are not counted).
+ *             Applies to the streams already open as well as later ones; a stream over a lowered budget evicts down to
+ *             it as it next needs room.
+ *
+ * parameters: bytes -- [in] budget per streamed model, in bytes
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::setStreamBudget(uint64_t bytes)
+{
+  m_streamBudget = bytes;
+  for (auto& stream : m_streams) stream->setBudget(bytes);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : getResourceUsage
+ *
+ * abstract  : Reports what the scene is using against the limits that bound it; the sampler descriptor pool, the
+ *             number of models covered by pipeline statistics and the device's cap on memory allocations.  Geometry
+ *             shared by model instances is only counted once.
+ *
+ * parameters: void
+ *
+ * returns   : resourceUsage, current usage
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+resourceUsage vkContext::getResourceUsage()
+{
+  resourceUsage usage;
+
+  usage.models = m_models.size();
+  usage.meshes = m_totalMeshCount;
+  usage.meshlets = m_meshlets.size();
+  for (size_t i = 0; i < m_models.size(); i++)
+  {
+    usage.triangles += m_modelStats[i].triangleCount;
+    if (!m_models.hotAt(i).ownsMeshes()) continue;
+
+    for (size_t k = 0; k < m_models.hotAt(i).getMeshCount(); k++)
+    {
+      mesh* thisMesh = m_models.hotAt(i).getMesh(k);
+      usage.geometryBytes += thisMesh->getVertexCount() * sizeof(vertex) + thisMesh->getIndexCount() * sizeof(uint32_t);
+    }
+  }
+
+  for (auto& stream : m_streams)
+  {
+    streamStats stats = stream->getStats();
+    usage.geometryBytes += stats.residentBytes + stats.proxyBytes;
+  }
+
+  usage.textures = m_textures.size();
+  usage.textureCapacity = m_texturePoolSize;
+  usage.textureBytes = m_textureBytes;
+  usage.statsQueryLimit = MAX_OBJECTS;
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(m_device.physical, &properties);
+  usage.deviceAllocations = g_deviceAllocationCount;
+  usage.maxDeviceAllocations = properties.limits.maxMemoryAllocationCount;
+
+  return usage;
+}
+
+
+
+double vkContext::getLastRecordTime()
+{
+  return m_lastRecordMs;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : getFrameStats
+ *
+ * abstract  : Returns what the last FRAME_STATS_HISTORY frames did, newest first; draw calls, indexed triangles,
+ *             pipeline, descriptor set, vertex and index buffer binds, push constant bytes, bytes uploaded, queue
+ *             submits and the time spent waiting on the frame's fence (see frameStats.h).  They are counted as the
+ *             commands are recorded, so are what was asked of the GPU, not what it did; the pipeline statistics
+ *             queries are for that.
+ *
+ * parameters: none
+ *
+ * returns   : const frameStatsHistory&, valid for the life of the context and updated by each draw
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+const frameStatsHistory& vkContext::getFrameStats()
+{
+  return m_frameStats;
+}
+
+
+
+// the history's averages, as one line
+void vkContext::reportFrameStats(std::ostream& os)
+{
+  frameStats mean = m_frameStats.average();
+
+  os << "[?] per frame over " << m_frameStats.size() << " frames: " << mean.drawCalls << " draws, " << mean.triangles
+     << " triangles, binds " << mean.pipelineBinds << " pipeline " << mean.descriptorBinds << " descriptor "
+     << mean.vertexBufferBinds << " vertex " << mean.indexBufferBinds << " index, " << mean.pushConstantBytes
+     << " push constant bytes, " << mean.uploadBytes << " bytes uploaded, " << mean.queueSubmits << " submits, fence wait "
+     << mean.fenceWaitMs << " ms" << std::endl;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : enablePipelineStatistics
+ *
+ * abstract  : Turns the per-model pipeline statistics queries on or off.  The queries are recorded into the command
+ *             buffers, so the change takes effect the next time each swapchain image is drawn.  Has no effect if the
+ *             device does not support pipeline statistics queries.
+ *
+ * parameters: enable -- [in] true to start gathering statistics, false to stop
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) not with split screen views; a query begun in a multiview render pass takes a slot
+ *                                per view, so the per-model queries would overlap one another and the next image's
+************************************************************************************************************************/
+void vkContext::enablePipelineStatistics(bool enable)
+{
+  if (enable && m_viewCount > 1)
+  {
+    std::cerr << "[-] pipeline statistics are for a single view, turned off for " << m_viewCount << " views" << std::endl;
+    enable = false;
+  }
+
+  m_useStats = enable;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : getModelStats
+ *
+ * abstract  : Returns the most recent pipeline statistics for a model along with its mesh, index and triangle counts.
+ *             Only the first MAX_OBJECTS models are queried, later models report their geometry counts only.
+ *
+ * parameters: model -- [in] model returned by createMeshModel
+ *             stats -- [out] pointer to a pipelineStats structure to fill in
+ *
+ * returns   : bool, true if GPU results are available for the model, false otherwise
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+bool vkContext::getModelStats(modelHandle model, pipelineStats* stats)
+{
+  size_t ndx = m_models.indexOf(model);
+  if (m_models.npos == ndx || nullptr == stats) return false;
+
+  *stats = m_modelStats[ndx];
+  return stats->valid;
+}
+
+
+
+pipelineStats vkContext::getPostPassStats()
+{
+  return m_postPassStats;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : reportPipelineStatistics
+ *
+ * abstract  : Writes a table of the per-model statistics to the given stream, heaviest model (by fragment shader
+ *             invocations) first, followed by the post-process pass.
+ *
+ * parameters: os -- [in] stream to write the report to
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::reportPipelineStatistics(std::ostream& os)
+{
+  if (VK_NULL_HANDLE == m_statsQueryPool)
+  {
+    os << "[-] pipeline statistics are not supported on this device" << std::endl;
+    return;
+  }
+
+  std::vector<size_t> order(m_modelStats.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b)
+    { return m_modelStats[a].fragmentInvocations > m_modelStats[b].fragmentInvocations; });
+
+  os << "[?] pipeline statistics (heaviest first)" << std::endl;
+  os << "    model   meshes    indices  triangles   vs invoc   clip in  clip out   fs invoc" << std::endl;
+  for (size_t ndx : order)
+  {
+    const pipelineStats& s = m_modelStats[ndx];
+    os << "    " << std::setw(5) << ndx << std::setw(9) << s.meshCount << std::setw(11) << s.indexCount << std::setw(11) << s.triangleCount;
+    if (s.valid)
+    {
+      os << std::setw(11) << s.vertexInvocations << std::setw(10) << s.clippingInvocations << std::setw(10) << s.clippingPrimitives
+         << std::setw(11) << s.fragmentInvocations << std::endl;
+    }
+    else
+    {
+      os << "   (no results)" << std::endl;
+    }
+  }
+
+  if (m_postPassStats.valid)
+  {
+    os << "    post-process pass: vs invoc " << m_postPassStats.vertexInvocations << ", fs invoc " << m_postPassStats.fragmentInvocations << std::endl;
+  }
+}
+
+
+
+void vkContext::reportStreaming(std::ostream& os)
+{
+  for (size_t s = 0; s < m_streams.size(); s++)
+  {
+    streamStats stats = m_streams[s]->getStats();
+    os << "[?] stream " << s << " (model " << m_streamModel[s] << "): " << stats.resident << " of " << stats.chunks
+       << " chunks resident, " << stats.loading << " loading, " << stats.visible << " visible (" << stats.proxies
+       << " as proxies), " << stats.residentBytes / (1024 * 1024) << " of " << stats.budgetBytes / (1024 * 1024)
+       << " MB, proxies " << stats.proxyBytes / 1024 << " KB, " << stats.uploads << " uploads, " << stats.evictions
+       << " evictions" << std::endl;
+  }
+}
+
+
+
+// device memory by heap, by use and by owner, see gpuMemoryTracker
+void vkContext::reportDeviceMemory(std::ostream& os)
+{
+  VkPhysicalDeviceMemoryProperties properties;
+  vkGetPhysicalDeviceMemoryProperties(m_device.physical, &properties);
+  writeDeviceMemoryReport(os, getDeviceMemoryReport(), &properties);
+}
+
+
+
+// the render graph the frame was built from, and the memory each alias slot took
+void vkContext::reportRenderGraph(std::ostream& os)
+{
+  m_renderGraph.dump(os);
+
+  for (size_t slot = 0; slot < m_attachmentSlotBytes.size(); slot++)
+  {
+    os << "[?]   memory slot " << slot << ": " << m_attachmentSlotBytes[slot] / 1024 << " KB per swapchain image"
+       << (m_attachmentSlotLazy[slot] ? ", lazily allocated" : "") << std::endl;
+  }
+}
+
+
+
+// how long initContext took and when each of its steps ran, then the time to the first frame (once there has been one)
+void vkContext::reportInitialisation(std::ostream& os)
+{
+  os << "[?] initContext steps, ms from the start of the graph (" << m_initGraph.getElapsedMs() << " ms, "
+     << m_initGraph.getWorkMs() << " ms of work):" << std::endl;
+  m_initGraph.report(os);
+  if (m_frameCount > 0) os << "[?] time to first frame " << m_firstFrameMs << " ms" << std::endl;
+}
+
+
+
+// ms from one point of the frame to another
+static double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+  return std::chrono::duration<double, std::milli>(to - from).count();
 }
 
 
@@ -172,20 +799,65 @@ void vkContext::updateModel(int modelId, glm::mat4 newModel)
  * 
  * parameters: none
  *
- * returns   : void, throws runtime exceptions
+ * returns   : bool, false if drawing on demand and the frame was skipped; throws runtime exceptions
  *
  * written   : Mar 2024 (GKHuber)
  * modified  : Apr 2024 (GKHuber) added support for uniform buffers - added code to update the uniforms
+ * modified  : Oct 2026 (GKHuber) updates the geometry streams before recording, and counts frames for them
+ * modified  : Oct 2026 (GKHuber) reports the time to the first frame
+ * modified  : Oct 2026 (GKHuber) times each phase for the HUD.  The HUD is recorded before this frame's submit, so it
+ *                                shows the previous frame's phases
+ * modified  : Oct 2026 (GKHuber) counts the frame's statistics (see frameStats.h) and adds them to the history
+ * modified  : Oct 2026 (GKHuber) drawing on demand (see setOnDemand) skips the frame if nothing has changed, and
+ *                                returns whether it drew
 ************************************************************************************************************************/
-void vkContext::draw()
+bool vkContext::draw()
 {
+  if (!needsRedraw())
+  {
+    m_skipped = true;
+    return false;
+  }
+  m_dirty = false;
+
+  // the time between two frames with skipped frames between them is idle time, not a frame time
+  std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+  if (m_useHud && m_frameCount > 0 && !m_skipped) m_hud.addFrame(elapsedMs(m_lastFrameStart, frameStart));
+  m_lastFrameStart = frameStart;
+  m_skipped = false;
+
+  m_frameCounters = frameStats();
+  m_frameCounters.frame = m_frameCount;
+
   vkWaitForFences(m_device.logical, 1, &m_drawFences[m_currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max());
+  m_frameCounters.fenceWaitMs = elapsedMs(frameStart, std::chrono::steady_clock::now());
   vkResetFences(m_device.logical, 1, &m_drawFences[m_currentFrame]);
+  m_frameArena[m_currentFrame].reset();           // GPU is done with this frame, so is everything allocated for it
   
+  std::chrono::steady_clock::time_point acquireStart = std::chrono::steady_clock::now();
   uint32_t imageIndex;
   vkAcquireNextImageKHR(m_device.logical, m_swapchain, std::numeric_limits<uint64_t>::max(), m_imageAvailable[m_currentFrame], VK_NULL_HANDLE, &imageIndex);
 
+  std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
+  collectPipelineStatistics(imageIndex);         // read back last use of this image's queries before they are reset
+  collectTimestamps(imageIndex);
+  m_transforms.compose(m_uboVP.proj * m_uboVP.view);
+  if (m_meshletsDirty) updateMeshletBuffers();
+
+  // streamed models choose their draws (and page and upload chunks) with the camera in their own space
+  glm::vec4 cameraPosition = glm::inverse(m_uboVP.view)[3];
+  for (size_t s = 0; s < m_streams.size(); s++)
+  {
+    uint32_t  model = m_streamModel[s];
+    glm::vec3 camera = glm::vec3(glm::inverse(m_transforms.getModel(model)) * cameraPosition);
+    m_streams[s]->update(m_frameCount, m_transforms.getMVP(model), camera);
+  }
+
+  std::chrono::steady_clock::time_point recordStart = std::chrono::steady_clock::now();
   recordcommands(imageIndex);
+  std::chrono::steady_clock::time_point submitStart = std::chrono::steady_clock::now();
+  m_lastRecordMs = elapsedMs(recordStart, submitStart);
+
   updateUniformBuffers(imageIndex);
 
   // submit command buffer to graphics queue....
@@ -207,6 +879,7 @@ void vkContext::draw()
   {
     throw std::runtime_error("failed to command to graphics queue");
   }
+  m_frameCounters.queueSubmits++;
 
   // submit finished image to presentation queue...
   VkPresentInfoKHR  presentInfo = {};
@@ -223,7 +896,29 @@ void vkContext::draw()
     throw std::runtime_error("failed to present image to presentation queue");
   }
 
+  if (m_useHud)
+  {
+    m_hudData.waitMs = elapsedMs(frameStart, acquireStart);
+    m_hudData.acquireMs = elapsedMs(acquireStart, updateStart);
+    m_hudData.updateMs = elapsedMs(updateStart, recordStart);
+    m_hudData.recordMs = m_lastRecordMs;
+    m_hudData.submitMs = elapsedMs(submitStart, std::chrono::steady_clock::now());
+  }
+
+  // and whatever the loaders and streams uploaded and submitted since the last frame
+  m_frameCounters.uploadBytes += g_uploadBytes.exchange(0, std::memory_order_relaxed);
+  m_frameCounters.queueSubmits += g_queueSubmits.exchange(0, std::memory_order_relaxed);
+  m_frameStats.push(m_frameCounters);
+
+  if (0 == m_frameCount)
+  {
+    m_firstFrameMs = elapsedMs(m_initStart, std::chrono::steady_clock::now());
+    std::cerr << "[+] time to first frame " << m_firstFrameMs << " ms (context " << m_initGraph.getElapsedMs() << " ms)" << std::endl;
+  }
+
   m_currentFrame = (m_currentFrame + 1) % MAX_FRAME_DRAWS;
+  m_frameCount++;
+  return true;
 }
 
 
@@ -242,6 +937,8 @@ void vkContext::draw()
  *
  * written   : Mar 2024 (GKHuber)
  ** modified  : Apr 2024 (GKHuber) added cleanup code for descriptor sets
+ * modified  : Oct 2026 (GKHuber) reports device memory that is still allocated before the device goes
+ * modified  : Oct 2026 (GKHuber) destroys the HUD's pipeline, buffers, atlas and timestamp queries
 ************************************************************************************************************************/
 void vkContext::cleanupContext()
 {
@@ -249,10 +946,11 @@ void vkContext::cleanupContext()
   
   //_aligned_free(m_modelTransferSpace);
 
-  for (size_t i = 0; i < m_modelList.size(); i++)
-  {
-    m_modelList[i].destroyMeshModel();
-  }
+  // the meshes' buffers go with the models, and the textures' images with the textures, while the device is still here
+  m_models.clear();
+
+  for (auto& stream : m_streams) stream->destroy();
+  m_streams.clear();
 
   vkDestroyDescriptorPool(m_device.logical, m_inputDescriptorPool, nullptr);
   vkDestroyDescriptorSetLayout(m_device.logical, m_inputSetLayout, nullptr);
@@ -262,33 +960,32 @@ void vkContext::cleanupContext()
 
   vkDestroySampler(m_device.logical, m_textureSampler, nullptr);
 
-  for (size_t i = 0; i < m_textureImages.size(); i++)
-  {
-    vkDestroyImageView(m_device.logical, m_textureImageViews[i], nullptr);
-    vkDestroyImage(m_device.logical, m_textureImages[i], nullptr);
-    vkFreeMemory(m_device.logical, m_textureImageMemory[i], nullptr);
-  }
+  // the descriptor sets went with their pool
+  m_textures.clear();
+  m_hudAtlas.reset();
+  m_hudQuadBuffer.clear();
+  m_hudQuads.clear();
 
   for (size_t i = 0; i < m_depthBufferImage.size(); i++)
   {
     vkDestroyImageView(m_device.logical, m_depthBufferImageView[i], nullptr);
     vkDestroyImage(m_device.logical, m_depthBufferImage[i], nullptr);
-    vkFreeMemory(m_device.logical, m_depthBufferImageMemory[i], nullptr);
   }
 
   for (size_t i = 0; i < m_colourBufferImage.size(); i++)
   {
     vkDestroyImageView(m_device.logical, m_colourBufferImageView[i], nullptr);
     vkDestroyImage(m_device.logical, m_colourBufferImage[i], nullptr);
-    vkFreeMemory(m_device.logical, m_colourBufferImageMemory[i], nullptr);
   }
 
+  for (VkDeviceMemory memory : m_attachmentMemory) freeDeviceMemory(m_device.logical, memory);
+
   vkDestroyDescriptorPool(m_device.logical, m_descriptorPool, nullptr);
   vkDestroyDescriptorSetLayout(m_device.logical, m_descriptorSetLayout, nullptr);
   for (size_t i = 0; i < m_swapChainImages.size(); i++)
   {
     vkDestroyBuffer(m_device.logical, m_vpUniformBuffer[i], nullptr);
-    vkFreeMemory(m_device.logical, m_vpUniformBufferMemory[i], nullptr);
+    freeDeviceMemory(m_device.logical, m_vpUniformBufferMemory[i]);
   }
 
   for (size_t i = 0; i < MAX_FRAME_DRAWS; i++)
@@ -298,16 +995,44 @@ void vkContext::cleanupContext()
     vkDestroyFence(m_device.logical, m_drawFences[i], nullptr);
   }
 
+  if (VK_NULL_HANDLE != m_statsQueryPool)
+  {
+    vkDestroyQueryPool(m_device.logical, m_statsQueryPool, nullptr);
+  }
+
+  if (VK_NULL_HANDLE != m_timestampPool)
+  {
+    vkDestroyQueryPool(m_device.logical, m_timestampPool, nullptr);
+  }
+
+  destroyMeshletBuffers();
+  if (VK_NULL_HANDLE != m_cullPipeline)
+  {
+    vkDestroyPipeline(m_device.logical, m_cullPipeline, nullptr);
+    vkDestroyPipelineLayout(m_device.logical, m_cullPipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(m_device.logical, m_cullSetLayout, nullptr);
+  }
+
   vkDestroyCommandPool(m_device.logical, m_graphicsCommandPool, nullptr);
   for (auto framebuffer : m_swapChainFrameBuffers)
   {
     vkDestroyFramebuffer(m_device.logical, framebuffer, nullptr);
   }
+  for (auto framebuffer : m_sceneFrameBuffers)
+  {
+    vkDestroyFramebuffer(m_device.logical, framebuffer, nullptr);
+  }
 
+  if (VK_NULL_HANDLE != m_hudPipeline)
+  {
+    vkDestroyPipeline(m_device.logical, m_hudPipeline, nullptr);
+    vkDestroyPipelineLayout(m_device.logical, m_hudPipelineLayout, nullptr);
+  }
   vkDestroyPipeline(m_device.logical, m_secondPipeline, nullptr);
   vkDestroyPipelineLayout(m_device.logical, m_secondPipelineLayout, nullptr);
   vkDestroyPipeline(m_device.logical, m_graphicsPipeline, nullptr);
   vkDestroyPipelineLayout(m_device.logical, m_pipelineLayout, nullptr);
+  if (m_sceneRenderPass != m_renderPass) vkDestroyRenderPass(m_device.logical, m_sceneRenderPass, nullptr);
   vkDestroyRenderPass(m_device.logical, m_renderPass, nullptr);
   for (auto image : m_swapChainImages)
   {
@@ -316,6 +1041,11 @@ void vkContext::cleanupContext()
 
   vkDestroySwapchainKHR(m_device.logical, m_swapchain, nullptr);
   vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+
+  // everything made on the device should be gone by now
+  size_t leaks = reportDeviceMemoryLeaks(std::cerr);
+  if (leaks > 0) std::cerr << "[-] " << leaks << " device memory allocations were not freed" << std::endl;
+
   vkDestroyDevice(m_device.logical, nullptr);
   if(m_useValidation) DestroyDebugUtilsMessengerEXT(m_instance, m_messenger, nullptr);
   vkDestroyInstance(m_instance, nullptr);
@@ -445,6 +1175,7 @@ void vkContext::createDebugMessenger()
  * returns   : void, throws runtime exception if an error happens.
  *
  * written   : Mar 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) enables VK_KHR_multiview when more than one view was asked for and the device has it
 ************************************************************************************************************************/
 void vkContext::createLogicalDevice()
 {
@@ -469,13 +1200,41 @@ void vkContext::createLogicalDevice()
   deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
   deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());		
   deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();								
-  deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());	// Number of enabled logical device extensions
-  deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();							          // List of enabled logical device extensions
+  VkPhysicalDeviceFeatures supportedFeatures;
+  vkGetPhysicalDeviceFeatures(m_device.physical, &supportedFeatures);
+
   VkPhysicalDeviceFeatures deviceFeatures = {};
   deviceFeatures.samplerAnisotropy = true;                                                  // enable anisotropy
+  deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;       // optional, used for per-model statistics
+  m_statsSupported = (VK_TRUE == supportedFeatures.pipelineStatisticsQuery);
 
   deviceCreateInfo.pEnabledFeatures = &deviceFeatures;			
 
+  // multiview (setViews) is VK_KHR_multiview on a 1.0 device, its feature and limit are read through the instance's
+  // properties2 extension, which the context only has along with device UUIDs
+  std::vector<const char*>             extensions = deviceExtensions;
+  VkPhysicalDeviceMultiviewFeaturesKHR multiviewFeatures = {};
+  multiviewFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES_KHR;
+  if (m_viewCount > 1)
+  {
+    uint32_t maxViews = multiviewViewCount();
+    if (maxViews > 1)
+    {
+      m_viewCount = std::min(m_viewCount, maxViews);
+      extensions.push_back(VK_KHR_MULTIVIEW_EXTENSION_NAME);
+      multiviewFeatures.multiview = VK_TRUE;
+      deviceCreateInfo.pNext = &multiviewFeatures;
+      std::cerr << "[+] multiview enabled, drawing " << m_viewCount << " views" << std::endl;
+    }
+    else
+    {
+      std::cerr << "[-] device does not support multiview, drawing one view" << std::endl;
+      m_viewCount = 1;
+    }
+  }
+  deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+  deviceCreateInfo.ppEnabledExtensionNames = extensions.data();
+
   VkResult result = vkCreateDevice(m_device.physical, &deviceCreateInfo, nullptr, &m_device.logical);
   if (result != VK_SUCCESS)
   {
@@ -492,6 +1251,49 @@ void vkContext::createLogicalDevice()
 
 
 
+// the most views the chosen device can draw in one multiview render pass, 0 if it has no multiview
+uint32_t vkContext::multiviewViewCount()
+{
+  PFN_vkGetPhysicalDeviceFeatures2KHR getFeatures2 = nullptr;
+  PFN_vkGetPhysicalDeviceProperties2KHR getProperties2 = nullptr;
+  if (m_deviceIds)
+  {
+    getFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(m_instance, "vkGetPhysicalDeviceFeatures2KHR");
+    getProperties2 = (PFN_vkGetPhysicalDeviceProperties2KHR)vkGetInstanceProcAddr(m_instance, "vkGetPhysicalDeviceProperties2KHR");
+  }
+  if (nullptr == getFeatures2 || nullptr == getProperties2) return 0;
+
+  uint32_t extensionCnt = 0;
+  vkEnumerateDeviceExtensionProperties(m_device.physical, nullptr, &extensionCnt, nullptr);
+  std::vector<VkExtensionProperties> available(extensionCnt);
+  vkEnumerateDeviceExtensionProperties(m_device.physical, nullptr, &extensionCnt, available.data());
+
+  bool hasExtension = false;
+  for (const VkExtensionProperties& ext : available)
+  {
+    hasExtension = hasExtension || (0 == strcmp(VK_KHR_MULTIVIEW_EXTENSION_NAME, ext.extensionName));
+  }
+  if (!hasExtension) return 0;
+
+  VkPhysicalDeviceMultiviewFeaturesKHR multiviewFeatures = {};
+  multiviewFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES_KHR;
+  VkPhysicalDeviceFeatures2KHR features = {};
+  features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+  features.pNext = &multiviewFeatures;
+  getFeatures2(m_device.physical, &features);
+
+  VkPhysicalDeviceMultiviewPropertiesKHR multiviewProperties = {};
+  multiviewProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_PROPERTIES_KHR;
+  VkPhysicalDeviceProperties2KHR properties = {};
+  properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+  properties.pNext = &multiviewProperties;
+  getProperties2(m_device.physical, &properties);
+
+  return (VK_TRUE == multiviewFeatures.multiview) ? multiviewProperties.maxMultiviewViewCount : 0;
+}
+
+
+
 /************************************************************************************************************************
  * function  : createSurface
  *
@@ -543,7 +1345,7 @@ void vkContext::createSwapChain()
 {
   SwapChainDetails swapChainDetails = getSwapChainDetails(m_device.physical);
 
-  VkSurfaceFormatKHR surfaceFormat = chooseBestSurfaceFormat(swapChainDetails.formats);
+  VkSurfaceFormatKHR surfaceFormat = m_surfaceFormat;      // chosen by initContext, the render pass is built with it
   VkPresentModeKHR presentMode = chooseBestPresentationMode(swapChainDetails.presentationModes);
   VkExtent2D extent = chooseSwapExtent(swapChainDetails.surfaceCapabilities);
 
@@ -591,10 +1393,10 @@ void vkContext::createSwapChain()
   VkResult result = vkCreateSwapchainKHR(m_device.logical, &swapChainCreateInfo, nullptr, &m_swapchain);
   if (result == VK_SUCCESS)
   {
-    m_swapChainImageFormat = surfaceFormat.format;
     m_swapChainExtent = extent;
+    m_presentMode = presentMode;
 
-    std::cerr << "[+] successfully created swapchain" << std::endl;
+    std::cerr << "[+] successfully created swapchain (present mode " << presentModeName(presentMode) << ")" << std::endl;
 
     uint32_t swapChainImageCount;
 
@@ -629,150 +1431,89 @@ void vkContext::createSwapChain()
  *             occur on load (image is being loaded) or store (image is being written too memory).  We can also define 
  *             subpasses that are used to inforce temporal constraints - i.e. action 1 must occure befor action 2 starts.
  *
+ *             The frame is described as a render graph and the render pass is derived from it:
+ *               (a) with meshlets, a transfer pass resets the cull buffer from the template and a compute pass culls
+ *                   into it
+ *               (b) the scene pass draws into the colour and depth attachments, reading the cull buffer's commands and
+ *                   indices
+ *               (c) the post pass (and the HUD) reads colour and depth as input attachments and writes the swapchain
+ *             which the graph turns into one render pass of two subpasses (attachments swapchain, colour, depth), the
+ *             dependencies between them and the barriers after the cull passes.  Colour and depth end with the render
+ *             pass, so are not stored and can be transient attachments, see createAttachmentImages.
+ *
+ *             With more than one view (setViews) the scene pass draws every view, into the layers of colour and depth,
+ *             and the post pass samples the colour layers (an input attachment only reads its own view's pixel).  The
+ *             graph then makes two render passes; the scene's, whose colour is stored and depth transient, and the
+ *             post pass's with just the swapchain.
+ *
  * parameters: none
  *
  * returns   : void, thows run time exception on error
  *
  * written   : Mar 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) built from a render graph rather than by hand
+ * modified  : Oct 2026 (GKHuber) a multiview scene render pass for split screen views
 ************************************************************************************************************************/
 void vkContext::createRenderPass()
 {
-  // array of our subpasses
-  std::array<VkSubpassDescription, 2> subpasses{};
-
-  // attachments
-  // subpass 1: attachments & references (input attachments)
-
-  // color attachment
-  VkAttachmentDescription  colorAttachment = {};
-  colorAttachment.format = chooseSupportedFormat({ VK_FORMAT_R8G8B8A8_UNORM }, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);;
-  colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-  colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-  colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-  colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-  colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-  colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-  colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-  //depth attachment
-  VkAttachmentDescription   depthAttachment = {};
+  m_colourFormat = chooseSupportedFormat({ VK_FORMAT_R8G8B8A8_UNORM }, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
   const std::vector<VkFormat> requestedFormats = { VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D32_SFLOAT, VK_FORMAT_D24_UNORM_S8_UINT };
-  depthAttachment.format = chooseSupportedFormat(requestedFormats, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
-  depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-  depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-  depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-  depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-  depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-  depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-  depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-  // REFERENCES
-  // attachment reference (by index) to the attachment list used in renderPassCreateInfo
-  VkAttachmentReference colorAttachmentReference = {};
-  colorAttachmentReference.attachment = 1;
-  colorAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-  VkAttachmentReference depthAttachmentReference = {};
-  depthAttachmentReference.attachment = 2;
-  depthAttachmentReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-  subpasses[0].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-  subpasses[0].colorAttachmentCount = 1;
-  subpasses[0].pColorAttachments = &colorAttachmentReference;
-  subpasses[0].pDepthStencilAttachment = &depthAttachmentReference;
-
-  // subpass 2 - attachments & references
-    // Swapchain colour attachment
-  VkAttachmentDescription swapchainColourAttachment = {};
-  swapchainColourAttachment.format = m_swapChainImageFormat;					// Format to use for attachment
-  swapchainColourAttachment.samples = VK_SAMPLE_COUNT_1_BIT;					// Number of samples to write for multisampling
-  swapchainColourAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;				// Describes what to do with attachment before rendering
-  swapchainColourAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;			// Describes what to do with attachment after rendering
-  swapchainColourAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;	// Describes what to do with stencil before rendering
-  swapchainColourAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;// Describes what to do with stencil after rendering
-
-  // Framebuffer data will be stored as an image, but images can be given different data layouts
-  // to give optimal use for certain operations
-  swapchainColourAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;			// Image data layout before render pass starts
-  swapchainColourAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;		// Image data layout after render pass (to change to)
-
-  // Attachment reference uses an attachment index that refers to index in the attachment list passed to renderPassCreateInfo
-  VkAttachmentReference swapchainColourAttachmentReference = {};
-  swapchainColourAttachmentReference.attachment = 0;
-  swapchainColourAttachmentReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-  // References to attachments that subpass will take input from
-  std::array<VkAttachmentReference, 2> inputReferences;
-  inputReferences[0].attachment = 1;
-  inputReferences[0].layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-  inputReferences[1].attachment = 2;
-  inputReferences[1].layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-  // Set up Subpass 2
-  subpasses[1].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-  subpasses[1].colorAttachmentCount = 1;
-  subpasses[1].pColorAttachments = &swapchainColourAttachmentReference;
-  subpasses[1].inputAttachmentCount = static_cast<uint32_t>(inputReferences.size());
-  subpasses[1].pInputAttachments = inputReferences.data();
-
-
-  // subpass dependencies
-  // Need to determine when layout transitions occur using subpass dependencies
-  std::array<VkSubpassDependency, 3> subpassDependencies;
-
-  // Conversion from VK_IMAGE_LAYOUT_UNDEFINED to VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-  // Transition must happen after...
-  subpassDependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;						// Subpass index (VK_SUBPASS_EXTERNAL = Special value meaning outside of renderpass)
-  subpassDependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;		// Pipeline stage
-  subpassDependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;				// Stage access mask (memory access)
-  // But must happen before...
-  subpassDependencies[0].dstSubpass = 0;
-  subpassDependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-  subpassDependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-  subpassDependencies[0].dependencyFlags = 0;
-
-  // Subpass 1 layout (colour/depth) to Subpass 2 layout (shader read)
-  subpassDependencies[1].srcSubpass = 0;
-  subpassDependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-  subpassDependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-  subpassDependencies[1].dstSubpass = 1;
-  subpassDependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-  subpassDependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-  subpassDependencies[1].dependencyFlags = 0;
-
-  // Conversion from VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL to VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
-  // Transition must happen after...
-  subpassDependencies[2].srcSubpass = 0;
-  subpassDependencies[2].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-  subpassDependencies[2].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;;
-  // But must happen before...
-  subpassDependencies[2].dstSubpass = VK_SUBPASS_EXTERNAL;
-  subpassDependencies[2].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-  subpassDependencies[2].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-  subpassDependencies[2].dependencyFlags = 0;
-
-  std::array<VkAttachmentDescription, 3> renderPassAttachments = { swapchainColourAttachment, colorAttachment, depthAttachment };
-
-  // Create info for Render Pass
-  VkRenderPassCreateInfo renderPassCreateInfo = {};
-  renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-  renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(renderPassAttachments.size());
-  renderPassCreateInfo.pAttachments = renderPassAttachments.data();
-  renderPassCreateInfo.subpassCount = static_cast<uint32_t>(subpasses.size());
-  renderPassCreateInfo.pSubpasses = subpasses.data();
-  renderPassCreateInfo.dependencyCount = static_cast<uint32_t>(subpassDependencies.size());
-  renderPassCreateInfo.pDependencies = subpassDependencies.data();
-
-  VkResult result = vkCreateRenderPass(m_device.logical, &renderPassCreateInfo, nullptr, &m_renderPass);
-  if (VK_SUCCESS == result)
-  {
-    std::cerr << "[+] render pass created" << std::endl;
+  m_depthFormat = chooseSupportedFormat(requestedFormats, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+
+  // attachments in framebuffer order, the order they are added
+  renderGraph& graph = m_renderGraph;
+  m_swapChainResource = graph.importImage("swapchain", m_swapChainImageFormat, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, true);
+  m_colourResource = graph.addImage("colour", m_colourFormat, true);
+  m_depthResource = graph.addImage("depth", m_depthFormat, true);
+
+  uint32_t cullBuffer = renderGraph::npos;
+  if (m_useMeshlets)
+  {
+    uint32_t cullTemplate = graph.importBuffer("cull template");
+    cullBuffer = graph.addBuffer("cull buffer");
+
+    m_cullResetPass = graph.addPass("cull reset", RG_TRANSFER);
+    graph.use(m_cullResetPass, cullTemplate, RG_TRANSFER_READ);
+    graph.use(m_cullResetPass, cullBuffer, RG_TRANSFER_WRITE);
+
+    m_cullPass = graph.addPass("cull", RG_COMPUTE);
+    graph.use(m_cullPass, cullBuffer, RG_STORAGE_READ);
+    graph.use(m_cullPass, cullBuffer, RG_STORAGE_WRITE);
+  }
+
+  uint32_t viewMask = (m_viewCount > 1) ? (1u << m_viewCount) - 1 : 0;
+  m_scenePass = graph.addPass("scene", RG_GRAPHICS, viewMask);
+  graph.use(m_scenePass, m_colourResource, RG_COLOUR_WRITE);
+  graph.use(m_scenePass, m_depthResource, RG_DEPTH_WRITE);
+  if (m_useMeshlets)
+  {
+    graph.use(m_scenePass, cullBuffer, RG_INDIRECT_READ);
+    graph.use(m_scenePass, cullBuffer, RG_INDEX_READ);
+  }
+
+  m_postPass = graph.addPass("post", RG_GRAPHICS);
+  if (0 == viewMask)
+  {
+    graph.use(m_postPass, m_colourResource, RG_INPUT_READ);
+    graph.use(m_postPass, m_depthResource, RG_INPUT_READ);
   }
   else
   {
-    std::cerr << "[-] failed to create render pass" << std::endl;
+    graph.use(m_postPass, m_colourResource, RG_SAMPLED_READ);
+  }
+  graph.use(m_postPass, m_swapChainResource, RG_COLOUR_WRITE);
+
+  graph.compile();
+  size_t expected = (0 == viewMask) ? 1 : 2;
+  if (expected != graph.getRenderPassCount())
+  {
+    std::cerr << "[-] render graph made " << graph.getRenderPassCount() << " render passes, expected " << expected << std::endl;
     throw std::runtime_error("failed to create render pass");
   }
+
+  m_renderPass = graph.createRenderPass(m_device.logical, graph.getRenderPass(m_postPass));
+  m_sceneRenderPass = (0 == viewMask) ? m_renderPass : graph.createRenderPass(m_device.logical, graph.getRenderPass(m_scenePass));
+  std::cerr << "[+] render pass created" << std::endl;
 }
 
 
@@ -787,6 +1528,7 @@ void vkContext::createRenderPass()
  * returns   : void, throws exception on error
  *
  * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) the post-process set samples the colour image's layers with split screen views
 ************************************************************************************************************************/
 void vkContext::createDescriptorSetLayout()
 {
@@ -853,6 +1595,13 @@ void vkContext::createDescriptorSetLayout()
   // Array of input attachment bindings
   std::vector<VkDescriptorSetLayoutBinding> inputBindings = { colourInputLayoutBinding, depthInputLayoutBinding };
 
+  // split screen views; the post-process samples the layers of the colour image, there is no input attachment
+  if (m_viewCount > 1)
+  {
+    colourInputLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    inputBindings = { colourInputLayoutBinding };
+  }
+
   // Create a descriptor set layout for input attachments
   VkDescriptorSetLayoutCreateInfo inputLayoutCreateInfo = {};
   inputLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -915,11 +1664,16 @@ void vkContext::createPushConstantRange()
  *
  * written   : Mar 2024 (GKHuber)
  *             Apr 2024 (GKHuber) add support for depth testing
+ * modified  : Oct 2026 (GKHuber) viewport and scissor are dynamic, the pipelines no longer wait for the swapchain
+ * modified  : Oct 2026 (GKHuber) creates the HUD's pipeline in the second subpass, if the HUD was requested
+ * modified  : Oct 2026 (GKHuber) split screen views use the multiview shaders, the scene pipeline is made for the
+ *                                scene's render pass and the others for the post pass's
 ************************************************************************************************************************/
 void vkContext::createGraphicsPipeline()
 {
-  auto vertexShaderCode = readFile("./Shaders/vert.spv");
-  auto fragmentShaderCode = readFile("./Shaders/frag.spv");
+  bool multiview = m_viewCount > 1;
+  auto vertexShaderCode = readAsset(multiview ? "./Shaders/multiview_vert.spv" : "./Shaders/vert.spv");
+  auto fragmentShaderCode = readAsset("./Shaders/frag.spv");
 
   VkShaderModule vertexShaderModule = createShaderModule(vertexShaderCode);
   VkShaderModule fragmentShaderModule = createShaderModule(fragmentShaderCode);
@@ -977,25 +1731,19 @@ void vkContext::createGraphicsPipeline()
   inputAssembly.primitiveRestartEnable = VK_FALSE;					
 
   // -- VIEWPORT & SCISSOR --
-  VkViewport viewport = {};
-  viewport.x = 0.0f;									                // x start coordinate
-  viewport.y = 0.0f;									                // y start coordinate
-  viewport.width = (float)m_swapChainExtent.width;		// width of viewport
-  viewport.height = (float)m_swapChainExtent.height;	// height of viewport
-  viewport.minDepth = 0.0f;							              // min framebuffer depth
-  viewport.maxDepth = 1.0f;							              // max framebuffer depth
-
-  // Create a scissor info struct
-  VkRect2D scissor = {};
-  scissor.offset = { 0,0 };							
-  scissor.extent = m_swapChainExtent;					
-
+  // both are dynamic (set when recording), so the pipelines can be built before the swapchain and its extent exist
   VkPipelineViewportStateCreateInfo viewportStateCreateInfo = {};
   viewportStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
   viewportStateCreateInfo.viewportCount = 1;
-  viewportStateCreateInfo.pViewports = &viewport;
+  viewportStateCreateInfo.pViewports = nullptr;
   viewportStateCreateInfo.scissorCount = 1;
-  viewportStateCreateInfo.pScissors = &scissor;
+  viewportStateCreateInfo.pScissors = nullptr;
+
+  std::array<VkDynamicState, 2> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+  VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo = {};
+  dynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+  dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+  dynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
 
   // -- RASTERIZER --
   VkPipelineRasterizationStateCreateInfo rasterizerCreateInfo = {};
@@ -1072,14 +1820,14 @@ void vkContext::createGraphicsPipeline()
   pipelineCreateInfo.pVertexInputState = &vertexInputCreateInfo;		// All the fixed function pipeline states
   pipelineCreateInfo.pInputAssemblyState = &inputAssembly;
   pipelineCreateInfo.pViewportState = &viewportStateCreateInfo;
-  pipelineCreateInfo.pDynamicState = nullptr;
+  pipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
   pipelineCreateInfo.pRasterizationState = &rasterizerCreateInfo;
   pipelineCreateInfo.pMultisampleState = &multisamplingCreateInfo;
   pipelineCreateInfo.pColorBlendState = &colorBlendingCreateInfo;
   pipelineCreateInfo.pDepthStencilState = &depthStencilCreateInfo;
   pipelineCreateInfo.layout = m_pipelineLayout;							        // Pipeline Layout pipeline should use
-  pipelineCreateInfo.renderPass = m_renderPass;							        // Render pass description the pipeline is compatible with
-  pipelineCreateInfo.subpass = 0;										                // Subpass of render pass to use with pipeline
+  pipelineCreateInfo.renderPass = m_sceneRenderPass;				        // Render pass description the pipeline is compatible with
+  pipelineCreateInfo.subpass = m_renderGraph.getSubpass(m_scenePass);	  // Subpass of render pass to use with pipeline
   pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;	          // Existing pipeline to derive from...
   pipelineCreateInfo.basePipelineIndex = -1;				                // or index of pipeline being created to derive from (in case creating multiple at once)
 
@@ -1101,8 +1849,8 @@ void vkContext::createGraphicsPipeline()
 
   // CREATE SECOND PASS PIPELINE
   // Second pass shaders
-  auto secondVertexShaderCode = readFile("Shaders/second_vert.spv");
-  auto secondFragmentShaderCode = readFile("Shaders/second_frag.spv");
+  auto secondVertexShaderCode = readAsset("Shaders/second_vert.spv");
+  auto secondFragmentShaderCode = readAsset(multiview ? "Shaders/multiview_post_frag.spv" : "Shaders/second_frag.spv");
 
   // Build shaders
   VkShaderModule secondVertexShaderModule = createShaderModule(secondVertexShaderCode);
@@ -1137,9 +1885,10 @@ void vkContext::createGraphicsPipeline()
     throw std::runtime_error("Failed to create a Pipeline Layout!");
   }
 
+  pipelineCreateInfo.renderPass = m_renderPass;			// the post pass's render pass, the scene's too with one view
   pipelineCreateInfo.pStages = secondShaderStages;	// Update second shader stage list
   pipelineCreateInfo.layout = m_secondPipelineLayout;	// Change pipeline layout for input attachment descriptor sets
-  pipelineCreateInfo.subpass = 1;						// Use second subpass
+  pipelineCreateInfo.subpass = m_renderGraph.getSubpass(m_postPass);	// Use the post-process subpass
 
   // Create second pipeline
   result = vkCreateGraphicsPipelines(m_device.logical, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &m_secondPipeline);
@@ -1151,77 +1900,205 @@ void vkContext::createGraphicsPipeline()
   // Destroy second shader modules
   vkDestroyShaderModule(m_device.logical, secondFragmentShaderModule, nullptr);
   vkDestroyShaderModule(m_device.logical, secondVertexShaderModule, nullptr);
-}
 
+  if (!m_useHud) return;
 
+  // CREATE HUD PIPELINE
+  // a quad per instance (see perfHud.h), blended over the post-processed image at the end of the second subpass
+  auto hudVertexShaderCode = readAsset("Shaders/hud_vert.spv");
+  auto hudFragmentShaderCode = readAsset("Shaders/hud_frag.spv");
 
-/************************************************************************************************************************
- * function : 
- *
- * abstract  :
- *
- * parameters:
- *
- * returns   :
- *
- * written   : May 2024 (GKHuber)
-************************************************************************************************************************/
-void vkContext::createColourBufferImage()
-{
-  // Resize supported format for colour attachment
-  m_colourBufferImage.resize(m_swapChainImages.size());
-  m_colourBufferImageMemory.resize(m_swapChainImages.size());
-  m_colourBufferImageView.resize(m_swapChainImages.size());
+  VkShaderModule hudVertexShaderModule = createShaderModule(hudVertexShaderCode);
+  VkShaderModule hudFragmentShaderModule = createShaderModule(hudFragmentShaderCode);
 
-  // Get supported format for colour attachment
-  VkFormat colourFormat = chooseSupportedFormat(
-    { VK_FORMAT_R8G8B8A8_UNORM },
-    VK_IMAGE_TILING_OPTIMAL,
-    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-  );
+  vertexShaderCreateInfo.module = hudVertexShaderModule;
+  fragmentShaderCreateInfo.module = hudFragmentShaderModule;
 
-  for (size_t i = 0; i < m_swapChainImages.size(); i++)
+  VkPipelineShaderStageCreateInfo hudShaderStages[] = { vertexShaderCreateInfo, fragmentShaderCreateInfo };
+
+  VkVertexInputBindingDescription hudBindingDescription = {};
+  hudBindingDescription.binding = 0;
+  hudBindingDescription.stride = sizeof(hudQuad);
+  hudBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;        // the four corners come from gl_VertexIndex
+
+  std::array<VkVertexInputAttributeDescription, 3> hudAttributeDescription;
+  hudAttributeDescription[0].binding = 0;
+  hudAttributeDescription[0].location = 0;
+  hudAttributeDescription[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+  hudAttributeDescription[0].offset = offsetof(hudQuad, x);
+
+  hudAttributeDescription[1].binding = 0;
+  hudAttributeDescription[1].location = 1;
+  hudAttributeDescription[1].format = VK_FORMAT_R32_UINT;
+  hudAttributeDescription[1].offset = offsetof(hudQuad, glyph);
+
+  hudAttributeDescription[2].binding = 0;
+  hudAttributeDescription[2].location = 2;
+  hudAttributeDescription[2].format = VK_FORMAT_R8G8B8A8_UNORM;
+  hudAttributeDescription[2].offset = offsetof(hudQuad, colour);
+
+  vertexInputCreateInfo.vertexBindingDescriptionCount = 1;
+  vertexInputCreateInfo.pVertexBindingDescriptions = &hudBindingDescription;
+  vertexInputCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(hudAttributeDescription.size());
+  vertexInputCreateInfo.pVertexAttributeDescriptions = hudAttributeDescription.data();
+
+  inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+  rasterizerCreateInfo.cullMode = VK_CULL_MODE_NONE;
+  depthStencilCreateInfo.depthTestEnable = VK_FALSE;
+
+  // the atlas is a texture like any other, and the screen size is pushed so the quads can be in pixels
+  VkPushConstantRange hudPushConstantRange = {};
+  hudPushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+  hudPushConstantRange.offset = 0;
+  hudPushConstantRange.size = 2 * sizeof(float);
+
+  VkPipelineLayoutCreateInfo hudPipelineLayoutCreateInfo = {};
+  hudPipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  hudPipelineLayoutCreateInfo.setLayoutCount = 1;
+  hudPipelineLayoutCreateInfo.pSetLayouts = &m_samplerSetLayout;
+  hudPipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+  hudPipelineLayoutCreateInfo.pPushConstantRanges = &hudPushConstantRange;
+
+  result = vkCreatePipelineLayout(m_device.logical, &hudPipelineLayoutCreateInfo, nullptr, &m_hudPipelineLayout);
+  if (result != VK_SUCCESS)
   {
-    // Create Colour Buffer Image
-    m_colourBufferImage[i] = createImage(m_swapChainExtent.width, m_swapChainExtent.height, colourFormat, VK_IMAGE_TILING_OPTIMAL,
-      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_colourBufferImageMemory[i]);
+    throw std::runtime_error("Failed to create the HUD Pipeline Layout!");
+  }
+
+  pipelineCreateInfo.pStages = hudShaderStages;
+  pipelineCreateInfo.layout = m_hudPipelineLayout;
+  pipelineCreateInfo.subpass = m_renderGraph.getSubpass(m_postPass);
 
-    // Create Colour Buffer Image View
-    m_colourBufferImageView[i] = createImageView(m_colourBufferImage[i], colourFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+  result = vkCreateGraphicsPipelines(m_device.logical, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &m_hudPipeline);
+  if (result != VK_SUCCESS)
+  {
+    throw std::runtime_error("Failed to create the HUD Pipeline!");
   }
+
+  vkDestroyShaderModule(m_device.logical, hudFragmentShaderModule, nullptr);
+  vkDestroyShaderModule(m_device.logical, hudVertexShaderModule, nullptr);
 }
 
 
+
 /************************************************************************************************************************
- * function  : createDepthBufferImage
+ * function  : createAttachmentImages
  *
- * abstract  :
+ * abstract  : Creates the colour and depth attachments of each swapchain image, with the usage the render graph worked
+ *             out for them.  Memory is allocated per alias slot rather than per image: the images of a slot are bound
+ *             to the start of the same block, sized for the largest, so images whose lifetimes within the frame do not
+ *             overlap share memory.  A slot whose images are all transient attachments takes lazily allocated memory
+ *             where the device has it, which tiled GPUs need never back at all.  With split screen views (setViews)
+ *             the images have a layer per view, each the window's height and its width split between the views.
  *
- * parameters:
+ * parameters: none
  *
- * returns   :
+ * returns   : void, throws a runtime exception on error
  *
- * written   : Apr 2024 (GKHuber)
+ * written   : Oct 2026 (GKHuber), replaces createColourBufferImage and createDepthBufferImage
 ************************************************************************************************************************/
-void vkContext::createDepthBufferImage()
+void vkContext::createAttachmentImages()
 {
-  m_depthBufferImage.resize(m_swapChainImages.size());
-  m_depthBufferImageMemory.resize(m_swapChainImages.size());
-  m_depthBufferImageView.resize(m_swapChainImages.size());
+  const renderGraph& graph = m_renderGraph;
+  size_t imageCount = m_swapChainImages.size();
+  uint32_t slotCount = graph.getAliasSlotCount();
 
-  const std::vector<VkFormat> requestedFormats = { VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D32_SFLOAT, VK_FORMAT_D24_UNORM_S8_UINT };
-  VkFormat depthFormat = chooseSupportedFormat(requestedFormats, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+  m_sceneExtent = { m_swapChainExtent.width / m_viewCount, m_swapChainExtent.height };
 
-  for (size_t i = 0; i < m_swapChainImages.size(); i++)
+  m_colourBufferImage.resize(imageCount);
+  m_colourBufferImageView.resize(imageCount);
+  m_depthBufferImage.resize(imageCount);
+  m_depthBufferImageView.resize(imageCount);
+  m_attachmentMemory.assign(imageCount * slotCount, VK_NULL_HANDLE);
+  m_attachmentSlotBytes.assign(slotCount, 0);
+  m_attachmentSlotLazy.assign(slotCount, false);
+
+  VkPhysicalDeviceMemoryProperties memoryProperties;
+  vkGetPhysicalDeviceMemoryProperties(m_device.physical, &memoryProperties);
+
+  struct attachment { uint32_t resource; VkFormat format; VkImage* image; };
+
+  for (size_t i = 0; i < imageCount; i++)
   {
-    m_depthBufferImage[i] = createImage(m_swapChainExtent.width, m_swapChainExtent.height, depthFormat, VK_IMAGE_TILING_OPTIMAL,
-      VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_depthBufferImageMemory[i]);
+    attachment attachments[] = { { m_colourResource, m_colourFormat, &m_colourBufferImage[i] },
+                                 { m_depthResource, m_depthFormat, &m_depthBufferImage[i] } };
+
+    for (const attachment& a : attachments)
+    {
+      VkImageCreateInfo imageCreateInfo = {};
+      imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+      imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+      imageCreateInfo.extent = { m_sceneExtent.width, m_sceneExtent.height, 1 };
+      imageCreateInfo.mipLevels = 1;
+      imageCreateInfo.arrayLayers = m_viewCount;
+      imageCreateInfo.format = a.format;
+      imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+      imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+      imageCreateInfo.usage = graph.getImageUsage(a.resource);
+      imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+      imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+      if (VK_SUCCESS != vkCreateImage(m_device.logical, &imageCreateInfo, nullptr, a.image))
+      {
+        std::cerr << "[-] failed to create attachment image" << std::endl;
+        throw std::runtime_error("Failed to create an Image!");
+      }
+    }
+
+    // what each slot's block must satisfy, for every image in it
+    for (uint32_t slot = 0; slot < slotCount; slot++)
+    {
+      VkMemoryRequirements slotRequirements = {};
+      slotRequirements.memoryTypeBits = ~0u;
+      bool                 transient = true;
+
+      for (const attachment& a : attachments)
+      {
+        if (graph.getAliasSlot(a.resource) != slot) continue;
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(m_device.logical, *a.image, &requirements);
+        slotRequirements.size = std::max(slotRequirements.size, requirements.size);
+        slotRequirements.alignment = std::max(slotRequirements.alignment, requirements.alignment);
+        slotRequirements.memoryTypeBits &= requirements.memoryTypeBits;
+        transient = transient && graph.isTransient(a.resource);
+      }
+      if (0 == slotRequirements.size) continue;
+
+      VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+      for (uint32_t t = 0; transient && t < memoryProperties.memoryTypeCount; t++)
+      {
+        if ((slotRequirements.memoryTypeBits & (1u << t)) &&
+            (memoryProperties.memoryTypes[t].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT))
+        {
+          properties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+          break;
+        }
+      }
+
+      VkDeviceMemory& memory = m_attachmentMemory[i * slotCount + slot];
+      if (0 == slotRequirements.memoryTypeBits ||
+          VK_SUCCESS != allocateDeviceMemory(m_device.physical, m_device.logical, slotRequirements, properties, MEMORY_ATTACHMENT, &memory))
+      {
+        std::cerr << "[-] failed to allocate memory for attachment slot " << slot << std::endl;
+        throw std::runtime_error("Failed to allocate memory for image!");
+      }
+      m_attachmentSlotBytes[slot] = slotRequirements.size;
+      m_attachmentSlotLazy[slot] = 0 != (properties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+    }
+
+    for (const attachment& a : attachments)
+    {
+      vkBindImageMemory(m_device.logical, *a.image, m_attachmentMemory[i * slotCount + graph.getAliasSlot(a.resource)], 0);
+    }
 
-    m_depthBufferImageView[i] = createImageView(m_depthBufferImage[i], depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
+    m_colourBufferImageView[i] = createImageView(m_colourBufferImage[i], m_colourFormat, VK_IMAGE_ASPECT_COLOR_BIT, m_viewCount);
+    m_depthBufferImageView[i] = createImageView(m_depthBufferImage[i], m_depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, m_viewCount);
   }
 }
 
 
+
 /************************************************************************************************************************
  * function  : createFramebuffers 
  *
@@ -1238,33 +2115,59 @@ void vkContext::createDepthBufferImage()
  *                                the drawing part of the pipeline, there is not need to have a separate depth buffer
  *                                per swapchain, the drawing section is 'protected' by a mutex so no change of over 
  *                                writting the image.
+ * modified  : Oct 2026 (GKHuber) attachments in the render graph's order; with split screen views the scene's render
+ *                                pass has framebuffers of its own, the size of a view
 ************************************************************************************************************************/
 void vkContext::createFramebuffers()
 {
+  const renderGraph& graph = m_renderGraph;
+  uint32_t           postRenderPass = graph.getRenderPass(m_postPass);
+  uint32_t           sceneRenderPass = graph.getRenderPass(m_scenePass);
+
   m_swapChainFrameBuffers.resize(m_swapChainImages.size());              // one frame buffer per image
+  if (sceneRenderPass != postRenderPass) m_sceneFrameBuffers.resize(m_swapChainImages.size());
 
   for (size_t i = 0; i < m_swapChainFrameBuffers.size(); i++)
   {
-    std::array<VkImageView, 3> attachments = { m_swapChainImages[i].imageView, m_colourBufferImageView[i], m_depthBufferImageView[i] };
+    bool firstRenderPass = true;
+    for (uint32_t rp : { postRenderPass, sceneRenderPass })
+    {
+      if (!firstRenderPass && sceneRenderPass == postRenderPass) break;       // one render pass, the scene a subpass
+      firstRenderPass = false;
 
-    VkFramebufferCreateInfo fbCreateInfo = {};
-    fbCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    fbCreateInfo.renderPass = m_renderPass;
-    fbCreateInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-    fbCreateInfo.pAttachments = attachments.data();
-    fbCreateInfo.width = m_swapChainExtent.width;
-    fbCreateInfo.height = m_swapChainExtent.height;
-    fbCreateInfo.layers = 1;
+      // the render pass's attachments, in the order the graph gave them
+      std::array<VkImageView, 3> attachments = {};
+      const std::vector<uint32_t>& resources = graph.getAttachments(rp);
+      for (size_t a = 0; a < resources.size() && a < attachments.size(); a++)
+      {
+        if (resources[a] == m_swapChainResource) attachments[a] = m_swapChainImages[i].imageView;
+        else if (resources[a] == m_colourResource) attachments[a] = m_colourBufferImageView[i];
+        else attachments[a] = m_depthBufferImageView[i];
+      }
 
-    VkResult result = vkCreateFramebuffer(m_device.logical, &fbCreateInfo, nullptr, &m_swapChainFrameBuffers[i]);
-    if (result == VK_SUCCESS)
-    {
-      std::cerr << "[+] created " << i + 1 << " framebuffer" << std::endl;
-    }
-    else
-    {
-      std::cerr << "[-] failed to create " << i + 1 << "framebuffer" << std::endl;
-      throw std::runtime_error("failed to create framebuffer");
+      // a multiview render pass's framebuffer has one layer, the views are the attachments' layers
+      VkExtent2D extent = (rp == postRenderPass) ? m_swapChainExtent : m_sceneExtent;
+
+      VkFramebufferCreateInfo fbCreateInfo = {};
+      fbCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+      fbCreateInfo.renderPass = (rp == postRenderPass) ? m_renderPass : m_sceneRenderPass;
+      fbCreateInfo.attachmentCount = static_cast<uint32_t>(std::min(resources.size(), attachments.size()));
+      fbCreateInfo.pAttachments = attachments.data();
+      fbCreateInfo.width = extent.width;
+      fbCreateInfo.height = extent.height;
+      fbCreateInfo.layers = 1;
+
+      VkFramebuffer* framebuffer = (rp == postRenderPass) ? &m_swapChainFrameBuffers[i] : &m_sceneFrameBuffers[i];
+      VkResult result = vkCreateFramebuffer(m_device.logical, &fbCreateInfo, nullptr, framebuffer);
+      if (result == VK_SUCCESS)
+      {
+        std::cerr << "[+] created " << i + 1 << " framebuffer" << std::endl;
+      }
+      else
+      {
+        std::cerr << "[-] failed to create " << i + 1 << "framebuffer" << std::endl;
+        throw std::runtime_error("failed to create framebuffer");
+      }
     }
   }
 }
@@ -1373,43 +2276,292 @@ void vkContext::createSynchronisations()
   fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
   fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-  for (size_t i = 0; i < MAX_FRAME_DRAWS; i++)
+  for (size_t i = 0; i < MAX_FRAME_DRAWS; i++)
+  {
+    if (vkCreateSemaphore(m_device.logical, &semaphoreCreateInfo, nullptr, &m_imageAvailable[i]) != VK_SUCCESS ||
+      vkCreateSemaphore(m_device.logical, &semaphoreCreateInfo, nullptr, &m_renderFinished[i]) != VK_SUCCESS ||
+      vkCreateFence(m_device.logical, &fenceCreateInfo, nullptr, &m_drawFences[i]) != VK_SUCCESS)
+    {
+      throw std::runtime_error("Failed to create a Semaphore and/or Fence!");
+    }
+  }
+}
+
+
+
+void vkContext::createTextureSampler()
+{
+  // Sampler Creation Info
+  VkSamplerCreateInfo samplerCreateInfo = {};
+  samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+  samplerCreateInfo.magFilter = VK_FILTER_LINEAR;						// How to render when image is magnified on screen
+  samplerCreateInfo.minFilter = VK_FILTER_LINEAR;						// How to render when image is minified on screen
+  samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;	// How to handle texture wrap in U (x) direction
+  samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;	// How to handle texture wrap in V (y) direction
+  samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;	// How to handle texture wrap in W (z) direction
+  samplerCreateInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;	// Border beyond texture (only workds for border clamp)
+  samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;				// Whether coords should be normalized (between 0 and 1)
+  samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;		// Mipmap interpolation mode
+  samplerCreateInfo.mipLodBias = 0.0f;								// Level of Details bias for mip level
+  samplerCreateInfo.minLod = 0.0f;									// Minimum Level of Detail to pick mip level
+  samplerCreateInfo.maxLod = 0.0f;									// Maximum Level of Detail to pick mip level
+  samplerCreateInfo.anisotropyEnable = VK_TRUE;						// Enable Anisotropy
+  samplerCreateInfo.maxAnisotropy = 16;								// Anisotropy sample level
+
+  VkResult result = vkCreateSampler(m_device.logical, &samplerCreateInfo, nullptr, &m_textureSampler);
+  if (result != VK_SUCCESS)
+  {
+    throw std::runtime_error("Filed to create a Texture Sampler!");
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createQueryPool
+ *
+ * abstract  : Creates the query pool used to gather pipeline statistics.  Each swapchain image owns a block of
+ *             STATS_QUERIES_PER_IMAGE queries -- one per model (up to MAX_OBJECTS) and a final one for the post-process
+ *             subpass.  Giving each image its own block means that the results of the previous use of an image can be
+ *             read back without stalling on frames that are still in flight.  If the device does not support the
+ *             pipelineStatisticsQuery feature no pool is created and statistics are silently unavailable.
+ *
+ * parameters: void
+ *
+ * returns   : void, throws runtime exception on error
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::createQueryPool()
+{
+  if (!m_statsSupported)
+  {
+    std::cerr << "[-] device does not support pipeline statistics queries" << std::endl;
+    return;
+  }
+
+  uint32_t queryCount = STATS_QUERIES_PER_IMAGE * static_cast<uint32_t>(m_swapChainImages.size());
+
+  VkQueryPoolCreateInfo queryPoolCreateInfo = {};
+  queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  queryPoolCreateInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+  queryPoolCreateInfo.queryCount = queryCount;
+  queryPoolCreateInfo.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |      // results are written in
+                                           VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |      // bit order, this order
+                                           VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |           // must match the unpacking
+                                           VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |            // in collectPipelineStatistics
+                                           VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+  VkResult result = vkCreateQueryPool(m_device.logical, &queryPoolCreateInfo, nullptr, &m_statsQueryPool);
+  if (result != VK_SUCCESS)
+  {
+    throw std::runtime_error("Failed to create pipeline statistics query pool!");
+  }
+
+  m_statsQueriesIssued.assign(m_swapChainImages.size(), 0);
+
+  // room for every value of every query in one image block, plus the availability word per query
+  m_statsResults.resize(STATS_QUERIES_PER_IMAGE * (STATS_VALUES_PER_QUERY + 1));
+
+  std::cerr << "[+] created pipeline statistics query pool (" << queryCount << " queries)" << std::endl;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createCullPipeline
+ *
+ * abstract  : Creates the compute pipeline that culls meshlets (Shaders/cull.comp) and the layout of its descriptor
+ *             set; the meshlet lists, and the indirect commands and index buffer it writes.  The buffers themselves are
+ *             made by updateMeshletBuffers once models have been loaded.  The cull pass is recorded into the same
+ *             command buffer as the render pass, so the graphics queue family has to support compute; if it does not
+ *             the pipeline is not created and meshes are drawn whole.
+ *
+ *             A device with VK_EXT_mesh_shader could cull and emit the meshlets in a task/mesh shader pair instead, the
+ *             meshlets are laid out so that a mesh shader can read them as they are.  That needs a Vulkan 1.1 instance
+ *             and SPIR-V 1.4 shaders though, and this context is Vulkan 1.0, so for now the extension is only reported.
+ *
+ * parameters: void
+ *
+ * returns   : void, throws a runtime error on failure
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::createCullPipeline()
+{
+  queueFamilyIndices indices = getQueueFamilies(m_device.physical, nullptr);
+
+  uint32_t familyCount = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(m_device.physical, &familyCount, nullptr);
+  std::vector<VkQueueFamilyProperties> families(familyCount);
+  vkGetPhysicalDeviceQueueFamilyProperties(m_device.physical, &familyCount, families.data());
+
+  if (0 == (families[indices.graphicsFamily].queueFlags & VK_QUEUE_COMPUTE_BIT))
+  {
+    std::cerr << "[-] graphics queue does not support compute, meshlets will not be culled" << std::endl;
+    return;
+  }
+
+  uint32_t extensionCount = 0;
+  vkEnumerateDeviceExtensionProperties(m_device.physical, nullptr, &extensionCount, nullptr);
+  std::vector<VkExtensionProperties> extensions(extensionCount);
+  vkEnumerateDeviceExtensionProperties(m_device.physical, nullptr, &extensionCount, extensions.data());
+  for (const auto& extension : extensions)
+  {
+    if (0 == strcmp(extension.extensionName, "VK_EXT_mesh_shader"))
+    {
+      std::cerr << "[?] device has VK_EXT_mesh_shader, meshlets are culled by the compute pass (mesh shaders need Vulkan 1.1)" << std::endl;
+    }
+  }
+
+  // meshlets, meshlet vertices, meshlet triangles, culled indices, draw commands
+  std::array<VkDescriptorSetLayoutBinding, 5> bindings = {};
+  for (uint32_t i = 0; i < bindings.size(); i++)
+  {
+    bindings[i].binding = i;
+    bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[i].descriptorCount = 1;
+    bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  }
+
+  VkDescriptorSetLayoutCreateInfo layoutCreateInfo = {};
+  layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+  layoutCreateInfo.pBindings = bindings.data();
+
+  VkResult result = vkCreateDescriptorSetLayout(m_device.logical, &layoutCreateInfo, nullptr, &m_cullSetLayout);
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create meshlet cull descriptor set layout" << std::endl;
+    throw std::runtime_error("failed to create meshlet cull descriptor set layout");
+  }
+
+  VkPushConstantRange pushRange = {};
+  pushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  pushRange.offset = 0;
+  pushRange.size = sizeof(cullConstants);
+
+  VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
+  pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  pipelineLayoutCreateInfo.setLayoutCount = 1;
+  pipelineLayoutCreateInfo.pSetLayouts = &m_cullSetLayout;
+  pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+  pipelineLayoutCreateInfo.pPushConstantRanges = &pushRange;
+
+  result = vkCreatePipelineLayout(m_device.logical, &pipelineLayoutCreateInfo, nullptr, &m_cullPipelineLayout);
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create meshlet cull pipeline layout" << std::endl;
+    throw std::runtime_error("failed to create meshlet cull pipeline layout");
+  }
+
+  auto cullShaderCode = readAsset("./Shaders/cull_comp.spv");
+  VkShaderModule cullShaderModule = createShaderModule(cullShaderCode);
+
+  VkComputePipelineCreateInfo pipelineCreateInfo = {};
+  pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+  pipelineCreateInfo.stage.module = cullShaderModule;
+  pipelineCreateInfo.stage.pName = "main";
+  pipelineCreateInfo.layout = m_cullPipelineLayout;
+
+  result = vkCreateComputePipelines(m_device.logical, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &m_cullPipeline);
+  vkDestroyShaderModule(m_device.logical, cullShaderModule, nullptr);
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create meshlet cull pipeline" << std::endl;
+    throw std::runtime_error("failed to create meshlet cull pipeline");
+  }
+
+  std::cerr << "[+] created meshlet cull pipeline" << std::endl;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createHudResources
+ *
+ * abstract  : Creates what the HUD draws with, its pipeline is made with the others in createGraphicsPipeline;
+ *               (a) the font atlas, uploaded like a texture but not one of the context's textures, with a set of its
+ *                   own from the sampler descriptor pool
+ *               (b) per swapchain image, a host visible buffer of HUD_MAX_QUADS quads that stays mapped, recordHud lays
+ *                   the HUD out straight into it
+ *               (c) a timestamp query pool, HUD_TIMESTAMPS per swapchain image so that, like the pipeline statistics,
+ *                   an image's results can be read back when it next comes round without waiting on the GPU.  If the
+ *                   graphics queue family has no timestamps the pool is not made and the HUD shows CPU times only
+ *
+ * parameters: void
+ *
+ * returns   : void, throws a runtime error on failure
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::createHudResources()
+{
+  std::vector<uint8_t> atlas;
+  uint32_t             width, height;
+  perfHud::buildAtlas(&atlas, &width, &height);
+
+  VkDeviceMemory memory;
+  VkImage        image = uploadTextureImage(atlas.data(), width, height, &memory);
+  m_hudAtlas = gpuImage(m_device.logical, image, memory, createImageView(image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT));
+  m_hudAtlasSet = createTextureDescriptor(m_hudAtlas.getView());
+
+  m_hudQuadBuffer.resize(m_swapChainImages.size());
+  m_hudQuads.resize(m_swapChainImages.size());
+  for (size_t i = 0; i < m_swapChainImages.size(); i++)
   {
-    if (vkCreateSemaphore(m_device.logical, &semaphoreCreateInfo, nullptr, &m_imageAvailable[i]) != VK_SUCCESS ||
-      vkCreateSemaphore(m_device.logical, &semaphoreCreateInfo, nullptr, &m_renderFinished[i]) != VK_SUCCESS ||
-      vkCreateFence(m_device.logical, &fenceCreateInfo, nullptr, &m_drawFences[i]) != VK_SUCCESS)
+    VkBuffer       buffer;
+    VkDeviceMemory bufferMemory;
+    VkDeviceSize   size = HUD_MAX_QUADS * sizeof(hudQuad);
+
+    createBuffer(m_device.physical, m_device.logical, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &buffer, &bufferMemory);
+    m_hudQuadBuffer[i] = gpuBuffer(m_device.logical, buffer, bufferMemory);
+
+    void* data;
+    if (VK_SUCCESS != vkMapMemory(m_device.logical, bufferMemory, 0, size, 0, &data))
     {
-      throw std::runtime_error("Failed to create a Semaphore and/or Fence!");
+      throw std::runtime_error("Failed to map a HUD quad buffer!");
     }
+    m_hudQuads[i] = static_cast<hudQuad*>(data);
   }
-}
 
+  // timestamps are only written on queues whose family has valid bits for them
+  queueFamilyIndices indices = getQueueFamilies(m_device.physical, nullptr);
 
+  uint32_t familyCount = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(m_device.physical, &familyCount, nullptr);
+  std::vector<VkQueueFamilyProperties> families(familyCount);
+  vkGetPhysicalDeviceQueueFamilyProperties(m_device.physical, &familyCount, families.data());
 
-void vkContext::createTextureSampler()
-{
-  // Sampler Creation Info
-  VkSamplerCreateInfo samplerCreateInfo = {};
-  samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-  samplerCreateInfo.magFilter = VK_FILTER_LINEAR;						// How to render when image is magnified on screen
-  samplerCreateInfo.minFilter = VK_FILTER_LINEAR;						// How to render when image is minified on screen
-  samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;	// How to handle texture wrap in U (x) direction
-  samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;	// How to handle texture wrap in V (y) direction
-  samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;	// How to handle texture wrap in W (z) direction
-  samplerCreateInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;	// Border beyond texture (only workds for border clamp)
-  samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;				// Whether coords should be normalized (between 0 and 1)
-  samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;		// Mipmap interpolation mode
-  samplerCreateInfo.mipLodBias = 0.0f;								// Level of Details bias for mip level
-  samplerCreateInfo.minLod = 0.0f;									// Minimum Level of Detail to pick mip level
-  samplerCreateInfo.maxLod = 0.0f;									// Maximum Level of Detail to pick mip level
-  samplerCreateInfo.anisotropyEnable = VK_TRUE;						// Enable Anisotropy
-  samplerCreateInfo.maxAnisotropy = 16;								// Anisotropy sample level
+  uint32_t validBits = families[indices.graphicsFamily].timestampValidBits;
+  if (0 == validBits)
+  {
+    std::cerr << "[-] graphics queue does not support timestamps, the HUD will not show GPU times" << std::endl;
+    return;
+  }
 
-  VkResult result = vkCreateSampler(m_device.logical, &samplerCreateInfo, nullptr, &m_textureSampler);
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(m_device.physical, &properties);
+  m_timestampPeriod = properties.limits.timestampPeriod;
+  m_timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+
+  VkQueryPoolCreateInfo queryPoolCreateInfo = {};
+  queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+  queryPoolCreateInfo.queryCount = HUD_TIMESTAMPS * static_cast<uint32_t>(m_swapChainImages.size());
+
+  VkResult result = vkCreateQueryPool(m_device.logical, &queryPoolCreateInfo, nullptr, &m_timestampPool);
   if (result != VK_SUCCESS)
   {
-    throw std::runtime_error("Filed to create a Texture Sampler!");
+    throw std::runtime_error("Failed to create the timestamp query pool!");
   }
+
+  m_timestampsIssued.assign(m_swapChainImages.size(), 0);
+  std::cerr << "[+] created HUD resources (" << width << " x " << height << " atlas, timestamps every "
+            << m_timestampPeriod << " ns)" << std::endl;
 }
 
 
@@ -1459,6 +2611,8 @@ void vkContext::createUniformBuffers()
  * returns   : void, throws runtime exception on error
  *
  * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) the sampler pool has a set more for the HUD's font atlas
+ * modified  : Oct 2026 (GKHuber) the post-process pool holds samplers with split screen views
 ************************************************************************************************************************/
 void vkContext::createDescriptorPool()
 {
@@ -1486,14 +2640,17 @@ void vkContext::createDescriptorPool()
     throw std::runtime_error("Failed to create a Descriptor Pool!");
   }
 
-  // sampler pool
+  // sampler pool, one set per texture and one for the HUD's font atlas
+  uint32_t samplerSets = m_texturePoolSize + (m_useHud ? 1 : 0);
+
   VkDescriptorPoolSize samplerPoolSize = {};
   samplerPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-  samplerPoolSize.descriptorCount = MAX_OBJECTS;
+  samplerPoolSize.descriptorCount = samplerSets;
 
   VkDescriptorPoolCreateInfo samplerPoolCreateInfo = {};
   samplerPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-  samplerPoolCreateInfo.maxSets = MAX_OBJECTS;
+  samplerPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;      // destroyTexture gives its set back
+  samplerPoolCreateInfo.maxSets = samplerSets;
   samplerPoolCreateInfo.poolSizeCount = 1;
   samplerPoolCreateInfo.pPoolSizes = &samplerPoolSize;
 
@@ -1517,6 +2674,11 @@ void vkContext::createDescriptorPool()
   depthInputPoolSize.descriptorCount = static_cast<uint32_t>(m_depthBufferImageView.size());
 
   std::vector<VkDescriptorPoolSize> inputPoolSizes = { colourInputPoolSize, depthInputPoolSize };
+  if (m_viewCount > 1)
+  {
+    colourInputPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    inputPoolSizes = { colourInputPoolSize };
+  }
 
   // Create input attachment pool
   VkDescriptorPoolCreateInfo inputPoolCreateInfo = {};
@@ -1605,6 +2767,7 @@ void vkContext::createDescriptorSets()
  * returns   :
  *
  * written   : May 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) writes the sampled colour image instead with split screen views
 ************************************************************************************************************************/
 void vkContext::createInputDescriptorSets()
 {
@@ -1666,6 +2829,14 @@ void vkContext::createInputDescriptorSets()
     // List of input descriptor set writes
     std::vector<VkWriteDescriptorSet> setWrites = { colourWrite, depthWrite };
 
+    // split screen views, the colour image's layers are sampled (read with texelFetch, so the sampler does not matter)
+    if (m_viewCount > 1)
+    {
+      colourAttachmentDescriptor.sampler = m_textureSampler;
+      colourWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+      setWrites = { colourWrite };
+    }
+
     // Update descriptor sets
     vkUpdateDescriptorSets(m_device.logical, static_cast<uint32_t>(setWrites.size()), setWrites.data(), 0, nullptr);
   }
@@ -1683,15 +2854,443 @@ void vkContext::createInputDescriptorSets()
  * returns   : void
  *
  * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) with split screen views, each view's view-projection; the views orbit the origin,
+ *                                evenly spaced about the y axis from the camera
 ************************************************************************************************************************/
 void vkContext::updateUniformBuffers(uint32_t imageIndex)
 {
+  for (uint32_t i = 0; i < m_viewCount; i++)
+  {
+    float angle = glm::radians(360.0f * static_cast<float>(i) / static_cast<float>(m_viewCount));
+    m_uboVP.viewProj[i] = m_uboVP.proj * m_uboVP.view * glm::rotate(glm::mat4(1.0f), angle, glm::vec3(0.0f, 1.0f, 0.0f));
+  }
+
   void* data;
   vkMapMemory(m_device.logical, m_vpUniformBufferMemory[imageIndex], 0, sizeof(UboVP), 0, &data);
   memcpy(data, &m_uboVP, sizeof(UboVP));
   vkUnmapMemory(m_device.logical, m_vpUniformBufferMemory[imageIndex]);
+  m_frameCounters.uploadBytes += sizeof(UboVP);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : collectPipelineStatistics
+ *
+ * abstract  : Reads back the pipeline statistics queries that were recorded the last time this swapchain image was
+ *             used.  The read is non-blocking, we ask for the availability word with each query and only update the
+ *             statistics for queries that the GPU has finished with, so a slow GPU just means slightly older numbers.
+ *             Must be called before recordcommands, as recording resets the queries for this image.
+ *
+ * parameters: imageIndex -- [in] the swapchain image whose query block should be read back
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::collectPipelineStatistics(uint32_t imageIndex)
+{
+  if (VK_NULL_HANDLE == m_statsQueryPool) return;
+
+  uint32_t queryCount = m_statsQueriesIssued[imageIndex];
+  if (0 == queryCount) return;
+
+  const VkDeviceSize stride = (STATS_VALUES_PER_QUERY + 1) * sizeof(uint64_t);
+
+  // VK_NOT_READY is expected if some of the queries are still in flight, anything else is an actual failure
+  VkResult result = vkGetQueryPoolResults(m_device.logical, m_statsQueryPool, imageIndex * STATS_QUERIES_PER_IMAGE, queryCount,
+                                          queryCount * stride, m_statsResults.data(), stride,
+                                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+  if (result != VK_SUCCESS && result != VK_NOT_READY) return;
+
+  // the last query in the block is always the post-process pass, the rest are models in order
+  for (uint32_t q = 0; q < queryCount; q++)
+  {
+    const uint64_t* values = &m_statsResults[q * (STATS_VALUES_PER_QUERY + 1)];
+    if (0 == values[STATS_VALUES_PER_QUERY]) continue;              // not available yet
+
+    pipelineStats* pStats = (q == queryCount - 1) ? &m_postPassStats : &m_modelStats[q];
+
+    pStats->inputPrimitives = values[0];
+    pStats->vertexInvocations = values[1];
+    pStats->clippingInvocations = values[2];
+    pStats->clippingPrimitives = values[3];
+    pStats->fragmentInvocations = values[4];
+    pStats->valid = true;
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : collectTimestamps
+ *
+ * abstract  : Reads back the HUD's timestamps from the last time this swapchain image was drawn and turns them into
+ *             the GPU time of each pass; the meshlet cull, the scene subpass, the post-process draw and the HUD itself.
+ *             Like collectPipelineStatistics the read does not wait, if any of the image's timestamps are not there
+ *             yet the previous times are kept.  Must be called before recordcommands resets the queries.
+ *
+ * parameters: imageIndex -- [in] the swapchain image whose timestamps should be read back
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::collectTimestamps(uint32_t imageIndex)
+{
+  if (VK_NULL_HANDLE == m_timestampPool || 0 == m_timestampsIssued[imageIndex]) return;
+
+  const VkDeviceSize stride = 2 * sizeof(uint64_t);
+  VkResult result = vkGetQueryPoolResults(m_device.logical, m_timestampPool, imageIndex * HUD_TIMESTAMPS, HUD_TIMESTAMPS,
+                                          sizeof(m_timestampResults), m_timestampResults, stride,
+                                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+  if (result != VK_SUCCESS && result != VK_NOT_READY) return;
+
+  for (uint32_t t = 0; t < HUD_TIMESTAMPS; t++)
+  {
+    if (0 == m_timestampResults[t * 2 + 1]) return;                 // not available yet
+  }
+
+  // the counter can wrap, so the differences are taken in its valid bits
+  double ticksToMs = m_timestampPeriod / 1.0e6;
+  auto   passMs = [&](uint32_t from) { return ((m_timestampResults[(from + 1) * 2] - m_timestampResults[from * 2]) & m_timestampMask) * ticksToMs; };
+
+  m_hudData.cullMs = passMs(0);
+  m_hudData.sceneMs = passMs(1);
+  m_hudData.postMs = passMs(2);
+  m_hudData.hudGpuMs = passMs(3);
+  m_hudData.gpuValid = true;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : updateMeshletBuffers
+ *
+ * abstract  : (Re)builds the GPU side of meshlet culling after models have been added.  The following are made;
+ *               (a) one device local storage buffer holding every meshlet and its vertex and triangle lists
+ *               (b) an indirect draw command for each mesh (of each model, instances included) that has meshlets, in
+ *                   the order recordcommands flattens the models.  Each command's firstIndex is the start of the mesh's
+ *                   part of the culled index buffer, big enough for all of the mesh's triangles, and its indexCount is
+ *                   0 -- the cull shader adds to it.  These are kept in a host visible template that is copied over the
+ *                   frame's commands before culling
+ *               (c) per swapchain image, a buffer holding the commands followed by the culled indices, and the
+ *                   descriptor set the cull shader uses with it
+ *             Called from draw, the device is waited on first as earlier frames may still be using the old buffers.
+ *
+ * parameters: void
+ *
+ * returns   : void, throws a runtime error on failure
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::updateMeshletBuffers()
+{
+  vkDeviceWaitIdle(m_device.logical);
+  destroyMeshletBuffers();
+  m_meshletsDirty = false;
+
+  std::vector<VkDrawIndexedIndirectCommand> commands;
+  VkDeviceSize indexTotal = 0;
+  for (size_t j = 0; j < m_models.size(); j++)
+  {
+    for (size_t k = 0; k < m_models.hotAt(j).getMeshCount(); k++)
+    {
+      mesh* thisMesh = m_models.hotAt(j).getMesh(k);
+      if (thisMesh->getFirstMeshlet() < 0) continue;
+
+      VkDrawIndexedIndirectCommand command = {};
+      command.instanceCount = 1;
+      command.firstIndex = static_cast<uint32_t>(indexTotal);
+      commands.push_back(command);
+
+      indexTotal += thisMesh->getIndexCount();
+    }
+  }
+
+  m_meshletDrawCount = static_cast<uint32_t>(commands.size());
+  if (commands.empty()) return;
+  if (indexTotal > std::numeric_limits<uint32_t>::max())
+  {
+    throw std::runtime_error("too many indices for the culled index buffer");
+  }
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(m_device.physical, &properties);
+  VkDeviceSize alignment = std::max<VkDeviceSize>(properties.limits.minStorageBufferOffsetAlignment, sizeof(uint32_t));
+  auto alignUp = [alignment](VkDeviceSize size) { return (size + alignment - 1) / alignment * alignment; };
+
+  // (a) the meshlet lists, staged into one buffer
+  m_meshletRanges[0] = 0;
+  m_meshletRanges[1] = alignUp(m_meshlets.size() * sizeof(meshlet));
+  m_meshletRanges[2] = m_meshletRanges[1] + alignUp(m_meshletVertices.size() * sizeof(uint32_t));
+  m_meshletRanges[3] = m_meshletRanges[2] + m_meshletTriangles.size() * sizeof(uint32_t);
+
+  VkBuffer       stagingBuffer;
+  VkDeviceMemory stagingBufferMemory;
+  createBuffer(m_device.physical, m_device.logical, m_meshletRanges[3], VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingBuffer, &stagingBufferMemory);
+
+  void* data;
+  vkMapMemory(m_device.logical, stagingBufferMemory, 0, m_meshletRanges[3], 0, &data);
+  memcpy(static_cast<uint8_t*>(data) + m_meshletRanges[0], m_meshlets.data(), m_meshlets.size() * sizeof(meshlet));
+  memcpy(static_cast<uint8_t*>(data) + m_meshletRanges[1], m_meshletVertices.data(), m_meshletVertices.size() * sizeof(uint32_t));
+  memcpy(static_cast<uint8_t*>(data) + m_meshletRanges[2], m_meshletTriangles.data(), m_meshletTriangles.size() * sizeof(uint32_t));
+  vkUnmapMemory(m_device.logical, stagingBufferMemory);
+
+  createBuffer(m_device.physical, m_device.logical, m_meshletRanges[3], VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_meshletBuffer, &m_meshletBufferMemory);
+  copyBuffer(m_device.logical, m_graphicsQueue, m_graphicsCommandPool, stagingBuffer, m_meshletBuffer, m_meshletRanges[3]);
+
+  vkDestroyBuffer(m_device.logical, stagingBuffer, nullptr);
+  freeDeviceMemory(m_device.logical, stagingBufferMemory);
+
+  // (b) the command template
+  VkDeviceSize commandBytes = commands.size() * sizeof(VkDrawIndexedIndirectCommand);
+  createBuffer(m_device.physical, m_device.logical, commandBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &m_cullCommandTemplate, &m_cullCommandTemplateMemory);
+
+  vkMapMemory(m_device.logical, m_cullCommandTemplateMemory, 0, commandBytes, 0, &data);
+  memcpy(data, commands.data(), (size_t)commandBytes);
+  vkUnmapMemory(m_device.logical, m_cullCommandTemplateMemory);
+  m_frameCounters.uploadBytes += commandBytes;
+
+  // (c) per image commands + culled indices, and the descriptor sets
+  m_cullIndexOffset = alignUp(commandBytes);
+  VkDeviceSize cullBytes = m_cullIndexOffset + indexTotal * sizeof(uint32_t);
+
+  m_cullBuffer.resize(m_swapChainImages.size());
+  m_cullBufferMemory.resize(m_swapChainImages.size());
+  for (size_t i = 0; i < m_swapChainImages.size(); i++)
+  {
+    createBuffer(m_device.physical, m_device.logical, cullBytes,
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_cullBuffer[i], &m_cullBufferMemory[i]);
+  }
+
+  VkDescriptorPoolSize poolSize = {};
+  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  poolSize.descriptorCount = static_cast<uint32_t>(5 * m_swapChainImages.size());
+
+  VkDescriptorPoolCreateInfo poolCreateInfo = {};
+  poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolCreateInfo.maxSets = static_cast<uint32_t>(m_swapChainImages.size());
+  poolCreateInfo.poolSizeCount = 1;
+  poolCreateInfo.pPoolSizes = &poolSize;
+
+  VkResult result = vkCreateDescriptorPool(m_device.logical, &poolCreateInfo, nullptr, &m_cullDescriptorPool);
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to create meshlet cull descriptor pool" << std::endl;
+    throw std::runtime_error("failed to create meshlet cull descriptor pool");
+  }
+
+  std::vector<VkDescriptorSetLayout> setLayouts(m_swapChainImages.size(), m_cullSetLayout);
+
+  VkDescriptorSetAllocateInfo setAllocInfo = {};
+  setAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  setAllocInfo.descriptorPool = m_cullDescriptorPool;
+  setAllocInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+  setAllocInfo.pSetLayouts = setLayouts.data();
+
+  m_cullDescriptorSets.resize(m_swapChainImages.size());
+  result = vkAllocateDescriptorSets(m_device.logical, &setAllocInfo, m_cullDescriptorSets.data());
+  if (result != VK_SUCCESS)
+  {
+    std::cerr << "[-] failed to allocate meshlet cull descriptor sets" << std::endl;
+    throw std::runtime_error("failed to allocate meshlet cull descriptor sets");
+  }
+
+  for (size_t i = 0; i < m_swapChainImages.size(); i++)
+  {
+    std::array<VkDescriptorBufferInfo, 5> bufferInfo = {};
+    bufferInfo[0] = { m_meshletBuffer, m_meshletRanges[0], m_meshletRanges[1] - m_meshletRanges[0] };
+    bufferInfo[1] = { m_meshletBuffer, m_meshletRanges[1], m_meshletRanges[2] - m_meshletRanges[1] };
+    bufferInfo[2] = { m_meshletBuffer, m_meshletRanges[2], m_meshletRanges[3] - m_meshletRanges[2] };
+    bufferInfo[3] = { m_cullBuffer[i], m_cullIndexOffset, cullBytes - m_cullIndexOffset };
+    bufferInfo[4] = { m_cullBuffer[i], 0, commandBytes };
+
+    std::array<VkWriteDescriptorSet, 5> writes = {};
+    for (uint32_t b = 0; b < writes.size(); b++)
+    {
+      writes[b].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+      writes[b].dstSet = m_cullDescriptorSets[i];
+      writes[b].dstBinding = b;
+      writes[b].descriptorCount = 1;
+      writes[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+      writes[b].pBufferInfo = &bufferInfo[b];
+    }
+
+    vkUpdateDescriptorSets(m_device.logical, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+  }
+
+  std::cerr << "[+] meshlet buffers built, " << m_meshlets.size() << " meshlets in " << m_meshletDrawCount << " draws" << std::endl;
+}
+
+
+
+// frees everything updateMeshletBuffers made, the device must be idle
+void vkContext::destroyMeshletBuffers()
+{
+  if (VK_NULL_HANDLE != m_cullDescriptorPool)
+  {
+    vkDestroyDescriptorPool(m_device.logical, m_cullDescriptorPool, nullptr);
+    m_cullDescriptorPool = VK_NULL_HANDLE;
+  }
+  m_cullDescriptorSets.clear();
+
+  for (size_t i = 0; i < m_cullBuffer.size(); i++)
+  {
+    vkDestroyBuffer(m_device.logical, m_cullBuffer[i], nullptr);
+    freeDeviceMemory(m_device.logical, m_cullBufferMemory[i]);
+  }
+  m_cullBuffer.clear();
+  m_cullBufferMemory.clear();
+
+  if (VK_NULL_HANDLE != m_cullCommandTemplate)
+  {
+    vkDestroyBuffer(m_device.logical, m_cullCommandTemplate, nullptr);
+    freeDeviceMemory(m_device.logical, m_cullCommandTemplateMemory);
+    m_cullCommandTemplate = VK_NULL_HANDLE;
+  }
+
+  if (VK_NULL_HANDLE != m_meshletBuffer)
+  {
+    vkDestroyBuffer(m_device.logical, m_meshletBuffer, nullptr);
+    freeDeviceMemory(m_device.logical, m_meshletBufferMemory);
+    m_meshletBuffer = VK_NULL_HANDLE;
+  }
+}
+
+
+
+/************************************************************************************************************************
+ * function  : recordCulling
+ *
+ * abstract  : Records the meshlet cull pass, ahead of the render pass.  The draw commands are reset from the template,
+ *             then one workgroup is dispatched per meshlet of each culled draw.  The frustum planes are taken from the
+ *             model's MVP matrix (Gribb/Hartmann, with Vulkan's 0..1 depth) and the camera is moved into model space,
+ *             so the meshlet bounds are used as they are whatever the model's transform.  The barriers after the
+ *             copy and the dispatches are the render graph's (see createRenderPass).
+ *
+ * parameters: imageIndex -- [in] swapchain image being recorded
+ *             drawList -- [in] the frame's flattened draw list
+ *             drawCount -- [in] number of entries in drawList
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::recordCulling(uint32_t imageIndex, const drawItem* drawList, size_t drawCount)
+{
+  if (0 == m_meshletDrawCount || m_cullBuffer.empty()) return;
+
+  VkCommandBuffer commandBuffer = m_commandbuffers[imageIndex];
+
+  VkBufferCopy region = {};
+  region.size = m_meshletDrawCount * sizeof(VkDrawIndexedIndirectCommand);
+  vkCmdCopyBuffer(commandBuffer, m_cullCommandTemplate, m_cullBuffer[imageIndex], 1, &region);
+
+  m_renderGraph.recordBarriers(commandBuffer, m_cullResetPass);
+
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipeline);
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipelineLayout, 0, 1,
+    &m_cullDescriptorSets[imageIndex], 0, nullptr);
+  m_frameCounters.pipelineBinds++;
+  m_frameCounters.descriptorBinds++;
+
+  glm::vec4     cameraPosition = glm::inverse(m_uboVP.view)[3];
+  cullConstants constants = {};
+  uint32_t      currentModel = std::numeric_limits<uint32_t>::max();
+
+  for (size_t d = 0; d < drawCount; d++)
+  {
+    const drawItem& item = drawList[d];
+    if (item.firstMeshlet < 0) continue;
+
+    if (item.modelId != currentModel)
+    {
+      currentModel = item.modelId;
+
+      frustumPlanes(m_transforms.getMVP(currentModel), constants.planes);
+      constants.camera = glm::inverse(m_transforms.getModel(currentModel)) * cameraPosition;
+    }
+
+    constants.firstMeshlet = static_cast<uint32_t>(item.firstMeshlet);
+    constants.meshletCount = item.meshletCount;
+    constants.command = item.command;
+    vkCmdPushConstants(commandBuffer, m_cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(cullConstants), &constants);
+    m_frameCounters.pushConstantBytes += sizeof(cullConstants);
+
+    // one workgroup per meshlet, folded into y when there are more than a dispatch's x can take
+    uint32_t groupsX = std::min<uint32_t>(item.meshletCount, 65535);
+    vkCmdDispatch(commandBuffer, groupsX, (item.meshletCount + groupsX - 1) / groupsX, 1);
+  }
+
+  m_renderGraph.recordBarriers(commandBuffer, m_cullPass);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : recordHud
+ *
+ * abstract  : Lays the HUD out into this image's quad buffer and records its draw, one instanced triangle strip for
+ *             every quad.  The buffer is host coherent and was last read by this image's previous submit, which has
+ *             finished by the time the image is recorded again.  The time this takes is shown on the HUD next frame.
+ *
+ * parameters: imageIndex -- [in] swapchain image being recorded, inside the second subpass
+ *
+ * returns   : void
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+void vkContext::recordHud(uint32_t imageIndex)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  getDeviceMemoryInUse(&m_hudData.memoryBytes, &m_hudData.memoryAllocations);
+  m_hudData.frame = m_frameStats.latest();                       // this frame's are still being counted
+  uint32_t quadCount = static_cast<uint32_t>(m_hud.build(m_hudData, m_hudQuads[imageIndex], HUD_MAX_QUADS));
+
+  VkCommandBuffer commandBuffer = m_commandbuffers[imageIndex];
+  VkBuffer        quadBuffer = m_hudQuadBuffer[imageIndex].get();
+  VkDeviceSize    offset = 0;
+  float           screen[2] = { (float)m_swapChainExtent.width, (float)m_swapChainExtent.height };
+
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_hudPipeline);
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_hudPipelineLayout, 0, 1, &m_hudAtlasSet, 0, nullptr);
+  vkCmdBindVertexBuffers(commandBuffer, 0, 1, &quadBuffer, &offset);
+  vkCmdPushConstants(commandBuffer, m_hudPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(screen), screen);
+  vkCmdDraw(commandBuffer, 4, quadCount, 0, 0);
+
+  m_frameCounters.pipelineBinds++;
+  m_frameCounters.descriptorBinds++;
+  m_frameCounters.vertexBufferBinds++;
+  m_frameCounters.pushConstantBytes += sizeof(screen);
+  m_frameCounters.drawCalls++;
+  m_frameCounters.uploadBytes += quadCount * sizeof(hudQuad);
+
+  m_hudData.hudCpuMs = elapsedMs(start, std::chrono::steady_clock::now());
+}
+
+// the clear value of each of a render pass's attachments, in the order the render graph gave them
+void vkContext::clearRenderPass(uint32_t renderPass, std::array<VkClearValue, 3>& clearValues, VkRenderPassBeginInfo& beginInfo)
+{
+  const std::vector<uint32_t>& resources = m_renderGraph.getAttachments(renderPass);
+  for (size_t a = 0; a < resources.size() && a < clearValues.size(); a++)
+  {
+    if (resources[a] == m_swapChainResource) clearValues[a].color = { 0.0f, 0.0f, 0.0, 1.0f };
+    else if (resources[a] == m_colourResource) clearValues[a].color = { 0.6f, 0.65f, 0.4f, 1.0f };
+    else clearValues[a].depthStencil = { 1.0f, 0 };
+  }
+
+  beginInfo.pClearValues = clearValues.data();
+  beginInfo.clearValueCount = static_cast<uint32_t>(std::min(resources.size(), clearValues.size()));
 }
 
+
+
 /************************************************************************************************************************
  * function  : recordCommands
  *
@@ -1705,7 +3304,20 @@ void vkContext::updateUniformBuffers(uint32_t imageIndex)
  *
  * written   : Mar 2024 (GKHuber)
  *           : modified Apr2024 to support index buffers and resource buffering.
- *           : modified Apr2024 to support descriptor sets, depth testing 
+ *           : modified Apr2024 to support descriptor sets, depth testing
+ *           : modified Oct2026 to optionally wrap each model (and the second pass) in a pipeline statistics query
+ *           : modified Oct2026 no longer copies each MeshModel, the draws are flattened into a list in the frame
+ *                      arena so recording makes no heap allocations.  Sampler descriptor sets are only re-bound when the
+ *                      texture changes.
+ *           : modified Oct2026 pushes the pre-multiplied MVP from the transform store rather than the model matrix
+ *           : modified Oct2026 meshes with meshlets are culled by a compute pass first and drawn indirectly from the
+ *                      culled index buffer
+ *           : modified Oct2026 appends the draws the geometry streams chose for the frame
+ *           : modified Oct2026 writes the HUD's timestamps, and draws the HUD at the end of the second subpass
+ *           : modified Oct2026 counts draws, binds and push constant bytes into the frame's statistics
+ *           : modified Oct2026 clear values in the render graph's attachment order.  With split screen views the scene
+ *                      is its own (multiview) render pass the size of one view, and the model matrix is pushed rather
+ *                      than the MVP since each view has its own view-projection
 ************************************************************************************************************************/
 void vkContext::recordcommands(uint32_t currentImage)
 {
@@ -1713,22 +3325,20 @@ void vkContext::recordcommands(uint32_t currentImage)
   VkCommandBufferBeginInfo bufferBeginInfo = {};
   bufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
+  // with split screen views the scene and post-processing are separate render passes, otherwise subpasses of one
+  bool multiview = (m_sceneRenderPass != m_renderPass);
+
   // Information about how to begin a render pass (only needed for graphical applications)
   VkRenderPassBeginInfo renderPassBeginInfo = {};
   renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-  renderPassBeginInfo.renderPass = m_renderPass;							// Render Pass to begin
+  renderPassBeginInfo.renderPass = m_sceneRenderPass;						// Render Pass to begin
   renderPassBeginInfo.renderArea.offset = { 0, 0 };						// Start point of render pass in pixels
-  renderPassBeginInfo.renderArea.extent = m_swapChainExtent;				// Size of region to run render pass on (starting at offset)
+  renderPassBeginInfo.renderArea.extent = m_sceneExtent;					// Size of region to run render pass on (starting at offset)
 
   std::array<VkClearValue, 3> clearValues = {};
-  clearValues[0].color = { 0.0f, 0.0f, 0.0, 1.0f };
-  clearValues[1].color = { 0.6f, 0.65f, 0.4f, 1.0f };
-  clearValues[2].depthStencil.depth = 1.0f;
- 
-  renderPassBeginInfo.pClearValues = clearValues.data();							// List of clear values (TODO: Depth Attachment Clear Value)
-  renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+  clearRenderPass(m_renderGraph.getRenderPass(m_scenePass), clearValues, renderPassBeginInfo);
 
-  renderPassBeginInfo.framebuffer = m_swapChainFrameBuffers[currentImage];
+  renderPassBeginInfo.framebuffer = multiview ? m_sceneFrameBuffers[currentImage] : m_swapChainFrameBuffers[currentImage];
 
   // Start recording commands to command buffer!
   VkResult result = vkBeginCommandBuffer(m_commandbuffers[currentImage], &bufferBeginInfo);
@@ -1737,48 +3347,209 @@ void vkContext::recordcommands(uint32_t currentImage)
     throw std::runtime_error("Failed to start recording a Command Buffer!");
   }
 
+  // Pipeline statistics, one query per model (up to MAX_OBJECTS) plus one for the second pass.  Queries have to be
+  // reset outside of a render pass, so reset this image's block before we begin.
+  bool     useStats = m_useStats && (VK_NULL_HANDLE != m_statsQueryPool);
+  uint32_t firstQuery = currentImage * STATS_QUERIES_PER_IMAGE;
+  uint32_t modelQueries = useStats ? static_cast<uint32_t>(std::min<size_t>(m_models.size(), MAX_OBJECTS)) : 0;
+
+  if (useStats)
+  {
+    vkCmdResetQueryPool(m_commandbuffers[currentImage], m_statsQueryPool, firstQuery, STATS_QUERIES_PER_IMAGE);
+  }
+  if (VK_NULL_HANDLE != m_statsQueryPool)
+  {
+    m_statsQueriesIssued[currentImage] = useStats ? modelQueries + 1 : 0;
+  }
+
+  // the HUD's timestamps; the start, after culling, after the scene, after post-processing and after the HUD
+  bool     useTimestamps = m_useHud && (VK_NULL_HANDLE != m_timestampPool);
+  uint32_t firstTimestamp = currentImage * HUD_TIMESTAMPS;
+  if (useTimestamps)
+  {
+    vkCmdResetQueryPool(m_commandbuffers[currentImage], m_timestampPool, firstTimestamp, HUD_TIMESTAMPS);
+    vkCmdWriteTimestamp(m_commandbuffers[currentImage], VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_timestampPool, firstTimestamp);
+    m_timestampsIssued[currentImage] = HUD_TIMESTAMPS;
+  }
+
+  // flatten the models into a draw list in this frame's arena (sized by createMeshModel, so this never fails in practice)
+  drawItem* drawList = m_frameArena[m_currentFrame].allocArray<drawItem>(m_totalMeshCount + m_streamDrawCapacity);
+  if (nullptr == drawList && m_totalMeshCount + m_streamDrawCapacity > 0)
+  {
+    throw std::runtime_error("frame arena too small for the draw list");
+  }
+
+  size_t   drawCount = 0;
+  uint32_t cullCommand = 0;
+  VkDescriptorSet defaultSet = *m_textures.getHot(m_defaultTexture);
+  for (size_t j = 0; j < m_models.size(); j++)
+  {
+    MeshModel& thisModel = m_models.hotAt(j);
+
+    for (size_t k = 0; k < thisModel.getMeshCount(); k++)
+    {
+      mesh* thisMesh = thisModel.getMesh(k);
+
+      drawItem& item = drawList[drawCount++];
+      item.vertexBuffer = thisMesh->getVertexBuffer();
+      item.indexBuffer = thisMesh->getIndexBuffer();
+      item.indexCount = static_cast<uint32_t>(thisMesh->getIndexCount());
+      item.textureSet = textureSet(thisMesh->getTexture(), defaultSet);
+      item.modelId = static_cast<uint32_t>(j);
+      item.firstMeshlet = (cullCommand < m_meshletDrawCount) ? thisMesh->getFirstMeshlet() : -1;
+      item.meshletCount = static_cast<uint32_t>(thisMesh->getMeshletCount());
+      item.command = (item.firstMeshlet >= 0) ? cullCommand++ : 0;
+    }
+  }
+
+  // streamed models, whatever their streams chose this frame (full chunks or proxies), never meshlet culled
+  for (size_t s = 0; s < m_streams.size(); s++)
+  {
+    for (size_t k = 0; k < m_streams[s]->getDrawCount(); k++)
+    {
+      mesh* thisMesh = m_streams[s]->getDraw(k);
+
+      drawItem& item = drawList[drawCount++];
+      item.vertexBuffer = thisMesh->getVertexBuffer();
+      item.indexBuffer = thisMesh->getIndexBuffer();
+      item.indexCount = static_cast<uint32_t>(thisMesh->getIndexCount());
+      item.textureSet = textureSet(thisMesh->getTexture(), defaultSet);
+      item.modelId = m_streamModel[s];
+      item.firstMeshlet = -1;
+      item.meshletCount = 0;
+      item.command = 0;
+    }
+  }
+
+  // meshlet culling is a compute pass, so has to be recorded before the render pass begins
+  recordCulling(currentImage, drawList, drawCount);
+  if (useTimestamps) vkCmdWriteTimestamp(m_commandbuffers[currentImage], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, firstTimestamp + 1);
+
   // Begin Render Pass
   vkCmdBeginRenderPass(m_commandbuffers[currentImage], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
   // Bind Pipeline to be used in render pass
   vkCmdBindPipeline(m_commandbuffers[currentImage], VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline);
+  m_frameCounters.pipelineBinds++;
 
-  for (size_t j = 0; j < m_modelList.size(); j++)
-  {
-    MeshModel thisModel = m_modelList[j];
+  // viewport and scissor are dynamic in both pipelines, so set once they hold for the second subpass too
+  VkViewport viewport = { 0.0f, 0.0f, (float)m_sceneExtent.width, (float)m_sceneExtent.height, 0.0f, 1.0f };
+  VkRect2D   scissor = { { 0, 0 }, m_sceneExtent };
+  vkCmdSetViewport(m_commandbuffers[currentImage], 0, 1, &viewport);
+  vkCmdSetScissor(m_commandbuffers[currentImage], 0, 1, &scissor);
 
-    glm::mat4 model = thisModel.getModel();
+  // the first set (view-projection) is the same for every draw, the second (texture) changes with the mesh
+  VkDescriptorSet descriptorSetGroup[2] = { m_descriptorSets[currentImage], VK_NULL_HANDLE };
+  uint32_t        currentModel = std::numeric_limits<uint32_t>::max();
+  frameStats&     counters = m_frameCounters;
 
-    vkCmdPushConstants(m_commandbuffers[currentImage], m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
-                       sizeof(Model), &model);
+  for (size_t d = 0; d < drawCount; d++)
+  {
+    const drawItem& item = drawList[d];
 
-    for (size_t k = 0; k < thisModel.getMeshCount(); k++)
+    if (item.modelId != currentModel)
     {
-      VkBuffer vertexBuffers[] = { thisModel.getMesh(k)->getVertexBuffer() };					// Buffers to bind
-      VkDeviceSize offsets[] = { 0 };												// Offsets into buffers being bound
-      vkCmdBindVertexBuffers(m_commandbuffers[currentImage], 0, 1, vertexBuffers, offsets);	// Command to bind vertex buffer before drawing with them
+      if (currentModel < modelQueries)
+      {
+        vkCmdEndQuery(m_commandbuffers[currentImage], m_statsQueryPool, firstQuery + currentModel);
+      }
+
+      currentModel = item.modelId;
+      if (currentModel < modelQueries)
+      {
+        vkCmdBeginQuery(m_commandbuffers[currentImage], m_statsQueryPool, firstQuery + currentModel, 0);
+      }
 
-      // Bind mesh index buffer, with 0 offset and using the uint32 type
-      vkCmdBindIndexBuffer(m_commandbuffers[currentImage], thisModel.getMesh(k)->getIndexBuffer(), 0, VK_INDEX_TYPE_UINT32);
+      const glm::mat4& mvp = multiview ? m_transforms.getModel(currentModel) : m_transforms.getMVP(currentModel);
+      vkCmdPushConstants(m_commandbuffers[currentImage], m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                         sizeof(Model), &mvp);
+      counters.pushConstantBytes += sizeof(Model);
+    }
 
+    VkDeviceSize offsets[] = { 0 };												// Offsets into buffers being bound
+    vkCmdBindVertexBuffers(m_commandbuffers[currentImage], 0, 1, &item.vertexBuffer, offsets);	// Command to bind vertex buffer before drawing with them
+    counters.vertexBufferBinds++;
 
-      std::array<VkDescriptorSet, 2> descriptorSetGroup = { m_descriptorSets[currentImage], m_samplerDescriptorSets[thisModel.getMesh(k)->getTexId()] };
+    // Bind mesh index buffer, with 0 offset and using the uint32 type, or the culled indices written by recordCulling
+    if (item.firstMeshlet >= 0)
+    {
+      vkCmdBindIndexBuffer(m_commandbuffers[currentImage], m_cullBuffer[currentImage], m_cullIndexOffset, VK_INDEX_TYPE_UINT32);
+    }
+    else
+    {
+      vkCmdBindIndexBuffer(m_commandbuffers[currentImage], item.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    }
+    counters.indexBufferBinds++;
 
-      // Bind Descriptor Sets
+    // Bind Descriptor Sets, only when the texture changes
+    if (item.textureSet != descriptorSetGroup[1])
+    {
+      descriptorSetGroup[1] = item.textureSet;
       vkCmdBindDescriptorSets(m_commandbuffers[currentImage], VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout,
-        0, static_cast<uint32_t>(descriptorSetGroup.size()), descriptorSetGroup.data(), 0, nullptr);
+        0, 2, descriptorSetGroup, 0, nullptr);
+      counters.descriptorBinds++;
+    }
 
-      // Execute pipeline
-      vkCmdDrawIndexed(m_commandbuffers[currentImage], thisModel.getMesh(k)->getIndexCount(), 1, 0, 0, 0);
+    // Execute pipeline
+    if (item.firstMeshlet >= 0)
+    {
+      vkCmdDrawIndexedIndirect(m_commandbuffers[currentImage], m_cullBuffer[currentImage],
+        item.command * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+    }
+    else
+    {
+      vkCmdDrawIndexed(m_commandbuffers[currentImage], item.indexCount, 1, 0, 0, 0);
     }
+    counters.drawCalls++;
+    counters.triangles += item.indexCount / 3;
+  }
+
+  if (currentModel < modelQueries)
+  {
+    vkCmdEndQuery(m_commandbuffers[currentImage], m_statsQueryPool, firstQuery + currentModel);
   }
 
   // start second pass
-    vkCmdNextSubpass(m_commandbuffers[currentImage], VK_SUBPASS_CONTENTS_INLINE);
+    if (multiview)
+    {
+      // the views are sampled, so the scene's render pass has to end; the graph's external dependency covers it.  The
+      // timestamp goes after it, in a multiview render pass it would take a query per view
+      vkCmdEndRenderPass(m_commandbuffers[currentImage]);
+      if (useTimestamps) vkCmdWriteTimestamp(m_commandbuffers[currentImage], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, firstTimestamp + 2);
+
+      renderPassBeginInfo.renderPass = m_renderPass;
+      renderPassBeginInfo.renderArea.extent = m_swapChainExtent;
+      renderPassBeginInfo.framebuffer = m_swapChainFrameBuffers[currentImage];
+      clearRenderPass(m_renderGraph.getRenderPass(m_postPass), clearValues, renderPassBeginInfo);
+      vkCmdBeginRenderPass(m_commandbuffers[currentImage], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+      viewport = { 0.0f, 0.0f, (float)m_swapChainExtent.width, (float)m_swapChainExtent.height, 0.0f, 1.0f };
+      scissor = { { 0, 0 }, m_swapChainExtent };
+      vkCmdSetViewport(m_commandbuffers[currentImage], 0, 1, &viewport);
+      vkCmdSetScissor(m_commandbuffers[currentImage], 0, 1, &scissor);
+    }
+    else
+    {
+      if (useTimestamps) vkCmdWriteTimestamp(m_commandbuffers[currentImage], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, firstTimestamp + 2);
+      vkCmdNextSubpass(m_commandbuffers[currentImage], VK_SUBPASS_CONTENTS_INLINE);
+    }
+    if (useStats) vkCmdBeginQuery(m_commandbuffers[currentImage], m_statsQueryPool, firstQuery + modelQueries, 0);
     vkCmdBindPipeline(m_commandbuffers[currentImage], VK_PIPELINE_BIND_POINT_GRAPHICS, m_secondPipeline);
     vkCmdBindDescriptorSets(m_commandbuffers[currentImage], VK_PIPELINE_BIND_POINT_GRAPHICS, m_secondPipelineLayout,
       0, 1, &m_inputDescriptorSets[currentImage], 0, nullptr);
     vkCmdDraw(m_commandbuffers[currentImage], 3, 1, 0, 0);
+    counters.pipelineBinds++;
+    counters.descriptorBinds++;
+    counters.drawCalls++;
+    if (useStats) vkCmdEndQuery(m_commandbuffers[currentImage], m_statsQueryPool, firstQuery + modelQueries);
+
+  // the HUD goes over the post-processed image, in the same subpass
+  if (m_useHud)
+  {
+    if (useTimestamps) vkCmdWriteTimestamp(m_commandbuffers[currentImage], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, firstTimestamp + 3);
+    recordHud(currentImage);
+    if (useTimestamps) vkCmdWriteTimestamp(m_commandbuffers[currentImage], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, firstTimestamp + 4);
+  }
 
   // End Render Pass
   vkCmdEndRenderPass(m_commandbuffers[currentImage]);
@@ -1804,6 +3575,8 @@ void vkContext::recordcommands(uint32_t currentImage)
  *               (a) enumerates all physical devices this instance of Vulkan can see (depends on m_instance)
  *               (b) build a buffer of VkPhysicalDevices (an opaque pointer to the device)
  *               (c) iterates over all devices looking for an acceptable device 
+ *               (d) scores the acceptable devices and uses the best, or the one named by the override (see
+ *                   setDeviceOverride), logging each score and why the device was chosen
  *
  * parameters: none
  *
@@ -1811,6 +3584,7 @@ void vkContext::recordcommands(uint32_t currentImage)
  *
  * written   : Mar 2024 (GKHuber)
  * modified  : Apr 2024 (GKHuber) added code to get the minimum offset for use with dynamic uniform buffers
+ * modified  : Oct 2026 (GKHuber) devices are scored instead of taking the first suitable one
 ************************************************************************************************************************/
 void vkContext::getPhysicalDevice()
 {
@@ -1826,23 +3600,28 @@ void vkContext::getPhysicalDevice()
   std::vector<VkPhysicalDevice> deviceList(deviceCnt);
   vkEnumeratePhysicalDevices(m_instance, &deviceCnt, deviceList.data());
 
-  for (const auto &device : deviceList)
+  std::vector<deviceCandidate> candidates(deviceCnt);
+  for (size_t ndx = 0; ndx < deviceList.size(); ndx++)
   {
-    if (checkDeviceSuitable(device))
-    {
-      m_device.physical = device;
-      break;
-    }
+    describeDevice(m_instance, deviceList[ndx], m_deviceIds, &candidates[ndx]);
+    candidates[ndx].suitable = checkDeviceSuitable(deviceList[ndx]);
+
+    deviceScore score = scoreDevice(candidates[ndx]);
+    std::cerr << "[?] device " << ndx << ": " << candidates[ndx].properties.deviceName;
+    if (candidates[ndx].hasUuid) std::cerr << " {" << formatUuid(candidates[ndx].uuid) << "}";
+    std::cerr << ", score " << score.score << " (" << score.reason << ")" << std::endl;
   }
 
-  if (m_device.physical == nullptr)
+  std::string reason;
+  int chosen = selectDevice(candidates, getDeviceOverride(m_deviceOverride), &reason);
+  if (chosen < 0)
   {
     std::cout << "[-] no suitable physical device found" << std::endl;
     throw std::runtime_error("No suitalbe physical device found");
   }
 
-  VkPhysicalDeviceProperties        deviceProperties;
-  vkGetPhysicalDeviceProperties(m_device.physical, &deviceProperties);
+  m_device.physical = deviceList[chosen];
+  std::cerr << "[+] using device " << chosen << ": " << candidates[chosen].properties.deviceName << " (" << reason << ")" << std::endl;
 }
 
 
@@ -2232,8 +4011,13 @@ VkSurfaceFormatKHR vkContext::chooseBestSurfaceFormat(const std::vector<VkSurfac
 /************************************************************************************************************************
  * function  : chooseBestPresentationMode
  *
- * abstract  : attempts to choose the best presentation mode to use,  if we find 'VK_PRESENT_MODE_MAILBOX_KHR' use it 
- *             otherwise use VK_PRESENT_MODE_FIFO_KHR (which compliant Vulkan implementations must support)
+ * abstract  : chooses the presentation mode that matches the requested presentation policy (m_presentPolicy).  If the
+ *             requested mode is not supported we fall back in order of preference;
+ *               PRESENT_LOW_LATENCY   : IMMEDIATE -> MAILBOX -> FIFO
+ *               PRESENT_MAILBOX       : MAILBOX -> FIFO
+ *               PRESENT_VSYNC_RELAXED : FIFO_RELAXED -> FIFO
+ *               PRESENT_VSYNC         : FIFO
+ *             VK_PRESENT_MODE_FIFO_KHR is the final fallback as compliant Vulkan implementations must support it.
  *
  * parameters: presentationModes -- [in] vector of VkPresentModeKHR types with the presentation modes that the device 
  *                                  supports
@@ -2241,19 +4025,30 @@ VkSurfaceFormatKHR vkContext::chooseBestSurfaceFormat(const std::vector<VkSurfac
  * returns   : VkPresentModeKHR value representing the optimal presentation mode.
  *
  * written   : Mar 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) choose based on the presentation policy rather than always preferring mailbox
 ************************************************************************************************************************/
 VkPresentModeKHR vkContext::chooseBestPresentationMode(const std::vector<VkPresentModeKHR> presentationModes)
 {
- // look for mailbox presentation mode -- prevents tearing
-  for (const auto& presentationMode : presentationModes)
+  std::vector<VkPresentModeKHR> preferred;
+
+  switch (m_presentPolicy)
+  {
+    case PRESENT_LOW_LATENCY:   preferred = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR }; break;
+    case PRESENT_MAILBOX:       preferred = { VK_PRESENT_MODE_MAILBOX_KHR }; break;
+    case PRESENT_VSYNC_RELAXED: preferred = { VK_PRESENT_MODE_FIFO_RELAXED_KHR }; break;
+    case PRESENT_VSYNC:         break;
+  }
+
+  for (VkPresentModeKHR mode : preferred)
   {
-    if (presentationMode == VK_PRESENT_MODE_MAILBOX_KHR)
+    if (std::find(presentationModes.begin(), presentationModes.end(), mode) != presentationModes.end())
     {
-      return presentationMode;
+      return mode;
     }
   }
-    // if can't find mailbox, choose FIFo mode -- Vulkan spec says it must be presnet
-    return VK_PRESENT_MODE_FIFO_KHR;
+
+  // if can't find a preferred mode, choose FIFO mode -- Vulkan spec says it must be present
+  return VK_PRESENT_MODE_FIFO_KHR;
 }
 
 
@@ -2353,6 +4148,7 @@ VkFormat vkContext::chooseSupportedFormat(const std::vector<VkFormat>& formats,
  * returns   : the image object, thows a runtime exception on error.
  *
  * written   : Apr 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) memory comes from allocateDeviceMemory, so the tracker sees it
 ************************************************************************************************************************/
 VkImage vkContext::createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling , VkImageUsageFlags useFlags, VkMemoryPropertyFlags propFlags, VkDeviceMemory* imageMemory)
 {
@@ -2388,12 +4184,7 @@ VkImage vkContext::createImage(uint32_t width, uint32_t height, VkFormat format,
   vkGetImageMemoryRequirements(m_device.logical, image, &memoryRequirements);
 
   // Allocate memory using image requirements and user defined properties
-  VkMemoryAllocateInfo memoryAllocInfo = {};
-  memoryAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  memoryAllocInfo.allocationSize = memoryRequirements.size;
-  memoryAllocInfo.memoryTypeIndex = findMemoryTypeIndex(m_device.physical, memoryRequirements.memoryTypeBits, propFlags);
-
-  result = vkAllocateMemory(m_device.logical, &memoryAllocInfo, nullptr, imageMemory);
+  result = allocateDeviceMemory(m_device.physical, m_device.logical, memoryRequirements, propFlags, imageMemoryTag(useFlags), imageMemory);
   if (result != VK_SUCCESS)
   {
     throw std::runtime_error("Failed to allocate memory for image!");
@@ -2416,17 +4207,19 @@ VkImage vkContext::createImage(uint32_t width, uint32_t height, VkFormat format,
  * parameters: image -- [in] swapchain image to create a view for
  *             format -- [in] format to use to create the view.
  *             aspectFlags -- [in] properties of the view.
+ *             layers -- [in] layers of the image, more than one is viewed as an array (multiview attachments)
  * 
  * returns   : VkImageView structure
  *
  * written   : Mar 2024 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) views every layer of a layered image
 ************************************************************************************************************************/
-VkImageView vkContext::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags)
+VkImageView vkContext::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t layers)
 {
   VkImageViewCreateInfo viewCreateInfo = {};
   viewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
   viewCreateInfo.image = image;											              // Image to create view for
-  viewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;						    // Type of image (1D, 2D, 3D, Cube, etc)
+  viewCreateInfo.viewType = (layers > 1) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;   // Type of image (1D, 2D, 3D, Cube, etc)
   viewCreateInfo.format = format;											            // Format of image data
   viewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;		// Allows remapping of rgba components to other rgba values
   viewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -2437,7 +4230,7 @@ VkImageView vkContext::createImageView(VkImage image, VkFormat format, VkImageAs
   viewCreateInfo.subresourceRange.baseMipLevel = 0;						    // Start mipmap level to view from
   viewCreateInfo.subresourceRange.levelCount = 1;							    // Number of mipmap levels to view
   viewCreateInfo.subresourceRange.baseArrayLayer = 0;						  // Start array level to view from
-  viewCreateInfo.subresourceRange.layerCount = 1;							    // Number of array levels to view
+  viewCreateInfo.subresourceRange.layerCount = layers;					    // Number of array levels to view
 
   // Create image view and return it
   VkImageView imageView;
@@ -2490,13 +4283,43 @@ VkShaderModule vkContext::createShaderModule(const std::vector<char>& code)
 
 
 
-int vkContext::createTextureImage(std::string fileName)
+VkImage vkContext::createTextureImage(std::string fileName, VkDeviceMemory* memory, VkDeviceSize* bytes)
 {
   int width, height;
   VkDeviceSize imageSize;
 
   stbi_uc* imageData = loadTextureFile(fileName, &width, &height, &imageSize);
 
+  VkImage image = uploadTextureImage(imageData, width, height, memory);
+  *bytes = imageSize;
+
+  // free original image data
+  stbi_image_free(imageData);
+
+  return image;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : uploadTextureImage
+ *
+ * abstract  : Copies RGBA8 pixel data into a new device local image (via a staging buffer), ready for sampling.
+ *
+ * parameters: pixels -- [in] width * height RGBA8 pixels
+ *             width -- [in] width of the image
+ *             height -- [in] height of the image
+ *             memory -- [out] memory bound to the image
+ *
+ * returns   : VkImage, the image
+ *
+ * written   : Oct 2026 (GKHuber) split out of createTextureImage
+ * modified  : Oct 2026 (GKHuber) returns the image rather than its index, textures are kept by addTexture
+************************************************************************************************************************/
+VkImage vkContext::uploadTextureImage(const uint8_t* pixels, int width, int height, VkDeviceMemory* memory)
+{
+  VkDeviceSize imageSize = static_cast<VkDeviceSize>(width) * height * 4;
+
   // create staging buffer to hold loaded data
   VkBuffer imageStagingBuffer;
   VkDeviceMemory imageStagingBufferMemory;
@@ -2506,16 +4329,12 @@ int vkContext::createTextureImage(std::string fileName)
   // copy image data to buffer
   void* data;
   vkMapMemory(m_device.logical, imageStagingBufferMemory, 0, imageSize, 0, &data);
-  memcpy(data, imageData, static_cast<uint32_t>(imageSize));
+  memcpy(data, pixels, static_cast<size_t>(imageSize));
   vkUnmapMemory(m_device.logical, imageStagingBufferMemory);
 
-  // free original image data
-  stbi_image_free(imageData);
-
   // create image to hold final texture
   VkImage texImage;
-  VkDeviceMemory texImageMemory;
-  texImage = createImage(width, height, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &texImageMemory);
+  texImage = createImage(width, height, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memory);
 
   // copy data to image
   transitionImageLayout(m_device.logical, m_graphicsQueue, m_graphicsCommandPool, texImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
@@ -2525,36 +4344,113 @@ int vkContext::createTextureImage(std::string fileName)
   // Transition image to be shader readable for shader usage
   transitionImageLayout(m_device.logical, m_graphicsQueue, m_graphicsCommandPool, texImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-  m_textureImages.push_back(texImage);
-  m_textureImageMemory.push_back(texImageMemory);
-
   vkDestroyBuffer(m_device.logical, imageStagingBuffer, nullptr);
-  vkFreeMemory(m_device.logical, imageStagingBufferMemory, nullptr);
+  freeDeviceMemory(m_device.logical, imageStagingBufferMemory);
+
+  return texImage;
+}
+
+
+
+textureHandle vkContext::createTexture(std::string fileName)
+{
+  VkDeviceMemory memory;
+  VkDeviceSize   bytes;
+  VkImage        image = createTextureImage(fileName, &memory, &bytes);
+
+  return addTexture(image, memory, bytes);
+}
+
+
+
+// gives an uploaded image a view and a descriptor set, and the texture a handle
+textureHandle vkContext::addTexture(VkImage image, VkDeviceMemory memory, VkDeviceSize bytes)
+{
+  textureResource texture;
+  texture.image = gpuImage(m_device.logical, image, memory, createImageView(image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT));
+  texture.bytes = bytes;
+
+  VkDescriptorSet descriptorSet = createTextureDescriptor(texture.image.getView());
+  m_textureBytes += bytes;
 
-  return m_textureImages.size() - 1;
+  textureHandle h = m_textures.create(descriptorSet, std::move(texture));
+  m_textures.getCold(h)->image.setOwner({ OWNER_TEXTURE, h.index });
+  m_dirty = true;
+  return h;
 }
 
 
 
-int vkContext::createTexture(std::string fileName)
+/************************************************************************************************************************
+ * function  : createTextureFromPixels
+ *
+ * abstract  : Creates a texture from RGBA8 pixels held in memory (e.g. generated procedurally).  Each texture needs a
+ *             set from the sampler descriptor pool, when the pool is full we report it and fail rather than throwing.
+ *
+ * parameters: rgba -- [in] width * height RGBA8 pixels
+ *             width -- [in] width of the texture
+ *             height -- [in] height of the texture
+ *
+ * returns   : textureHandle, texture to pass to createProceduralModel, null if the sampler descriptor pool is full
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+textureHandle vkContext::createTextureFromPixels(const uint8_t* rgba, int width, int height)
+{
+  if (m_textures.size() >= m_texturePoolSize)
+  {
+    std::cerr << "[-] sampler descriptor pool is full (" << m_texturePoolSize << " textures)" << std::endl;
+    return textureHandle();
+  }
+
+  VkDeviceMemory memory;
+  VkImage        image = uploadTextureImage(rgba, width, height, &memory);
+
+  return addTexture(image, memory, static_cast<VkDeviceSize>(width) * height * 4);
+}
+
+
+
+/************************************************************************************************************************
+ * function  : destroyTexture
+ *
+ * abstract  : Destroys a texture and gives its set back to the sampler descriptor pool.  Meshes that still hold the
+ *             handle find it stale and are drawn with the default texture.  The device is waited on first, frames in
+ *             flight may be sampling it; this is not for the frame loop.
+ *
+ * parameters: texture -- [in] the texture
+ *
+ * returns   : bool, false if the handle is stale or is the default texture
+ *
+ * written   : Oct 2026 (GKHuber)
+************************************************************************************************************************/
+bool vkContext::destroyTexture(textureHandle texture)
 {
-  // Create Texture Image and get its location in array
-  int textureImageLoc = createTextureImage(fileName);
+  if (!m_textures.isValid(texture) || texture == m_defaultTexture) return false;
+
+  vkDeviceWaitIdle(m_device.logical);
+
+  VkDescriptorSet descriptorSet = *m_textures.getHot(texture);
+  vkFreeDescriptorSets(m_device.logical, m_samplerDescriptorPool, 1, &descriptorSet);
+  m_textureBytes -= m_textures.getCold(texture)->bytes;
 
-  // Create Image View and add to list
-  VkImageView imageView = createImageView(m_textureImages[textureImageLoc], VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT);
-  m_textureImageViews.push_back(imageView);
+  m_textures.destroy(texture);                       // the image, view and memory go with the pool entry
+  m_dirty = true;
+  return true;
+}
 
-  // Create Texture Descriptor
-  int descriptorLoc = createTextureDescriptor(imageView);
 
-  // Return location of set with texture
-  return descriptorLoc;
+
+// the set to bind for a mesh's texture, fallback (the default texture's) if the handle is null or stale
+VkDescriptorSet vkContext::textureSet(textureHandle texture, VkDescriptorSet fallback)
+{
+  VkDescriptorSet* set = m_textures.getHot(texture);
+  return (nullptr == set) ? fallback : *set;
 }
 
 
 
-int vkContext::createTextureDescriptor(VkImageView textureImage)
+VkDescriptorSet vkContext::createTextureDescriptor(VkImageView textureImage)
 {
   VkDescriptorSet descriptorSet;
 
@@ -2591,16 +4487,48 @@ int vkContext::createTextureDescriptor(VkImageView textureImage)
   // Update new descriptor set
   vkUpdateDescriptorSets(m_device.logical, 1, &descriptorWrite, 0, nullptr);
 
-  // Add descriptor set to list
-  m_samplerDescriptorSets.push_back(descriptorSet);
+  return descriptorSet;
+}
+
+
+// reports the draw calls a model needed before and after its meshes were merged
+static void reportMerge(const std::string& modelFile, meshMerger& merger)
+{
+  std::cerr << "[+] " << modelFile << ": merged " << merger.getSourceCount() << " meshes into " << merger.getGroupCount()
+            << " (draw calls " << merger.getSourceCount() << " -> " << merger.getGroupCount() << ")" << std::endl;
+}
+
+// case insensitive test of a file name's extension, e.g. hasExtension("x.OBJ", ".obj")
+static bool hasExtension(const std::string& fileName, const char* extension)
+{
+  size_t length = strlen(extension);
+  if (fileName.size() <= length) return false;
 
-  // Return descriptor set location
-  return m_samplerDescriptorSets.size() - 1;
+  for (size_t ndx = 0; ndx < length; ndx++)
+  {
+    if (tolower((unsigned char)fileName[fileName.size() - length + ndx]) != tolower((unsigned char)extension[ndx])) return false;
+  }
+  return true;
 }
 
 
-int vkContext::createMeshModel(std::string modelFile)
+
+modelHandle vkContext::createMeshModel(std::string modelFile)
 {
+  // binary glTF and Wavefront OBJ are read directly, everything else goes through Assimp
+  if (hasExtension(modelFile, ".glb"))
+  {
+    return createGlbModel(modelFile);
+  }
+  if (hasExtension(modelFile, ".obj"))
+  {
+    return createObjModel(modelFile);
+  }
+  if (hasExtension(modelFile, ".vkc"))
+  {
+    return createStreamedModel(modelFile);
+  }
+
   // Import model "scene"
   Assimp::Importer importer;
   const aiScene* scene = importer.ReadFile(modelFile, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
@@ -2612,33 +4540,411 @@ int vkContext::createMeshModel(std::string modelFile)
   // Get vector of all materials with 1:1 ID placement
   std::vector<std::string> textureNames = MeshModel::LoadMaterials(scene);
 
-  // Conversion from the materials list IDs to our Descriptor Array IDs
-  std::vector<int> matToTex(textureNames.size());
+  // Conversion from the materials list IDs to our texture handles
+  std::vector<textureHandle> matToTex(textureNames.size());
 
   // Loop over textureNames and create textures for them
   for (size_t i = 0; i < textureNames.size(); i++)
   {
-    // If material had no texture, set '0' to indicate no texture, texture 0 will be reserved for a default texture
-    if (textureNames[i].empty())
+    // If material had no texture, leave the handle null, meshes with a null handle are drawn with the default texture
+    if (!textureNames[i].empty())
     {
-      matToTex[i] = 0;
+      matToTex[i] = createTexture(textureNames[i]);
     }
-    else
+  }
+
+  // Load in all our meshes, or merge those that share a texture
+  std::vector<mesh> modelMeshes;
+  if (m_mergeMeshes)
+  {
+    // the merger groups by material index, which build then maps through matToTex
+    std::vector<int> materials(matToTex.size());
+    for (size_t i = 0; i < materials.size(); i++) materials[i] = (int)i;
+
+    meshMerger merger;
+    MeshModel::mergeNode(scene->mRootNode, scene, materials, glm::mat4(1.0f), &merger);
+    modelMeshes = merger.build(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool, matToTex,
+      VK_NULL_HANDLE != m_cullPipeline);
+    reportMerge(modelFile, merger);
+  }
+  else
+  {
+    modelMeshes.reserve(MeshModel::countMeshes(scene->mRootNode));
+    MeshModel::loadNode(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool,
+      scene->mRootNode, scene, matToTex, &modelMeshes, VK_NULL_HANDLE != m_cullPipeline);
+  }
+
+  // Create mesh model and add to list, the meshes are moved in rather than copied
+  return addModel(MeshModel(std::move(modelMeshes)));
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createGlbModel
+ *
+ * abstract  : Loads a binary glTF file without Assimp.  The file is memory mapped, vertex and index data that is
+ *             already in our layout (see glbLoader::convert) is memcpy'd from the mapping into the staging buffers,
+ *             anything else is converted first.  Embedded images are decoded straight from the mapping, images that
+ *             are referenced by name are loaded from ./Textures/ as the Assimp path does.
+ *
+ * parameters: modelFile -- [in] path of the .glb file
+ *
+ * returns   : modelHandle, handle of the new model
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) textures by handle
+************************************************************************************************************************/
+modelHandle vkContext::createGlbModel(std::string modelFile)
+{
+  glbLoader loader;
+  loader.open(modelFile);
+
+  // one texture per image that a material uses, a null handle (the default texture) when it fails to load
+  const std::vector<glbImage>& images = loader.getImages();
+  std::vector<textureHandle> imageToTex(images.size());
+  std::vector<bool>          imageLoaded(images.size(), false);
+  for (int image : loader.getMaterialImages())
+  {
+    if (image < 0 || imageLoaded[image]) continue;
+
+    if (nullptr != images[image].data)       imageToTex[image] = createTextureFromMemory(images[image].data, images[image].size);
+    else if (!images[image].uri.empty())     imageToTex[image] = createTexture(images[image].uri);
+    imageLoaded[image] = true;
+  }
+
+  std::vector<mesh>     modelMeshes;
+  std::vector<vertex>   vertexScratch;
+  std::vector<uint32_t> indexScratch;
+  meshMerger            merger;              // used if m_mergeMeshes, node transforms are ignored as by the unmerged path
+  if (!m_mergeMeshes) modelMeshes.reserve(loader.getPrimitives().size());
+  for (const glbPrimitive& primitive : loader.getPrimitives())
+  {
+    size_t vertexCount = glbLoader::vertexCount(primitive);
+    size_t indexCount = glbLoader::indexCount(primitive);
+    if (0 == vertexCount || 0 == indexCount) continue;
+
+    int image = -1;                          // -1 => the default texture
+    if (primitive.material >= 0 && primitive.material < (int)loader.getMaterialImages().size())
     {
-      // Otherwise, create texture and set value to index of new texture
-      matToTex[i] = createTexture(textureNames[i]);
+      image = loader.getMaterialImages()[primitive.material];
+    }
+
+    const void* vertices = glbLoader::vertexData(primitive, &vertexScratch);
+    const void* indices = glbLoader::indexData(primitive, &indexScratch);
+
+    if (m_mergeMeshes)
+    {
+      merger.add(vertices, (uint32_t)vertexCount, indices, (uint32_t)indexCount, image);
+      continue;
+    }
+
+    textureHandle texture = (image >= 0) ? imageToTex[image] : textureHandle();
+    modelMeshes.emplace_back(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool,
+      vertices, (uint32_t)vertexCount, indices, (uint32_t)indexCount, texture, VK_NULL_HANDLE != m_cullPipeline);
+  }
+
+  if (m_mergeMeshes)
+  {
+    modelMeshes = merger.build(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool, imageToTex,
+      VK_NULL_HANDLE != m_cullPipeline);
+    reportMerge(modelFile, merger);
+  }
+
+  return addModel(MeshModel(std::move(modelMeshes)));
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createObjModel
+ *
+ * abstract  : Loads a Wavefront OBJ file (and its materials) with objLoader, which parses and welds on the job system,
+ *             rather than Assimp.  Textures are created for the materials that a mesh uses, from ./Textures/ as the
+ *             Assimp path does.
+ *
+ * parameters: modelFile -- [in] path of the .obj file
+ *
+ * returns   : modelHandle, handle of the new model
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) textures by handle
+************************************************************************************************************************/
+modelHandle vkContext::createObjModel(std::string modelFile)
+{
+  objModel model;
+  objLoader loader(m_jobs);
+  loader.load(modelFile, &model);
+
+  // materials to textures, created on first use; a null handle (the default texture) if the material has none
+  std::vector<textureHandle> matToTex(model.textureNames.size());
+  std::vector<bool>          matLoaded(model.textureNames.size(), false);
+
+  std::vector<mesh> modelMeshes;
+  meshMerger        merger;                  // used if m_mergeMeshes, OBJ has no transforms
+  if (!m_mergeMeshes) modelMeshes.reserve(model.meshes.size());
+  for (objMesh& source : model.meshes)
+  {
+    textureHandle texture;
+    if (source.material >= 0)
+    {
+      if (!matLoaded[source.material])
+      {
+        if (!model.textureNames[source.material].empty()) matToTex[source.material] = createTexture(model.textureNames[source.material]);
+        matLoaded[source.material] = true;
+      }
+      texture = matToTex[source.material];
+    }
+
+    if (m_mergeMeshes)
+    {
+      merger.add(source.vertices.data(), (uint32_t)source.vertices.size(), source.indices.data(), (uint32_t)source.indices.size(), source.material);
+      std::vector<vertex>().swap(source.vertices);
+      std::vector<uint32_t>().swap(source.indices);
+      continue;
+    }
+
+    modelMeshes.emplace_back(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool,
+      &source.vertices, &source.indices, texture, VK_NULL_HANDLE != m_cullPipeline);
+  }
+
+  if (m_mergeMeshes)
+  {
+    modelMeshes = merger.build(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool, matToTex,
+      VK_NULL_HANDLE != m_cullPipeline);
+    reportMerge(modelFile, merger);
+  }
+
+  return addModel(MeshModel(std::move(modelMeshes)));
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createStreamedModel
+ *
+ * abstract  : Opens a chunk file (see chunkFile::build) as a streamed model.  Its textures and every chunk's proxy are
+ *             loaded now, the full detail chunks are paged in and uploaded by the stream as they come into view (see
+ *             geometryStream::update) within the stream budget.  The model itself has no meshes; recordcommands adds
+ *             the stream's draws for the frame under its id, so it is moved, gets statistics and so on as any other.
+ *
+ * parameters: modelFile -- [in] path of the .vkc file
+ *
+ * returns   : modelHandle, handle of the new model
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) textures and the model by handle
+************************************************************************************************************************/
+modelHandle vkContext::createStreamedModel(std::string modelFile)
+{
+  std::unique_ptr<geometryStream> stream(new geometryStream(m_device.physical, m_device.logical, m_graphicsQueue,
+    m_graphicsCommandPool, m_jobs));
+  stream->open(modelFile);
+
+  std::vector<textureHandle> textures;
+  for (const std::string& name : stream->getTextureNames()) textures.push_back(createTexture(name));
+
+  stream->setBudget(m_streamBudget);
+  stream->createProxies(textures);
+
+  // the stream's draws need room in the frame arenas, addModel sizes them
+  m_streamDrawCapacity += stream->getChunkCount();
+  m_streams.push_back(std::move(stream));
+
+  modelInfo info;
+  info.streamed = true;
+  modelHandle model = addModel(MeshModel(), info);
+  m_streamModel.push_back(static_cast<uint32_t>(m_models.indexOf(model)));
+  m_streams.back()->setMemoryOwner({ OWNER_MODEL, model.index });
+
+  std::cerr << "[+] " << modelFile << ": streaming " << m_streams.back()->getChunkCount() << " chunks, budget "
+            << m_streamBudget / (1024 * 1024) << " MB" << std::endl;
+
+  return model;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createModelInstance
+ *
+ * abstract  : Adds another copy of an existing model.  The copy shares the original's vertex/index buffers (so costs
+ *             no GPU memory), but has its own transform and is drawn separately.
+ *
+ * parameters: model -- [in] model to copy, may itself be an instance
+ *
+ * returns   : modelHandle, handle of the new model, null if model is not valid
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) models by handle, the instance shares the original's mesh list (see MeshModel)
+************************************************************************************************************************/
+modelHandle vkContext::createModelInstance(modelHandle model)
+{
+  modelInfo* info = m_models.getCold(model);
+  if (nullptr == info) return modelHandle();
+  if (info->streamed)
+  {
+    std::cerr << "[-] streamed models can not be instanced" << std::endl;
+    return modelHandle();
+  }
+
+  return addModel(m_models.getHot(model)->createInstance());
+}
+
+
+
+/************************************************************************************************************************
+ * function  : createProceduralModel
+ *
+ * abstract  : Creates a single mesh model from vertex and index data generated by the caller rather than read from a
+ *             file.
+ *
+ * parameters: vertices -- [in] pointer to the vertex data
+ *             indices -- [in] pointer to the index data (triangle list)
+ *             texture -- [in] texture to use, as returned by createTextureFromPixels, null for the default texture
+ *
+ * returns   : modelHandle, handle of the new model
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) textures and models by handle
+************************************************************************************************************************/
+modelHandle vkContext::createProceduralModel(std::vector<vertex>* vertices, std::vector<uint32_t>* indices, textureHandle texture)
+{
+  std::vector<mesh> meshes;
+  meshes.emplace_back(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool, vertices, indices, texture,
+    VK_NULL_HANDLE != m_cullPipeline);
+
+  return addModel(MeshModel(std::move(meshes)));
+}
+
+
+
+// common tail of the create*Model functions, registers the model with everything that is sized per model
+modelHandle vkContext::addModel(MeshModel&& model, modelInfo info)
+{
+  // take over any meshlets the meshes were built with, instances share the meshes (and meshlets) of their original
+  for (size_t k = 0; k < model.getMeshCount(); k++)
+  {
+    mesh* thisMesh = model.getMesh(k);
+    const meshletData* data = thisMesh->getMeshletData();
+    if (nullptr != data && thisMesh->getMeshletCount() > 0)
+    {
+      uint32_t vertexBase = static_cast<uint32_t>(m_meshletVertices.size());
+      uint32_t triangleBase = static_cast<uint32_t>(m_meshletTriangles.size());
+
+      thisMesh->setFirstMeshlet(static_cast<int>(m_meshlets.size()));
+      for (meshlet m : data->meshlets)
+      {
+        m.vertexOffset += vertexBase;
+        m.triangleOffset += triangleBase;
+        m_meshlets.push_back(m);
+      }
+      m_meshletVertices.insert(m_meshletVertices.end(), data->vertices.begin(), data->vertices.end());
+      m_meshletTriangles.insert(m_meshletTriangles.end(), data->triangles.begin(), data->triangles.end());
     }
+    thisMesh->releaseMeshletData();
+
+    if (thisMesh->getFirstMeshlet() >= 0) m_meshletsDirty = true;
+  }
+
+  // geometry counts for the pipeline statistics report, the GPU counters are filled in as queries complete
+  pipelineStats stats;
+  stats.meshCount = model.getMeshCount();
+  stats.indexCount = model.getIndexCount();
+  stats.triangleCount = stats.indexCount / 3;
+  m_modelStats.push_back(stats);
+
+  modelHandle h = m_models.create(std::move(model), info);
+  m_transforms.add();
+
+  // charge the buffers to the model in the device memory report, an instance's are the original's
+  MeshModel* added = m_models.getHot(h);
+  if (added->ownsMeshes())
+  {
+    for (size_t k = 0; k < added->getMeshCount(); k++) added->getMesh(k)->setMemoryOwner({ OWNER_MODEL, h.index });
+  }
+
+  // make sure the frame arenas can hold the draw list, growing them here keeps the allocation out of the frame loop
+  m_totalMeshCount += stats.meshCount;
+  size_t arenaSize = (m_totalMeshCount + m_streamDrawCapacity) * sizeof(drawItem) + alignof(drawItem);
+  for (auto& arena : m_frameArena)
+  {
+    if (arena.getCapacity() < arenaSize) arena.reserve(std::max(arenaSize * 2, FRAME_ARENA_SIZE));
+  }
+
+  m_dirty = true;
+  return h;
+}
+
+
+
+/************************************************************************************************************************
+ * function  : destroyModel
+ *
+ * abstract  : Removes a model from the scene.  A streamed model can not be removed (the stream keeps its dense index).
+ *             The model's slot in the pool is freed, so its handle (and any copy of it) stops resolving, and the last
+ *             model moves into its place in the dense array; the transforms and statistics kept alongside move with
+ *             it.  The meshes, and their buffers, go with the last model drawing them, so an original can be removed
+ *             while its instances stay.  Meshlets the model added stay in the meshlet arrays until the context is
+ *             cleaned up, they are just no longer drawn.
+ *
+ * parameters: model -- [in] model to remove
+ *
+ * returns   : bool, true if the model was removed
+ *
+ * written   : Oct 2026 (GKHuber)
+ * modified  : Oct 2026 (GKHuber) meshes are shared by the models drawing them, originals can go before instances
+************************************************************************************************************************/
+bool vkContext::destroyModel(modelHandle model)
+{
+  modelInfo* info = m_models.getCold(model);
+  if (nullptr == info) return false;
+  if (info->streamed)
+  {
+    std::cerr << "[-] streamed models can not be destroyed" << std::endl;
+    return false;
+  }
+
+  // the frames in flight may still draw it
+  vkDeviceWaitIdle(m_device.logical);
+
+  m_totalMeshCount -= m_models.getHot(model)->getMeshCount();
+
+  size_t last = m_models.size() - 1;
+  size_t ndx = m_models.destroy(model);
+  m_transforms.remove(ndx);
+  if (ndx != last) m_modelStats[ndx] = m_modelStats[last];
+  m_modelStats.pop_back();
+  for (uint32_t& streamModel : m_streamModel)
+  {
+    if (streamModel == last) streamModel = static_cast<uint32_t>(ndx);
   }
 
-  // Load in all our meshes
-  std::vector<mesh> modelMeshes = MeshModel::loadNode(m_device.physical, m_device.logical, m_graphicsQueue, m_graphicsCommandPool,
-    scene->mRootNode, scene, matToTex);
+  // queries already recorded were indexed by the old dense order, and the meshlet draws are built from the model list
+  std::fill(m_statsQueriesIssued.begin(), m_statsQueriesIssued.end(), 0);
+  if (m_meshletDrawCount > 0) m_meshletsDirty = true;
+  m_dirty = true;
+
+  return true;
+}
+
+
+
+// decodes an image file held in memory (PNG, JPEG, TGA, ... anything stb_image reads), a null handle if it can not be used
+textureHandle vkContext::createTextureFromMemory(const uint8_t* encoded, size_t size)
+{
+  int width, height, channels;
+  stbi_uc* image = stbi_load_from_memory(encoded, (int)size, &width, &height, &channels, STBI_rgb_alpha);
+  if (!image)
+  {
+    std::cerr << "[-] failed to decode an embedded image: " << stbi_failure_reason() << std::endl;
+    return textureHandle();
+  }
 
-  // Create mesh model and add to list
-  MeshModel meshModel = MeshModel(modelMeshes);
-  m_modelList.push_back(meshModel);
+  textureHandle texture = createTextureFromPixels(image, width, height);
+  stbi_image_free(image);
 
-  return m_modelList.size() - 1;
+  return texture;
 }
 
 
@@ -2648,9 +4954,21 @@ stbi_uc* vkContext::loadTextureFile(std::string fileName, int* width, int* heigh
   // number of channels image used
   int channels;
 
-  // load pixel data for images
-  std::string fileLoc = "./Textures/" + fileName;
-  stbi_uc* image = stbi_load(fileLoc.c_str(), width, height, &channels, STBI_rgb_alpha);
+  // load pixel data for images, decoded from memory when the texture is in the asset pack (one unbuffered read)
+  std::string      fileLoc = "./Textures/" + fileName;
+  assetPack*       pack = assetPack::current();
+  const packEntry* entry = (nullptr != pack) ? pack->find(fileLoc) : nullptr;
+  stbi_uc*         image = nullptr;
+  if (nullptr != entry)
+  {
+    packBuffer bytes;
+    pack->read(*entry, &bytes, &m_jobs);
+    image = stbi_load_from_memory(bytes.data(), (int)bytes.size(), width, height, &channels, STBI_rgb_alpha);
+  }
+  else
+  {
+    image = stbi_load(fileLoc.c_str(), width, height, &channels, STBI_rgb_alpha);
+  }
 
   if (!image)
   {
@@ -16,12 +16,27 @@
 #include <set>
 #include <algorithm>
 #include <array>
+#include <memory>
+#include <chrono>
 
 #include "stb_image.h"
 
 #include "mesh.h"
 #include "MeshModel.h"
 #include "utilities.h"
+#include "jobSystem.h"
+#include "linearArena.h"
+#include "transformStore.h"
+#include "glbLoader.h"
+#include "objLoader.h"
+#include "geometryStream.h"
+#include "taskGraph.h"
+#include "handlePool.h"
+#include "gpuResource.h"
+#include "deviceScore.h"
+#include "perfHud.h"
+#include "frameStats.h"
+#include "renderGraph.h"
 
 class vkContext
 {
@@ -29,26 +44,115 @@ public:
   vkContext(GLFWwindow*, bool v = true);
   ~vkContext();
 
+  void setPresentPolicy(presentPolicy policy);       // must be called before initContext
+  void setDeviceOverride(const std::string& spec);   // must be called before initContext, see selectDevice
+  void setHud(bool enable);                          // must be called before initContext
+  void setViews(uint32_t count);                     // split screen views drawn in one pass, before initContext
+  void setOnDemand(bool enable);                     // draw only when something has changed, see needsRedraw
   int initContext();
 
-  int  createMeshModel(std::string modelFile);
-  void updateModel(int modelID, glm::mat4 newModel);
-  void draw();
+  modelHandle   createMeshModel(std::string modelFile);
+  modelHandle   createModelInstance(modelHandle model);
+  modelHandle   createProceduralModel(std::vector<vertex>* vertices, std::vector<uint32_t>* indices, textureHandle texture);
+  textureHandle createTextureFromPixels(const uint8_t* rgba, int width, int height);
+  bool destroyModel(modelHandle model);
+  bool destroyTexture(textureHandle texture);         // meshes still using it are drawn with the default texture
+  void setTexturePoolSize(uint32_t textures);        // must be called before initContext
+  void setMeshlets(bool enable);                     // must be called before initContext
+  void setMergeMeshes(bool enable);                  // applies to models loaded afterwards
+  void setStreamBudget(uint64_t bytes);              // GPU memory for each streamed (.vkc) model's chunks
+  void updateModel(modelHandle model, glm::mat4 newModel);
+  void updateModels(const modelHandle* models, size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales);
+  void setCamera(const glm::vec3& eye, const glm::vec3& target, const glm::vec3& up);
+  void invalidate();                                 // the next draw draws, e.g. the window needs repainting
+  bool needsRedraw();                                // always true unless drawing on demand
+  bool draw();                                       // false if nothing had changed and the frame was skipped
   void cleanupContext();
 
+  // pipeline statistics (vertex/clipping/fragment counts per model)
+  void enablePipelineStatistics(bool enable);
+  bool getModelStats(modelHandle model, pipelineStats* stats);
+  pipelineStats getPostPassStats();
+  void reportPipelineStatistics(std::ostream& os);
+  void reportStreaming(std::ostream& os);              // one line per streamed model, nothing if there are none
+  void reportInitialisation(std::ostream& os);         // initContext's steps and the time to the first frame
+  void reportDeviceMemory(std::ostream& os);           // totals by heap, use and owner, peak and live allocations
+  void reportRenderGraph(std::ostream& os);            // the frame's passes, render passes and barriers
+
+  VkPresentModeKHR getPresentMode();
+
+  resourceUsage getResourceUsage();
+  double        getLastRecordTime();                   // CPU time of the last recordcommands, in ms
+  const frameStatsHistory& getFrameStats();            // what the last FRAME_STATS_HISTORY frames did, newest first
+  void          reportFrameStats(std::ostream& os);    // their averages as one line
+
+  jobSystem& getJobSystem();                           // shared worker pool for loaders and recorders
+
 
 private:
   GLFWwindow* m_pWindow;
   bool        m_useValidation;
   int         m_currentFrame = 0;
-
-  // scene objects
-  std::vector<MeshModel>          m_modelList;
+  presentPolicy    m_presentPolicy = PRESENT_MAILBOX;
+  uint32_t         m_texturePoolSize = MAX_OBJECTS;  // sampler descriptor sets, i.e. the most textures we can load
+  uint64_t         m_textureBytes = 0;
+  double           m_lastRecordMs = 0.0;
+  VkPresentModeKHR m_presentMode = VK_PRESENT_MODE_FIFO_KHR;     // mode actually chosen for the swapchain
+
+  // shared thread pool
+  jobSystem        m_jobs;
+
+  // what a model needs besides its meshes, only looked at when models are created and destroyed
+  struct modelInfo
+  {
+    bool        streamed = false;
+  };
+
+  // a texture's Vulkan objects, the draw loop only needs the descriptor set (the pool's hot part)
+  struct textureResource
+  {
+    gpuImage       image;                                // with its memory and view, destroyed with the pool entry
+    VkDeviceSize   bytes = 0;
+  };
+
+  // scene objects.  m_transforms, m_modelStats and m_streamModel are indexed like the models' dense array, so follow
+  // its moves when a model is destroyed
+  handlePool<modelTag, MeshModel, modelInfo> m_models;
+  size_t                          m_totalMeshCount = 0;
+  transformStore                  m_transforms;          // one per model, composed with the view-projection each frame
+
+  // one draw call, flattened out of the model list into the frame arena by recordcommands
+  struct drawItem
+  {
+    VkBuffer  vertexBuffer;
+    VkBuffer  indexBuffer;
+    VkDescriptorSet textureSet;        // resolved from the mesh's texture handle as the list is built
+    uint32_t  indexCount;
+    uint32_t  modelId;                 // dense index of the model
+    int32_t   firstMeshlet;          // -1 => drawn whole, otherwise culled by recordCulling
+    uint32_t  meshletCount;
+    uint32_t  command;               // the draw's indirect command in m_cullBuffer
+  };
+
+  // push constants of the meshlet cull shader (Shaders/cull.comp), 128 bytes, the most every device has to allow
+  struct cullConstants
+  {
+    glm::vec4 planes[6];
+    glm::vec4 camera;
+    uint32_t  firstMeshlet;
+    uint32_t  meshletCount;
+    uint32_t  command;
+    uint32_t  unused;
+  };
+
+  // transient per-frame memory, reset when the frame's fence is waited on.  Keeps the frame loop off the heap.
+  linearArena                     m_frameArena[MAX_FRAME_DRAWS];
 
   // scene settings
   struct UboVP {
     glm::mat4 proj;
     glm::mat4 view;
+    glm::mat4 viewProj[MAX_VIEWS];     // proj * view of each view, turned about the model (see updateUniformBuffers)
   } m_uboVP;
 
   // Vulkan components
@@ -62,16 +166,30 @@ private:
   
   std::vector<swapChainImage> m_swapChainImages;
   std::vector<VkFramebuffer>  m_swapChainFrameBuffers;
+  std::vector<VkFramebuffer>  m_sceneFrameBuffers;       // the scene's own render pass, with more than one view
   std::vector<VkCommandBuffer> m_commandbuffers;
 
   std::vector<VkImage>         m_colourBufferImage;
-  std::vector<VkDeviceMemory>  m_colourBufferImageMemory;
   std::vector<VkImageView>     m_colourBufferImageView;
 
   std::vector<VkImage>         m_depthBufferImage;
-  std::vector<VkDeviceMemory>  m_depthBufferImageMemory;
   std::vector<VkImageView>     m_depthBufferImageView;
 
+  // the frame as a render graph, which the render pass, the attachments' usage and memory and the cull barriers come from
+  renderGraph                  m_renderGraph;
+  uint32_t                     m_swapChainResource = renderGraph::npos;   // resources and passes in m_renderGraph
+  uint32_t                     m_colourResource = renderGraph::npos;
+  uint32_t                     m_depthResource = renderGraph::npos;
+  uint32_t                     m_cullResetPass = renderGraph::npos;
+  uint32_t                     m_cullPass = renderGraph::npos;
+  uint32_t                     m_scenePass = renderGraph::npos;
+  uint32_t                     m_postPass = renderGraph::npos;
+  VkFormat                     m_colourFormat = VK_FORMAT_UNDEFINED;
+  VkFormat                     m_depthFormat = VK_FORMAT_UNDEFINED;
+  std::vector<VkDeviceMemory>  m_attachmentMemory;                 // per swapchain image, one block per alias slot
+  std::vector<VkDeviceSize>    m_attachmentSlotBytes;              // size of each slot's block, for reportRenderGraph
+  std::vector<bool>            m_attachmentSlotLazy;
+
   VkSampler                    m_textureSampler;
 
   // descriptor sets
@@ -84,7 +202,6 @@ private:
   VkDescriptorPool             m_samplerDescriptorPool;
   VkDescriptorPool             m_inputDescriptorPool;
   std::vector<VkDescriptorSet> m_descriptorSets;
-  std::vector<VkDescriptorSet> m_samplerDescriptorSets;
   std::vector<VkDescriptorSet> m_inputDescriptorSets;
 
   std::vector<VkBuffer>        m_vpUniformBuffer;
@@ -92,7 +209,6 @@ private:
 
   std::vector<VkBuffer>        m_modelDUniformBuffer;
   std::vector<VkDeviceMemory>  m_modelDUniformBufferMemory;
-  std::vector<VkImageView>     m_textureImageViews;
 
   //VkDeviceSize                 m_minUniformBufferOffset;
   //size_t                       m_modelUniformAlignment;
@@ -102,10 +218,12 @@ private:
     VkPhysicalDevice  physical;
     VkDevice          logical;
   } m_device;
+  std::string         m_deviceOverride;              // --device=, else $VULKAN7_DEVICE
+  bool                m_deviceIds = false;           // instance has the extensions for device UUIDs
 
-  // asset handling
-  std::vector<VkImage>        m_textureImages;
-  std::vector<VkDeviceMemory> m_textureImageMemory;
+  // asset handling, a texture is one set from the sampler descriptor pool
+  handlePool<textureTag, VkDescriptorSet, textureResource> m_textures;
+  textureHandle               m_defaultTexture;     // plain.png, drawn for a null or destroyed texture
 
   // pipeline components
   VkPipeline                  m_graphicsPipeline;
@@ -114,12 +232,89 @@ private:
   VkPipeline                  m_secondPipeline;
   VkPipelineLayout            m_secondPipelineLayout;
   VkRenderPass                m_renderPass;
+  VkRenderPass                m_sceneRenderPass;     // m_renderPass unless the scene is drawn in views
+
+  // multiview split screen (see setViews), each view draws the scene into its own layer of the colour and depth images
+  uint32_t                    m_viewCount = 1;
+  VkExtent2D                  m_sceneExtent = {};    // of a layer, the swapchain's width split between the views
 
   //pools
   VkCommandPool       m_graphicsCommandPool;
 
+  // pipeline statistics queries
+  VkQueryPool                  m_statsQueryPool = VK_NULL_HANDLE;
+  bool                         m_statsSupported = false;       // device supports pipelineStatisticsQuery
+  bool                         m_useStats = false;             // user requested statistics
+  std::vector<uint32_t>        m_statsQueriesIssued;           // per swapchain image, number of queries recorded
+  std::vector<uint64_t>        m_statsResults;                 // scratch space for vkGetQueryPoolResults
+  std::vector<pipelineStats>   m_modelStats;                   // indexed by the model's dense index
+  pipelineStats                m_postPassStats;
+
+  // meshlet culling, a compute pass ahead of the render pass writes the visible triangles of each mesh that has meshlets
+  bool                         m_useMeshlets = false;          // user requested meshlets
+  bool                         m_mergeMeshes = false;          // merge meshes sharing a texture at import, see setMergeMeshes
+  bool                         m_meshletsDirty = false;        // models added since the buffers below were built
+  std::vector<meshlet>         m_meshlets;                     // every mesh's meshlets, offsets into the two lists below
+  std::vector<uint32_t>        m_meshletVertices;
+  std::vector<uint32_t>        m_meshletTriangles;
+  uint32_t                     m_meshletDrawCount = 0;         // draws culled by meshlet, one indirect command each
+  VkBuffer                     m_meshletBuffer = VK_NULL_HANDLE;          // the three lists above, back to back
+  VkDeviceMemory               m_meshletBufferMemory = VK_NULL_HANDLE;
+  VkDeviceSize                 m_meshletRanges[4] = {};                   // offsets of the lists in m_meshletBuffer, and its size
+  std::vector<VkBuffer>        m_cullBuffer;                   // per swapchain image, indirect commands then culled indices
+  std::vector<VkDeviceMemory>  m_cullBufferMemory;
+  VkDeviceSize                 m_cullIndexOffset = 0;          // of the culled indices in m_cullBuffer
+  VkBuffer                     m_cullCommandTemplate = VK_NULL_HANDLE;    // the commands with no indices, copied over each frame
+  VkDeviceMemory               m_cullCommandTemplateMemory = VK_NULL_HANDLE;
+  VkDescriptorSetLayout        m_cullSetLayout = VK_NULL_HANDLE;
+  VkDescriptorPool             m_cullDescriptorPool = VK_NULL_HANDLE;
+  std::vector<VkDescriptorSet> m_cullDescriptorSets;
+  VkPipelineLayout             m_cullPipelineLayout = VK_NULL_HANDLE;
+  VkPipeline                   m_cullPipeline = VK_NULL_HANDLE;
+
+  // out-of-core models (see createStreamedModel), stream i draws as the model with dense index m_streamModel[i]
+  std::vector<std::unique_ptr<geometryStream>> m_streams;
+  std::vector<uint32_t>        m_streamModel;
+  size_t                       m_streamDrawCapacity = 0;       // most draws the streams can add to a frame
+  uint64_t                     m_streamBudget = STREAM_DEFAULT_BUDGET;
+  uint64_t                     m_frameCount = 0;               // frames drawn, the streams' clock
+
+  // on demand drawing (see setOnDemand); what is drawn has changed since the last frame.  Starts set for the first frame
+  bool                         m_onDemand = false;
+  std::atomic<bool>            m_dirty{ true };                // set by loaders on the job system's workers too
+  bool                         m_skipped = false;              // the last draw was skipped, so the HUD skips the gap
+
+  // per frame counters, see frameStats.h.  m_frameCounters is the frame being drawn, pushed onto the history by draw
+  frameStatsHistory            m_frameStats;
+  frameStats                   m_frameCounters;
+
+  // initContext's steps after the logical device, and when it started (for the time to the first frame)
+  taskGraph                    m_initGraph;
+  std::chrono::steady_clock::time_point m_initStart;
+  double                       m_firstFrameMs = 0.0;
+
+  // performance HUD (see setHud), one instanced draw at the end of the post-process subpass
+  bool                         m_useHud = false;
+  perfHud                      m_hud;
+  hudFrameData                 m_hudData;                      // CPU phases are the previous frame's, see draw
+  gpuImage                     m_hudAtlas;                     // the font, see perfHud::buildAtlas
+  VkDescriptorSet              m_hudAtlasSet = VK_NULL_HANDLE; // from the sampler descriptor pool
+  VkPipeline                   m_hudPipeline = VK_NULL_HANDLE;
+  VkPipelineLayout             m_hudPipelineLayout = VK_NULL_HANDLE;
+  std::vector<gpuBuffer>       m_hudQuadBuffer;                // per swapchain image, host visible and kept mapped
+  std::vector<hudQuad*>        m_hudQuads;
+  std::chrono::steady_clock::time_point m_lastFrameStart;
+
+  // GPU timestamps for the HUD, HUD_TIMESTAMPS per swapchain image; none if the graphics queue cannot write them
+  VkQueryPool                  m_timestampPool = VK_NULL_HANDLE;
+  std::vector<uint32_t>        m_timestampsIssued;             // per swapchain image, 0 or HUD_TIMESTAMPS
+  uint64_t                     m_timestampResults[HUD_TIMESTAMPS * 2] = {};   // value and availability of each
+  uint64_t                     m_timestampMask = 0;            // timestampValidBits of the graphics queue family
+  double                       m_timestampPeriod = 0.0;        // ns per tick
+
   // Utility components
   VkFormat   m_swapChainImageFormat;
+  VkSurfaceFormatKHR m_surfaceFormat;           // chosen before the swapchain is made, see initContext
   VkExtent2D m_swapChainExtent;
 
   // synchronisation
@@ -137,13 +332,15 @@ private:
   void createDescriptorSetLayout();
   void createPushConstantRange();
   void createGraphicsPipeline();
-  void createColourBufferImage();
-  void createDepthBufferImage();
+  void createAttachmentImages();
   void createFramebuffers();
   void createCommandPool();
   void createCommandBuffers();
   void createSynchronisations();
   void createTextureSampler();
+  void createQueryPool();
+  void createCullPipeline();
+  void createHudResources();
 
   void createUniformBuffers();
   void createDescriptorPool();
@@ -151,9 +348,16 @@ private:
   void createInputDescriptorSets();
 
   void updateUniformBuffers(uint32_t imageIndex);
+  void collectPipelineStatistics(uint32_t imageIndex);
+  void collectTimestamps(uint32_t imageIndex);
+  void updateMeshletBuffers();
+  void destroyMeshletBuffers();
 
   // Vulkan functions -- record functions
   void recordcommands(uint32_t imageIndex);
+  void recordCulling(uint32_t imageIndex, const drawItem* drawList, size_t drawCount);
+  void recordHud(uint32_t imageIndex);
+  void clearRenderPass(uint32_t renderPass, std::array<VkClearValue, 3>& clearValues, VkRenderPassBeginInfo& beginInfo);
 
   // Vulkan functions - get functions
   void getPhysicalDevice();
@@ -165,6 +369,7 @@ private:
   bool checkDeviceExtensionSupport(VkPhysicalDevice);
   bool checkValidationLayerSupport();
   bool checkDeviceSuitable(VkPhysicalDevice);
+  uint32_t multiviewViewCount();
   
   // support functions -- getter functions
   queueFamilyIndices getQueueFamilies(VkPhysicalDevice, VkQueueFamilyProperties*);
@@ -179,14 +384,23 @@ private:
 
 
   // generic create functions
-  VkImageView    createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags); 
+  VkImageView    createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t layers = 1);
   VkShaderModule createShaderModule(const std::vector<char>& code);
-  int            createTextureImage(std::string fileName);
-  int            createTexture(std::string fileName);
-  int            createTextureDescriptor(VkImageView textureImage);
+  VkImage        createTextureImage(std::string fileName, VkDeviceMemory* memory, VkDeviceSize* bytes);
+  VkImage        uploadTextureImage(const uint8_t* pixels, int width, int height, VkDeviceMemory* memory);
+  textureHandle  createTexture(std::string fileName);
+  VkDescriptorSet createTextureDescriptor(VkImageView textureImage);
+  textureHandle  addTexture(VkImage image, VkDeviceMemory memory, VkDeviceSize bytes);
+
+  VkDescriptorSet textureSet(textureHandle texture, VkDescriptorSet fallback);
 
   // loader functions
   stbi_uc* loadTextureFile(std::string fileName, int* width, int* height, VkDeviceSize* imageSize);
+  textureHandle createTextureFromMemory(const uint8_t* encoded, size_t size);
+  modelHandle   createGlbModel(std::string modelFile);
+  modelHandle   createObjModel(std::string modelFile);
+  modelHandle   createStreamedModel(std::string modelFile);
+  modelHandle   addModel(MeshModel&& model, modelInfo info = modelInfo());
 };
 
 